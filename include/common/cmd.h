@@ -10,6 +10,7 @@
 
 #include "ascii.h"
 #include "get_opt.h"
+#include "tm_usage.h"
 
 #include <cstdio>
 
@@ -71,10 +72,12 @@ namespace CommonNs
 		Cmd *getCmd(const std::string &name) const;
 		Result read();
 		Result exec(const std::string &cmdStr);
+		bool serve(const std::string &sockPath, const bool &isSerial);
 		void setComment(const char &ch);
 		void setPrompt(const std::string &str);
 		void setColor(const Color &color);
 		void setExit(const bool &exit);
+		bool setTelemetry(const std::string &fname);
 		bool addVar(const std::string &var, const std::string &str);
 		VarMap getVars() const;
 		Error getError() const;
@@ -101,6 +104,15 @@ namespace CommonNs
 		void resetStdout(const int &stdoutFd,
 										 const fpos_t &stdoutPos) const;
 
+		// serving clients on a socket
+		void serveClient(const int &fd);
+
+		// per command telemetry
+		Result execTraced(Cmd *const cmd, const std::vector<std::string> &argv);
+		void writeTelemetry(const std::vector<std::string> &argv,
+												const Result &res,
+												const TmStat &stat) const;
+
 		// user interface printing
 		void refresh();
 		void autoComplete();
@@ -125,6 +137,10 @@ namespace CommonNs
 		std::string cmdStr_;							// user input command string
 		size_t csrPos_;										// cursor position
 		size_t maxPos_;										// maximum command string position
+
+		std::string telemetryFile_; // JSON lines file, empty if disabled
+		int cmdDepth_;							 // nesting of commands run by source
+		long childRssPeak_;					 // peak RSS of the nested commands
 	};
 
 	// Cmd inline methods
@@ -147,6 +163,8 @@ namespace CommonNs
 		color_ = WHITE;
 		error_ = E_EXIST;
 		exit_ = false;
+		cmdDepth_ = 0;
+		childRssPeak_ = 0;
 	}
 
 	inline CmdMgr::~CmdMgr() {}
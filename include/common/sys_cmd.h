@@ -94,6 +94,18 @@ namespace CommonNs
 		CmdMgr *cmdMgr_;
 	};
 
+	class SysServeCmd : public Cmd
+	{
+	public:
+		SysServeCmd(const std::string &name, CmdMgr *mgr);
+		~SysServeCmd();
+
+		bool exec(const std::vector<std::string> &argv);
+
+	private:
+		CmdMgr *cmdMgr_;
+	};
+
 	class SysHelpCmd : public Cmd
 	{
 	public:
@@ -17,9 +17,18 @@ namespace CommonNs
 		long vmSize; // in kilobytes
 		long vmPeak; // in kilobytes
 		long vmDiff; // in kilobytes
+		long rss;		 // in kilobytes
+		long rssPeak; // in kilobytes
 		long rTime;	 // in micro seconds
 		long uTime;	 // in micro seconds
 		long sTime;	 // in micro seconds
+		long tuTime; // in micro seconds, calling thread only
+		long tsTime; // in micro seconds, calling thread only
+		long minFlt; // page faults without I/O
+		long majFlt; // page faults with I/O
+		long nvCsw;	 // voluntary context switches
+		long nivCsw; // involuntary context switches
+		long nThread;
 	};
 
 	class TmUsage
@@ -33,8 +42,11 @@ namespace CommonNs
 		bool getTotalUsage(TmStat &st) const;
 		bool getPeriodUsage(TmStat &st) const;
 		bool checkUsage(TmStat &st) const;
+		bool resetRssPeak() const;
 
 	private:
+		void subtract(TmStat &st, const TmStat &start) const;
+
 		TmStat tStart_;
 		TmStat pStart_;
 	};
@@ -0,0 +1,68 @@
+// **************************************************************************
+// File       [ atpg_checkpoint.h ]
+// Author     [ PYH ]
+// Synopsis   [ binary checkpoint of a pattern generation run ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_ATPG_CHECKPOINT_H_
+#define _CORE_ATPG_CHECKPOINT_H_
+
+#include <vector>
+
+#include "pattern.h"
+
+namespace CoreNs
+{
+
+	// ************************************
+	// * file layout, native byte order
+	// *     char[4]  magic "FANC"
+	// *     uint32   version
+	// *     uint32   fault list type
+	// *     uint32   number of faults in faultsInCircuit_
+	// *     uint64   signature of the fault list
+	// *     faults   uint8 state, uint32 detections, for every fault
+	// *     int32    current fault, int32 number of untestable faults
+	// *     int32    phase, int32 backtrack limit of the phase
+	// *     list     uint32 size, uint32 fault indices; target faults
+	// *     list     uint32 size, uint32 fault indices; faults for STC
+	// *     uint32   number of patterns
+	// *     patterns PI1, PI2, PPI, SI, PO1, PO2, PPO as uint32 size, values
+	// ************************************
+
+	// State of Atpg::generatePatternSet between two target faults. Faults
+	// are stored as their index in faultsInCircuit_, so a checkpoint can
+	// only be restored into a fault list built the same way.
+	// The X-fill needs no state of its own, Atpg::randomFill reseeds for
+	// every pattern.
+	class AtpgCheckpoint
+	{
+	public:
+		AtpgCheckpoint();
+		~AtpgCheckpoint();
+
+		bool write(const char *const fname, FaultListExtract *pFaultListExtract, const PatternProcessor *pPatternProcessor) const;
+		bool read(const char *const fname, FaultListExtract *pFaultListExtract, PatternProcessor *pPatternProcessor);
+
+		FaultPtrList targetFaults_; // faults left to target, in order
+		FaultPtrList stcFaults_;		// faults graded by static compression
+		Fault *pCurrentFault_;			// fault targeted by the last step
+		int numOfAtpgUntestableFaults_;
+		int phase_;					 // index into Atpg::backtrackLimits_
+		int backtrackLimit_; // in use by the phase
+	};
+
+	inline AtpgCheckpoint::AtpgCheckpoint()
+	{
+		pCurrentFault_ = NULL;
+		numOfAtpgUntestableFaults_ = 0;
+		phase_ = 0;
+		backtrackLimit_ = 0;
+	}
+
+	inline AtpgCheckpoint::~AtpgCheckpoint() {}
+
+};
+
+#endif
@@ -8,8 +8,10 @@
 #ifndef _CORE_FAULT_H_
 #define _CORE_FAULT_H_
 
+#include <limits>
 #include <vector>
 #include <list>
+#include <utility>
 #include "circuit.h"
 
 namespace CoreNs
@@ -30,6 +32,11 @@ namespace CoreNs
 		// *     STF    slow to fall
 		// *     BR     bridge
 		// *
+		// * bridge types , victim is gateID_ and aggressor is aggr_
+		// *     WAND   wired-AND, both nets take the AND of the two values
+		// *     WOR    wired-OR, both nets take the OR of the two values
+		// *     DOM    dominant, the victim takes the value of the aggressor
+		// *
 		// * fault states  , defined according to TMAX
 		// *     UD     undetected
 		// *     DT     detected
@@ -47,6 +54,12 @@ namespace CoreNs
 			STF,
 			BR
 		};
+		enum BRIDGE_TYPE
+		{
+			WAND = 0,
+			WOR,
+			DOM
+		};
 		enum FAULT_STATE
 		{
 			UD = 0,
@@ -60,15 +73,20 @@ namespace CoreNs
 
 		Fault();
 		Fault(int gateID, FAULT_TYPE faultType, int faultyLine, int equivalent = 1, FAULT_STATE faultState = UD);
+		Fault(int gateID, int aggr, BRIDGE_TYPE bridgeType);
 
-		// int aggr_;            // ID of the aggressor gate.
+		int aggr_;               // ID of the aggressor gate, only used by bridge faults.
+		BRIDGE_TYPE bridgeType_; // Bridge type, only used by bridge faults.
 		int gateID_;             // ID of the faulty gate.
 		FAULT_TYPE faultType_;   // Fault type.
 		int faultyLine_;         // Faulty line location: 0 means gate output fault,
 		                         // 1+ means gate input fault on the corresponding gate input line.
 		int detection_;          // Number of detection.
+		float detectionSlack_;   // Least slack of a path detecting the fault, see Simulator::setTiming.
+		                         // Infinity if no path was graded.
 		FAULT_STATE faultState_; // Fault state.
 		int equivalent_;         // The number of equivalent faults, used to calculate uncollapsed fault coverage.
+		bool isDominated_;       // Dominated by other faults, not targeted by ATPG, see FaultListExtract::markDominatedFaults.
 	};
 
 	class FaultListExtract
@@ -80,42 +98,89 @@ namespace CoreNs
 			TDF,
 			BRF
 		};
+		// ************************************
+		// * collapse types
+		// *     NO_COLLAPSE  every fault is kept
+		// *     EQUIVALENCE  simple equivalent fault collapsing
+		// *     DOMINANCE    equivalence, checkpoint reduction and dominance
+		// *                  collapsing, plus static untestability marking
+		// ************************************
+		enum COLLAPSE_TYPE
+		{
+			NO_COLLAPSE = 0,
+			EQUIVALENCE,
+			DOMINANCE
+		};
 
 		FaultListExtract();
 
 		// Extract faults from the circuit.
 		void extractFaultFromCircuit(Circuit *pCircuit);
+		// Extract bridge faults from a net pair file.
+		bool extractBridgeFaultFromFile(Circuit *pCircuit, const char *const fname, const Fault::BRIDGE_TYPE &defaultType);
+		// Mark faults which are untestable by structure alone as TI or RE.
+		void markUntestableFaults(Circuit *pCircuit, int &numTied, int &numRedundant);
+		// Mark a dominated fault DT once one of its dominating faults is.
+		void markDominatedFaults();
 
 		std::vector<int> gateIndexToFaultIndex_; // Map gate index to fault list index.
 		std::vector<Fault> uncollapsedFaults_;   // Record faults without fault collapsing, used for adding part of faults for ATPG.
 		std::vector<Fault> extractedFaults_;     // Faults extracted from the circuit.
 		FaultPtrList faultsInCircuit_;           // Faults used in the ATPG.
 		FAULTLIST_TYPE faultListType_;           // Fault list type.
+		COLLAPSE_TYPE collapseType_;             // Fault collapsing method.
+		std::vector<std::pair<int, int> > dominance_; // Dominated and dominating fault, indices into extractedFaults_.
+
+	private:
+		void collapseFaultByDominance(Circuit *pCircuit);
 	};
 
 	inline Fault::Fault()
 	{
+		aggr_ = -1;
+		bridgeType_ = WAND;
 		gateID_ = -1;
 		faultType_ = SA0;
 		faultyLine_ = -1;
 		detection_ = 0;
+		detectionSlack_ = std::numeric_limits<float>::infinity();
 		faultState_ = UD;
 		equivalent_ = 1;
+		isDominated_ = false;
 	}
 
 	inline Fault::Fault(int gateID, FAULT_TYPE faultType, int faultyLine, int equivalent, FAULT_STATE faultState)
 	{
+		aggr_ = -1;
+		bridgeType_ = WAND;
 		gateID_ = gateID;
 		faultType_ = faultType;
 		faultyLine_ = faultyLine;
 		detection_ = 0;
+		detectionSlack_ = std::numeric_limits<float>::infinity();
 		faultState_ = faultState;
 		equivalent_ = equivalent;
+		isDominated_ = false;
+	}
+
+	inline Fault::Fault(int gateID, int aggr, BRIDGE_TYPE bridgeType)
+	{
+		aggr_ = aggr;
+		bridgeType_ = bridgeType;
+		gateID_ = gateID;
+		faultType_ = BR;
+		faultyLine_ = 0;
+		detection_ = 0;
+		detectionSlack_ = std::numeric_limits<float>::infinity();
+		faultState_ = UD;
+		equivalent_ = 1;
+		isDominated_ = false;
 	}
 
 	inline FaultListExtract::FaultListExtract()
 	{
 		faultListType_ = SAF;
+		collapseType_ = EQUIVALENCE;
 	}
 
 };
@@ -0,0 +1,84 @@
+// **************************************************************************
+// File       [ fault_rw.h ]
+// Author     [ PYH ]
+// Synopsis   [ binary fault grading results, written by fault simulation
+//              shards and merged back into the fault list ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_FAULT_RW_H_
+#define _CORE_FAULT_RW_H_
+
+#include <stdint.h>
+
+#include "fault.h"
+
+namespace CoreNs
+{
+
+	// ************************************
+	// * file layout, native byte order
+	// *     char[4]  magic "FANR"
+	// *     uint32   version
+	// *     uint32   fault list type
+	// *     uint32   number of faults in faultsInCircuit_
+	// *     uint64   signature of the fault list
+	// *     uint32   shard index
+	// *     uint32   number of shards
+	// *     uint32   number of records
+	// *     records  uint32 fault index, uint32 detections, uint8 state
+	// ************************************
+
+	// Fault k of faultsInCircuit_ belongs to shard k % numShard, so every
+	// process building the fault list the same way agrees on the slices.
+	class FaultResultWriter
+	{
+	public:
+		FaultResultWriter(FaultListExtract *pFaultListExtract);
+		~FaultResultWriter();
+
+		bool writeResult(const char *const fname, const int &shardIndex, const int &numShard);
+
+	protected:
+		FaultListExtract *pFaultListExtract_;
+	};
+
+	inline FaultResultWriter::FaultResultWriter(FaultListExtract *pFaultListExtract)
+	{
+		pFaultListExtract_ = pFaultListExtract;
+	}
+
+	inline FaultResultWriter::~FaultResultWriter() {}
+
+	class FaultResultReader
+	{
+	public:
+		FaultResultReader(FaultListExtract *pFaultListExtract);
+		~FaultResultReader();
+
+		// Merge a result file into the fault list. A detection in any file
+		// wins, detection counts add up.
+		bool mergeResult(const char *const fname, int &numRecord);
+
+	protected:
+		FaultListExtract *pFaultListExtract_;
+	};
+
+	inline FaultResultReader::FaultResultReader(FaultListExtract *pFaultListExtract)
+	{
+		pFaultListExtract_ = pFaultListExtract;
+	}
+
+	inline FaultResultReader::~FaultResultReader() {}
+
+	// identity of the faults in faultsInCircuit_, in list order
+	uint64_t getFaultListSignature(FaultListExtract *pFaultListExtract);
+
+	inline bool isFaultInShard(const size_t &faultIndex, const int &shardIndex, const int &numShard)
+	{
+		return (int)(faultIndex % (size_t)numShard) == shardIndex;
+	}
+
+};
+
+#endif
@@ -48,7 +48,15 @@ namespace CoreNs
 			TIE0,
 			TIE1,
 			TIEX,
-			TIEZ
+			TIEZ,
+			// N-input gates, for primitives wider than the fixed types above.
+			// Appended so the numbers of the older types stay the same.
+			ANDN,
+			NANDN,
+			ORN,
+			NORN,
+			XORN,
+			XNORN
 		};
 		inline Gate();
 		inline Gate(int gateId, int cellId, int primitiveId, int numLevel, GateType gateType, int numFO);
@@ -185,8 +193,11 @@ namespace CoreNs
 			case NOR2:
 			case NOR3:
 			case NOR4:
+			case NANDN:
+			case NORN:
 			case XNOR2:
 			case XNOR3:
+			case XNORN:
 				return H;
 			default:
 				return L;
@@ -249,14 +260,18 @@ namespace CoreNs
 			case OR2:
 			case OR3:
 			case OR4:
+			case ORN:
 			case NAND2:
 			case NAND3:
 			case NAND4:
+			case NANDN:
 				return L;
 			case XOR2:
 			case XOR3:
+			case XORN:
 			case XNOR2:
 			case XNOR3:
+			case XNORN:
 				return X;
 			default:
 				return H;
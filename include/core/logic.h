@@ -43,6 +43,100 @@ namespace CoreNs
 		return (parallelValue & ((ParallelValue)0x01 << bit)) == PARA_L ? L : H;
 	}
 
+	// dual-rail encoding of the 5-valued logic used by ATPG
+	// bit 0/1 : the good value is 0/1, bit 2/3 : the faulty value is 0/1,
+	// bit 4 : high-impedance. X sets no rail, so a gate of any fanin count
+	// is evaluated by a few bitwise operations and D/B fall out directly.
+	typedef unsigned char Rail;
+	constexpr Rail RAIL_G0 = 0x01;
+	constexpr Rail RAIL_G1 = 0x02;
+	constexpr Rail RAIL_F0 = 0x04;
+	constexpr Rail RAIL_F1 = 0x08;
+	constexpr Rail RAIL_Z = 0x10;
+	constexpr Rail RAIL_ZERO = RAIL_G0 | RAIL_F0; // zero rails, also the value L
+	constexpr Rail RAIL_ONE = RAIL_G1 | RAIL_F1;	// one rails, also the value H
+	constexpr Rail RAIL_GOOD = RAIL_G0 | RAIL_G1;
+
+	// indexed by L, H, X, D, B, Z
+	constexpr Rail VALUE_TO_RAIL[6] = {RAIL_ZERO, RAIL_ONE, 0, RAIL_G1 | RAIL_F0, RAIL_G0 | RAIL_F1, RAIL_Z};
+
+	// a value is only L, H, D or B when both the good and the faulty value
+	// are known, anything partially known is X
+	constexpr Value railToValueEntry(const Rail r)
+	{
+		return (r & RAIL_Z) ? Z
+				 : ((r & RAIL_GOOD) == RAIL_G0 && (r & ~RAIL_GOOD) == RAIL_F0) ? L
+				 : ((r & RAIL_GOOD) == RAIL_G1 && (r & ~RAIL_GOOD) == RAIL_F1) ? H
+				 : ((r & RAIL_GOOD) == RAIL_G1 && (r & ~RAIL_GOOD) == RAIL_F0) ? D
+				 : ((r & RAIL_GOOD) == RAIL_G0 && (r & ~RAIL_GOOD) == RAIL_F1) ? B
+				 : X;
+	}
+
+	constexpr Value RAIL_TO_VALUE[32] = {
+			railToValueEntry(0), railToValueEntry(1), railToValueEntry(2), railToValueEntry(3),
+			railToValueEntry(4), railToValueEntry(5), railToValueEntry(6), railToValueEntry(7),
+			railToValueEntry(8), railToValueEntry(9), railToValueEntry(10), railToValueEntry(11),
+			railToValueEntry(12), railToValueEntry(13), railToValueEntry(14), railToValueEntry(15),
+			railToValueEntry(16), railToValueEntry(17), railToValueEntry(18), railToValueEntry(19),
+			railToValueEntry(20), railToValueEntry(21), railToValueEntry(22), railToValueEntry(23),
+			railToValueEntry(24), railToValueEntry(25), railToValueEntry(26), railToValueEntry(27),
+			railToValueEntry(28), railToValueEntry(29), railToValueEntry(30), railToValueEntry(31)};
+
+	static_assert(RAIL_TO_VALUE[RAIL_ZERO] == L && RAIL_TO_VALUE[RAIL_ONE] == H && RAIL_TO_VALUE[0] == X &&
+										RAIL_TO_VALUE[RAIL_G1 | RAIL_F0] == D && RAIL_TO_VALUE[RAIL_G0 | RAIL_F1] == B,
+								"RAIL_TO_VALUE must invert VALUE_TO_RAIL");
+
+	// values above Z, i.e. I, are treated as Z like the scalar tables did
+	inline Rail valueToRail(const Value &value)
+	{
+		return value >= Z ? RAIL_Z : VALUE_TO_RAIL[value];
+	}
+
+	inline Value railToValue(const Rail &rail)
+	{
+		return RAIL_TO_VALUE[rail];
+	}
+
+	inline Rail railInv(const Rail &a)
+	{
+		return ((a & RAIL_ZERO) << 1) | ((a >> 1) & RAIL_ZERO) | (a & RAIL_Z);
+	}
+
+	// a zero on any input, a one on all inputs
+	inline Rail railAnd(const Rail &a, const Rail &b)
+	{
+		return ((a | b) & (RAIL_ZERO | RAIL_Z)) | (a & b & RAIL_ONE);
+	}
+
+	inline Rail railOr(const Rail &a, const Rail &b)
+	{
+		return ((a | b) & (RAIL_ONE | RAIL_Z)) | (a & b & RAIL_ZERO);
+	}
+
+	inline Rail railXor(const Rail &a, const Rail &b)
+	{
+		const Rail a0 = a & RAIL_ZERO;
+		const Rail a1 = (a >> 1) & RAIL_ZERO;
+		const Rail b0 = b & RAIL_ZERO;
+		const Rail b1 = (b >> 1) & RAIL_ZERO;
+		return ((a0 & b0) | (a1 & b1)) | (((a0 & b1) | (a1 & b0)) << 1) | ((a | b) & RAIL_Z);
+	}
+
+	// select ? in1 : in0, an unknown select still gives the value both
+	// inputs agree on
+	inline Rail railMux(const Rail &in0, const Rail &in1, const Rail &select)
+	{
+		const Rail select0 = (select & RAIL_ZERO) * 3; // spread onto both rails
+		const Rail select1 = ((select >> 1) & RAIL_ZERO) * 3;
+		return (((select0 & in0) | (select1 & in1) | (in0 & in1)) & ~RAIL_Z) | ((in0 | in1 | select) & RAIL_Z);
+	}
+
+	// force the faulty value, keeping the good one
+	inline Rail railInject(const Rail &a, const Value &stuckValue)
+	{
+		return (a & (RAIL_GOOD | RAIL_Z)) | (stuckValue == L ? RAIL_F0 : RAIL_F1);
+	}
+
 	void printValue(const Value &value, std::ostream &out = std::cout);
 	void printParallelValue(const ParallelValue &parallelValue, std::ostream &out = std::cout);
 	void printSimulationValue(const ParallelValue &low, const ParallelValue &high, std::ostream &out = std::cout);
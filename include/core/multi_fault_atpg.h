@@ -0,0 +1,76 @@
+// **************************************************************************
+// File       [ multi_fault_atpg.h ]
+// Author     [ PYH ]
+// Synopsis   [ bit-parallel test generation for a group of stuck-at faults ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_MULTI_FAULT_ATPG_H_
+#define _CORE_MULTI_FAULT_ATPG_H_
+
+#include <vector>
+
+#include "pattern.h"
+
+namespace CoreNs
+{
+
+	// Up to WORD_SIZE stuck-at faults are targeted by one shared input
+	// assignment. Bit k of every faulty value word carries the circuit with
+	// fault k injected; the good values are the same in all lanes. Each
+	// decision is taken for the first lane still alive and implied in all
+	// lanes at once.
+	//
+	// A lane is split off as soon as the shared assignment sets its fault
+	// site to the stuck value or leaves it with an empty D-frontier. There
+	// is no backtracking here, a split lane can only be picked up again by
+	// the next pattern, or by the scalar engine of Atpg.
+	//
+	// Only single time frame circuits are supported.
+	class MultiFaultAtpg
+	{
+	public:
+		MultiFaultAtpg(Circuit *pCircuit);
+
+		// generate one pattern for faults, at most WORD_SIZE stuck-at faults
+		// return the lanes detected by the pattern, bit k for faults[k]
+		ParallelValue generatePattern(const std::vector<Fault *> &faults, Pattern &pattern);
+
+	private:
+		void reset(const std::vector<Fault *> &faults);
+		bool evaluate(const int &gateID);
+		void assignInput(const int &gateID, const Value &val);
+		bool getObjective(const int &lane, int &gateID, Value &val) const;
+		bool backtrace(int gateID, Value val, int &inputGateID, Value &inputVal) const;
+		Value getGoodVal(const int &gateID) const;
+
+		Circuit *pCircuit_;
+		std::vector<ParallelValue> goodLow_;
+		std::vector<ParallelValue> goodHigh_;
+		std::vector<ParallelValue> faultLow_;
+		std::vector<ParallelValue> faultHigh_;
+		// same layout as the fault injection of Simulator, line 0 is the
+		// output and line k the k-th fanin, at injectBegin_[gateID] + line
+		std::vector<int> injectBegin_;
+		std::vector<ParallelValue> injectLow_;
+		std::vector<ParallelValue> injectHigh_;
+		std::vector<int> injectedGates_;
+		// fanin values of the gate under evaluation, as many as the widest gate
+		std::vector<ParallelValue> faninGoodLow_;
+		std::vector<ParallelValue> faninGoodHigh_;
+		std::vector<ParallelValue> faninFaultLow_;
+		std::vector<ParallelValue> faninFaultHigh_;
+		// lanes with the fault effect on a fanin but an unknown output
+		std::vector<ParallelValue> dFrontier_;
+		std::vector<int> dFrontierGates_;
+		std::vector<int> isInDFrontierGates_;
+		std::vector<std::vector<int>> events_;
+		std::vector<int> isInEvents_;
+		ParallelValue detected_;
+		// per lane, the gate whose good value activates the fault
+		int activationGates_[WORD_SIZE];
+		Value stuckVals_[WORD_SIZE];
+	};
+};
+
+#endif
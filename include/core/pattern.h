@@ -55,6 +55,103 @@ namespace CoreNs
 		SI_.resize(1);
 	}
 
+	// Up to PATTERNS_PER_BLOCK patterns as bitplanes, the unit a binary
+	// pattern file is stored and streamed in. Every signal has a value and
+	// a care plane of numWord_ words each, bit j of word w is pattern
+	// w * WORD_SIZE + j; a care bit of zero is X. Signals of a field are in
+	// circuit order, a field the patterns do not have is empty.
+	class PatternBlock
+	{
+	public:
+		enum Field
+		{
+			PI1 = 0,
+			PI2,
+			PPI,
+			SI,
+			PO1,
+			PO2,
+			PPO,
+			NUM_FIELD
+		};
+		static constexpr int PATTERNS_PER_BLOCK = 16 * WORD_SIZE;
+
+		inline PatternBlock();
+		// numSignal[f] signals in field f, 0 if the field is absent
+		inline void init(const int numSignal[NUM_FIELD], const int &numPattern);
+		inline int getNumSignal(const Field &field) const;
+		inline ParallelValue *getValuePlane(const Field &field, const int &index);
+		inline ParallelValue *getCarePlane(const Field &field, const int &index);
+		inline ParallelValue getLow(const Field &field, const int &index, const int &wordIndex) const;
+		inline ParallelValue getHigh(const Field &field, const int &index, const int &wordIndex) const;
+		inline Value getValue(const Field &field, const int &index, const int &patternIndex) const;
+
+		int numPattern_;
+		int numWord_;
+		int fieldBegin_[NUM_FIELD + 1]; // first signal of each field
+		std::vector<ParallelValue> planes_;
+	};
+
+	inline PatternBlock::PatternBlock()
+	{
+		numPattern_ = 0;
+		numWord_ = 0;
+		for (int f = 0; f <= NUM_FIELD; ++f)
+		{
+			fieldBegin_[f] = 0;
+		}
+	}
+
+	inline void PatternBlock::init(const int numSignal[NUM_FIELD], const int &numPattern)
+	{
+		numPattern_ = numPattern;
+		numWord_ = (numPattern + WORD_SIZE - 1) / WORD_SIZE;
+		fieldBegin_[0] = 0;
+		for (int f = 0; f < NUM_FIELD; ++f)
+		{
+			fieldBegin_[f + 1] = fieldBegin_[f] + numSignal[f];
+		}
+		planes_.assign((size_t)fieldBegin_[NUM_FIELD] * 2 * numWord_, PARA_L);
+	}
+
+	inline int PatternBlock::getNumSignal(const Field &field) const
+	{
+		return fieldBegin_[field + 1] - fieldBegin_[field];
+	}
+
+	inline ParallelValue *PatternBlock::getValuePlane(const Field &field, const int &index)
+	{
+		return &planes_[(size_t)(fieldBegin_[field] + index) * 2 * numWord_];
+	}
+
+	inline ParallelValue *PatternBlock::getCarePlane(const Field &field, const int &index)
+	{
+		return &planes_[((size_t)(fieldBegin_[field] + index) * 2 + 1) * numWord_];
+	}
+
+	inline ParallelValue PatternBlock::getLow(const Field &field, const int &index, const int &wordIndex) const
+	{
+		const size_t base = (size_t)(fieldBegin_[field] + index) * 2 * numWord_ + wordIndex;
+		return planes_[base + numWord_] & ~planes_[base];
+	}
+
+	inline ParallelValue PatternBlock::getHigh(const Field &field, const int &index, const int &wordIndex) const
+	{
+		const size_t base = (size_t)(fieldBegin_[field] + index) * 2 * numWord_ + wordIndex;
+		return planes_[base + numWord_] & planes_[base];
+	}
+
+	inline Value PatternBlock::getValue(const Field &field, const int &index, const int &patternIndex) const
+	{
+		const int wordIndex = patternIndex / WORD_SIZE;
+		const int bit = patternIndex % WORD_SIZE;
+		if (getBitValue(getLow(field, index, wordIndex), bit) == H)
+		{
+			return L;
+		}
+		return getBitValue(getHigh(field, index, wordIndex), bit) == H ? H : X;
+	}
+
 	// This class process the test pattern set
 	// it supports :
 	//  X-filling
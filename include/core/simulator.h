@@ -8,7 +8,7 @@
 #ifndef _CORE_SIMULATOR_H_
 #define _CORE_SIMULATOR_H_
 
-#include <array>
+#include <algorithm>
 #include <stack>
 #include <vector>
 
@@ -18,6 +18,9 @@
 
 namespace CoreNs
 {
+	class Timing;
+	class PatternBlockReader;
+
 	class Simulator
 	{
 	public:
@@ -39,10 +42,26 @@ namespace CoreNs
 
 		// Parallel pattern simulator.
 		void parallelPatternGoodSimWithAllPattern(PatternProcessor *pPatternCollector);
+		void parallelPatternWriteGoodSimValToPatternPO(PatternProcessor *pPatternCollector);
 		void parallelPatternFaultSimWithAllPattern(PatternProcessor *pPatternCollector, FaultListExtract *pFaultListExtract);
 		void parallelPatternFaultSim(FaultPtrList &remainingFaults);
+		// Same as parallelPatternFaultSimWithAllPattern, the patterns decoded
+		// from a binary pattern file one block at a time.
+		bool parallelPatternFaultSimWithPatternBlocks(const PatternBlockReader *pReader, FaultListExtract *pFaultListExtract);
+		// Small delay mode of the parallel pattern simulator. A transition
+		// fault is credited only by a pattern propagating it along a path
+		// with at most slackThreshold ns of slack, and its least detection
+		// slack is kept. NULL turns it off.
+		inline void setTiming(const Timing *pTiming, const float &slackThreshold);
 
 	private:
+		// Patterns whose longest sensitized path to a gate is length_ ns.
+		struct PathLength
+		{
+			float length_;
+			ParallelValue patterns_;
+		};
+
 		// Used by both parallel fault and parallel pattern simulation.
 		Circuit *pCircuit_;                   // The circuit use in simulator.
 		int numDetection_;                    // For n-detect.
@@ -53,28 +72,44 @@ namespace CoreNs
 		// This is to inject fault into the circuit.
 		// faultInjectLow_ = 1 faultInjectHigh_ = 0 means we inject a stuck-at zero fault.
 		// faultInjectLow_ = 0 faultInjectHigh_ = 1 means we inject a stuck-at one fault.
-		// We use 5 ParallelValues since a gate have 1 fanout and at most 4 fanins.
-		std::vector<std::array<ParallelValue, 5>> faultInjectLow_;
-		std::vector<std::array<ParallelValue, 5>> faultInjectHigh_;
+		// Line 0 of a gate is its output and line i its i-th fanin, stored at
+		// faultInjectBegin_[gateID] + line. Every gate gets at least 5 lines so the
+		// fixed-width evaluations can read fanin 1 to 4 unconditionally.
+		std::vector<int> faultInjectBegin_;
+		std::vector<ParallelValue> faultInjectLow_;
+		std::vector<ParallelValue> faultInjectHigh_;
 
 		// Used by parallel fault simulation.
 		FaultPtrListIter injectedFaults_[WORD_SIZE]; // The injected faults, used for erase detected faults.
 		int numInjectedFaults_;                      // The number of injected faults.
 		// Used by parallel pattern simulation.
 		ParallelValue activated_; // Record which pattern is activated.
+		// Used by small delay simulation.
+		const Timing *pTiming_;              // Delays of the first time frame, NULL if not timed.
+		float slackThreshold_;               // Detection slack a fault is credited up to.
+		std::vector<int> pathBegin_;         // Path lengths of a gate are paths_[pathBegin_[gateID]] up to pathEnd_[gateID].
+		std::vector<int> pathEnd_;
+		std::vector<PathLength> paths_;
+		std::vector<PathLength> faninPaths_; // Scratch for the path lengths of one gate.
 
 		// Functions for parallel fault simulator.
 		void parallelFaultReset();
 		bool parallelFaultCheckActivation(const Fault *const pfault);
 		void parallelFaultFaultInjection(const Fault *const pfault, const size_t &injectFaultIndex);
+		void parallelFaultBridgeInjection(const Fault *const pfault, const size_t &injectFaultIndex);
 		void parallelFaultCheckDetectionDropFaults(FaultPtrList &remainingFaults);
 
 		// Functions for parallel pattern simulator.
 		void parallelPatternReset();
 		bool parallelPatternCheckActivation(const Fault *const pfault);
 		void parallelPatternFaultInjection(const Fault *const pfault);
+		void parallelPatternBridgeInjection(const Fault *const pfault);
 		void parallelPatternCheckDetection(Fault *const pfault);
+		void parallelPatternCheckTimedDetection(Fault *const pfault);
+		inline bool isTimedFault(const Fault *const pfault) const;
+		inline static bool isLongerPath(const PathLength &a, const PathLength &b);
 		void parallelPatternSetPattern(PatternProcessor *pPatternProcessor, const int &patternStartIndex);
+		void parallelPatternSetPattern(const PatternBlock &block, const int &wordIndex);
 	};
 
 	inline Simulator::Simulator(Circuit *pCircuit)
@@ -84,11 +119,20 @@ namespace CoreNs
 				events_(pCircuit->totalLvl_),
 				processed_(pCircuit->totalGate_, 0),
 				recoverGates_(pCircuit->totalGate_),
-				faultInjectLow_(pCircuit->totalGate_, std::array<ParallelValue, 5>({0, 0, 0, 0, 0})),
-				faultInjectHigh_(pCircuit->totalGate_, std::array<ParallelValue, 5>({0, 0, 0, 0, 0})),
+				faultInjectBegin_(pCircuit->totalGate_ + 1, 0),
 				numInjectedFaults_(0),
-				activated_(PARA_L)
+				activated_(PARA_L),
+				pTiming_(NULL),
+				slackThreshold_(0),
+				pathBegin_(pCircuit->totalGate_, 0),
+				pathEnd_(pCircuit->totalGate_, 0)
 	{
+		for (int gateID = 0; gateID < pCircuit->totalGate_; ++gateID)
+		{
+			faultInjectBegin_[gateID + 1] = faultInjectBegin_[gateID] + std::max(pCircuit->circuitGates_[gateID].numFI_, 4) + 1;
+		}
+		faultInjectLow_.assign(faultInjectBegin_[pCircuit->totalGate_], PARA_L);
+		faultInjectHigh_.assign(faultInjectBegin_[pCircuit->totalGate_], PARA_L);
 	}
 
 	// **************************************************************************
@@ -107,6 +151,22 @@ namespace CoreNs
 		numDetection_ = numDetection;
 	}
 
+	inline void Simulator::setTiming(const Timing *pTiming, const float &slackThreshold)
+	{
+		pTiming_ = pTiming;
+		slackThreshold_ = slackThreshold;
+	}
+
+	inline bool Simulator::isTimedFault(const Fault *const pfault) const
+	{
+		return pTiming_ && pCircuit_->numFrame_ > 1 && (pfault->faultType_ == Fault::STR || pfault->faultType_ == Fault::STF);
+	}
+
+	inline bool Simulator::isLongerPath(const PathLength &a, const PathLength &b)
+	{
+		return a.length_ > b.length_;
+	}
+
 	// **************************************************************************
 	// Function   [ Simulator::goodSim ]
 	// Commenter  [ CJY, CBH, PYH ]
@@ -158,7 +218,7 @@ namespace CoreNs
 	//              arguments:
 	//              	[in] gateID : The gate we want to evaluate.
 	//            ]
-	// Date       [ Ver. 1.0 started 2013/08/18 last modified 2023/01/05 ]
+	// Date       [ Ver. 1.0 started 2013/08/18 last modified 2026/10/19 ]
 	// **************************************************************************
 	inline void Simulator::goodValueEvaluation(const int &gateID)
 	{
@@ -261,6 +321,47 @@ namespace CoreNs
 				pCircuit_->circuitGates_[gateID].goodSimHigh_ = (l1 & l2 & l3) | (l1 & h2 & h3) | (h1 & l2 & h3) | (h1 & h2 & l3);
 				// End of TO-DO
 				break;
+			case Gate::ANDN:
+			case Gate::NANDN:
+			case Gate::ORN:
+			case Gate::NORN:
+			{
+				// One AND and one OR per fanin, the AND family collects the low
+				// rails with OR and the OR family the high rails.
+				Gate &gate = pCircuit_->circuitGates_[gateID];
+				const bool isAnd = gate.gateType_ == Gate::ANDN || gate.gateType_ == Gate::NANDN;
+				ParallelValue anyCtrl = PARA_L;
+				ParallelValue allNonCtrl = PARA_H;
+				for (int i = 0; i < gate.numFI_; ++i)
+				{
+					const Gate &fanin = pCircuit_->circuitGates_[gate.faninVector_[i]];
+					anyCtrl |= isAnd ? fanin.goodSimLow_ : fanin.goodSimHigh_;
+					allNonCtrl &= isAnd ? fanin.goodSimHigh_ : fanin.goodSimLow_;
+				}
+				// the low rail of AND and NOR, the high rail of NAND and OR
+				const bool ctrlIsLow = gate.gateType_ == Gate::ANDN || gate.gateType_ == Gate::NORN;
+				gate.goodSimLow_ = ctrlIsLow ? anyCtrl : allNonCtrl;
+				gate.goodSimHigh_ = ctrlIsLow ? allNonCtrl : anyCtrl;
+				break;
+			}
+			case Gate::XORN:
+			case Gate::XNORN:
+			{
+				// Fold the fanins one at a time, an X on any of them clears both rails.
+				Gate &gate = pCircuit_->circuitGates_[gateID];
+				ParallelValue low = PARA_H;
+				ParallelValue high = PARA_L;
+				for (int i = 0; i < gate.numFI_; ++i)
+				{
+					const Gate &fanin = pCircuit_->circuitGates_[gate.faninVector_[i]];
+					const ParallelValue foldLow = (low & fanin.goodSimLow_) | (high & fanin.goodSimHigh_);
+					high = (low & fanin.goodSimHigh_) | (high & fanin.goodSimLow_);
+					low = foldLow;
+				}
+				gate.goodSimLow_ = gate.gateType_ == Gate::XORN ? low : high;
+				gate.goodSimHigh_ = gate.gateType_ == Gate::XORN ? high : low;
+				break;
+			}
 			case Gate::TIE1:
 				pCircuit_->circuitGates_[gateID].goodSimLow_ = PARA_L;
 				pCircuit_->circuitGates_[gateID].goodSimHigh_ = PARA_H;
@@ -296,7 +397,7 @@ namespace CoreNs
 	//              arguments:
 	//              	[in] gateID : The gate we want to evaluate.
 	//            ]
-	// Date       [ Ver. 1.0 started 2013/08/14 last modified 2023/01/06 ]
+	// Date       [ Ver. 1.0 started 2013/08/14 last modified 2026/10/19 ]
 	// **************************************************************************
 	inline void Simulator::faultyValueEvaluation(const int &gateID)
 	{
@@ -305,15 +406,18 @@ namespace CoreNs
 		const int fanin2 = pCircuit_->circuitGates_[gateID].numFI_ > 1 ? pCircuit_->circuitGates_[gateID].faninVector_[1] : 0;
 		const int fanin3 = pCircuit_->circuitGates_[gateID].numFI_ > 2 ? pCircuit_->circuitGates_[gateID].faninVector_[2] : 0;
 		const int fanin4 = pCircuit_->circuitGates_[gateID].numFI_ > 3 ? pCircuit_->circuitGates_[gateID].faninVector_[3] : 0;
+		// The fault masks of the output (line 0) and the fanins of the gate.
+		const ParallelValue *const injectLow = &faultInjectLow_[faultInjectBegin_[gateID]];
+		const ParallelValue *const injectHigh = &faultInjectHigh_[faultInjectBegin_[gateID]];
 		// Read the value of fanins with fault masking.
-		const ParallelValue l1 = (pCircuit_->circuitGates_[fanin1].faultSimLow_ & ~faultInjectHigh_[gateID][1]) | faultInjectLow_[gateID][1];
-		const ParallelValue h1 = (pCircuit_->circuitGates_[fanin1].faultSimHigh_ & ~faultInjectLow_[gateID][1]) | faultInjectHigh_[gateID][1];
-		const ParallelValue l2 = (pCircuit_->circuitGates_[fanin2].faultSimLow_ & ~faultInjectHigh_[gateID][2]) | faultInjectLow_[gateID][2];
-		const ParallelValue h2 = (pCircuit_->circuitGates_[fanin2].faultSimHigh_ & ~faultInjectLow_[gateID][2]) | faultInjectHigh_[gateID][2];
-		const ParallelValue l3 = (pCircuit_->circuitGates_[fanin3].faultSimLow_ & ~faultInjectHigh_[gateID][3]) | faultInjectLow_[gateID][3];
-		const ParallelValue h3 = (pCircuit_->circuitGates_[fanin3].faultSimHigh_ & ~faultInjectLow_[gateID][3]) | faultInjectHigh_[gateID][3];
-		const ParallelValue l4 = (pCircuit_->circuitGates_[fanin4].faultSimLow_ & ~faultInjectHigh_[gateID][4]) | faultInjectLow_[gateID][4];
-		const ParallelValue h4 = (pCircuit_->circuitGates_[fanin4].faultSimHigh_ & ~faultInjectLow_[gateID][4]) | faultInjectHigh_[gateID][4];
+		const ParallelValue l1 = (pCircuit_->circuitGates_[fanin1].faultSimLow_ & ~injectHigh[1]) | injectLow[1];
+		const ParallelValue h1 = (pCircuit_->circuitGates_[fanin1].faultSimHigh_ & ~injectLow[1]) | injectHigh[1];
+		const ParallelValue l2 = (pCircuit_->circuitGates_[fanin2].faultSimLow_ & ~injectHigh[2]) | injectLow[2];
+		const ParallelValue h2 = (pCircuit_->circuitGates_[fanin2].faultSimHigh_ & ~injectLow[2]) | injectHigh[2];
+		const ParallelValue l3 = (pCircuit_->circuitGates_[fanin3].faultSimLow_ & ~injectHigh[3]) | injectLow[3];
+		const ParallelValue h3 = (pCircuit_->circuitGates_[fanin3].faultSimHigh_ & ~injectLow[3]) | injectHigh[3];
+		const ParallelValue l4 = (pCircuit_->circuitGates_[fanin4].faultSimLow_ & ~injectHigh[4]) | injectLow[4];
+		const ParallelValue h4 = (pCircuit_->circuitGates_[fanin4].faultSimHigh_ & ~injectLow[4]) | injectHigh[4];
 		// Evaluate the faulty value of gate's output.
 		switch (pCircuit_->circuitGates_[gateID].gateType_)
 		{
@@ -399,6 +503,48 @@ namespace CoreNs
 				pCircuit_->circuitGates_[gateID].faultSimHigh_ = (l1 & l2 & l3) | (l1 & h2 & h3) | (h1 & l2 & h3) | (h1 & h2 & l3);
 				// End of TO-DO
 				break;
+			case Gate::ANDN:
+			case Gate::NANDN:
+			case Gate::ORN:
+			case Gate::NORN:
+			{
+				// As in goodValueEvaluation, with the fault masks of every fanin.
+				Gate &gate = pCircuit_->circuitGates_[gateID];
+				const bool isAnd = gate.gateType_ == Gate::ANDN || gate.gateType_ == Gate::NANDN;
+				ParallelValue anyCtrl = PARA_L;
+				ParallelValue allNonCtrl = PARA_H;
+				for (int i = 0; i < gate.numFI_; ++i)
+				{
+					const Gate &fanin = pCircuit_->circuitGates_[gate.faninVector_[i]];
+					const ParallelValue l = (fanin.faultSimLow_ & ~injectHigh[i + 1]) | injectLow[i + 1];
+					const ParallelValue h = (fanin.faultSimHigh_ & ~injectLow[i + 1]) | injectHigh[i + 1];
+					anyCtrl |= isAnd ? l : h;
+					allNonCtrl &= isAnd ? h : l;
+				}
+				const bool ctrlIsLow = gate.gateType_ == Gate::ANDN || gate.gateType_ == Gate::NORN;
+				gate.faultSimLow_ = ctrlIsLow ? anyCtrl : allNonCtrl;
+				gate.faultSimHigh_ = ctrlIsLow ? allNonCtrl : anyCtrl;
+				break;
+			}
+			case Gate::XORN:
+			case Gate::XNORN:
+			{
+				Gate &gate = pCircuit_->circuitGates_[gateID];
+				ParallelValue low = PARA_H;
+				ParallelValue high = PARA_L;
+				for (int i = 0; i < gate.numFI_; ++i)
+				{
+					const Gate &fanin = pCircuit_->circuitGates_[gate.faninVector_[i]];
+					const ParallelValue l = (fanin.faultSimLow_ & ~injectHigh[i + 1]) | injectLow[i + 1];
+					const ParallelValue h = (fanin.faultSimHigh_ & ~injectLow[i + 1]) | injectHigh[i + 1];
+					const ParallelValue foldLow = (low & l) | (high & h);
+					high = (low & h) | (high & l);
+					low = foldLow;
+				}
+				gate.faultSimLow_ = gate.gateType_ == Gate::XORN ? low : high;
+				gate.faultSimHigh_ = gate.gateType_ == Gate::XORN ? high : low;
+				break;
+			}
 			case Gate::TIE1:
 				pCircuit_->circuitGates_[gateID].faultSimLow_ = PARA_L;
 				pCircuit_->circuitGates_[gateID].faultSimHigh_ = PARA_H;
@@ -418,8 +564,8 @@ namespace CoreNs
 				break;
 		}
 		// Output the value of fanout with fault masking.
-		pCircuit_->circuitGates_[gateID].faultSimLow_ = (pCircuit_->circuitGates_[gateID].faultSimLow_ & ~faultInjectHigh_[gateID][0]) | faultInjectLow_[gateID][0];
-		pCircuit_->circuitGates_[gateID].faultSimHigh_ = (pCircuit_->circuitGates_[gateID].faultSimHigh_ & ~faultInjectLow_[gateID][0]) | faultInjectHigh_[gateID][0];
+		pCircuit_->circuitGates_[gateID].faultSimLow_ = (pCircuit_->circuitGates_[gateID].faultSimLow_ & ~injectHigh[0]) | injectLow[0];
+		pCircuit_->circuitGates_[gateID].faultSimHigh_ = (pCircuit_->circuitGates_[gateID].faultSimHigh_ & ~injectLow[0]) | injectHigh[0];
 	}
 
 	// **************************************************************************
@@ -0,0 +1,212 @@
+// **************************************************************************
+// File       [ timing.h ]
+// Author     [ PYH ]
+// Synopsis   [ SDF delays on the gates and static timing over them ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_TIMING_H_
+#define _CORE_TIMING_H_
+
+#include <vector>
+
+#include "interface/sdf_file.h"
+#include "circuit.h"
+#include "fault.h"
+
+namespace CoreNs
+{
+	// Rise and fall times of a signal, or the delays of an arc for a rising
+	// and a falling output. In ns.
+	struct Delay
+	{
+		float rise_;
+		float fall_;
+	};
+
+	// Timing graph of the first time frame. An arc runs from every fanin
+	// of a gate to the gate; it has a wire delay, from the driver to the
+	// pin, and a cell delay, from the pin to the output of the gate. PIs
+	// and PPIs start with their input delay plus their source delay, the
+	// clock to Q delay of a flip-flop; POs and PPOs are required at the
+	// clock period less their output delay.
+	//
+	// Arrival times are the longest paths, required times the tightest
+	// ones. Unate gates keep the edge or invert it, the XOR family and MUX
+	// take the later edge of each pin for both. A cell of several
+	// primitives carries its delays on the pins where its inputs enter, the
+	// primitives inside have zero cell delay.
+	class Timing
+	{
+	public:
+		Timing(Circuit *pCircuit);
+		~Timing();
+
+		// Annotation. ABSOLUTE keeps the larger value, since an arc can be
+		// listed once per condition or once per output of the cell.
+		// Changes take effect at the next update().
+		void addCellDelay(const int &gateID, const int &faninIndex, const Delay &delay, const bool &isIncrement);
+		void addWireDelay(const int &gateID, const int &faninIndex, const Delay &delay, const bool &isIncrement);
+		void addSourceDelay(const int &gateID, const Delay &delay, const bool &isIncrement);
+
+		// Constraints. Changes take effect at the next update() or
+		// updateIncremental(). A period of 0 or less is the longest path.
+		void setClockPeriod(const float &period);
+		void setInputDelay(const int &gateID, const float &delay);
+		void setOutputDelay(const int &gateID, const float &delay);
+
+		// Full pass, the gates of one level on numThread threads.
+		void update(const int &numThread = 1);
+		// Only the gates whose times the changed constraints reach. Falls
+		// back to update() before the first one.
+		void updateIncremental();
+
+		inline const Delay &getArrival(const int &gateID) const;
+		inline const Delay &getRequired(const int &gateID) const;
+		inline float getSlack(const int &gateID) const;
+		inline float getClockPeriod() const;
+		inline float getLongestPath() const;
+		// Slack of the longest path through the fault site. STR and STF
+		// use the edge they delay, other faults the worse one. A pin fault
+		// is timed at the pin, after the wire.
+		float getFaultSlack(const Fault &fault) const;
+		// Arrival time at the output of the faulty gate, by the longest path
+		// through the fault site. A pin fault adds the cell delay of its pin.
+		float getFaultArrival(const Fault &fault) const;
+		// Wire and cell delay from a fanin to the gate output, the slower
+		// edge.
+		inline float getArcDelay(const int &gateID, const int &faninIndex) const;
+		// Small delay defect quality level of the faults, the expected
+		// number of delay defects per fault site a test set lets escape. A
+		// defect matters if it is larger than the slack of the fault and is
+		// caught if it is larger than the detection slack, see
+		// Fault::detectionSlack_.
+		double getSmallDelayQualityLevel(const FaultPtrList &faults) const;
+
+		Circuit *pCircuit_;
+
+	private:
+		enum UNATENESS
+		{
+			POSITIVE = 0,
+			NEGATIVE,
+			NON_UNATE
+		};
+
+		bool evaluateArrival(const int &gateID);
+		bool evaluateRequired(const int &gateID);
+		void getPinArrival(const int &gateID, const int &faninIndex, Delay &arrival) const;
+		void getPinRequired(const int &gateID, const int &faninIndex, Delay &required) const;
+		void updateLevels(const bool &isForward, const int &numThread);
+		void updateLevelRange(const bool &isForward, const int &level, const int &begin, const int &end);
+		bool findClockPeriod();
+		void pushEvent(const int &gateID, const bool &isForward);
+
+		std::vector<UNATENESS> unateness_;
+		std::vector<int> pinBegin_;				// first arc of each gate, numGate_ + 1 entries
+		std::vector<Delay> cellDelay_;		// of each arc
+		std::vector<Delay> wireDelay_;		// of each arc
+		std::vector<Delay> sourceDelay_;	// of each gate
+		std::vector<float> inputDelay_;		// of each gate
+		std::vector<float> outputDelay_;	// of each gate
+		std::vector<Delay> arrival_;
+		std::vector<Delay> required_;
+		std::vector<int> levelBegin_; // gates of level l are levelGates_[levelBegin_[l]] up to levelBegin_[l + 1]
+		std::vector<int> levelGates_;
+		float userPeriod_;	 // as set, 0 or less for the longest path
+		float clockPeriod_;	 // in use
+		float longestPath_;	 // to the POs and PPOs, output delays included
+		bool isUpdated_;		 // a full pass was done since the last annotation
+		bool periodChanged_; // setClockPeriod() since the last update
+		std::vector<std::vector<int>> forwardEvents_; // by level
+		std::vector<std::vector<int>> backwardEvents_;
+		std::vector<char> isForwardQueued_;
+		std::vector<char> isBackwardQueued_;
+	};
+
+	// Annotates a Timing from an SDF file. IOPATH gives the cell delays of
+	// the pins where the input enters the cell, or the source delay of a
+	// flip-flop; INTERCONNECT gives the wire delay of the pins it ends at.
+	// Instances are looked up by name in the top cell of the netlist the
+	// circuit was built from, other constructs are read and ignored.
+	class SdfDelayBuilder : public IntfNs::SdfFile
+	{
+	public:
+		enum CORNER
+		{
+			MIN = 0,
+			TYP,
+			MAX
+		};
+
+		SdfDelayBuilder(Timing *pTiming, const CORNER &corner = MAX);
+		~SdfDelayBuilder();
+
+		bool addTimeScale(const float &num, const char *const unit);
+		bool addHierChar(const char &hier);
+		bool addCell(const char *const type, const char *const name);
+		bool addIoDelay(const IntfNs::SdfDelayType &type,
+		                const IntfNs::SdfPortSpec &spec,
+		                const char *const port,
+		                const IntfNs::SdfDelayValueList &v);
+		bool addInterconnectDelay(const IntfNs::SdfDelayType &type,
+		                          const char *const from,
+		                          const char *const to,
+		                          const IntfNs::SdfDelayValueList &v);
+
+		int numAnnotated_; // IOPATH and INTERCONNECT entries put on arcs
+		int numUnmatched_; // entries naming instances or ports not found
+
+	private:
+		bool getDelay(const IntfNs::SdfDelayValueList &v, Delay &delay) const;
+		bool annotatePort(IntfNs::Cell *const cell, const char *const portName, const Delay &delay, const bool &isIncrement, const bool &isWire);
+
+		Timing *pTiming_;
+		CORNER corner_;
+		float scale_;						 // SDF time unit in ns
+		char hierChar_;
+		IntfNs::Cell *cell_; // instance of the current CELL, NULL if not in the netlist
+	};
+
+	inline Timing::~Timing() {}
+
+	inline const Delay &Timing::getArrival(const int &gateID) const
+	{
+		return arrival_[gateID];
+	}
+
+	inline const Delay &Timing::getRequired(const int &gateID) const
+	{
+		return required_[gateID];
+	}
+
+	inline float Timing::getSlack(const int &gateID) const
+	{
+		const float riseSlack = required_[gateID].rise_ - arrival_[gateID].rise_;
+		const float fallSlack = required_[gateID].fall_ - arrival_[gateID].fall_;
+		return riseSlack < fallSlack ? riseSlack : fallSlack;
+	}
+
+	inline float Timing::getArcDelay(const int &gateID, const int &faninIndex) const
+	{
+		const Delay &wire = wireDelay_[pinBegin_[gateID] + faninIndex];
+		const Delay &cell = cellDelay_[pinBegin_[gateID] + faninIndex];
+		const float rise = wire.rise_ + cell.rise_;
+		const float fall = wire.fall_ + cell.fall_;
+		return rise > fall ? rise : fall;
+	}
+
+	inline float Timing::getClockPeriod() const
+	{
+		return clockPeriod_;
+	}
+
+	inline float Timing::getLongestPath() const
+	{
+		return longestPath_;
+	}
+
+	inline SdfDelayBuilder::~SdfDelayBuilder() {}
+};
+
+#endif
@@ -153,6 +153,39 @@ private:
     FanMgr *fanMgr_;
 };
 
+class MergeFaultResultsCmd : public CommonNs::Cmd {
+public:
+         MergeFaultResultsCmd(const std::string &name, FanMgr *fanMgr);
+         ~MergeFaultResultsCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+private:
+    FanMgr *fanMgr_;
+};
+
+class WriteEcoImageCmd : public CommonNs::Cmd {
+public:
+         WriteEcoImageCmd(const std::string &name, FanMgr *fanMgr);
+         ~WriteEcoImageCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+private:
+    FanMgr *fanMgr_;
+};
+
+class EcoAtpgCmd : public CommonNs::Cmd {
+public:
+         EcoAtpgCmd(const std::string &name, FanMgr *fanMgr);
+         ~EcoAtpgCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+private:
+    FanMgr *fanMgr_;
+};
+
 class WritePatCmd : public CommonNs::Cmd {
 public:
          WritePatCmd(const std::string &name, FanMgr *fanMgr);
@@ -31,6 +31,24 @@ public:
 
 };
 
+class SetTraceCmd : public CommonNs::Cmd {
+public:
+         SetTraceCmd(const std::string &name);
+         ~SetTraceCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+};
+
+class WriteTraceCmd : public CommonNs::Cmd {
+public:
+         WriteTraceCmd(const std::string &name);
+         ~WriteTraceCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+};
+
 };
 
 #endif
\ No newline at end of file
@@ -139,7 +139,38 @@ private:
 };
 //Ne
 
+class ReadSdfCmd : public CommonNs::Cmd {
+public:
+         ReadSdfCmd(const std::string &name, FanMgr *fanMgr);
+         ~ReadSdfCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+private:
+    FanMgr *fanMgr_;
+};
+
+class SetClockPeriodCmd : public CommonNs::Cmd {
+public:
+         SetClockPeriodCmd(const std::string &name, FanMgr *fanMgr);
+         ~SetClockPeriodCmd();
+
+    bool exec(const std::vector<std::string> &argv);
 
+private:
+    FanMgr *fanMgr_;
+};
+
+class SetIoDelayCmd : public CommonNs::Cmd {
+public:
+         SetIoDelayCmd(const std::string &name, FanMgr *fanMgr);
+         ~SetIoDelayCmd();
+
+    bool exec(const std::vector<std::string> &argv);
+
+private:
+    FanMgr *fanMgr_;
+};
 
 };
 
@@ -8,6 +8,7 @@
 #ifndef _INTF_NETLIST_H_
 #define _INTF_NETLIST_H_
 
+#include "arena.h"
 #include "cell.h"
 #include "techlib.h"
 
@@ -35,11 +36,21 @@ public:
     Cell    *getModule(const char * const name) const;
     Cell    *getModule(const size_t &i) const;
 
+    // object allocation, owned by the netlist and freed all at once
+    // when the netlist is destroyed
+    Cell    *createCell(const char * const name);
+    Port    *createPort(const char * const name);
+    Net     *createNet(const char * const name);
+
     // operations
     bool    removeFloatingNets();
-    bool    levelize();
+    bool    levelize(); // no-op until the top is changed
 
 private:
+            Netlist(const Netlist &);
+    Netlist &operator=(const Netlist &);
+
+    Arena   arena_;
     Cell    *top_;
     CellVec modules_;
     CellMap nameToModule_;
@@ -58,6 +69,18 @@ inline Netlist::Netlist() {
 inline Netlist::~Netlist() {
 }
 
+inline Cell *Netlist::createCell(const char * const name) {
+    return arena_.create<Cell>(name);
+}
+
+inline Port *Netlist::createPort(const char * const name) {
+    return arena_.create<Port>(name);
+}
+
+inline Net *Netlist::createNet(const char * const name) {
+    return arena_.create<Net>(name);
+}
+
 inline bool Netlist::setTechlib(Techlib * const lib) {
     lib_ = lib;
     return true;
@@ -72,12 +95,12 @@ inline Cell *Netlist::getTop() const {
 }
 
 inline bool Netlist::setTop(const char * const name) {
-    CellMap::const_iterator it = nameToModule_.find(name);
-    if (it != nameToModule_.end()) {
-        top_ = it->second;
+    Cell *m = nameToModule_.find(name);
+    if (m) {
+        top_ = m;
         lvl_ = -1;
     }
-    return it != nameToModule_.end();
+    return m != NULL;
 }
 
 inline bool Netlist::setTop(const size_t &i) {
@@ -89,11 +112,9 @@ inline bool Netlist::setTop(const size_t &i) {
 }
 
 inline bool Netlist::addModule(Cell *m) {
-    CellMap::iterator it = nameToModule_.find(m->name_);
-    if (it != nameToModule_.end())
+    if (!nameToModule_.insert(m))
         return false;
     modules_.push_back(m);
-    nameToModule_[m->name_] = m;
     return true;
 }
 
@@ -102,8 +123,7 @@ inline size_t Netlist::getNModule() const {
 }
 
 inline Cell *Netlist::getModule(const char * const name) const {
-    CellMap::const_iterator it = nameToModule_.find(name);
-    return it == nameToModule_.end() ? NULL : it->second;
+    return nameToModule_.find(name);
 }
 
 inline Cell *Netlist::getModule(const size_t &i) const {
@@ -0,0 +1,75 @@
+// **************************************************************************
+// File       [ techlib_cache.h ]
+// Author     [ PYH ]
+// Synopsis   [ binary cache of a parsed technology library ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _INTF_TECHLIB_CACHE_H_
+#define _INTF_TECHLIB_CACHE_H_
+
+#include <stdint.h>
+
+#include "techlib.h"
+
+namespace IntfNs
+{
+
+	// ************************************
+	// * file layout, native byte order
+	// *     char[4]  magic "FANL"
+	// *     uint32   version
+	// *     uint64   key, FNV-1a of the MDT file the library was read from
+	// *     uint32   number of cells, then for every cell
+	// *       name
+	// *       uint32 ports;      name, int32 type
+	// *       uint32 nets;       name
+	// *       uint32 subcells;   uint8 is primitive, name, type name,
+	// *                          int32 primitive type, int32 level,
+	// *                          uint32 ports; name, int32 type, int32 net
+	// *       int32            net of every port of the cell
+	// *       for every net      uint32 ports; int32 subcell (-1 for the
+	// *                          cell itself), uint32 port
+	// *                          uint32 eqvs; int32 net
+	// * names are uint32 length and the characters, no terminator
+	// ************************************
+
+	// Holds a Techlib exactly as MdtLibBuilder::read leaves it, the order of
+	// cells, ports, nets and the ports on every net included, so a library
+	// restored from the cache builds the same circuit as the parsed one.
+	// Primitives come back as plain Pmt with their type and ports, which is
+	// all the subclasses of Pmt carry.
+	class TechlibCache
+	{
+	public:
+		enum Status
+		{
+			SUCCESS = 0,
+			MISS, // no cache, or one written for another MDT file
+			FAIL
+		};
+
+		TechlibCache(Techlib *lib);
+		~TechlibCache();
+
+		// key of an MDT file, false if it cannot be read
+		static bool hashFile(const char *const fname, uint64_t &key);
+
+		// lib must be empty; on FAIL it is left partly filled
+		Status read(const char *const fname, const uint64_t &key);
+		bool write(const char *const fname, const uint64_t &key) const;
+
+	private:
+		Techlib *lib_;
+	};
+
+	inline TechlibCache::TechlibCache(Techlib *lib)
+	{
+		lib_ = lib;
+	}
+
+	inline TechlibCache::~TechlibCache() {}
+
+};
+
+#endif
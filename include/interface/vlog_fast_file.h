@@ -0,0 +1,191 @@
+// **************************************************************************
+// File       [ vlog_fast_file.h ]
+// Author     [ PYH ]
+// Synopsis   [ memory mapped reader for structural verilog netlists ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _INTF_VLOG_FAST_FILE_H_
+#define _INTF_VLOG_FAST_FILE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace IntfNs
+{
+
+	// Reads the structural subset of verilog which gate level netlists are
+	// written in: module headers, input/output/inout/wire/reg/supply
+	// declarations, assign and instances with named port mapping. The file
+	// is mapped private and writable, every name is terminated in place by
+	// overwriting the character behind it, so the names handed out point
+	// into the mapping and nothing is copied.
+	// Any other construct makes read() return UNSUPPORTED, the caller then
+	// falls back to the bison parser.
+	class VlogFastFile
+	{
+	public:
+		enum Status
+		{
+			SUCCESS = 0,
+			UNSUPPORTED,
+			FAIL
+		};
+
+		// a statement is a run of names in names_
+		// MODULE  : module name, followed by its port names
+		// INPUT, OUTPUT, INOUT, WIRE : declared names
+		// ASSIGN  : left and right net
+		// CELL    : cell type, instance name, then port/net pairs
+		struct Stmt
+		{
+			enum Type
+			{
+				MODULE = 0,
+				INPUT,
+				OUTPUT,
+				INOUT,
+				WIRE,
+				ASSIGN,
+				CELL
+			};
+			Type type_;
+			size_t begin_;
+			size_t end_;
+		};
+
+		VlogFastFile();
+		~VlogFastFile();
+
+		Status read(const char *const fname);
+
+		size_t getNBytes() const;
+		size_t getNStmt() const;
+		const Stmt &getStmt(const size_t &i) const;
+		const char *getName(const size_t &i) const;
+
+	private:
+		VlogFastFile(const VlogFastFile &);
+		VlogFastFile &operator=(const VlogFastFile &);
+
+		enum TokType
+		{
+			T_NAME = 0,
+			T_MODULE,
+			T_ENDMODULE,
+			T_INPUT,
+			T_OUTPUT,
+			T_INOUT,
+			T_WIRE,
+			T_REG,
+			T_SUPPLY,
+			T_ASSIGN,
+			T_PUNCT
+		};
+
+		struct Tok
+		{
+			TokType type_;
+			char c_; // punctuation character
+			char *text_;
+		};
+
+		// tokens are lexed on demand into a small ring, the parser never
+		// looks further ahead than one port mapping ". A ( B )"
+		enum
+		{
+			LOOKAHEAD = 8
+		};
+
+		Status parse();
+		bool parseList(const char &close);
+		bool lex(Tok &tok);
+		const Tok *peek(const size_t &k);
+		void consume(const size_t &n);
+		bool isName(const size_t &k);
+		bool isPunct(const size_t &k, const char &c);
+		void unmap();
+
+		char *buf_;
+		size_t size_;
+		char *cur_;
+		char *prevEnd_;		// end of the previous name or keyword
+		char pendingPunct_; // punctuation overwritten by a name terminator
+		bool unsupported_;
+		Tok look_[LOOKAHEAD];
+		size_t lookHead_;
+		size_t nLook_;
+		std::vector<const char *> names_;
+		std::vector<Stmt> stmts_;
+	};
+
+	inline VlogFastFile::VlogFastFile()
+	{
+		buf_ = NULL;
+		size_ = 0;
+		cur_ = NULL;
+		prevEnd_ = NULL;
+		pendingPunct_ = '\0';
+		unsupported_ = false;
+		lookHead_ = 0;
+		nLook_ = 0;
+	}
+
+	inline VlogFastFile::~VlogFastFile()
+	{
+		unmap();
+	}
+
+	inline size_t VlogFastFile::getNBytes() const
+	{
+		return size_;
+	}
+
+	inline size_t VlogFastFile::getNStmt() const
+	{
+		return stmts_.size();
+	}
+
+	inline const VlogFastFile::Stmt &VlogFastFile::getStmt(const size_t &i) const
+	{
+		return stmts_[i];
+	}
+
+	inline const char *VlogFastFile::getName(const size_t &i) const
+	{
+		return names_[i];
+	}
+
+	inline const VlogFastFile::Tok *VlogFastFile::peek(const size_t &k)
+	{
+		while (nLook_ <= k)
+		{
+			if (!lex(look_[(lookHead_ + nLook_) % LOOKAHEAD]))
+			{
+				return NULL;
+			}
+			++nLook_;
+		}
+		return &look_[(lookHead_ + k) % LOOKAHEAD];
+	}
+
+	inline void VlogFastFile::consume(const size_t &n)
+	{
+		lookHead_ = (lookHead_ + n) % LOOKAHEAD;
+		nLook_ -= n;
+	}
+
+	inline bool VlogFastFile::isName(const size_t &k)
+	{
+		const Tok *tok = peek(k);
+		return tok && tok->type_ == T_NAME;
+	}
+
+	inline bool VlogFastFile::isPunct(const size_t &k, const char &c)
+	{
+		const Tok *tok = peek(k);
+		return tok && tok->type_ == T_PUNCT && tok->c_ == c;
+	}
+};
+
+#endif
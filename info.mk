@@ -29,7 +29,7 @@ OWNPKGS = $(STAPKGS) $(DYNPKGS)
 # To specify dependent packages
 #        test3_DEP = test1 test2          // test3 depends on test1 and test2
 
-core_DEP = interface
+core_DEP = common interface
 fan_DEP = common interface core
 
 # To specify sources containing main function
@@ -62,3 +62,6 @@ main.cpp_fan_BIN = fan
 #        test1_DBGEXT = oaCommonD         // test1 debug external lib is
 #                                         // oaCommonD
 
+fan_OPTEXT = pthread
+fan_DBGEXT = pthread
+
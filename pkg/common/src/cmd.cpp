@@ -12,9 +12,15 @@
 #include <unistd.h>		 // current user ID
 #include <termios.h>	 // setting stdin
 #include <dirent.h>		 // getting directory contents
+#include <sys/socket.h> // server socket
+#include <sys/un.h>		 // UNIX domain address
+#include <signal.h>		 // ignoring SIGPIPE and SIGCHLD
+#include <cerrno>
 #include <cstdlib>		 // getting environment variable
 #include <cstring>
+#include <ctime>
 #include <iomanip>
+#include <sstream>
 
 #include "ascii.h"
 #include "vt100.h"
@@ -826,7 +832,14 @@ CmdMgr::Result CmdMgr::exec(const std::string &cmdStr)
 		}
 		else
 		{
-			res = it->second->exec(argv) ? (exit_ ? EXIT : SUCCESS) : FAIL;
+			if (telemetryFile_.empty())
+			{
+				res = it->second->exec(argv) ? (exit_ ? EXIT : SUCCESS) : FAIL;
+			}
+			else
+			{
+				res = execTraced(it->second, argv);
+			}
 		}
 	}
 
@@ -871,4 +884,324 @@ void CmdMgr::resetStdout(const int &stdoutFd, const fpos_t &stdoutPos) const
 	close(stdoutFd);
 	clearerr(stdout);
 	fsetpos(stdout, &stdoutPos);
-}
\ No newline at end of file
+}
+// **************************************************************************
+// Function   [ bool CmdMgr::serve(const std::string, const bool) ]
+// Author     [ PYH ]
+// Synopsis   [ listens on a UNIX socket and runs the commands sent by
+//              clients, one command per line. Everything loaded so far,
+//              like the netlist, the circuit and the fault list, stays
+//              resident between jobs.
+//              By default every connection is served by a forked child,
+//              so clients run concurrently on a copy-on-write snapshot of
+//              the state and cannot disturb each other. With isSerial the
+//              connections are served one after another in this process,
+//              then a client can change the state seen by later ones.
+//              Only returns if the socket cannot be set up ]
+// **************************************************************************
+bool CmdMgr::serve(const std::string &sockPath, const bool &isSerial)
+{
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (sockPath.size() >= sizeof(addr.sun_path))
+	{
+		std::cerr << "**ERROR CmdMgr::serve(): socket path `" << sockPath;
+		std::cerr << "' is too long\n";
+		return false;
+	}
+	strcpy(addr.sun_path, sockPath.c_str());
+
+	int sockFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sockFd < 0)
+	{
+		std::cerr << "**ERROR CmdMgr::serve(): cannot create socket\n";
+		return false;
+	}
+	unlink(sockPath.c_str()); // stale socket of a previous server
+	if (bind(sockFd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(sockFd, 64) < 0)
+	{
+		std::cerr << "**ERROR CmdMgr::serve(): cannot listen on `" << sockPath;
+		std::cerr << "'\n";
+		close(sockFd);
+		return false;
+	}
+
+	// a client hanging up must not kill the server, children reap themselves
+	signal(SIGPIPE, SIG_IGN);
+	if (!isSerial)
+	{
+		signal(SIGCHLD, SIG_IGN);
+	}
+
+	std::cout << "#  Serving on `" << sockPath << "'" << std::endl;
+	while (true)
+	{
+		int fd = accept(sockFd, NULL, NULL);
+		if (fd < 0)
+		{
+			if (errno != EINTR)
+			{
+				std::cerr << "**WARN CmdMgr::serve(): accept failed\n";
+			}
+			continue;
+		}
+
+		if (isSerial)
+		{
+			serveClient(fd);
+			close(fd);
+			exit_ = false;
+			continue;
+		}
+
+		std::cout << std::flush;
+		fflush(stdout);
+		fflush(stderr);
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			close(sockFd);
+			signal(SIGCHLD, SIG_DFL);
+			serveClient(fd);
+			close(fd);
+			_exit(0);
+		}
+		if (pid < 0)
+		{
+			std::cerr << "**WARN CmdMgr::serve(): fork failed\n";
+		}
+		close(fd);
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ void CmdMgr::serveClient(const int) ]
+// Author     [ PYH ]
+// Synopsis   [ runs the commands of one client. stdout and stderr go to
+//              the client while the session lasts. Each command is
+//              answered by its output followed by the line
+//              "#  done SUCCESS|FAIL|NOT_EXIST|NOP". The session ends when
+//              the client hangs up or sends exit ]
+// **************************************************************************
+void CmdMgr::serveClient(const int &fd)
+{
+	std::cout << std::flush;
+	fflush(stdout);
+	fflush(stderr);
+	int stdoutFd = dup(fileno(stdout));
+	int stderrFd = dup(fileno(stderr));
+	dup2(fd, fileno(stdout));
+	dup2(fd, fileno(stderr));
+
+	std::string buf;
+	char chunk[4096];
+	bool isEnd = false;
+	while (!isEnd)
+	{
+		ssize_t n = ::read(fd, chunk, sizeof(chunk));
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			break;
+		}
+		buf.append(chunk, n);
+
+		size_t begin = 0;
+		size_t end;
+		while (!isEnd && (end = buf.find('\n', begin)) != std::string::npos)
+		{
+			std::string cmdStr = buf.substr(begin, end - begin);
+			begin = end + 1;
+			if (cmdStr.size() > 0 && cmdStr[cmdStr.size() - 1] == '\r')
+			{
+				cmdStr.erase(cmdStr.size() - 1);
+			}
+
+			Result res = exec(cmdStr);
+			if (res == NOT_EXIST)
+			{
+				std::cerr << "**ERROR CmdMgr::serveClient(): command `";
+				std::cerr << errorStr_ << "' not found\n";
+			}
+			std::cout << "#  done ";
+			switch (res)
+			{
+				case EXIT:
+				case SUCCESS:
+					std::cout << "SUCCESS";
+					break;
+				case FAIL:
+					std::cout << "FAIL";
+					break;
+				case NOT_EXIST:
+					std::cout << "NOT_EXIST";
+					break;
+				default:
+					std::cout << "NOP";
+					break;
+			}
+			std::cout << std::endl;
+			fflush(stdout);
+			isEnd = res == EXIT;
+		}
+		buf.erase(0, begin);
+	}
+
+	std::cout << std::flush;
+	fflush(stdout);
+	fflush(stderr);
+	dup2(stdoutFd, fileno(stdout));
+	dup2(stderrFd, fileno(stderr));
+	close(stdoutFd);
+	close(stderrFd);
+	clearerr(stdout);
+	clearerr(stderr);
+}
+
+// **************************************************************************
+// Function   [ bool CmdMgr::setTelemetry(const std::string) ]
+// Author     [ PYH ]
+// Synopsis   [ enables per command telemetry. Every command run by exec()
+//              from now on appends one JSON line to fname. An empty fname
+//              disables it again ]
+// **************************************************************************
+bool CmdMgr::setTelemetry(const std::string &fname)
+{
+	if (fname.empty())
+	{
+		telemetryFile_ = "";
+		return true;
+	}
+	FILE *fptr = fopen(fname.c_str(), "a");
+	if (!fptr)
+	{
+		std::cerr << "**ERROR CmdMgr::setTelemetry(): file `" << fname;
+		std::cerr << "' cannot be written\n";
+		return false;
+	}
+	fclose(fptr);
+	telemetryFile_ = fname;
+	return true;
+}
+
+// **************************************************************************
+// Function   [ CmdMgr::Result CmdMgr::execTraced(Cmd *, std::vector) ]
+// Author     [ PYH ]
+// Synopsis   [ runs the command while sampling time and memory around it.
+//              The RSS high water mark is reset before the command, so
+//              its peak is the peak of this command. Commands nested by
+//              source reset it as well, their peaks are folded into the
+//              one of the enclosing command ]
+// **************************************************************************
+CmdMgr::Result CmdMgr::execTraced(Cmd *const cmd, const std::vector<std::string> &argv)
+{
+	TmUsage tmusg;
+	tmusg.resetRssPeak();
+	tmusg.periodStart();
+	const long outerRssPeak = childRssPeak_;
+	childRssPeak_ = 0;
+	++cmdDepth_;
+
+	Result res = cmd->exec(argv) ? (exit_ ? EXIT : SUCCESS) : FAIL;
+
+	--cmdDepth_;
+	TmStat stat;
+	tmusg.getPeriodUsage(stat);
+	if (stat.rssPeak < childRssPeak_)
+	{
+		stat.rssPeak = childRssPeak_;
+	}
+	childRssPeak_ = outerRssPeak > stat.rssPeak ? outerRssPeak : stat.rssPeak;
+	writeTelemetry(argv, res, stat);
+	return res;
+}
+
+// quotes and escapes str as a JSON string
+static std::string jsonStr(const std::string &str)
+{
+	std::string json = "\"";
+	for (size_t i = 0; i < str.size(); ++i)
+	{
+		const unsigned char ch = str[i];
+		if (ch == '"' || ch == '\\')
+		{
+			json += '\\';
+			json += ch;
+		}
+		else if (ch < 0x20)
+		{
+			char buf[8];
+			snprintf(buf, sizeof(buf), "\\u%04x", ch);
+			json += buf;
+		}
+		else
+		{
+			json += ch;
+		}
+	}
+	return json + "\"";
+}
+
+// **************************************************************************
+// Function   [ void CmdMgr::writeTelemetry(...) const ]
+// Author     [ PYH ]
+// Synopsis   [ appends one JSON line describing a finished command. Times
+//              are in micro seconds and memory in kilobytes ]
+// **************************************************************************
+void CmdMgr::writeTelemetry(const std::vector<std::string> &argv,
+														const Result &res,
+														const TmStat &stat) const
+{
+	std::ostringstream line;
+	line << "{\"time\":" << (long)time(NULL);
+	line << ",\"pid\":" << (long)getpid();
+	line << ",\"depth\":" << cmdDepth_;
+	line << ",\"cmd\":" << jsonStr(argv[0]);
+	line << ",\"argv\":[";
+	for (size_t i = 1; i < argv.size(); ++i)
+	{
+		line << (i > 1 ? "," : "") << jsonStr(argv[i]);
+	}
+	line << "],\"result\":";
+	switch (res)
+	{
+		case EXIT:
+		case SUCCESS:
+			line << "\"SUCCESS\"";
+			break;
+		default:
+			line << "\"FAIL\"";
+			break;
+	}
+	line << ",\"real_us\":" << stat.rTime;
+	line << ",\"user_us\":" << stat.uTime;
+	line << ",\"sys_us\":" << stat.sTime;
+	line << ",\"thread_user_us\":" << stat.tuTime;
+	line << ",\"thread_sys_us\":" << stat.tsTime;
+	line << ",\"threads\":" << stat.nThread;
+	line << ",\"vm_kb\":" << stat.vmSize;
+	line << ",\"vm_diff_kb\":" << stat.vmDiff;
+	line << ",\"vm_peak_kb\":" << stat.vmPeak;
+	line << ",\"rss_kb\":" << stat.rss;
+	line << ",\"rss_peak_kb\":" << stat.rssPeak;
+	line << ",\"minor_faults\":" << stat.minFlt;
+	line << ",\"major_faults\":" << stat.majFlt;
+	line << ",\"vol_ctx_switches\":" << stat.nvCsw;
+	line << ",\"invol_ctx_switches\":" << stat.nivCsw;
+	line << "}\n";
+
+	// one write per line, so concurrent writers do not interleave
+	FILE *fptr = fopen(telemetryFile_.c_str(), "a");
+	if (!fptr)
+	{
+		return;
+	}
+	const std::string str = line.str();
+	fwrite(str.c_str(), 1, str.size(), fptr);
+	fclose(fptr);
+}
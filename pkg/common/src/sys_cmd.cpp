@@ -350,6 +350,43 @@ bool SysSourceCmd::exec(const std::vector<std::string> &argv)
 	return true;
 }
 
+SysServeCmd::SysServeCmd(const std::string &name, CmdMgr *cmdMgr) : Cmd(name)
+{
+	cmdMgr_ = cmdMgr;
+	optMgr_.setShortDes("serve commands on a UNIX socket");
+	optMgr_.setDes("listens on SOCKET and runs the commands clients send, one per line, while everything loaded stays resident. Each connection runs in a forked copy of the current state unless --serial is given. A client can be as simple as `socat - UNIX-CONNECT:SOCKET'");
+	optMgr_.regArg(new Arg(Arg::REQ, "socket path", "SOCKET"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "serve connections one by one in this process, changes persist", "");
+	opt->addFlag("s");
+	opt->addFlag("serial");
+	optMgr_.regOpt(opt);
+}
+
+SysServeCmd::~SysServeCmd() {}
+
+bool SysServeCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR SysServeCmd::exec(): ";
+		std::cerr << "please specify socket path\n";
+		return false;
+	}
+
+	return cmdMgr_->serve(optMgr_.getParsedArg(0), optMgr_.isFlagSet("s"));
+}
+
 SysHelpCmd::SysHelpCmd(const std::string &name, CmdMgr *cmdMgr) : Cmd(name)
 {
 	cmdMgr_ = cmdMgr;
@@ -17,18 +17,8 @@ using namespace CommonNs;
 
 TmUsage::TmUsage()
 {
-	tStart_.uTime = 0;
-	tStart_.sTime = 0;
-	tStart_.rTime = 0;
-	tStart_.vmSize = 0;
-	tStart_.vmPeak = 0;
-	tStart_.vmDiff = 0;
-	pStart_.uTime = 0;
-	pStart_.sTime = 0;
-	pStart_.rTime = 0;
-	pStart_.vmSize = 0;
-	pStart_.vmPeak = 0;
-	pStart_.vmDiff = 0;
+	memset(&tStart_, 0, sizeof(tStart_));
+	memset(&pStart_, 0, sizeof(pStart_));
 }
 
 TmUsage::~TmUsage() {}
@@ -49,11 +39,7 @@ bool TmUsage::getTotalUsage(TmStat &st) const
 	{
 		return false;
 	}
-	st.uTime -= tStart_.uTime;
-	st.sTime -= tStart_.sTime;
-	st.rTime -= tStart_.rTime;
-	st.vmDiff = st.vmSize - tStart_.vmSize;
-	st.vmPeak = st.vmPeak > tStart_.vmPeak ? st.vmPeak : tStart_.vmPeak;
+	subtract(st, tStart_);
 	return true;
 }
 
@@ -63,40 +49,87 @@ bool TmUsage::getPeriodUsage(TmStat &st) const
 	{
 		return false;
 	}
-	st.uTime -= pStart_.uTime;
-	st.sTime -= pStart_.sTime;
-	st.rTime -= pStart_.rTime;
-	st.vmDiff = st.vmSize - pStart_.vmSize;
-	st.vmPeak = st.vmPeak > pStart_.vmPeak ? st.vmPeak : pStart_.vmPeak;
+	subtract(st, pStart_);
 	return true;
 }
 
+// **************************************************************************
+// Function   [ subtract(TmStat &, const TmStat &) ]
+// Author     [ PYH ]
+// Synopsis   [ turns counters into the usage since start. Sizes and peaks
+//              stay absolute ]
+// **************************************************************************
+void TmUsage::subtract(TmStat &st, const TmStat &start) const
+{
+	st.uTime -= start.uTime;
+	st.sTime -= start.sTime;
+	st.rTime -= start.rTime;
+	st.tuTime -= start.tuTime;
+	st.tsTime -= start.tsTime;
+	st.minFlt -= start.minFlt;
+	st.majFlt -= start.majFlt;
+	st.nvCsw -= start.nvCsw;
+	st.nivCsw -= start.nivCsw;
+	st.vmDiff = st.vmSize - start.vmSize;
+	st.vmPeak = st.vmPeak > start.vmPeak ? st.vmPeak : start.vmPeak;
+}
+
+// **************************************************************************
+// Function   [ resetRssPeak() ]
+// Author     [ PYH ]
+// Synopsis   [ resets the resident set high water mark of the process, so
+//              that rssPeak of the next check covers only what follows.
+//              Needs Linux 4.0 or later, returns false otherwise ]
+// **************************************************************************
+bool TmUsage::resetRssPeak() const
+{
+	FILE *fref = fopen("/proc/self/clear_refs", "w");
+	if (!fref)
+	{
+		return false;
+	}
+	bool isReset = fputs("5", fref) >= 0;
+	return fclose(fref) == 0 && isReset;
+}
+
 // **************************************************************************
 // Function   [ checkUsage(TmStat &) ]
 // Author     [ littleshamoo ]
 // Synopsis   [ get user time and system time using getrusage() function and
 //              get real time using gettimeofday() function and read
-//              "/proc/self/status" to get memory usage ]
+//              "/proc/self/status" to get memory usage. Page faults and
+//              context switches come from getrusage() as well ]
 // **************************************************************************
 bool TmUsage::checkUsage(TmStat &st) const
 {
 	// check user time and system time
 	rusage tUsg;
+	rusage thUsg;
 	timeval tReal;
 	getrusage(RUSAGE_SELF, &tUsg);
+	getrusage(RUSAGE_THREAD, &thUsg);
 	gettimeofday(&tReal, NULL);
 	st.uTime = tUsg.ru_utime.tv_sec * 1000000 + tUsg.ru_utime.tv_usec;
 	st.sTime = tUsg.ru_stime.tv_sec * 1000000 + tUsg.ru_stime.tv_usec;
 	st.rTime = tReal.tv_sec * 1000000 + tReal.tv_usec;
+	st.tuTime = thUsg.ru_utime.tv_sec * 1000000 + thUsg.ru_utime.tv_usec;
+	st.tsTime = thUsg.ru_stime.tv_sec * 1000000 + thUsg.ru_stime.tv_usec;
+	st.minFlt = tUsg.ru_minflt;
+	st.majFlt = tUsg.ru_majflt;
+	st.nvCsw = tUsg.ru_nvcsw;
+	st.nivCsw = tUsg.ru_nivcsw;
 
 	// check current memory and peak memory
+	st.vmSize = 0;
+	st.vmPeak = 0;
+	st.rss = 0;
+	st.rssPeak = 0;
+	st.nThread = 0;
 	FILE *fmem = fopen("/proc/self/status", "r");
 	if (!fmem)
 	{
 		fprintf(stderr,
 						"**ERROR TmUsage::checkUsage(): cannot get memory usage\n");
-		st.vmSize = 0;
-		st.vmPeak = 0;
 		return false;
 	}
 	char membuf[128];
@@ -111,6 +144,21 @@ bool TmUsage::checkUsage(TmStat &st) const
 		if ((ch = strstr(membuf, "VmSize:")))
 		{
 			st.vmSize = atol(ch + 7);
+			continue;
+		}
+		if ((ch = strstr(membuf, "VmHWM:")))
+		{
+			st.rssPeak = atol(ch + 6);
+			continue;
+		}
+		if ((ch = strstr(membuf, "VmRSS:")))
+		{
+			st.rss = atol(ch + 6);
+			continue;
+		}
+		if ((ch = strstr(membuf, "Threads:")))
+		{
+			st.nThread = atol(ch + 8);
 			break;
 		}
 	}
@@ -0,0 +1,129 @@
+// **************************************************************************
+// File       [ trace.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ per thread ring buffers and the Chrome trace writer ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <unistd.h> // getpid()
+#include <ctime>		// clock_gettime()
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+#include "trace.h"
+
+using namespace CommonNs;
+
+static std::atomic<bool> traceEnabled(false);
+static size_t traceBufSize = 1 << 16;
+static std::mutex traceMutex;					 // guards traceBuffers
+static std::vector<TraceBuffer *> traceBuffers; // never freed, threads may exit before the dump
+static thread_local TraceBuffer *threadBuffer = NULL;
+
+void Trace::enable(const size_t &bufSize)
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	// buffers already handed out keep their size
+	traceBufSize = bufSize > 0 ? bufSize : 1;
+	traceEnabled.store(true, std::memory_order_release);
+}
+
+void Trace::disable()
+{
+	traceEnabled.store(false, std::memory_order_release);
+}
+
+bool Trace::isEnabled()
+{
+	return traceEnabled.load(std::memory_order_relaxed);
+}
+
+// nEvent_ belongs to the recording thread, so the events are hidden from
+// dump() instead of being dropped
+void Trace::clear()
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	for (size_t i = 0; i < traceBuffers.size(); ++i)
+	{
+		traceBuffers[i]->nCleared_ = traceBuffers[i]->nEvent_.load(std::memory_order_acquire);
+	}
+}
+
+long long Trace::now()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+TraceBuffer *Trace::getBuffer()
+{
+	if (!threadBuffer)
+	{
+		std::lock_guard<std::mutex> lock(traceMutex);
+		threadBuffer = new TraceBuffer;
+		threadBuffer->tid_ = (int)traceBuffers.size();
+		threadBuffer->events_.resize(traceBufSize);
+		threadBuffer->nEvent_.store(0, std::memory_order_relaxed);
+		threadBuffer->nCleared_ = 0;
+		traceBuffers.push_back(threadBuffer);
+	}
+	return threadBuffer;
+}
+
+void Trace::record(const char *const name, const long long &begin, const long long &end)
+{
+	TraceBuffer *buf = getBuffer();
+	const size_t n = buf->nEvent_.load(std::memory_order_relaxed);
+	TraceEvent &event = buf->events_[n % buf->events_.size()];
+	event.name_ = name;
+	event.begin_ = begin;
+	event.dur_ = end - begin;
+	// publish the event to dump()
+	buf->nEvent_.store(n + 1, std::memory_order_release);
+}
+
+// **************************************************************************
+// Function   [ bool Trace::dump(const char *) ]
+// Author     [ PYH ]
+// Synopsis   [ writes the events still held by the buffers as complete
+//              ("ph":"X") events of the Chrome trace format, readable by
+//              chrome://tracing and Perfetto. Best called while no thread
+//              is recording, an event overwritten during the dump may come
+//              out torn ]
+// **************************************************************************
+bool Trace::dump(const char *const fname)
+{
+	FILE *fout = fopen(fname, "w");
+	if (!fout)
+	{
+		std::cerr << "**ERROR Trace::dump(): file `" << fname;
+		std::cerr << "' cannot be written\n";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(traceMutex);
+	const long pid = (long)getpid();
+	fprintf(fout, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	bool isFirst = true;
+	for (size_t i = 0; i < traceBuffers.size(); ++i)
+	{
+		const TraceBuffer &buf = *traceBuffers[i];
+		fprintf(fout, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+						isFirst ? "" : ",", pid, buf.tid_, buf.tid_);
+		isFirst = false;
+
+		const size_t n = buf.nEvent_.load(std::memory_order_acquire);
+		const size_t size = buf.events_.size();
+		const size_t begin = n > size ? n - size : 0;
+		for (size_t j = begin > buf.nCleared_ ? begin : buf.nCleared_; j < n; ++j)
+		{
+			const TraceEvent &event = buf.events_[j % size];
+			fprintf(fout, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%ld,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+							event.name_, pid, buf.tid_, event.begin_ / 1000.0, event.dur_ / 1000.0);
+		}
+	}
+	fprintf(fout, "\n]}\n");
+	return fclose(fout) == 0;
+}
@@ -0,0 +1,86 @@
+// **************************************************************************
+// File       [ trace.h ]
+// Author     [ PYH ]
+// Synopsis   [ scoped trace events dumped as Chrome trace JSON ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _COMMON_TRACE_H_
+#define _COMMON_TRACE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace CommonNs
+{
+
+	struct TraceEvent
+	{
+		const char *name_; // must outlive the trace, string literals only
+		long long begin_;	 // in nano seconds
+		long long dur_;		 // in nano seconds
+	};
+
+	// Events of one thread. Only the owning thread writes, so recording
+	// needs neither locks nor atomic read-modify-write. Once full the
+	// oldest events are overwritten.
+	struct TraceBuffer
+	{
+		int tid_;
+		std::vector<TraceEvent> events_;
+		std::atomic<size_t> nEvent_; // number of events ever recorded
+		size_t nCleared_;            // events recorded before the last clear, guarded by the trace lock
+	};
+
+	// Tracing is off by default, a TraceScope then costs one flag check.
+	// A thread gets its buffer on the first event it records, only that
+	// registration takes a lock.
+	class Trace
+	{
+	public:
+		static void enable(const size_t &bufSize = 1 << 16);
+		static void disable();
+		static bool isEnabled();
+		static void clear();
+		static bool dump(const char *const fname);
+
+		static long long now();
+		static void record(const char *const name, const long long &begin, const long long &end);
+
+	private:
+		static TraceBuffer *getBuffer();
+	};
+
+	// Records the lifetime of the object as one complete event.
+	class TraceScope
+	{
+	public:
+		TraceScope(const char *const name);
+		~TraceScope();
+
+	private:
+		TraceScope(const TraceScope &);
+		TraceScope &operator=(const TraceScope &);
+
+		const char *name_;
+		long long begin_;
+	};
+
+	inline TraceScope::TraceScope(const char *const name)
+	{
+		name_ = Trace::isEnabled() ? name : NULL;
+		begin_ = name_ ? Trace::now() : 0;
+	}
+
+	inline TraceScope::~TraceScope()
+	{
+		if (name_)
+		{
+			Trace::record(name_, begin_, Trace::now());
+		}
+	}
+
+};
+
+#endif
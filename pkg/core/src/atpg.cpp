@@ -6,7 +6,11 @@
 // **************************************************************************
 
 #include "atpg.h"
+#include "common/trace.h"
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 using namespace CoreNs;
 
@@ -21,6 +25,10 @@ using namespace CoreNs;
 // 								Activate STC/DTC depending on the pPatternProcessor's flag
 // 								which is set previously in atpg_cmd.cpp based on user's
 // 								script.
+// 								Faults are targeted in phases, one per backtrack limit of
+// 								setBacktrackLimits(). A phase retargets the faults aborted
+// 								by the previous one, on numWorker_ threads if set. At the
+// 								deadline of setDeadline() the faults left are aborted.
 //
 // 							arguments:
 // 								[in, out] pPatternProcessor : A pointer to an empty pattern
@@ -41,59 +49,168 @@ using namespace CoreNs;
 // **************************************************************************
 void Atpg::generatePatternSet(PatternProcessor *pPatternProcessor, FaultListExtract *pFaultListExtractor, bool isMFO)
 {
+	CommonNs::TraceScope traceScope("Atpg::generatePatternSet");
 	Fault *pCurrentFault = NULL;
 	FaultPtrList originalFaultPtrList, faultPtrListForSTC;
 	setupCircuitParameter();
 	pPatternProcessor->init(pCircuit_);
 
-	// setting faults for running ATPG
-	for (Fault *pFault : pFaultListExtractor->faultsInCircuit_)
+	int numOfAtpgUntestableFaults = 0;
+	size_t firstPhase = 0;
+	bool isPhaseResumed = false;
+	isStoppedByTimeBudget_ = false;
+	if (isResuming_)
+	{
+		// fault states and patterns were restored by loadCheckpoint
+		isResuming_ = false;
+		originalFaultPtrList.swap(resumeCheckpoint_.targetFaults_);
+		faultPtrListForSTC.swap(resumeCheckpoint_.stcFaults_);
+		pCurrentFault = resumeCheckpoint_.pCurrentFault_;
+		numOfAtpgUntestableFaults = resumeCheckpoint_.numOfAtpgUntestableFaults_;
+		firstPhase = resumeCheckpoint_.phase_;
+		isPhaseResumed = true;
+	}
+	else
 	{
-		const bool faultIsQualified = (pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultyLine_ >= 0);
-		if (faultIsQualified)
+		// setting faults for running ATPG
+		for (Fault *pFault : pFaultListExtractor->faultsInCircuit_)
 		{
-			originalFaultPtrList.push_back(pFault);
-			faultPtrListForSTC.push_back(pFault);
+			const bool faultIsQualified = (pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultState_ != Fault::TI && pFault->faultyLine_ >= 0 && !pFault->isDominated_);
+			if (faultIsQualified)
+			{
+				originalFaultPtrList.push_back(pFault);
+				faultPtrListForSTC.push_back(pFault);
+			}
 		}
-	}
 
-	// testClearFaultEffect(originalFaultPtrList); // only used for debug
+		// testClearFaultEffect(originalFaultPtrList); // only used for debug
+
+		orderFaultsByTestability(originalFaultPtrList);
+
+		pPatternProcessor->patternVector_.clear();
+		pPatternProcessor->patternVector_.reserve(MAX_LIST_SIZE);
+
+		if (isMultiFault_)
+		{
+			multiFaultPatternGeneration(originalFaultPtrList, pPatternProcessor);
+		}
+	}
 
-	const double faultPtrListSize = (double)(originalFaultPtrList.size());
-	int numOfAtpgUntestableFaults = 0;
 	// record pattern set when lower undetected fault/ lower test length with same undetected fault
-	numOfAtpgUntestableFaults = 0;
 
-	pPatternProcessor->patternVector_.clear();
-	pPatternProcessor->patternVector_.reserve(MAX_LIST_SIZE);
+	typedef std::chrono::steady_clock Clock;
+	const Clock::time_point startTime = Clock::now();
+	Clock::time_point lastCheckpointTime = startTime;
 
 	// start ATPG
-	while (!originalFaultPtrList.empty())
+	// the first phase targets every fault with the first backtrack limit,
+	// each later phase retargets the faults aborted so far with the next one
+	isStoppedByDeadline_ = false;
+	deadlineTime_ = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(deadline_));
+	for (size_t phase = firstPhase; phase < backtrackLimits_.size() && !isStoppedByDeadline_; ++phase)
 	{
-		// meaning the originalFaultPtrList is already left with aborted fault
-		if (originalFaultPtrList.front()->faultState_ == Fault::AB)
-		{
-			break;
+		// a resumed phase goes on with the limit it was checkpointed with,
+		// its aborted faults were already put back before the checkpoint
+		const bool isResumedPhase = isPhaseResumed;
+		isPhaseResumed = false;
+		backtrackLimit_ = isResumedPhase ? resumeCheckpoint_.backtrackLimit_ : backtrackLimits_[phase];
+		if (phase > 0 && !isResumedPhase)
+		{
+			// only aborted faults are left
+			if (originalFaultPtrList.empty())
+			{
+				break;
+			}
+			if (isDeadlineReached())
+			{
+				isStoppedByDeadline_ = true;
+				break;
+			}
+			for (Fault *pFault : originalFaultPtrList)
+			{
+				pFault->faultState_ = Fault::UD;
+			}
+			// the front fault may be the one of the last call, which was aborted
+			pCurrentFault = NULL;
+			if (numWorker_ > 1 && pCircuit_->numFrame_ == 1)
+			{
+				parallelStuckAtFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			}
 		}
-
-		// the fault is not popped in previous call of StuckAtFaultATPG()
-		// => the fault is neither aborted nor untestable => a pattern was found => detected fault
-		if (pCurrentFault == originalFaultPtrList.front())
+		while (!originalFaultPtrList.empty())
 		{
-			originalFaultPtrList.front()->faultState_ = Fault::DT;
-			originalFaultPtrList.pop_front();
-			continue;
-		}
+			// meaning the originalFaultPtrList is already left with aborted fault
+			if (originalFaultPtrList.front()->faultState_ == Fault::AB)
+			{
+				break;
+			}
 
-		pCurrentFault = originalFaultPtrList.front();
-		const bool isTransitionDelayFault = (pCurrentFault->faultType_ == Fault::STR || pCurrentFault->faultType_ == Fault::STF);
-		if (isTransitionDelayFault)
-		{
-			TransitionDelayFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			// checkpoints are only taken here, between two target faults, where
+			// the lists and the patterns are all that is left of the run
+			if (!checkpointFile_.empty())
+			{
+				const Clock::time_point now = Clock::now();
+				isStoppedByTimeBudget_ = timeBudget_ > 0.0 && std::chrono::duration<double>(now - startTime).count() >= timeBudget_;
+				if (isStoppedByTimeBudget_ || std::chrono::duration<double>(now - lastCheckpointTime).count() >= checkpointInterval_)
+				{
+					CommonNs::TraceScope checkpointTraceScope("Atpg::writeCheckpoint");
+					AtpgCheckpoint checkpoint;
+					checkpoint.targetFaults_ = originalFaultPtrList;
+					checkpoint.stcFaults_ = faultPtrListForSTC;
+					checkpoint.pCurrentFault_ = pCurrentFault;
+					checkpoint.numOfAtpgUntestableFaults_ = numOfAtpgUntestableFaults;
+					checkpoint.phase_ = (int)phase;
+					checkpoint.backtrackLimit_ = backtrackLimit_;
+					checkpoint.write(checkpointFile_.c_str(), pFaultListExtractor, pPatternProcessor);
+					lastCheckpointTime = now;
+				}
+				if (isStoppedByTimeBudget_)
+				{
+					pFaultListExtractor->markDominatedFaults();
+					return;
+				}
+			}
+
+			// the fault is not popped in previous call of StuckAtFaultATPG()
+			// => the fault is neither aborted nor untestable => a pattern was found => detected fault
+			if (pCurrentFault == originalFaultPtrList.front())
+			{
+				originalFaultPtrList.front()->faultState_ = Fault::DT;
+				originalFaultPtrList.pop_front();
+				continue;
+			}
+
+			// the faults left are given up as aborted
+			if (isDeadlineReached())
+			{
+				isStoppedByDeadline_ = true;
+				break;
+			}
+
+			pCurrentFault = originalFaultPtrList.front();
+			const bool isTransitionDelayFault = (pCurrentFault->faultType_ == Fault::STR || pCurrentFault->faultType_ == Fault::STF);
+			if (isTransitionDelayFault)
+			{
+				TransitionDelayFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			}
+			else if (pCurrentFault->faultType_ == Fault::BR)
+			{
+				BridgeFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			}
+			else
+			{
+				StuckAtFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			}
 		}
-		else
+	}
+	if (isStoppedByDeadline_)
+	{
+		for (Fault *pFault : originalFaultPtrList)
 		{
-			StuckAtFaultATPG(originalFaultPtrList, pPatternProcessor, numOfAtpgUntestableFaults);
+			if (pFault->faultState_ == Fault::UD)
+			{
+				pFault->faultState_ = Fault::AB;
+			}
 		}
 	}
 	if (pPatternProcessor->staticCompression_ == PatternProcessor::ON)
@@ -102,6 +219,10 @@ void Atpg::generatePatternSet(PatternProcessor *pPatternProcessor, FaultListExtr
 		originalFaultPtrList = faultPtrListForSTC;
 	}
 
+	// dominated faults were not targeted, a test of a dominating fault
+	// detects them
+	pFaultListExtractor->markDominatedFaults();
+
 	// finish calculation equivalent faults left
 	for (Fault *pFault : originalFaultPtrList)
 	{
@@ -109,6 +230,38 @@ void Atpg::generatePatternSet(PatternProcessor *pPatternProcessor, FaultListExtr
 	}
 }
 
+// **************************************************************************
+// Function   [ Atpg::loadCheckpoint ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Restore a checkpoint for the next generatePatternSet.
+//              description:
+//              	Fault states and the patterns generated so far are
+//              	restored right away. The next call of generatePatternSet
+//              	continues with the saved target list instead of
+//              	collecting the faults again, so no pattern is generated
+//              	or simulated twice.
+//              arguments:
+//              	[in] fname : The checkpoint file.
+//              	[out] pPatternProcessor : Receives the patterns.
+//              	[in, out] pFaultListExtractor : The fault list to restore.
+//              	[out] bool : False if the checkpoint cannot be restored.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool Atpg::loadCheckpoint(const std::string &fname, PatternProcessor *pPatternProcessor, FaultListExtract *pFaultListExtractor)
+{
+	pPatternProcessor->init(pCircuit_);
+	isResuming_ = resumeCheckpoint_.read(fname.c_str(), pFaultListExtractor, pPatternProcessor);
+	if (isResuming_ && resumeCheckpoint_.phase_ >= (int)backtrackLimits_.size())
+	{
+		std::cerr << "**ERROR Atpg::loadCheckpoint(): the checkpoint was taken in phase ";
+		std::cerr << resumeCheckpoint_.phase_ + 1 << ", but only " << backtrackLimits_.size();
+		std::cerr << " backtrack limits are set\n";
+		isResuming_ = false;
+	}
+	return isResuming_;
+}
+
 // **************************************************************************
 // Function   [ Atpg::setupCircuitParameter ]
 // Commenter  [ KOREAL WWS ]
@@ -125,6 +278,12 @@ void Atpg::setupCircuitParameter()
 	// set depthFromPo_
 	calculateGateDepthFromPO();
 
+	// see calculateGateReachableOutputs()
+	calculateGateReachableOutputs();
+
+	// see calSCOAP()
+	calSCOAP();
+
 	// Determine the lineType of a gate is FREE_LINE, BOUND_LINE or HEAD_LINE.
 	identifyGateLineType();
 
@@ -178,289 +337,582 @@ void Atpg::calculateGateDepthFromPO()
 }
 
 // **************************************************************************
-// Function   [ Atpg::identifyGateLineType ]
-// Commenter  [ CKY WWS ]
-// Synopsis   [ usage:	Identify and sets the gates' lineType
+// Function   [ Atpg::calculateGateReachableOutputs ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:	Calculate the PO/PPO reachable from every gate.
 //
-// 							description:
-// 								This functions sets this->gateID_to_lineType_ (FREE_LINE,
-// 								HEAD_LINE, BOUND_LINE). Records number of headline gates
-// 								to this->numOfHeadLines_. Records all the headline gates'
-// 								gateID into this->headLineGateIDs_.
+//              description:
+// 								The k-th PO/PPO sets bit k % WORD_SIZE, a gate gets the
+// 								union of its fanouts. A gate shares no bit with the PO/PPO
+// 								still X has no X-path, so xPathTracing stops there
+// 								without walking its fanout cone.
 //            ]
-// Date       [ CKY Ver. 1.0 started 2013/08/17 last modified 2023/01/05 ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
 // **************************************************************************
-void Atpg::identifyGateLineType()
+void Atpg::calculateGateReachableOutputs()
 {
-	numOfheadLines_ = 0;
-
-	for (const Gate &gate : pCircuit_->circuitGates_)
+	outputGateIDs_.clear();
+	for (int gateID = pCircuit_->totalGate_ - 1; gateID >= 0; --gateID)
 	{
-		const int &gateID = gate.gateId_;
-
-		gateID_to_lineType_[gateID] = FREE_LINE; // initialize to FREE_LINE
-
-		if (gate.gateType_ != Gate::PI && gate.gateType_ != Gate::PPI)
-		{
-			for (const int &fanInGateID : gate.faninVector_)
-			{
-				if (gateID_to_lineType_[fanInGateID] != FREE_LINE)
-				{
-					gateID_to_lineType_[gateID] = BOUND_LINE;
-					break;
-				}
-			}
-		}
-
-		// check it is HEAD_LINE or not(rule 1)
-		if ((gateID_to_lineType_[gateID] == FREE_LINE) && (gate.numFO_ != 1))
+		const Gate &gate = pCircuit_->circuitGates_[gateID];
+		ParallelValue &reachableOutputs = gateID_to_reachableOutputs_[gateID];
+		reachableOutputs = PARA_L;
+		if ((gate.gateType_ == Gate::PO) || (gate.gateType_ == Gate::PPO))
 		{
-			gateID_to_lineType_[gateID] = HEAD_LINE;
-			++numOfheadLines_;
+			setBitValue(reachableOutputs, outputGateIDs_.size() % WORD_SIZE, H);
+			outputGateIDs_.push_back(gateID);
+			continue;
 		}
-
-		// check it is HEAD_LINE or not(rule 2)
-		if (gateID_to_lineType_[gate.gateId_] == BOUND_LINE)
+		for (const int &fanOutGateID : gate.fanoutVector_)
 		{
-			for (const int &fanInGateID : gate.faninVector_)
-			{
-				if (gateID_to_lineType_[fanInGateID] == FREE_LINE)
-				{
-					gateID_to_lineType_[fanInGateID] = HEAD_LINE;
-					++numOfheadLines_;
-				}
-			}
+			reachableOutputs |= gateID_to_reachableOutputs_[fanOutGateID];
 		}
 	}
+}
 
-	// store all head lines to array headLineGateIDs_
-	headLineGateIDs_.reserve(numOfheadLines_);
-
-	int count = 0;
-	for (const Gate &gate : pCircuit_->circuitGates_)
-	{
-		if (gateID_to_lineType_[gate.gateId_] == HEAD_LINE)
-		{
-			headLineGateIDs_.push_back(gate.gateId_);
-			++count;
-		}
-		if (count == numOfheadLines_)
-		{
-			break;
-		}
-	}
+// SCOAP measures saturate at SCOAP_LIMIT, which stands for impossible
+static inline int addSCOAP(const int &measure1, const int &measure2)
+{
+	return std::min(measure1 + measure2, SCOAP_LIMIT);
 }
 
 // **************************************************************************
-// Function   [ Atpg::identifyGateDominator ]
-// Commenter  [ CAL WWS ]
-// Synopsis   [ usage:
-// 								Identify Dominator of every gate for unique sensitization.
-//
-// 							description:
-// 								Traverse every gate and try to find each gates’ Dominator.
-// 								For each gate, if it has 1 or 0 fanout gate, we can skip it
-// 								because a fanout free gate's Dominator is always the same.
-// 								Push its fanout gates into circuitLevel_to_eventStack. We
-// 								check the event stack for levels bigger than the gate level.
-// 								In the process of finding the Dominator, we keep adding
-// 								the fanout gates of gates into the event stack to traverse
-// 								all paths the gate would pass.(For fanout of the gate, we
-// 								just need to add its Dominator.) Once the event stack has
-// 								only one gate left, we say that all paths will pass this
-// 								gate, so this gate is the Dominator and we push this gate
-// 								in this->gateID_to_uniquePath. We also check the existence
-// 								of the Dominator in the process.
-// 								The dominator doesn’t exist when:
-// 									1.	Event stack isn’t empty but we find the PO/PPO in the
-// 											event stack(numFO_ == 0). This implies more than one
-// 										path to PO/PPO.
-// 									2.	Event stack contains a fanout which has no dominator.
-// 								Notice that the gateCount is equal to the number of events
-// 								in the the whole event stack during this function call.
-// 								If we have finished finding the Dominator of the gate,
-// 								or the Dominator doesn't exist, gateCount will be 0 or
-// 								set to 0. Then, we remove all the remaining events in
-// 								event stack and go to next iteration(next gate).
-// 								In addition, we check this->gateID_to_valModified_ to avoid
-// 								repeated assignments.
-//
-// 								After this function, each gate has one or zero
-// 								Dominator recorded in this->gateID_to_uniquePath_.
-// 								A Dominator of a gate is the wire that must be passed
-// 								for the dominated gate to reach PO/PPO.
+// Function   [ Atpg::calSCOAP ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:	Calculate the SCOAP testability of every gate.
 //
-// Date       [ Ver. 1.0 started 2013/08/13  last modified 2023/01/05 ]
+//              description:
+// 								cc0_ and cc1_ are set in gateID order from the PI/PPI,
+// 								co_ in reverse order from the PO/PPO, so every gate and
+// 								every fanin is visited once per pass. A stem gets the
+// 								easiest of its branches. TIE gates cannot be set to the
+// 								other value and gates without a path to PO/PPO cannot be
+// 								observed, both are SCOAP_LIMIT.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
 // **************************************************************************
-void Atpg::identifyGateDominator()
+void Atpg::calSCOAP()
 {
-	for (int i = pCircuit_->totalGate_ - 1; i >= 0; --i)
+	for (Gate &gate : pCircuit_->circuitGates_)
 	{
-		Gate &gate = pCircuit_->circuitGates_[i];
-		if (gate.numFO_ <= 1) // if gate has only 1 or 0 output skip this gate
-		{
-			continue;
+		int ccAll0 = 0;						// every fanin 0
+		int ccAll1 = 0;						// every fanin 1
+		int ccAny0 = SCOAP_LIMIT; // some fanin 0
+		int ccAny1 = SCOAP_LIMIT; // some fanin 1
+		int ccEven = 0;						// even number of fanins 1
+		int ccOdd = SCOAP_LIMIT;	// odd number of fanins 1
+		for (const int &faninID : gate.faninVector_)
+		{
+			const Gate &fanin = pCircuit_->circuitGates_[faninID];
+			ccAll0 = addSCOAP(ccAll0, fanin.cc0_);
+			ccAll1 = addSCOAP(ccAll1, fanin.cc1_);
+			ccAny0 = std::min(ccAny0, fanin.cc0_);
+			ccAny1 = std::min(ccAny1, fanin.cc1_);
+			const int ccEvenNext = std::min(addSCOAP(ccEven, fanin.cc0_), addSCOAP(ccOdd, fanin.cc1_));
+			ccOdd = std::min(addSCOAP(ccEven, fanin.cc1_), addSCOAP(ccOdd, fanin.cc0_));
+			ccEven = ccEvenNext;
 		}
 
-		int gateCount = pushGateFanoutsToEventStack(i);
-		for (int j = gate.numLevel_ + 1; j < pCircuit_->totalLvl_; ++j)
+		switch (gate.gateType_)
 		{
-			// if next level's output isn't empty
-			while (!circuitLevel_to_EventStack_[j].empty())
+			case Gate::PI:
+			case Gate::PPI:
+				gate.cc0_ = 1;
+				gate.cc1_ = 1;
+				break;
+			case Gate::PO:
+			case Gate::PPO:
+			case Gate::PPI_IN:
+			case Gate::PPO_IN:
+			case Gate::BUF:
+				gate.cc0_ = ccAll0;
+				gate.cc1_ = ccAll1;
+				break;
+			case Gate::INV:
+				gate.cc0_ = addSCOAP(ccAll1, 1);
+				gate.cc1_ = addSCOAP(ccAll0, 1);
+				break;
+			case Gate::AND2:
+			case Gate::AND3:
+			case Gate::AND4:
+			case Gate::ANDN:
+				gate.cc0_ = addSCOAP(ccAny0, 1);
+				gate.cc1_ = addSCOAP(ccAll1, 1);
+				break;
+			case Gate::NAND2:
+			case Gate::NAND3:
+			case Gate::NAND4:
+			case Gate::NANDN:
+				gate.cc0_ = addSCOAP(ccAll1, 1);
+				gate.cc1_ = addSCOAP(ccAny0, 1);
+				break;
+			case Gate::OR2:
+			case Gate::OR3:
+			case Gate::OR4:
+			case Gate::ORN:
+				gate.cc0_ = addSCOAP(ccAll0, 1);
+				gate.cc1_ = addSCOAP(ccAny1, 1);
+				break;
+			case Gate::NOR2:
+			case Gate::NOR3:
+			case Gate::NOR4:
+			case Gate::NORN:
+				gate.cc0_ = addSCOAP(ccAny1, 1);
+				gate.cc1_ = addSCOAP(ccAll0, 1);
+				break;
+			case Gate::XOR2:
+			case Gate::XOR3:
+			case Gate::XORN:
+				gate.cc0_ = addSCOAP(ccEven, 1);
+				gate.cc1_ = addSCOAP(ccOdd, 1);
+				break;
+			case Gate::XNOR2:
+			case Gate::XNOR3:
+			case Gate::XNORN:
+				gate.cc0_ = addSCOAP(ccOdd, 1);
+				gate.cc1_ = addSCOAP(ccEven, 1);
+				break;
+			case Gate::MUX:
 			{
-				Gate &gDom = pCircuit_->circuitGates_[circuitLevel_to_EventStack_[j].top()];
-				circuitLevel_to_EventStack_[j].pop();
-				gateID_to_valModified_[gDom.gateId_] = 0; // set the gDom to not handle
-				// Because the gateCount is zero while the circuitLevel_to_EventStack_ is not zero, we
-				// only need to pop without other operations. That is, continue operation.
-				if (gateCount <= 0)
-				{
-					continue;
-				}
-
-				--gateCount;
-
-				if (gateCount == 0)
-				{
-					if ((int)gateID_to_uniquePath_.capacity() < pCircuit_->totalLvl_)
-					{
-						gateID_to_uniquePath_.reserve(pCircuit_->totalLvl_);
-					}
-					// when all the fanout gate has been calculated
-					gateID_to_uniquePath_[gate.gateId_].push_back(gDom.gateId_); // push the last calculate fanout gate into gateID_to_uniquePath_
-					break;
-				}
-				// If there is a gate without gates on its output, then we suppose that this
-				// gate is PO/PPO.  Because there are other gates still inside the
-				// event queue (gateCount larger than 1), it means that gate gate does
-				// not have any dominator.  Hence, we will set gateCount to zero as a
-				// signal to clear the gates left in circuitLevel_to_EventStack_.  While the circuitLevel_to_EventStack_ is
-				// not empty but gateCount is zero, we will continue.
-				if (gDom.numFO_ == 0)
-				{
-					gateCount = 0;
-				}
-				else if (gDom.numFO_ > 1)
-				{
-					if ((int)gateID_to_uniquePath_[gDom.gateId_].size() == 0)
-					{
-						gateCount = 0;
-					}
-					else
-					{
-						// Because the first gate in gateID_to_uniquePath_ is the closest Dominator, we just
-						// push it to the circuitLevel_to_EventStack_. Then, we can skip the operation we have done
-						// for gates with higher circuitLvl_ than gate gate.
-						Gate &gTmp = pCircuit_->circuitGates_[gateID_to_uniquePath_[gDom.gateId_][0]];
-						if (!gateID_to_valModified_[gTmp.gateId_])
-						{
-							circuitLevel_to_EventStack_[gTmp.numLevel_].push(gTmp.gateId_);
-							gateID_to_valModified_[gTmp.gateId_] = 1;
-							++gateCount;
-						}
-					}
-				}
-				else if (!gateID_to_valModified_[gDom.fanoutVector_[0]])
-				{
-					Gate &gTmp = pCircuit_->circuitGates_[gDom.fanoutVector_[0]];
-					circuitLevel_to_EventStack_[gTmp.numLevel_].push(gTmp.gateId_);
-					gateID_to_valModified_[gTmp.gateId_] = 1;
-					++gateCount;
-				}
+				// fanins are data 0, data 1 and select
+				const Gate &data0 = pCircuit_->circuitGates_[gate.faninVector_[0]];
+				const Gate &data1 = pCircuit_->circuitGates_[gate.faninVector_[1]];
+				const Gate &select = pCircuit_->circuitGates_[gate.faninVector_[2]];
+				gate.cc0_ = addSCOAP(std::min(addSCOAP(data0.cc0_, select.cc0_), addSCOAP(data1.cc0_, select.cc1_)), 1);
+				gate.cc1_ = addSCOAP(std::min(addSCOAP(data0.cc1_, select.cc0_), addSCOAP(data1.cc1_, select.cc1_)), 1);
+				break;
 			}
+			case Gate::TIE0:
+				gate.cc0_ = 0;
+				gate.cc1_ = SCOAP_LIMIT;
+				break;
+			case Gate::TIE1:
+				gate.cc0_ = SCOAP_LIMIT;
+				gate.cc1_ = 0;
+				break;
+			default:
+				gate.cc0_ = SCOAP_LIMIT;
+				gate.cc1_ = SCOAP_LIMIT;
+				break;
 		}
 	}
-}
 
-// **************************************************************************
-// Function   [ Atpg::identifyGateUniquePath ]
-// Commenter  [ CAL WWS ]
-// Synopsis   [ usage:
-// 								Compute this->gateID_to_uniquePath_(2D vector).
-//                In unique path sensitization phase, we will need to know
-//                if the inputs of a gate is fault reachable. Then, we can
-//                prevent assigning non-controlling value to them.
-//
-//                We find the Dominator, then we push_back the input gate
-//                which is fault reachable from the current gate.
-//
-//                After identifying the unique path, if a gate has Dominator,
-// 								this->gateID_to_uniquePath_ of this gate will contains the
-//                following gate id:
-//
-//                	[dominatorID fRIG1ID fRIG2ID ......]
-//
-// 								fRIG is faultReachableInputGate1ID for the above example
-// 								Do NOT use fRIG in actual code for the sake of readability.
-//
-// 							description:
-// 								We traverse all gates. For each gate, if it has no
-// 								Dominator, we skip the gate. Now we push its fanout gates
-// 								into the event stack.
-// 								Notice that "count" is equal to the number of events in
-// 								the whole event stack. We check the event stack for levels
-// 								higher than the gate level. In this function, we keep
-// 								adding the fanout of the current gate into the event stack
-// 								to traverse all paths the gate would have to pass to reach
-// 								PO/PPO. Simultaneously we adjust "count" and set the
-// 								reachableByDominator of the fanout to current gate.
-// 								Once "count" is 0 (the event stack has only one gate left),
-// 								we should get the Dominator.
-// 								Then we check reachableByDominator of the fanin of the
-// 								Dominator. If it is the current gate, then we push the
-// 								fanin into this->gateID_to_uniquePath.
-// 								Finally, we go to the next iteration (the next gate).
-//
-//            ]
-// Date       [ Ver. 1.0 started 2013/08/13  last modified 2023/01/05 ]
-// **************************************************************************
-void Atpg::identifyGateUniquePath()
-{
-	static std::vector<int> reachableByDominator(pCircuit_->totalGate_);
-	for (int i = pCircuit_->totalGate_ - 1; i >= 0; --i)
+	for (int gateID = pCircuit_->totalGate_ - 1; gateID >= 0; --gateID)
 	{
-		Gate &gate = pCircuit_->circuitGates_[i];
-		// Because we will call identifyGateDominator before entering this function,
-		// a gate with gateID_to_uniquePath_ will contain one Dominator.  Hence, we can
-		// skip the gates while the sizes of their gateID_to_uniquePath_ is zero.
-		if (gateID_to_uniquePath_[gate.gateId_].size() == 0)
+		Gate &gate = pCircuit_->circuitGates_[gateID];
+		if (gate.gateType_ == Gate::PO || gate.gateType_ == Gate::PPO)
 		{
+			gate.co_ = 0;
 			continue;
 		}
-
-		reachableByDominator[gate.gateId_] = i;
-		int count = pushGateFanoutsToEventStack(i);
-		for (int j = gate.numLevel_ + 1; j < pCircuit_->totalLvl_; ++j)
+		gate.co_ = SCOAP_LIMIT;
+		for (const int &fanOutGateID : gate.fanoutVector_)
 		{
-			while (!circuitLevel_to_EventStack_[j].empty())
-			{ // if fanout gate was not empty
-				Gate &gTmp = pCircuit_->circuitGates_[circuitLevel_to_EventStack_[j].top()];
-				circuitLevel_to_EventStack_[j].pop();
-				gateID_to_valModified_[gTmp.gateId_] = 0;
-				reachableByDominator[gTmp.gateId_] = i;
-				--count;
-				if (count == 0)
+			const Gate &fanOutGate = pCircuit_->circuitGates_[fanOutGateID];
+			for (int i = 0; i < fanOutGate.numFI_; ++i)
+			{
+				if (fanOutGate.faninVector_[i] == gateID)
 				{
-					for (int gReachID : gTmp.faninVector_)
-					{
-						if (reachableByDominator[gReachID] == i) // if it is UniquePath
-						{
-							// save gate to gateID_to_uniquePath_ list
-							gateID_to_uniquePath_[gate.gateId_].push_back(gReachID);
-						}
-					}
-					break;
+					gate.co_ = std::min(gate.co_, calInputObservability(fanOutGate, i));
 				}
-				count += pushGateFanoutsToEventStack(gTmp.gateId_);
 			}
 		}
 	}
 }
 
 // **************************************************************************
-// Function   [ Atpg::TransitionDelayFaultATPG ]
-// Commenter  [ HKY CYW WWS ]
-// Synopsis   [ usage: Do transition delay fault model ATPG
+// Function   [ Atpg::calInputObservability ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:	Return the SCOAP observability of a fanin line.
+//
+//              description:
+// 								The co_ of the gate plus the cost of setting the other
+// 								fanins to values which let the line through. The co_ of
+// 								the gate must be set already.
+//
+//              arguments:
+// 								[in] gate: The gate the line goes into.
+// 								[in] faninIndex: The line, index into faninVector_.
+//
+//              output:
+// 								The observability of the line.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+int Atpg::calInputObservability(const Gate &gate, const int &faninIndex) const
+{
+	int sideCost = 0;
+	switch (gate.gateType_)
+	{
+		case Gate::PO:
+		case Gate::PPO:
+		case Gate::PPI_IN:
+		case Gate::PPO_IN:
+		case Gate::BUF:
+			return gate.co_;
+		case Gate::AND2:
+		case Gate::AND3:
+		case Gate::AND4:
+		case Gate::ANDN:
+		case Gate::NAND2:
+		case Gate::NAND3:
+		case Gate::NAND4:
+		case Gate::NANDN:
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				if (i != faninIndex)
+				{
+					sideCost = addSCOAP(sideCost, pCircuit_->circuitGates_[gate.faninVector_[i]].cc1_);
+				}
+			}
+			break;
+		case Gate::OR2:
+		case Gate::OR3:
+		case Gate::OR4:
+		case Gate::ORN:
+		case Gate::NOR2:
+		case Gate::NOR3:
+		case Gate::NOR4:
+		case Gate::NORN:
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				if (i != faninIndex)
+				{
+					sideCost = addSCOAP(sideCost, pCircuit_->circuitGates_[gate.faninVector_[i]].cc0_);
+				}
+			}
+			break;
+		case Gate::XOR2:
+		case Gate::XOR3:
+		case Gate::XORN:
+		case Gate::XNOR2:
+		case Gate::XNOR3:
+		case Gate::XNORN:
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				if (i != faninIndex)
+				{
+					const Gate &sideGate = pCircuit_->circuitGates_[gate.faninVector_[i]];
+					sideCost = addSCOAP(sideCost, std::min(sideGate.cc0_, sideGate.cc1_));
+				}
+			}
+			break;
+		case Gate::MUX:
+		{
+			const Gate &data0 = pCircuit_->circuitGates_[gate.faninVector_[0]];
+			const Gate &data1 = pCircuit_->circuitGates_[gate.faninVector_[1]];
+			const Gate &select = pCircuit_->circuitGates_[gate.faninVector_[2]];
+			if (faninIndex == 0)
+			{
+				sideCost = select.cc0_;
+			}
+			else if (faninIndex == 1)
+			{
+				sideCost = select.cc1_;
+			}
+			else
+			{
+				sideCost = std::min(addSCOAP(data0.cc0_, data1.cc1_), addSCOAP(data0.cc1_, data1.cc0_));
+			}
+			break;
+		}
+		case Gate::INV:
+			break;
+		default:
+			return SCOAP_LIMIT;
+	}
+	return addSCOAP(addSCOAP(gate.co_, sideCost), 1);
+}
+
+// **************************************************************************
+// Function   [ Atpg::calFaultTestability ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:	Return the SCOAP cost of detecting a fault.
+//
+//              description:
+// 								A stuck-at fault costs the controllability of the value
+// 								opposite to the stuck value plus the observability of the
+// 								faulty line. A transition fault needs both values, one in
+// 								each frame. A bridge is estimated by its victim.
+//
+//              arguments:
+// 								[in] fault: The fault.
+//
+//              output:
+// 								The cost, larger is harder.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+int Atpg::calFaultTestability(const Fault &fault) const
+{
+	const Gate &gate = pCircuit_->circuitGates_[fault.gateID_];
+	const Gate &line = fault.faultyLine_ == 0 ? gate : pCircuit_->circuitGates_[gate.faninVector_[fault.faultyLine_ - 1]];
+	const int co = fault.faultyLine_ == 0 ? gate.co_ : calInputObservability(gate, fault.faultyLine_ - 1);
+	switch (fault.faultType_)
+	{
+		case Fault::SA0:
+			return addSCOAP(line.cc1_, co);
+		case Fault::SA1:
+			return addSCOAP(line.cc0_, co);
+		case Fault::STR:
+		case Fault::STF:
+			return addSCOAP(addSCOAP(line.cc0_, line.cc1_), co);
+		default:
+			return addSCOAP(std::min(line.cc0_, line.cc1_), co);
+	}
+}
+
+static bool isFaultCostLess(const std::pair<int, Fault *> &faultCost1, const std::pair<int, Fault *> &faultCost2)
+{
+	return faultCost1.first < faultCost2.first;
+}
+
+// **************************************************************************
+// Function   [ Atpg::orderFaultsByTestability ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:	Sort the target faults as faultOrder_ asks.
+//
+//              description:
+// 								A stable sort on calFaultTestability, faults of the same
+// 								cost keep the extraction order. Hard faults first tends to
+// 								give fewer patterns, as the patterns of hard faults detect
+// 								many easy ones by the way. Easy faults first drops most
+// 								faults early with cheap searches.
+//
+//              arguments:
+// 								[in, out] faultPtrList: The target faults.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Atpg::orderFaultsByTestability(FaultPtrList &faultPtrList) const
+{
+	if (faultOrder_ == EXTRACTION_ORDER)
+	{
+		return;
+	}
+
+	std::vector<std::pair<int, Fault *>> faultCosts;
+	faultCosts.reserve(faultPtrList.size());
+	for (Fault *pFault : faultPtrList)
+	{
+		const int cost = calFaultTestability(*pFault);
+		faultCosts.push_back(std::make_pair(faultOrder_ == HARD_FIRST ? -cost : cost, pFault));
+	}
+	std::stable_sort(faultCosts.begin(), faultCosts.end(), isFaultCostLess);
+
+	faultPtrList.clear();
+	for (const std::pair<int, Fault *> &faultCost : faultCosts)
+	{
+		faultPtrList.push_back(faultCost.second);
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::identifyGateLineType ]
+// Commenter  [ CKY WWS ]
+// Synopsis   [ usage:	Identify and sets the gates' lineType
+//
+// 							description:
+// 								This functions sets this->gateID_to_lineType_ (FREE_LINE,
+// 								HEAD_LINE, BOUND_LINE). Records number of headline gates
+// 								to this->numOfHeadLines_. Records all the headline gates'
+// 								gateID into this->headLineGateIDs_.
+//            ]
+// Date       [ CKY Ver. 1.0 started 2013/08/17 last modified 2023/01/05 ]
+// **************************************************************************
+void Atpg::identifyGateLineType()
+{
+	numOfheadLines_ = 0;
+
+	for (const Gate &gate : pCircuit_->circuitGates_)
+	{
+		const int &gateID = gate.gateId_;
+
+		gateID_to_lineType_[gateID] = FREE_LINE; // initialize to FREE_LINE
+
+		if (gate.gateType_ != Gate::PI && gate.gateType_ != Gate::PPI)
+		{
+			for (const int &fanInGateID : gate.faninVector_)
+			{
+				if (gateID_to_lineType_[fanInGateID] != FREE_LINE)
+				{
+					gateID_to_lineType_[gateID] = BOUND_LINE;
+					break;
+				}
+			}
+		}
+
+		// check it is HEAD_LINE or not(rule 1)
+		if ((gateID_to_lineType_[gateID] == FREE_LINE) && (gate.numFO_ != 1))
+		{
+			gateID_to_lineType_[gateID] = HEAD_LINE;
+			++numOfheadLines_;
+		}
+
+		// check it is HEAD_LINE or not(rule 2)
+		if (gateID_to_lineType_[gate.gateId_] == BOUND_LINE)
+		{
+			for (const int &fanInGateID : gate.faninVector_)
+			{
+				if (gateID_to_lineType_[fanInGateID] == FREE_LINE)
+				{
+					gateID_to_lineType_[fanInGateID] = HEAD_LINE;
+					++numOfheadLines_;
+				}
+			}
+		}
+	}
+
+	// store all head lines to array headLineGateIDs_
+	headLineGateIDs_.reserve(numOfheadLines_);
+
+	int count = 0;
+	for (const Gate &gate : pCircuit_->circuitGates_)
+	{
+		if (gateID_to_lineType_[gate.gateId_] == HEAD_LINE)
+		{
+			headLineGateIDs_.push_back(gate.gateId_);
+			++count;
+		}
+		if (count == numOfheadLines_)
+		{
+			break;
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::identifyGateDominator ]
+// Commenter  [ CAL WWS ]
+// Synopsis   [ usage:
+// 								Identify Dominator of every gate for unique sensitization.
+//
+// 							description:
+// 								A Dominator of a gate is the wire that must be passed
+// 								for the dominated gate to reach PO/PPO. The immediate
+// 								Dominators form a tree over the reversed circuit, rooted
+// 								at a virtual sink which joins every gate without fanout.
+//
+// 								The tree is built as Cooper, Harvey and Kennedy do, in
+// 								a single pass since the circuit is acyclic: gates are
+// 								visited from the outputs, so the fanouts of a gate are
+// 								already in the tree, and the Dominator of the gate is the
+// 								nearest common ancestor of its fanouts. Any ancestor has a
+// 								larger gateID than its descendants, so the two walks up
+// 								the tree are merged by comparing gateIDs.
+//
+// 								After this function, this->gateID_to_dominator_ holds the
+// 								immediate Dominator of every gate, totalGate_ (the sink)
+// 								if the gate has none.
+//
+// Date       [ Ver. 1.0 started 2013/08/13  last modified 2026/10/19 ]
+// **************************************************************************
+void Atpg::identifyGateDominator()
+{
+	const int sinkID = pCircuit_->totalGate_;
+	gateID_to_dominator_.assign(pCircuit_->totalGate_, sinkID);
+	for (int i = pCircuit_->totalGate_ - 1; i >= 0; --i)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[i];
+		if (gate.numFO_ == 0) // PO/PPO, dominated by the sink only
+		{
+			continue;
+		}
+
+		int dominatorID = gate.fanoutVector_[0];
+		for (int j = 1; j < gate.numFO_ && dominatorID != sinkID; ++j)
+		{
+			int fanOutDominatorID = gate.fanoutVector_[j];
+			while (dominatorID != fanOutDominatorID)
+			{
+				if (dominatorID < fanOutDominatorID)
+				{
+					dominatorID = gateID_to_dominator_[dominatorID];
+				}
+				else
+				{
+					fanOutDominatorID = gateID_to_dominator_[fanOutDominatorID];
+				}
+			}
+		}
+		gateID_to_dominator_[i] = dominatorID;
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::identifyGateUniquePath ]
+// Commenter  [ CAL WWS ]
+// Synopsis   [ usage:
+// 								Compute this->gateID_to_uniquePath_(2D vector).
+//                In unique path sensitization phase, we will need to know
+//                if the inputs of a gate is fault reachable. Then, we can
+//                prevent assigning non-controlling value to them.
+//
+//                For a gate with fanout and a Dominator, we push_back the
+//                inputs of the Dominator which are fault reachable from
+//                the current gate:
+//
+//                	[fRIG1ID fRIG2ID ......]
+//
+// 								fRIG is faultReachableInputGate1ID for the above example
+// 								Do NOT use fRIG in actual code for the sake of readability.
+//
+// 							description:
+// 								We traverse all gates. For each gate, if it is fanout
+// 								free or has no Dominator, we skip the gate. Otherwise we
+// 								mark every gate reachable from it without passing the
+// 								Dominator, all of them lie between the gate and the
+// 								Dominator. The marked fanins of the Dominator are pushed
+// 								into this->gateID_to_uniquePath.
+//
+//            ]
+// Date       [ Ver. 1.0 started 2013/08/13  last modified 2026/10/19 ]
+// **************************************************************************
+void Atpg::identifyGateUniquePath()
+{
+	std::vector<int> reachableByGate(pCircuit_->totalGate_, -1);
+	std::vector<int> gateIDStack;
+	for (int i = pCircuit_->totalGate_ - 1; i >= 0; --i)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[i];
+		const int &dominatorID = gateID_to_dominator_[i];
+		gateID_to_uniquePath_[i].clear();
+		if (gate.numFO_ <= 1 || dominatorID == pCircuit_->totalGate_)
+		{
+			continue;
+		}
+
+		reachableByGate[i] = i;
+		gateIDStack.push_back(i);
+		while (!gateIDStack.empty())
+		{
+			const Gate &gReach = pCircuit_->circuitGates_[gateIDStack.back()];
+			gateIDStack.pop_back();
+			for (const int &fanOutGateID : gReach.fanoutVector_)
+			{
+				if (fanOutGateID != dominatorID && reachableByGate[fanOutGateID] != i)
+				{
+					reachableByGate[fanOutGateID] = i;
+					gateIDStack.push_back(fanOutGateID);
+				}
+			}
+		}
+
+		for (const int &gReachID : pCircuit_->circuitGates_[dominatorID].faninVector_)
+		{
+			if (reachableByGate[gReachID] == i) // if it is UniquePath
+			{
+				// save gate to gateID_to_uniquePath_ list
+				gateID_to_uniquePath_[i].push_back(gReachID);
+			}
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::TransitionDelayFaultATPG ]
+// Commenter  [ HKY CYW WWS ]
+// Synopsis   [ usage: Do transition delay fault model ATPG
 //
 // 							description:
 // 								This function is implemented very similar to the
@@ -477,6 +929,7 @@ void Atpg::identifyGateUniquePath()
 // **************************************************************************
 void Atpg::TransitionDelayFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults)
 {
+	CommonNs::TraceScope traceScope("Atpg::TransitionDelayFaultATPG");
 	const Fault &fTDF = *faultPtrListForGen.front();
 
 	SINGLE_PATTERN_GENERATION_STATUS result = generateSinglePatternOnTargetFault(Fault(fTDF.gateID_ + pCircuit_->numGate_, fTDF.faultType_, fTDF.faultyLine_, fTDF.equivalent_, fTDF.faultState_), false);
@@ -504,87 +957,610 @@ void Atpg::TransitionDelayFaultATPG(FaultPtrList &faultPtrListForGen, PatternPro
 	}
 	else
 	{
-		faultPtrListForGen.front()->faultState_ = Fault::AB;
-		faultPtrListForGen.push_back(faultPtrListForGen.front());
-		faultPtrListForGen.pop_front();
+		faultPtrListForGen.front()->faultState_ = Fault::AB;
+		faultPtrListForGen.push_back(faultPtrListForGen.front());
+		faultPtrListForGen.pop_front();
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::StuckAtFaultATPG ]
+// Commenter  [ CAL WWS ]
+// Synopsis   [ usage:
+// 								Do stuck at fault model ATPG on one fault and do DTC
+// 								on the pattern generated to the single fault if the DTC
+// 								flag is set to ON.
+//
+// 							description:
+// 								The first fault pointed to by the first pointer in
+// 								faultPtrListForGen will be selected as the first target
+// 								fault for single pattern generation in this function.
+// 								There will be three possible scenario after the
+// 								single pattern generation on the first selected fault.
+// 								1.	PATTERN_FOUND
+// 										If a pattern is found for the first selected fault.
+// 										A pattern will be allocated and push back to
+// 										pPatternProcessor->patternVector and will be updated
+// 										immediately. If the DTC is set to ON for the pattern
+// 										processor. The first selected fault will immediately
+// 										be dropped by fault simulation.
+// 										Then the DTC stage will start officially and select
+// 										other undetected faults one by one for DTC. If the
+// 										latter selected fault can be detected by filling
+// 										some of the X(s) to 1 or 0. The fault state of the
+// 										fault will be set to DT(detected) and the pattern will
+// 										be updated to the original pattern with specific X(s)
+// 										assigned.
+// 										If the latter selected undetected fault is not detected,
+// 										atpgVals will have to be restored to previous atpgVals
+// 										because the single pattern generation will change the
+//										gate atpg values. If there is no more faults for DTC,
+// 										the loop of DTC will be ended. After the loop, we will
+// 										randomly XFill the pattern and perform fault simulation
+// 										with the most recently updated pattern to drop the
+// 										additional faults detected during the DTC phase.
+// 								2.	FAULT_UNTESTABLE
+// 										If the fault is not detected even after all the
+// 										backtracks is done in the single pattern generation
+// 										the fault is then declared as fault untestable.
+// 								3.	ABORT
+// 										If the Atpg is aborted due to the time of backtracks
+// 										exceeding the BACKTRACK_LIMIT 500 (can be changed
+// 										manually in namespace atpg.h::CoreNs).
+//
+// 							arguments:
+// 								[in, out] faultPtrListForGen : Current list of fault
+// 								pointers that are pointed to undetected faults. If detected
+// 								when seen as the first selected target fault, it will be
+// 								dropped immediately by fault simulation. If detected during
+// 								DTC stage the faults will be dropped altogether after DTC.
+//
+// 								[in, out] pPatternProcessor : A pointer to pattern
+// 								processor that contains a pattern vector recording the
+// 								whole pattern set. In this function, the pattern processor
+// 								should already possess the patterns generated for the
+// 								faults before the current fault. A new Pattern will be
+// 								pushed back to the the pPatternProcessor->patternVector_
+// 								if the fault first selected in this function is detected.
+// 								It will become pPatternProcessor->patternVector_.back().
+// 								Then it will be determined and random XFilled at end of
+// 								the function.
+//
+// 								[in, out] numOfAtpgUntestableFaults : It is a reference
+// 								variable for recording the number of equivalent faults
+// 								untestable. Here untestable faults means this function call
+// 								has ended without abortion. If the function is aborted due
+// 								to backtrack time exceeding limit, it is called aborted
+// 								fault which is different to untestable fault.
+//            ]
+// Date       [ started 2020/07/07    last modified 2023/01/05 ]
+// **************************************************************************
+void Atpg::StuckAtFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults)
+{
+	CommonNs::TraceScope traceScope("Atpg::StuckAtFaultATPG");
+	SINGLE_PATTERN_GENERATION_STATUS result = isFaultCone_ ? generateSinglePatternOnFaultCone(*faultPtrListForGen.front()) : generateSinglePatternOnTargetFault(*faultPtrListForGen.front(), false);
+	if (result == PATTERN_FOUND)
+	{
+		Pattern pattern(pCircuit_);
+		pPatternProcessor->patternVector_.push_back(pattern);
+
+		resetPrevAtpgValStored();
+		clearAllFaultEffectByEvaluation();
+		storeCurrentAtpgVal();
+		writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
+
+		if (pPatternProcessor->dynamicCompression_ == PatternProcessor::ON)
+		{
+			CommonNs::TraceScope dtcTraceScope("Atpg::dynamicTestCompression");
+			FaultPtrList faultListTemp = faultPtrListForGen;
+			pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
+			pSimulator_->goodSim();
+			writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
+
+			for (Fault *pFault : faultListTemp)
+			{
+				// skip detected faults
+				if (pFault->faultState_ == Fault::DT)
+				{
+					continue;
+				}
+
+				Gate *pGateForActivation = getGateForFaultActivation(*pFault);
+				if (((pGateForActivation->atpgVal_ == L) && (pFault->faultType_ == Fault::SA0)) ||
+					((pGateForActivation->atpgVal_ == H) && (pFault->faultType_ == Fault::SA1)))
+				{
+					continue;
+				}
+
+				// Activation check
+				if (pGateForActivation->atpgVal_ != X)
+				{
+					if ((pFault->faultType_ == Fault::SA0) || (pFault->faultType_ == Fault::SA1))
+					{
+						setGateAtpgValAndRunImplication((*pGateForActivation), X);
+					}
+					else
+					{
+						continue;
+					}
+				}
+
+				if (xPathExists(pGateForActivation))
+				{
+					// TO-DO homework 05 implement DTC here end of TO-DO
+					if (generateSinglePatternOnTargetFault(*pFault, true) == PATTERN_FOUND)
+					{
+						resetPrevAtpgValStored();
+						clearAllFaultEffectByEvaluation();
+						storeCurrentAtpgVal();
+						writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
+					}
+					else
+					{
+						for (Gate &gate : pCircuit_->circuitGates_)
+						{
+							gate.atpgVal_ = gate.prevAtpgValStored_;
+						}
+					}
+				}
+				else
+				{
+					setGateAtpgValAndRunImplication((*pGateForActivation), pGateForActivation->prevAtpgValStored_);
+				}
+			}
+		}
+
+		clearAllFaultEffectByEvaluation();
+		storeCurrentAtpgVal();
+		writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
+
+		if (pPatternProcessor->XFill_ == PatternProcessor::ON)
+		{
+			// Randomly fill the pats_.back().
+			// Note that the v_, gh_, gl_, fh_ and fl_ do not be changed.
+			randomFill(pPatternProcessor->patternVector_.back());
+		}
+
+		//  This function will assign pi/ppi stored in pats_.back() to
+		//  the gh_ and gl_ in each gate, and then it will run fault
+		//  simulation to drop fault.
+
+		pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
+
+		// After pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(),faultListToGen) , the pi/ppi
+		// values have been passed to gh_ and gl_ of each gate.  Therefore, we can
+		// directly use "writeGoodSimValToPatternPO" to perform goodSim to get the PoValue.
+		pSimulator_->goodSim();
+		writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
+	}
+	else if (result == FAULT_UNTESTABLE)
+	{
+		faultPtrListForGen.front()->faultState_ = Fault::AU;
+		numOfAtpgUntestableFaults += faultPtrListForGen.front()->equivalent_;
+		faultPtrListForGen.pop_front();
+	}
+	else
+	{
+		faultPtrListForGen.front()->faultState_ = Fault::AB;
+		faultPtrListForGen.push_back(faultPtrListForGen.front());
+		faultPtrListForGen.pop_front();
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::generateSinglePatternOnFaultCone ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: generateSinglePatternOnTargetFault on the cone of the
+//              fault site.
+//              description:
+//              	The cone Atpg works on arrays and event stacks sized to
+//              	the cone only. On success its input assignment is copied
+//              	to the PIs and PPIs of this circuit and every other gate
+//              	is X, the caller evaluates the rest from the inputs as it
+//              	does after generateSinglePatternOnTargetFault. The cone
+//              	holds everything that can justify or observe the fault,
+//              	so untestable and aborted results carry over as well.
+//              	Other faults, multiple time frames and cones larger than
+//              	half the circuit use the whole circuit.
+//              arguments:
+//              	[in] targetFault : The fault to generate a pattern for.
+//              	[out] SINGLE_PATTERN_GENERATION_STATUS : As returned by
+//              	generateSinglePatternOnTargetFault.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+Atpg::SINGLE_PATTERN_GENERATION_STATUS Atpg::generateSinglePatternOnFaultCone(const Fault &targetFault)
+{
+	const bool isStuckAtFault = targetFault.faultType_ == Fault::SA0 || targetFault.faultType_ == Fault::SA1;
+	FaultCone *pFaultCone = (isStuckAtFault && pCircuit_->numFrame_ == 1) ? getFaultCone(targetFault.gateID_) : NULL;
+	if (!pFaultCone)
+	{
+		return generateSinglePatternOnTargetFault(targetFault, false);
+	}
+
+	// the cone engine searches under the limits of the current phase
+	pFaultCone->pAtpg_->backtrackLimit_ = backtrackLimit_;
+	pFaultCone->pAtpg_->deadline_ = deadline_;
+	pFaultCone->pAtpg_->deadlineTime_ = deadlineTime_;
+	pFaultCone->pAtpg_->isScoapGuided_ = isScoapGuided_;
+	const Fault coneFault(pFaultCone->coneSiteGateID_, targetFault.faultType_, targetFault.faultyLine_);
+	const SINGLE_PATTERN_GENERATION_STATUS result = pFaultCone->pAtpg_->generateSinglePatternOnTargetFault(coneFault, false);
+	if (result != PATTERN_FOUND)
+	{
+		return result;
+	}
+
+	for (Gate &gate : pCircuit_->circuitGates_)
+	{
+		gate.atpgVal_ = X;
+	}
+	const Circuit &cone = pFaultCone->circuit_;
+	for (int i = 0; i < cone.numPI_; ++i)
+	{
+		pCircuit_->circuitGates_[pFaultCone->coneGateToGate_[i]].atpgVal_ = cone.circuitGates_[i].atpgVal_;
+	}
+	return PATTERN_FOUND;
+}
+
+// **************************************************************************
+// Function   [ Atpg::getFaultCone ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Return the cone of a fault site.
+//              description:
+//              	The faults of a gate are next to each other in the fault
+//              	list, so the cones of the latest FAULT_CONE_CACHE_SIZE
+//              	sites are kept, the least recently used one is replaced.
+//              	A site whose cone is too large is kept without an Atpg so
+//              	its cone is not collected again.
+//              arguments:
+//              	[in] siteGateID : The gate of the fault.
+//              	[out] FaultCone * : The cone, NULL if it is too large.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+FaultCone *Atpg::getFaultCone(const int &siteGateID)
+{
+	++numFaultConeUse_;
+	FaultCone *pFaultCone = NULL;
+	for (FaultCone *pCachedFaultCone : faultCones_)
+	{
+		if (pCachedFaultCone->siteGateID_ == siteGateID)
+		{
+			pCachedFaultCone->lastUse_ = numFaultConeUse_;
+			return pCachedFaultCone->pAtpg_ ? pCachedFaultCone : NULL;
+		}
+		if (!pFaultCone || pCachedFaultCone->lastUse_ < pFaultCone->lastUse_)
+		{
+			pFaultCone = pCachedFaultCone;
+		}
+	}
+
+	if ((int)faultCones_.size() < FAULT_CONE_CACHE_SIZE)
+	{
+		pFaultCone = new FaultCone;
+		faultCones_.push_back(pFaultCone);
+	}
+	else
+	{
+		delete pFaultCone->pAtpg_;
+		pFaultCone->pAtpg_ = NULL;
+	}
+	pFaultCone->siteGateID_ = siteGateID;
+	pFaultCone->lastUse_ = numFaultConeUse_;
+	if (gateID_to_coneGateID_.empty())
+	{
+		gateID_to_coneGateID_.assign(pCircuit_->totalGate_, -1);
+	}
+	if (pFaultCone->extract(pCircuit_, siteGateID, pCircuit_->totalGate_ / 2, gateID_to_coneGateID_))
+	{
+		pFaultCone->pAtpg_ = new Atpg(&pFaultCone->circuit_, NULL);
+		pFaultCone->pAtpg_->setupCircuitParameter();
+	}
+	return pFaultCone->pAtpg_ ? pFaultCone : NULL;
+}
+
+// **************************************************************************
+// Function   [ Atpg::multiFaultPatternGeneration ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Generate patterns for groups of stuck-at faults.
+//              description:
+//              	The stuck-at faults of faultPtrListForGen are taken
+//              	WORD_SIZE at a time and handed to MultiFaultAtpg. Each
+//              	pattern is X-filled and fault simulated like the patterns of
+//              	StuckAtFaultATPG. A group is retried with its undetected
+//              	lanes, a pattern that detects nothing hands the leading
+//              	lane over to the scalar engine instead. Those faults stay
+//              	in faultPtrListForGen, the per fault setup of the scalar
+//              	engine is skipped for all faults detected here.
+//              	Only single time frame circuits are handled.
+//              arguments:
+//              	[in, out] faultPtrListForGen : Detected faults are dropped.
+//              	[in, out] pPatternProcessor : Receives the patterns.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Atpg::multiFaultPatternGeneration(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor)
+{
+	CommonNs::TraceScope traceScope("Atpg::multiFaultPatternGeneration");
+	if (pCircuit_->numFrame_ != 1)
+	{
+		return;
+	}
+
+	std::vector<Fault *> candidates;
+	for (Fault *pFault : faultPtrListForGen)
+	{
+		if (pFault->faultType_ == Fault::SA0 || pFault->faultType_ == Fault::SA1)
+		{
+			candidates.push_back(pFault);
+		}
+	}
+
+	MultiFaultAtpg multiFaultAtpg(pCircuit_);
+	std::vector<Fault *> group;
+	for (size_t begin = 0; begin < candidates.size(); begin += WORD_SIZE)
+	{
+		// faults detected by earlier patterns were dropped by fault simulation
+		group.clear();
+		for (size_t i = begin; i < candidates.size() && i < begin + WORD_SIZE; ++i)
+		{
+			if (candidates[i]->faultState_ != Fault::DT)
+			{
+				group.push_back(candidates[i]);
+			}
+		}
+		while (!group.empty())
+		{
+			Pattern pattern(pCircuit_);
+			const ParallelValue detected = multiFaultAtpg.generatePattern(group, pattern);
+			if (detected == PARA_L)
+			{
+				group.erase(group.begin());
+				continue;
+			}
+			pPatternProcessor->patternVector_.push_back(pattern);
+			if (pPatternProcessor->XFill_ == PatternProcessor::ON)
+			{
+				randomFill(pPatternProcessor->patternVector_.back());
+			}
+			pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
+			pSimulator_->goodSim();
+			writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
+
+			size_t numLane = 0;
+			for (size_t lane = 0; lane < group.size(); ++lane)
+			{
+				if (getBitValue(detected, lane) == L && group[lane]->faultState_ != Fault::DT)
+				{
+					group[numLane++] = group[lane];
+				}
+			}
+			group.resize(numLane);
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ Atpg::parallelStuckAtFaultATPG ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Retarget the stuck-at faults of a later phase of
+//              generatePatternSet on numWorker_ threads.
+//              description:
+//              	Every worker runs its own Atpg on its own copy of the
+//              	circuit and takes the next fault from a shared counter
+//              	until none is left, so a few hard faults do not hold up
+//              	the others. The results are merged afterwards in the order
+//              	of faultPtrListForGen: a pattern is kept only if its fault
+//              	was not dropped by an earlier one, then X-filled and fault
+//              	simulated as in StuckAtFaultATPG. DTC is not applied.
+//              	Untestable faults are removed, aborted faults are moved to
+//              	the end of the list and the other faults are left in front
+//              	for the serial loop of generatePatternSet.
+//              arguments:
+//              	[in, out] faultPtrListForGen : The faults of the phase.
+//              	[in, out] pPatternProcessor : Receives the patterns.
+//              	[in, out] numOfAtpgUntestableFaults : The number of
+//              	equivalent faults untestable.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Atpg::parallelStuckAtFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults)
+{
+	CommonNs::TraceScope traceScope("Atpg::parallelStuckAtFaultATPG");
+	std::vector<Fault *> faults;
+	for (Fault *pFault : faultPtrListForGen)
+	{
+		if (pFault->faultType_ == Fault::SA0 || pFault->faultType_ == Fault::SA1)
+		{
+			faults.push_back(pFault);
+		}
+	}
+
+	std::vector<SINGLE_PATTERN_GENERATION_STATUS> results(faults.size(), ABORT);
+	std::vector<Pattern> patterns(faults.size());
+	std::atomic<size_t> nextFault(0);
+	std::vector<std::thread> workers;
+	for (int i = 0; i < numWorker_; ++i)
+	{
+		workers.push_back(std::thread(&Atpg::parallelStuckAtFaultWorker, this, std::cref(faults), std::ref(nextFault), std::ref(results), std::ref(patterns)));
+	}
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+
+	for (size_t k = 0; k < faults.size(); ++k)
+	{
+		Fault *pFault = faults[k];
+		if (pFault->faultState_ == Fault::DT)
+		{
+			continue;
+		}
+		if (results[k] == PATTERN_FOUND)
+		{
+			pPatternProcessor->patternVector_.push_back(patterns[k]);
+			if (pPatternProcessor->XFill_ == PatternProcessor::ON)
+			{
+				randomFill(pPatternProcessor->patternVector_.back());
+			}
+			pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
+			pSimulator_->goodSim();
+			writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
+		}
+		else if (results[k] == FAULT_UNTESTABLE)
+		{
+			pFault->faultState_ = Fault::AU;
+			numOfAtpgUntestableFaults += pFault->equivalent_;
+		}
+		else
+		{
+			pFault->faultState_ = Fault::AB;
+		}
+	}
+
+	FaultPtrList abortedFaults;
+	for (FaultPtrList::iterator it = faultPtrListForGen.begin(); it != faultPtrListForGen.end();)
+	{
+		FaultPtrList::iterator next = it;
+		++next;
+		if ((*it)->faultState_ == Fault::AU)
+		{
+			faultPtrListForGen.erase(it);
+		}
+		else if ((*it)->faultState_ == Fault::AB)
+		{
+			abortedFaults.splice(abortedFaults.end(), faultPtrListForGen, it);
+		}
+		it = next;
+	}
+	faultPtrListForGen.splice(faultPtrListForGen.end(), abortedFaults);
+}
+
+// **************************************************************************
+// Function   [ Atpg::parallelStuckAtFaultWorker ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: One thread of parallelStuckAtFaultATPG.
+//              description:
+//              	The engine writes the values of the gates, so the circuit
+//              	is copied and a new Atpg is set up on the copy with the
+//              	limits of the current phase. Members of this Atpg are only
+//              	read.
+//              arguments:
+//              	[in] faults : The faults of the phase.
+//              	[in, out] nextFault : Index of the next fault to take.
+//              	[out] results : The result for every fault.
+//              	[out] patterns : The pattern of every fault found.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Atpg::parallelStuckAtFaultWorker(const std::vector<Fault *> &faults, std::atomic<size_t> &nextFault, std::vector<SINGLE_PATTERN_GENERATION_STATUS> &results, std::vector<Pattern> &patterns) const
+{
+	Circuit circuit = *pCircuit_;
+	Atpg atpg(&circuit, NULL);
+	atpg.setupCircuitParameter();
+	atpg.isFaultCone_ = isFaultCone_;
+	atpg.isScoapGuided_ = isScoapGuided_;
+	atpg.backtrackLimit_ = backtrackLimit_;
+	atpg.deadline_ = deadline_;
+	atpg.deadlineTime_ = deadlineTime_;
+	for (size_t k = nextFault++; k < faults.size(); k = nextFault++)
+	{
+		results[k] = atpg.isFaultCone_ ? atpg.generateSinglePatternOnFaultCone(*faults[k]) : atpg.generateSinglePatternOnTargetFault(*faults[k], false);
+		if (results[k] == PATTERN_FOUND)
+		{
+			patterns[k] = Pattern(&circuit);
+			atpg.clearAllFaultEffectByEvaluation();
+			atpg.writeAtpgValToPatternPI(patterns[k]);
+		}
 	}
 }
 
 // **************************************************************************
-// Function   [ Atpg::StuckAtFaultATPG ]
-// Commenter  [ CAL WWS ]
+// Function   [ Atpg::BridgeFaultATPG ]
+// Commenter  [ WWS ]
 // Synopsis   [ usage:
-// 								Do stuck at fault model ATPG on one fault and do DTC
-// 								on the pattern generated to the single fault if the DTC
-// 								flag is set to ON.
+// 								Generate a pattern for the bridge fault at the front of
+// 								faultPtrListForGen.
 //
 // 							description:
-// 								The first fault pointed to by the first pointer in
-// 								faultPtrListForGen will be selected as the first target
-// 								fault for single pattern generation in this function.
-// 								There will be three possible scenario after the
-// 								single pattern generation on the first selected fault.
-// 								1.	PATTERN_FOUND
-// 										If a pattern is found for the first selected fault.
-// 										A pattern will be allocated and push back to
-// 										pPatternProcessor->patternVector and will be updated
-// 										immediately. If the DTC is set to ON for the pattern
-// 										processor. The first selected fault will immediately
-// 										be dropped by fault simulation.
-// 										Then the DTC stage will start officially and select
-// 										other undetected faults one by one for DTC. If the
-// 										latter selected fault can be detected by filling
-// 										some of the X(s) to 1 or 0. The fault state of the
-// 										fault will be set to DT(detected) and the pattern will
-// 										be updated to the original pattern with specific X(s)
-// 										assigned.
-// 										If the latter selected undetected fault is not detected,
-// 										atpgVals will have to be restored to previous atpgVals
-// 										because the single pattern generation will change the
-//										gate atpg values. If there is no more faults for DTC,
-// 										the loop of DTC will be ended. After the loop, we will
-// 										randomly XFill the pattern and perform fault simulation
-// 										with the most recently updated pattern to drop the
-// 										additional faults detected during the DTC phase.
-// 								2.	FAULT_UNTESTABLE
-// 										If the fault is not detected even after all the
-// 										backtracks is done in the single pattern generation
-// 										the fault is then declared as fault untestable.
-// 								3.	ABORT
-// 										If the Atpg is aborted due to the time of backtracks
-// 										exceeding the BACKTRACK_LIMIT 500 (can be changed
-// 										manually in namespace atpg.h::CoreNs).
+// 								A bridge is detected by a stuck-at test of one net under
+// 								a value constraint on the other net:
+// 									WAND: victim SA0 with aggressor L, or
+// 									      aggressor SA0 with victim L.
+// 									WOR:  victim SA1 with aggressor H, or
+// 									      aggressor SA1 with victim H.
+// 									DOM:  victim SA0 with aggressor L, or
+// 									      victim SA1 with aggressor H.
+// 								The constraint is injected through bridgeConstraintGateID_
+// 								and bridgeConstraintVal_, see setBridgeConstraint(), and
+// 								the two stuck-at targets are tried in order. The pattern
+// 								is then fault simulated with the bridge model itself, so a
+// 								pattern which does not detect the bridge is dropped and
+// 								the bridge is aborted. DTC is not applied on bridges.
 //
 // 							arguments:
-// 								[in, out] faultPtrListForGen : Current list of fault
-// 								pointers that are pointed to undetected faults. If detected
-// 								when seen as the first selected target fault, it will be
-// 								dropped immediately by fault simulation. If detected during
-// 								DTC stage the faults will be dropped altogether after DTC.
+// 								[in, out] faultPtrListForGen : The fault list, the target
+// 								bridge is the front. Detected faults are dropped.
 //
-// 								[in, out] pPatternProcessor : A pointer to pattern
-// 								processor that contains a pattern vector recording the
-// 								whole pattern set. In this function, the pattern processor
-// 								should already possess the patterns generated for the
-// 								faults before the current fault. A new Pattern will be
-// 								pushed back to the the pPatternProcessor->patternVector_
-// 								if the fault first selected in this function is detected.
-// 								It will become pPatternProcessor->patternVector_.back().
-// 								Then it will be determined and random XFilled at end of
-// 								the function.
+// 								[in, out] pPatternProcessor : The pattern processor, the
+// 								new pattern is pushed back to patternVector_.
 //
-// 								[in, out] numOfAtpgUntestableFaults : It is a reference
-// 								variable for recording the number of equivalent faults
-// 								untestable. Here untestable faults means this function call
-// 								has ended without abortion. If the function is aborted due
-// 								to backtrack time exceeding limit, it is called aborted
-// 								fault which is different to untestable fault.
+// 								[in, out] numOfAtpgUntestableFaults : The number of
+// 								equivalent faults untestable.
 //            ]
-// Date       [ started 2020/07/07    last modified 2023/01/05 ]
+// Date       [ started 2026/10/19 ]
 // **************************************************************************
-void Atpg::StuckAtFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults)
+void Atpg::BridgeFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults)
 {
-	SINGLE_PATTERN_GENERATION_STATUS result = generateSinglePatternOnTargetFault(*faultPtrListForGen.front(), false);
+	CommonNs::TraceScope traceScope("Atpg::BridgeFaultATPG");
+	Fault *pBridgeFault = faultPtrListForGen.front();
+	const int &victim = pBridgeFault->gateID_;
+	const int &aggressor = pBridgeFault->aggr_;
+
+	Fault targetFaults[2];
+	int constraintGateIDs[2];
+	Value constraintVals[2];
+	switch (pBridgeFault->bridgeType_)
+	{
+		case Fault::WAND:
+			targetFaults[0] = Fault(victim, Fault::SA0, 0);
+			targetFaults[1] = Fault(aggressor, Fault::SA0, 0);
+			constraintGateIDs[0] = aggressor;
+			constraintGateIDs[1] = victim;
+			constraintVals[0] = L;
+			constraintVals[1] = L;
+			break;
+		case Fault::WOR:
+			targetFaults[0] = Fault(victim, Fault::SA1, 0);
+			targetFaults[1] = Fault(aggressor, Fault::SA1, 0);
+			constraintGateIDs[0] = aggressor;
+			constraintGateIDs[1] = victim;
+			constraintVals[0] = H;
+			constraintVals[1] = H;
+			break;
+		default:
+			targetFaults[0] = Fault(victim, Fault::SA0, 0);
+			targetFaults[1] = Fault(victim, Fault::SA1, 0);
+			constraintGateIDs[0] = aggressor;
+			constraintGateIDs[1] = aggressor;
+			constraintVals[0] = L;
+			constraintVals[1] = H;
+			break;
+	}
+
+	SINGLE_PATTERN_GENERATION_STATUS result = FAULT_UNTESTABLE;
+	for (int i = 0; i < 2 && result != PATTERN_FOUND; ++i)
+	{
+		bridgeConstraintGateID_ = constraintGateIDs[i];
+		bridgeConstraintVal_ = constraintVals[i];
+		SINGLE_PATTERN_GENERATION_STATUS status = generateSinglePatternOnTargetFault(targetFaults[i], false);
+		if (status != FAULT_UNTESTABLE)
+		{
+			result = status;
+		}
+	}
+	bridgeConstraintGateID_ = -1;
+
 	if (result == PATTERN_FOUND)
 	{
 		Pattern pattern(pCircuit_);
@@ -595,99 +1571,39 @@ void Atpg::StuckAtFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *
 		storeCurrentAtpgVal();
 		writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
 
-		if (pPatternProcessor->dynamicCompression_ == PatternProcessor::ON)
-		{
-			FaultPtrList faultListTemp = faultPtrListForGen;
-			pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
-			pSimulator_->goodSim();
-			writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
-
-			for (Fault *pFault : faultListTemp)
-			{
-				// skip detected faults
-				if (pFault->faultState_ == Fault::DT)
-				{
-					continue;
-				}
-
-				Gate *pGateForActivation = getGateForFaultActivation(*pFault);
-				if (((pGateForActivation->atpgVal_ == L) && (pFault->faultType_ == Fault::SA0)) ||
-					((pGateForActivation->atpgVal_ == H) && (pFault->faultType_ == Fault::SA1)))
-				{
-					continue;
-				}
-
-				// Activation check
-				if (pGateForActivation->atpgVal_ != X)
-				{
-					if ((pFault->faultType_ == Fault::SA0) || (pFault->faultType_ == Fault::SA1))
-					{
-						setGateAtpgValAndRunImplication((*pGateForActivation), X);
-					}
-					else
-					{
-						continue;
-					}
-				}
-
-				if (xPathExists(pGateForActivation))
-				{
-					// TO-DO homework 05 implement DTC here end of TO-DO
-					if (generateSinglePatternOnTargetFault(*pFault, true) == PATTERN_FOUND)
-					{
-						resetPrevAtpgValStored();
-						clearAllFaultEffectByEvaluation();
-						storeCurrentAtpgVal();
-						writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
-					}
-					else
-					{
-						for (Gate &gate : pCircuit_->circuitGates_)
-						{
-							gate.atpgVal_ = gate.prevAtpgValStored_;
-						}
-					}
-				}
-				else
-				{
-					setGateAtpgValAndRunImplication((*pGateForActivation), pGateForActivation->prevAtpgValStored_);
-				}
-			}
-		}
-
-		clearAllFaultEffectByEvaluation();
-		storeCurrentAtpgVal();
-		writeAtpgValToPatternPI(pPatternProcessor->patternVector_.back());
-
 		if (pPatternProcessor->XFill_ == PatternProcessor::ON)
 		{
-			// Randomly fill the pats_.back().
-			// Note that the v_, gh_, gl_, fh_ and fl_ do not be changed.
 			randomFill(pPatternProcessor->patternVector_.back());
 		}
 
-		//  This function will assign pi/ppi stored in pats_.back() to
-		//  the gh_ and gl_ in each gate, and then it will run fault
-		//  simulation to drop fault.
-
+		const size_t numFaultsBeforeSim = faultPtrListForGen.size();
 		pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(), faultPtrListForGen);
-
-		// After pSimulator_->parallelFaultFaultSimWithOnePattern(pPatternProcessor->patternVector_.back(),faultListToGen) , the pi/ppi
-		// values have been passed to gh_ and gl_ of each gate.  Therefore, we can
-		// directly use "writeGoodSimValToPatternPO" to perform goodSim to get the PoValue.
 		pSimulator_->goodSim();
 		writeGoodSimValToPatternPO(pPatternProcessor->patternVector_.back());
+
+		if (pBridgeFault->faultState_ == Fault::DT)
+		{
+			return;
+		}
+		// the constraint did not survive justification, keep the pattern only
+		// if it detected something else
+		if (faultPtrListForGen.size() == numFaultsBeforeSim)
+		{
+			pPatternProcessor->patternVector_.pop_back();
+		}
+		result = ABORT;
 	}
-	else if (result == FAULT_UNTESTABLE)
+
+	if (result == FAULT_UNTESTABLE)
 	{
-		faultPtrListForGen.front()->faultState_ = Fault::AU;
-		numOfAtpgUntestableFaults += faultPtrListForGen.front()->equivalent_;
+		pBridgeFault->faultState_ = Fault::AU;
+		numOfAtpgUntestableFaults += pBridgeFault->equivalent_;
 		faultPtrListForGen.pop_front();
 	}
 	else
 	{
-		faultPtrListForGen.front()->faultState_ = Fault::AB;
-		faultPtrListForGen.push_back(faultPtrListForGen.front());
+		pBridgeFault->faultState_ = Fault::AB;
+		faultPtrListForGen.push_back(pBridgeFault);
 		faultPtrListForGen.pop_front();
 	}
 }
@@ -986,6 +1902,7 @@ void Atpg::clearFaultEffectOnGateAtpgVal(Gate &gate)
 // **************************************************************************
 Atpg::SINGLE_PATTERN_GENERATION_STATUS Atpg::generateSinglePatternOnTargetFault(Fault targetFault, bool isAtStageDTC)
 {
+	CommonNs::TraceScope traceScope("Atpg::generateSinglePatternOnTargetFault");
 
 	int backwardImplicationLevel = 0;							// backward imply level
 	int numOfBacktrack = 0;										// backtrack times
@@ -1010,16 +1927,16 @@ Atpg::SINGLE_PATTERN_GENERATION_STATUS Atpg::generateSinglePatternOnTargetFault(
 
 	while (!Finish)
 	{
-		if (!doImplication(implicationStatus, backwardImplicationLevel))
+		if (implicationStatus == CONFLICT || !doImplication(implicationStatus, backwardImplicationLevel))
 		{
-			// implication INCONSISTENCY
+			// implication INCONSISTENCY, or a side input blocking the unique path
 			// record the number of backtrack
 			if (backtrackDecisionTree_.lastNodeMarked())
 			{
 				++numOfBacktrack;
 			}
-			// Abort if numOfBacktrack reaching the BACKTRACK_LIMIT
-			if (numOfBacktrack > BACKTRACK_LIMIT)
+			// Abort if numOfBacktrack reaching the backtrack limit of the phase, or at the deadline
+			if (isBacktrackLimitReached(numOfBacktrack))
 			{
 				genStatus = ABORT;
 				Finish = true;
@@ -1091,8 +2008,8 @@ Atpg::SINGLE_PATTERN_GENERATION_STATUS Atpg::generateSinglePatternOnTargetFault(
 				{
 					++numOfBacktrack;
 				}
-				// Abort if numOfBacktrack reaching the BACKTRACK_LIMIT
-				if (numOfBacktrack > BACKTRACK_LIMIT)
+				// Abort if numOfBacktrack reaching the backtrack limit of the phase, or at the deadline
+				if (isBacktrackLimitReached(numOfBacktrack))
 				{
 					genStatus = ABORT;
 					Finish = true;
@@ -1122,12 +2039,19 @@ Atpg::SINGLE_PATTERN_GENERATION_STATUS Atpg::generateSinglePatternOnTargetFault(
 			{
 				// There exist just one path to the PO
 				// UNIQUE SENSITIZATION
+				const size_t numImplicatedBefore = backtrackImplicatedGateIDs_.size();
 				backwardImplicationLevel = doUniquePathSensitization(pCircuit_->circuitGates_[dFrontiers_[0]]);
 				// Unique Sensitization fail
 				if (backwardImplicationLevel == UNIQUE_PATH_SENSITIZE_FAIL)
 				{
 					// If UNIQUE_PATH_SENSITIZE_FAIL, the number of gates in d-frontier in the next while loop
-					// and will backtrack
+					// and will backtrack.
+					// Nothing assigned means nothing new to imply, and an XOR-type
+					// D-frontier keeps its X output, so backtrack here instead.
+					if (backtrackImplicatedGateIDs_.size() == numImplicatedBefore)
+					{
+						implicationStatus = CONFLICT;
+					}
 					continue;
 				}
 				// Unique Sensitization success
@@ -1248,6 +2172,7 @@ Gate *Atpg::initializeForSinglePatternGeneration(Fault &targetFault, int &backwa
 	else
 	{
 		backwardImplicationLevel = setFaultyGate(targetFault);
+		implicationStatus = (backwardImplicationLevel > 0) ? BACKWARD : FORWARD;
 	}
 
 	if (backwardImplicationLevel < 0)
@@ -1283,6 +2208,21 @@ Gate *Atpg::initializeForSinglePatternGeneration(Fault &targetFault, int &backwa
 			implicationStatus = BACKWARD;
 		}
 	}
+
+	if (bridgeConstraintGateID_ >= 0)
+	{
+		Level = setBridgeConstraint();
+		if (Level < 0)
+		{
+			return NULL;
+		}
+
+		if (Level > backwardImplicationLevel)
+		{
+			backwardImplicationLevel = Level;
+			implicationStatus = BACKWARD;
+		}
+	}
 	return &pCircuit_->circuitGates_[fGate_id];
 }
 
@@ -1373,8 +2313,8 @@ void Atpg::initializeCircuitWithFaultyGate(Gate &gFaultyLine, bool isAtStageDTC)
 		{
 			gate.atpgVal_ = X;
 		}
-		gateID_to_xPathStatus_[gate.gateId_] = UNKNOWN;
 	}
+	resetXPathStatus();
 
 	pushGateToEventStack(gFaultyLine.gateId_);
 
@@ -1687,6 +2627,45 @@ Atpg::IMPLICATION_STATUS Atpg::doOneGateBackwardImplication(Gate *pGate)
 			implicationStatus = FORWARD;
 		}
 	}
+	else if (pGate->gateType_ == Gate::XORN || pGate->gateType_ == Gate::XNORN)
+	{
+		// as XOR3, the only X fanin gets the output XORed with all the others
+		unsigned NumOfX = 0;
+		int ImpPtr = 0;
+		Value temp = pGate->atpgVal_;
+		for (int i = 0; i < pGate->numFI_; ++i)
+		{
+			const Value &faninVal = pCircuit_->circuitGates_[pGate->faninVector_[i]].atpgVal_;
+			if (faninVal == X)
+			{
+				++NumOfX;
+				ImpPtr = i;
+			}
+			else
+			{
+				temp = cXOR2(temp, faninVal);
+			}
+		}
+		if (NumOfX == 1)
+		{
+			Gate *pImpGate = &pCircuit_->circuitGates_[pGate->faninVector_[ImpPtr]];
+			if (pGate->gateType_ == Gate::XNORN)
+			{
+				temp = cINV(temp);
+			}
+			pImpGate->atpgVal_ = temp;
+			gateID_to_valModified_[pGate->gateId_] = 1;
+			backtrackImplicatedGateIDs_.push_back(pImpGate->gateId_);
+			pushGateToEventStack(pGate->faninVector_[ImpPtr]);
+			pushGateFanoutsToEventStack(pGate->faninVector_[ImpPtr]);
+			implicationStatus = BACKWARD;
+		}
+		else
+		{
+			unjustifiedGateIDs_.push_back(pGate->gateId_);
+			implicationStatus = FORWARD;
+		}
+	}
 	else
 	{
 		Value OutputControlVal = pGate->getOutputCtrlValue();
@@ -1895,7 +2874,7 @@ bool Atpg::backtrack(int &backwardImplicationLevel)
 			}
 		}
 		// Reset xPathStatus
-		std::fill(gateID_to_xPathStatus_.begin(), gateID_to_xPathStatus_.end(), UNKNOWN);
+		resetXPathStatus();
 		return true;
 	}
 	return false;
@@ -2159,14 +3138,14 @@ void Atpg::findFinalObjective(BACKTRACE_STATUS &backtraceFlag, const bool &fault
 				else
 				{ // NO
 					// ADD A GATE IN D-FRONTIER TO THE SET OF INITIAL OBJECTIVES
-					pLastDFrontier = findClosestToPO(dFrontiers_, index);
+					pLastDFrontier = pTiming_ ? findLongestPathToPO(dFrontiers_, index) : findClosestToPO(dFrontiers_, index);
 					initialObjectives_.push_back(pLastDFrontier->gateId_);
 				}
 			}
 			else
 			{ // NO
 				// ADD A GATE IN D-FRONTIER TO THE SET OF INITIAL OBJECTIVES
-				pLastDFrontier = findClosestToPO(dFrontiers_, index);
+				pLastDFrontier = pTiming_ ? findLongestPathToPO(dFrontiers_, index) : findClosestToPO(dFrontiers_, index);
 				initialObjectives_.push_back(pLastDFrontier->gateId_);
 			}
 
@@ -2466,18 +3445,9 @@ int Atpg::countEffectiveDFrontiers(Gate *pFaultyLineGate)
 	// update the frontier
 	updateDFrontiers();
 
-	// Change the xPathStatus from XPATH_EXIST to UNKNOWN of a gate
-	// which has equal or higher level than the faulty gate
-	//(the gate array has been given its level already)
-	// This is to clear the xPathStatus of previous xPathTracing
-	for (int i = pFaultyLineGate->gateId_; i < pCircuit_->totalGate_; ++i)
-	{
-		Gate *pGate = &pCircuit_->circuitGates_[i];
-		if (gateID_to_xPathStatus_[pGate->gateId_] == XPATH_EXIST)
-		{
-			gateID_to_xPathStatus_[pGate->gateId_] = UNKNOWN;
-		}
-	}
+	// A new query drops the XPATH_EXIST status of previous xPathTracing,
+	// NO_XPATH_EXIST is kept
+	startXPathQuery();
 
 	// if D-frontier can't propagate to the PO, erase it
 	for (int k = dFrontiers_.size() - 1; k >= 0; --k)
@@ -2596,13 +3566,13 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 		{
 			pNextGate = &pCircuit_->circuitGates_[pCurrGate->fanoutVector_[0]];
 		}
-		else if (UniquePathList.size() == 0) // If pCurrGate no UniquePath, break.
+		else if (gateID_to_dominator_[pCurrGate->gateId_] == pCircuit_->totalGate_) // If pCurrGate has no Dominator, break.
 		{
 			break;
 		}
 		else
 		{
-			pNextGate = &pCircuit_->circuitGates_[UniquePathList[0]]; // set pNextGate to UniquePathList[0].
+			pNextGate = &pCircuit_->circuitGates_[gateID_to_dominator_[pCurrGate->gateId_]]; // set pNextGate to the Dominator.
 		}
 
 		Value NonControlVal = pNextGate->getInputNonCtrlValue();
@@ -2638,7 +3608,7 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 			}
 			else
 			{
-				// gCurrGate(pGate) is not fanout free, pNextGate is UniquePathList[0].
+				// gCurrGate(pGate) is not fanout free, pNextGate is its Dominator.
 				bool DependOnCurrent;
 				for (int i = 0; i < pNextGate->numFI_; ++i)
 				{
@@ -2646,7 +3616,7 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 					Gate *pFaninGate = &pCircuit_->circuitGates_[pNextGate->faninVector_[i]];
 					DependOnCurrent = false;
 
-					for (int j = 1; j < UniquePathList.size(); ++j)
+					for (int j = 0; j < (int)UniquePathList.size(); ++j)
 					{
 						if (UniquePathList[j] == pFaninGate->gateId_)
 						{
@@ -2680,7 +3650,7 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 				}
 			}
 		}
-		pCurrGate = pNextGate; // move to last gate in gateID_to_uniquePath_
+		pCurrGate = pNextGate; // move to the Dominator
 	}
 	return backwardImplicationLevel;
 }
@@ -2694,6 +3664,8 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 // 							description:
 //                Used before generateSinglePatternOnTargetFault
 //                Return true if there is X-path. Otherwise return false.
+//                Values may have been unassigned since the last query, so
+//                all the statuses are reset.
 //
 //              arguments:
 // 								[in] gate: The gate to see if xpath exists.
@@ -2701,16 +3673,12 @@ int Atpg::doUniquePathSensitization(Gate &gate)
 //              output:
 // 								A boolean indicating if the x path exists.
 //            ]
-// Date       [ started 2020/07/07    last modified 2023/01/06 ]
+// Date       [ started 2020/07/07    last modified 2026/10/19 ]
 // **************************************************************************
 bool Atpg::xPathExists(Gate *pGate)
 {
-	// Clear the gateID_to_xPathStatus_ from target gate to PO/PPO
-	// TODO: This part can be implemented by event-driven method
-	for (int i = pGate->gateId_; i < pCircuit_->totalGate_; ++i)
-	{
-		gateID_to_xPathStatus_[i] = UNKNOWN;
-	}
+	resetXPathStatus();
+	startXPathQuery();
 	return xPathTracing(pGate);
 }
 
@@ -2721,9 +3689,14 @@ bool Atpg::xPathExists(Gate *pGate)
 // 								Determine if xpath exist for "gate".
 //
 // 							description:
-// 								Recursive call the function itself with the fanout of
-//								original pGate until PO/PPO is reached and check if pGate
-// 								has a X path.
+// 								Depth first search from pGate through the fanouts until
+// 								an X PO/PPO is reached, on the explicit xPathStack_ so
+// 								deep circuits do not overflow the call stack. A gate which
+// 								is not X or reaches no X PO/PPO, see
+// 								calculateGateReachableOutputs(), is not entered. The
+// 								gates on the stack get XPATH_EXIST once a path is found,
+// 								every gate left gets NO_XPATH_EXIST. Call
+// 								startXPathQuery() before.
 //
 //              arguments:
 // 								[in] gate: The gate to see if xpath exists.
@@ -2731,38 +3704,44 @@ bool Atpg::xPathExists(Gate *pGate)
 //              output:
 // 								A boolean indicating if the x path exists.
 //            ]
-// Date       [ Ver. 1.0 started 2013/08/13 last modified 2023/01/06 ]
+// Date       [ Ver. 1.0 started 2013/08/13 last modified 2026/10/19 ]
 // **************************************************************************
 bool Atpg::xPathTracing(Gate *pGate)
 {
-	if (pGate->atpgVal_ != X || gateID_to_xPathStatus_[pGate->gateId_] == NO_XPATH_EXIST)
-	{
-		gateID_to_xPathStatus_[pGate->gateId_] = NO_XPATH_EXIST;
-		return false;
-	}
-
-	if (gateID_to_xPathStatus_[pGate->gateId_] == XPATH_EXIST)
+	const XPATH_STATE xPathStatus = checkXPath(pGate->gateId_);
+	if (xPathStatus != UNKNOWN)
 	{
-		return true;
+		return xPathStatus == XPATH_EXIST;
 	}
 
-	if (pGate->gateType_ == Gate::PO || pGate->gateType_ == Gate::PPO)
+	xPathStack_.clear();
+	xPathStack_.push_back(std::make_pair(pGate->gateId_, 0));
+	while (!xPathStack_.empty())
 	{
-		gateID_to_xPathStatus_[pGate->gateId_] = XPATH_EXIST;
-		return true;
-	}
+		std::pair<int, int> &top = xPathStack_.back();
+		const Gate &gate = pCircuit_->circuitGates_[top.first];
+		if (top.second == gate.numFO_)
+		{
+			setXPathStatus(top.first, NO_XPATH_EXIST);
+			xPathStack_.pop_back();
+			continue;
+		}
 
-	for (int i = 0; i < pGate->numFO_; ++i)
-	{
-		// TO-DO homework 03
-		if (xPathTracing(&(pCircuit_->circuitGates_[pGate->fanoutVector_[i]])))
+		const int fanOutGateID = gate.fanoutVector_[top.second++];
+		const XPATH_STATE fanOutXPathStatus = checkXPath(fanOutGateID);
+		if (fanOutXPathStatus == XPATH_EXIST)
 		{
-			gateID_to_xPathStatus_[pGate->gateId_] = XPATH_EXIST;
+			for (const std::pair<int, int> &gateOnPath : xPathStack_)
+			{
+				setXPathStatus(gateOnPath.first, XPATH_EXIST);
+			}
 			return true;
 		}
-		// end of TO-DO
+		if (fanOutXPathStatus == UNKNOWN)
+		{
+			xPathStack_.push_back(std::make_pair(fanOutGateID, 0));
+		}
 	}
-	gateID_to_xPathStatus_[pGate->gateId_] = NO_XPATH_EXIST;
 	return false;
 }
 
@@ -2844,7 +3823,7 @@ int Atpg::setFaultyGate(Fault &fault)
 
 		backtrackImplicatedGateIDs_.push_back(pFaultyLine->gateId_);
 
-		if (pFaultyGate->gateType_ == Gate::AND2 || pFaultyGate->gateType_ == Gate::AND3 || pFaultyGate->gateType_ == Gate::AND4 || pFaultyGate->gateType_ == Gate::NAND2 || pFaultyGate->gateType_ == Gate::NAND3 || pFaultyGate->gateType_ == Gate::NAND4 || pFaultyGate->gateType_ == Gate::NOR2 || pFaultyGate->gateType_ == Gate::NOR3 || pFaultyGate->gateType_ == Gate::NOR4 || pFaultyGate->gateType_ == Gate::OR2 || pFaultyGate->gateType_ == Gate::OR3 || pFaultyGate->gateType_ == Gate::OR4)
+		if (pFaultyGate->gateType_ == Gate::AND2 || pFaultyGate->gateType_ == Gate::AND3 || pFaultyGate->gateType_ == Gate::AND4 || pFaultyGate->gateType_ == Gate::ANDN || pFaultyGate->gateType_ == Gate::NAND2 || pFaultyGate->gateType_ == Gate::NAND3 || pFaultyGate->gateType_ == Gate::NAND4 || pFaultyGate->gateType_ == Gate::NANDN || pFaultyGate->gateType_ == Gate::NOR2 || pFaultyGate->gateType_ == Gate::NOR3 || pFaultyGate->gateType_ == Gate::NOR4 || pFaultyGate->gateType_ == Gate::NORN || pFaultyGate->gateType_ == Gate::OR2 || pFaultyGate->gateType_ == Gate::OR3 || pFaultyGate->gateType_ == Gate::OR4 || pFaultyGate->gateType_ == Gate::ORN)
 		{
 			// scan all fanin gate of pFaultyGate
 			bool isFaultyGateScanned = false;
@@ -3106,18 +4085,46 @@ void Atpg::fanoutFreeBacktrace(Gate *pGate)
 				}
 				if (pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_ == X)
 				{
-					pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_ = L;
+					pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_ = L;
+				}
+				pCircuit_->circuitGates_[pGate->faninVector_[1]].atpgVal_ = cXOR3(cXOR2(pGate->atpgVal_, pGate->isInverse()), pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_);
+			}
+			else
+			{
+				pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_ = L;
+				pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_ = cXOR3(cXOR2(pGate->atpgVal_, pGate->isInverse()), pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[pGate->faninVector_[1]].atpgVal_);
+			}
+			currentObjectives_.push_back(pGate->faninVector_[0]);
+			currentObjectives_.push_back(pGate->faninVector_[1]);
+			currentObjectives_.push_back(pGate->faninVector_[2]);
+		}
+		else if (pGate->gateType_ == Gate::XORN || pGate->gateType_ == Gate::XNORN)
+		{
+			// the last fanin other than the head line takes the parity, the other X fanins L
+			int target = pGate->numFI_ - 1;
+			if (&pCircuit_->circuitGates_[pGate->faninVector_[target]] == firstTimeFrameHeadLine_)
+			{
+				--target;
+			}
+			Value parity = cXOR2(pGate->atpgVal_, pGate->isInverse());
+			for (int i = 0; i < pGate->numFI_; ++i)
+			{
+				Gate *pFaninGate = &pCircuit_->circuitGates_[pGate->faninVector_[i]];
+				if (i == target)
+				{
+					continue;
+				}
+				if (pFaninGate->atpgVal_ == X)
+				{
+					pFaninGate->atpgVal_ = L;
 				}
-				pCircuit_->circuitGates_[pGate->faninVector_[1]].atpgVal_ = cXOR3(cXOR2(pGate->atpgVal_, pGate->isInverse()), pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_);
+				parity = cXOR2(parity, pFaninGate->atpgVal_);
 			}
-			else
+			pCircuit_->circuitGates_[pGate->faninVector_[target]].atpgVal_ = parity;
+			for (int i = 0; i < pGate->numFI_; ++i)
 			{
-				pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_ = L;
-				pCircuit_->circuitGates_[pGate->faninVector_[2]].atpgVal_ = cXOR3(cXOR2(pGate->atpgVal_, pGate->isInverse()), pCircuit_->circuitGates_[pGate->faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[pGate->faninVector_[1]].atpgVal_);
+				currentObjectives_.push_back(pGate->faninVector_[i]);
 			}
-			currentObjectives_.push_back(pGate->faninVector_[0]);
-			currentObjectives_.push_back(pGate->faninVector_[1]);
-			currentObjectives_.push_back(pGate->faninVector_[2]);
 		}
 		else if (pGate->isUnary())
 		{ // if pGate only have one input gate
@@ -3447,6 +4454,7 @@ Value Atpg::assignBacktraceValue(int &n0, int &n1, const Gate &gate)
 		case Gate::AND2:
 		case Gate::AND3:
 		case Gate::AND4:
+		case Gate::ANDN:
 			n0 = gateID_to_n0_[gate.gateId_];
 			n1 = gateID_to_n1_[gate.gateId_];
 			return L;
@@ -3455,6 +4463,7 @@ Value Atpg::assignBacktraceValue(int &n0, int &n1, const Gate &gate)
 		case Gate::OR2:
 		case Gate::OR3:
 		case Gate::OR4:
+		case Gate::ORN:
 			// TO-DO homework 04
 			n0 = gateID_to_n0_[gate.gateId_];
 			n1 = gateID_to_n1_[gate.gateId_];
@@ -3465,6 +4474,7 @@ Value Atpg::assignBacktraceValue(int &n0, int &n1, const Gate &gate)
 		case Gate::NAND2:
 		case Gate::NAND3:
 		case Gate::NAND4:
+		case Gate::NANDN:
 			n0 = gateID_to_n1_[gate.gateId_];
 			n1 = gateID_to_n0_[gate.gateId_];
 			return L;
@@ -3473,6 +4483,7 @@ Value Atpg::assignBacktraceValue(int &n0, int &n1, const Gate &gate)
 		case Gate::NOR2:
 		case Gate::NOR3:
 		case Gate::NOR4:
+		case Gate::NORN:
 			// TO-DO homework 04
 			n0 = gateID_to_n1_[gate.gateId_];
 			n1 = gateID_to_n0_[gate.gateId_];
@@ -3542,6 +4553,29 @@ Value Atpg::assignBacktraceValue(int &n0, int &n1, const Gate &gate)
 				n1 = temp;
 			}
 			return X;
+
+			// when gate is XORN or XNORN, every fanin at H flips the parity
+		case Gate::XORN:
+		case Gate::XNORN:
+			v1 = 0;
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				if (pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_ == H)
+				{
+					++v1;
+				}
+			}
+			if ((v1 % 2 == 1) != (gate.gateType_ == Gate::XNORN))
+			{
+				n0 = gateID_to_n1_[gate.gateId_];
+				n1 = gateID_to_n0_[gate.gateId_];
+			}
+			else
+			{
+				n0 = gateID_to_n0_[gate.gateId_];
+				n1 = gateID_to_n1_[gate.gateId_];
+			}
+			return X;
 		default:
 			n0 = gateID_to_n0_[gate.gateId_];
 			n1 = gateID_to_n1_[gate.gateId_];
@@ -3593,21 +4627,27 @@ void Atpg::initializeForMultipleBacktrace()
 				case Gate::AND2:
 				case Gate::AND3:
 				case Gate::AND4:
+				case Gate::ANDN:
 				case Gate::NOR2:
 				case Gate::NOR3:
 				case Gate::NOR4:
+				case Gate::NORN:
 				case Gate::XNOR2:
 				case Gate::XNOR3:
+				case Gate::XNORN:
 					setGaten0n1(pGate->gateId_, 0, 1);
 					break;
 				case Gate::OR2:
 				case Gate::OR3:
 				case Gate::OR4:
+				case Gate::ORN:
 				case Gate::NAND2:
 				case Gate::NAND3:
 				case Gate::NAND4:
+				case Gate::NANDN:
 				case Gate::XOR2:
 				case Gate::XOR3:
+				case Gate::XORN:
 					setGaten0n1(pGate->gateId_, 1, 0);
 					break;
 				default:
@@ -3625,12 +4665,10 @@ void Atpg::initializeForMultipleBacktrace()
 // Synopsis   [ usage: Find the easiest fanin by gate::cc0_ or gate::cc1_.
 //
 // 							description:
-// 								Utilize SCOAP heuristic if addSCOAP is called in
-// 								setupCircuitParameter().
-// 								Otherwise cc0_ and cc1_ is 0.
-// 								SCOAP heuristic is finished and can be found in atpg.cpp
-// 								but is not included in the algorithm because the result
-// 								of SCOAP is even worse.
+// 								Utilize SCOAP heuristic if setScoapGuided() is on, see
+// 								calSCOAP(). Otherwise the first fanin which is X.
+// 								With setTiming(), a gate of the second frame takes
+// 								the X fanin with the latest arrival time instead.
 //
 // 							arguments:
 // 								[in] pGate:
@@ -3640,7 +4678,7 @@ void Atpg::initializeForMultipleBacktrace()
 //
 //              output: The easiest fanin gate to assign value.
 //            ]
-// Date       [ CPJ Ver. 1.0 started 2013/08/10 last modified 2023/01/06 ]
+// Date       [ CPJ Ver. 1.0 started 2013/08/10 last modified 2026/10/19 ]
 // **************************************************************************
 Gate *Atpg::findEasiestInput(Gate *pGate, Value atpgValOfpGate)
 {
@@ -3656,6 +4694,31 @@ Gate *Atpg::findEasiestInput(Gate *pGate, Value atpgValOfpGate)
 		return &pCircuit_->circuitGates_[pGate->faninVector_[0]];
 	}
 
+	// with timing, gates of the capture (second) frame are justified
+	// through the latest fanin, so the transition reaching the fault site
+	// travels the longest path; the launch frame keeps the plain choice
+	if (pTiming_ && pGate->gateId_ >= pCircuit_->numGate_)
+	{
+		float latestArrival = -std::numeric_limits<float>::infinity();
+		for (int i = 0; i < pGate->numFI_; ++i)
+		{
+			Gate *pFaninGate = &pCircuit_->circuitGates_[pGate->faninVector_[i]];
+			if (pFaninGate->atpgVal_ != X)
+			{
+				continue;
+			}
+
+			const Delay &arrival = pTiming_->getArrival(pFaninGate->gateId_ % pCircuit_->numGate_);
+			const float faninArrival = std::max(arrival.rise_, arrival.fall_);
+			if (faninArrival > latestArrival)
+			{
+				latestArrival = faninArrival;
+				pRetGate = pFaninGate;
+			}
+		}
+		return pRetGate;
+	}
+
 	if (atpgValOfpGate == L)
 	{
 		// choose the value-undetermined faninGate which has smallest cc0_
@@ -3667,9 +4730,10 @@ Gate *Atpg::findEasiestInput(Gate *pGate, Value atpgValOfpGate)
 				continue;
 			}
 
-			if (pFaninGate->cc0_ < easyControlVal)
+			const int cc0 = isScoapGuided_ ? pFaninGate->cc0_ : 0;
+			if (cc0 < easyControlVal)
 			{
-				easyControlVal = pFaninGate->cc0_;
+				easyControlVal = cc0;
 				pRetGate = pFaninGate;
 			}
 		}
@@ -3685,9 +4749,10 @@ Gate *Atpg::findEasiestInput(Gate *pGate, Value atpgValOfpGate)
 				continue;
 			}
 
-			if (pFaninGate->cc1_ < easyControlVal)
+			const int cc1 = isScoapGuided_ ? pFaninGate->cc1_ : 0;
+			if (cc1 < easyControlVal)
 			{
-				easyControlVal = pFaninGate->cc1_;
+				easyControlVal = cc1;
 				pRetGate = pFaninGate;
 			}
 		}
@@ -3723,7 +4788,10 @@ Gate *Atpg::findClosestToPO(std::vector<int> &gateVec, int &index)
 	index = gateVec.size() - 1;
 	for (int i = gateVec.size() - 2; i >= 0; --i)
 	{
-		if (pCircuit_->circuitGates_[gateVec[i]].depthFromPo_ < pCloseGate->depthFromPo_)
+		const Gate &gate = pCircuit_->circuitGates_[gateVec[i]];
+		// with SCOAP, ties are broken by the observability
+		if (gate.depthFromPo_ < pCloseGate->depthFromPo_ ||
+				(isScoapGuided_ && gate.depthFromPo_ == pCloseGate->depthFromPo_ && gate.co_ < pCloseGate->co_))
 		{
 			index = i;
 			pCloseGate = &pCircuit_->circuitGates_[gateVec[i]];
@@ -3732,6 +4800,50 @@ Gate *Atpg::findClosestToPO(std::vector<int> &gateVec, int &index)
 	return pCloseGate;
 }
 
+// **************************************************************************
+// Function   [ Atpg::findLongestPathToPO ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage:
+// 								Find the gate with the longest path to output, the
+// 								least required time, see setTiming(). A transition
+// 								fault is propagated along it. Ties are broken by
+// 								the distance to PO/PPO.
+//
+// 							arguments:
+// 								[in] gateVec: The gate vector to search.
+// 								[in, out] index: The index of the gate found.
+//
+//              output:
+// 								The gate with the longest path to PO/PPO.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// *************************************************************************
+Gate *Atpg::findLongestPathToPO(std::vector<int> &gateVec, int &index)
+{
+	if (gateVec.empty())
+	{
+		return NULL;
+	}
+
+	Gate *pLongGate = &pCircuit_->circuitGates_[gateVec.back()];
+	index = gateVec.size() - 1;
+	const Delay &longRequired = pTiming_->getRequired(pLongGate->gateId_ % pCircuit_->numGate_);
+	float longTime = std::min(longRequired.rise_, longRequired.fall_);
+	for (int i = gateVec.size() - 2; i >= 0; --i)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[gateVec[i]];
+		const Delay &required = pTiming_->getRequired(gate.gateId_ % pCircuit_->numGate_);
+		const float time = std::min(required.rise_, required.fall_);
+		if (time < longTime || (time == longTime && gate.depthFromPo_ < pLongGate->depthFromPo_))
+		{
+			index = i;
+			pLongGate = &pCircuit_->circuitGates_[gateVec[i]];
+			longTime = time;
+		}
+	}
+	return pLongGate;
+}
+
 // **************************************************************************
 // Function   [ Atpg::evaluateAndSetGateAtpgVal ]
 // Commenter  [ KOREAL WWS ]
@@ -3903,6 +5015,18 @@ Atpg::IMPLICATION_STATUS Atpg::evaluateAndSetFaultyGateAtpgVal(Gate *pGate)
 					ImpVal = cXOR2(ImpVal, temp);
 				}
 
+				// set ImpVal if pGate is XORN or XNORN
+				if (pGate->gateType_ == Gate::XORN || pGate->gateType_ == Gate::XNORN)
+				{
+					for (int i = 0; i < pGate->numFI_; ++i)
+					{
+						if (i != ImpPtr)
+						{
+							ImpVal = cXOR2(ImpVal, pCircuit_->circuitGates_[pGate->faninVector_[i]].atpgVal_);
+						}
+					}
+				}
+
 				// if pGate is an inverse function, ImpVal = NOT(ImpVal)
 				Value isInv = pGate->isInverse();
 				ImpVal = cXOR2(ImpVal, isInv);
@@ -3966,6 +5090,7 @@ Atpg::IMPLICATION_STATUS Atpg::evaluateAndSetFaultyGateAtpgVal(Gate *pGate)
 // **************************************************************************
 void Atpg::staticTestCompressionByReverseFaultSimulation(PatternProcessor *pPatternProcessor, FaultPtrList &originalFaultList)
 {
+	CommonNs::TraceScope traceScope("Atpg::staticTestCompressionByReverseFaultSimulation");
 
 	std::vector<Pattern> tmp = pPatternProcessor->patternVector_;
 	pPatternProcessor->patternVector_.clear();
@@ -4131,6 +5256,84 @@ int Atpg::setUpFirstTimeFrame(Fault &fault)
 	return backwardImplicationLevel;
 }
 
+// **************************************************************************
+// Function   [ Atpg::setBridgeConstraint ]
+// Commenter  [ WWS ]
+// Synopsis   [ usage: Inject the value constraint of a bridge fault target.
+//                     Works the same way as setUpFirstTimeFrame:
+//                     1.Constrained gate is FREE LINE
+//                      (1)Set the value and justify it by fanout free backtrace.
+//                      (2)Propagate the value forward until it meets a HEAD LINE.
+//                      (3)Schedule fanout gates of the HEAD LINE.
+//                     2.Constrained gate is HEAD LINE or BOUND LINE
+//                      (1)Set the value and schedule the gate and its fanouts.
+//                      (2)Return the gate level for backward implication.
+//                     If the gate already has a value (e.g. from unique
+//                     sensitization) it is only checked.
+//              in:    void, uses bridgeConstraintGateID_ and bridgeConstraintVal_
+//              out:   int backwardImplicationLevel: the backward imply level,
+//                     return -1 when the constraint conflicts
+//            ]
+// Date       [ started 2026/10/19 ]
+// **************************************************************************
+int Atpg::setBridgeConstraint()
+{
+	Gate *pGate = &pCircuit_->circuitGates_[bridgeConstraintGateID_];
+	const Value &val = bridgeConstraintVal_;
+
+	if (pGate->atpgVal_ != X)
+	{
+		Value goodVal = pGate->atpgVal_;
+		if (goodVal == D)
+		{
+			goodVal = H;
+		}
+		else if (goodVal == B)
+		{
+			goodVal = L;
+		}
+		return goodVal == val ? 0 : -1;
+	}
+
+	pGate->atpgVal_ = val;
+	backtrackImplicatedGateIDs_.push_back(pGate->gateId_);
+
+	if (gateID_to_lineType_[pGate->gateId_] == FREE_LINE)
+	{
+		fanoutFreeBacktrace(pGate);
+		Gate *gTemp = pGate;
+		Gate *gNext = NULL;
+		// propagate until meet the other LINE
+		do
+		{
+			gNext = &pCircuit_->circuitGates_[gTemp->fanoutVector_[0]];
+			if (gNext->atpgVal_ != X || (!gNext->isUnary() && (gNext->getOutputCtrlValue() == X || gTemp->atpgVal_ != gNext->getInputCtrlValue())))
+			{
+				break;
+			}
+			gNext->atpgVal_ = cXOR2(gNext->isInverse(), gTemp->atpgVal_);
+			gTemp = gNext;
+		} while (gateID_to_lineType_[gTemp->gateId_] == FREE_LINE);
+
+		if (gateID_to_lineType_[gTemp->gateId_] == HEAD_LINE)
+		{
+			gateID_to_valModified_[gTemp->gateId_] = 1;
+			backtrackImplicatedGateIDs_.push_back(gTemp->gateId_);
+			pushGateFanoutsToEventStack(gTemp->gateId_);
+		}
+		return 0;
+	}
+
+	pushGateFanoutsToEventStack(pGate->gateId_);
+	if (gateID_to_lineType_[pGate->gateId_] == HEAD_LINE)
+	{
+		gateID_to_valModified_[pGate->gateId_] = 1;
+		return 0;
+	}
+	pushGateToEventStack(pGate->gateId_);
+	return pGate->numLevel_;
+}
+
 // **************************************************************************
 // Function   [ Atpg::checkLevelInfo ]
 // Commenter  [ CAL ]
@@ -4190,274 +5393,6 @@ std::string Atpg::getValStr(Value val)
 	return valStr;
 }
 
-// TODO comment by wang
-void Atpg::calSCOAP()
-{
-	// cc0, cc1 and co default is 0, check if is changed before
-	for (int gateID = 0; gateID < pCircuit_->totalGate_; ++gateID)
-	{
-		Gate &gate = pCircuit_->circuitGates_[gateID];
-		if (gate.cc0_ != 0)
-		{
-			std::cerr << "cc0_ is not -1\n";
-			std::cin.get();
-		}
-		if (gate.cc1_ != 0)
-		{
-			std::cerr << "cc1_ is not -1\n";
-			std::cin.get();
-		}
-		if (gate.co_ != 0)
-		{
-			std::cerr << "co_ is not -1\n";
-			std::cin.get();
-		}
-	}
-
-	// array for xor2, xor3, xnor2, xnor3
-	// xor2 xnor2 : {00,01,10,11}
-	// xor3 xnor3 : {000, 001, 010, 011, 100, 101, 110, 111}
-	int xorcc[8] = {0};
-	Gate gateInputs[3];
-
-	// calculate cc0 and cc1 starting from PI and PPI
-	for (int gateID = 0; gateID < pCircuit_->totalGate_; ++gateID)
-	{
-		Gate &gate = pCircuit_->circuitGates_[gateID];
-		switch (gate.gateType_)
-		{
-			case Gate::PPI:
-			case Gate::PI:
-				gate.cc0_ = 1;
-				gate.cc1_ = 1;
-				break;
-			case Gate::PO:
-			case Gate::PPO:
-			case Gate::BUF:
-				gate.cc0_ = pCircuit_->circuitGates_[gate.faninVector_[0]].cc0_;
-				gate.cc1_ = pCircuit_->circuitGates_[gate.faninVector_[0]].cc1_;
-				break;
-			case Gate::INV:
-				gate.cc0_ = pCircuit_->circuitGates_[gate.faninVector_[0]].cc1_ + 1;
-				gate.cc1_ = pCircuit_->circuitGates_[gate.faninVector_[0]].cc0_ + 1;
-				break;
-			case Gate::AND2:
-			case Gate::AND3:
-			case Gate::AND4:
-				for (int j = 0; j < gate.numFI_; ++j)
-				{
-					Gate &gateInput = pCircuit_->circuitGates_[gate.faninVector_[j]];
-					if (j == 0 || (gateInput.cc0_ < gate.cc0_))
-					{
-						gate.cc0_ = gateInput.cc0_;
-					}
-					gate.cc1_ += gateInput.cc1_;
-				}
-				++gate.cc1_;
-				++gate.cc0_;
-				break;
-			case Gate::NAND2:
-			case Gate::NAND3:
-			case Gate::NAND4:
-				for (int j = 0; j < gate.numFI_; ++j)
-				{
-					Gate &gateInput = pCircuit_->circuitGates_[gate.faninVector_[j]];
-					if (j == 0 || (gateInput.cc0_ < gate.cc1_))
-					{
-						gate.cc1_ = gateInput.cc0_;
-					}
-					gate.cc0_ += gateInput.cc1_;
-				}
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::OR2:
-			case Gate::OR3:
-			case Gate::OR4:
-				for (int j = 0; j < gate.numFI_; ++j)
-				{
-					Gate &gateInput = pCircuit_->circuitGates_[gate.faninVector_[j]];
-					if (j == 0 || (gateInput.cc1_ < gate.cc1_))
-					{
-						gate.cc1_ = gateInput.cc1_;
-					}
-					gate.cc0_ += gateInput.cc0_;
-				}
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::NOR2:
-			case Gate::NOR3:
-			case Gate::NOR4:
-				for (int j = 0; j < gate.numFI_; ++j)
-				{
-					Gate &gateInput = pCircuit_->circuitGates_[gate.faninVector_[j]];
-					if (j == 0 || (gateInput.cc1_ < gate.cc0_))
-					{
-						gate.cc0_ = gateInput.cc1_;
-					}
-					gate.cc1_ += gateInput.cc0_;
-				}
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::XOR2:
-				gateInputs[0] = pCircuit_->circuitGates_[gate.faninVector_[0]];
-				gateInputs[1] = pCircuit_->circuitGates_[gate.faninVector_[1]];
-				xorcc[0] = gateInputs[0].cc0_ + gateInputs[1].cc0_;
-				xorcc[1] = gateInputs[0].cc0_ + gateInputs[1].cc1_;
-				xorcc[2] = gateInputs[0].cc1_ + gateInputs[1].cc0_;
-				xorcc[3] = gateInputs[0].cc1_ + gateInputs[1].cc1_;
-				gate.cc0_ = std::min(xorcc[0], xorcc[3]);
-				gate.cc1_ = std::min(xorcc[1], xorcc[2]);
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::XOR3:
-				gateInputs[0] = pCircuit_->circuitGates_[gate.faninVector_[0]];
-				gateInputs[1] = pCircuit_->circuitGates_[gate.faninVector_[1]];
-				gateInputs[2] = pCircuit_->circuitGates_[gate.faninVector_[2]];
-				xorcc[0] = gateInputs[0].cc0_ + gateInputs[1].cc0_ + gateInputs[2].cc0_;
-				xorcc[1] = gateInputs[0].cc0_ + gateInputs[1].cc0_ + gateInputs[2].cc1_;
-				xorcc[2] = gateInputs[0].cc0_ + gateInputs[1].cc1_ + gateInputs[2].cc0_;
-				xorcc[3] = gateInputs[0].cc0_ + gateInputs[1].cc1_ + gateInputs[2].cc1_;
-				xorcc[4] = gateInputs[0].cc1_ + gateInputs[1].cc0_ + gateInputs[2].cc0_;
-				xorcc[5] = gateInputs[0].cc1_ + gateInputs[1].cc0_ + gateInputs[2].cc1_;
-				xorcc[6] = gateInputs[0].cc1_ + gateInputs[1].cc1_ + gateInputs[2].cc0_;
-				xorcc[7] = gateInputs[0].cc1_ + gateInputs[1].cc1_ + gateInputs[2].cc1_;
-				gate.cc0_ = std::min(xorcc[0], xorcc[7]);
-				for (int j = 1; j < 7; ++j)
-				{
-					if (j == 1 || xorcc[j] < gate.cc1_)
-					{
-						gate.cc1_ = xorcc[j];
-					}
-				}
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::XNOR2:
-				gateInputs[0] = pCircuit_->circuitGates_[gate.faninVector_[0]];
-				gateInputs[1] = pCircuit_->circuitGates_[gate.faninVector_[1]];
-				xorcc[0] = gateInputs[0].cc0_ + gateInputs[1].cc0_;
-				xorcc[1] = gateInputs[0].cc0_ + gateInputs[1].cc1_;
-				xorcc[2] = gateInputs[0].cc1_ + gateInputs[1].cc0_;
-				xorcc[3] = gateInputs[0].cc1_ + gateInputs[1].cc1_;
-				gate.cc0_ = std::min(xorcc[1], xorcc[2]);
-				gate.cc1_ = std::min(xorcc[0], xorcc[3]);
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			case Gate::XNOR3:
-				gateInputs[0] = pCircuit_->circuitGates_[gate.faninVector_[0]];
-				gateInputs[1] = pCircuit_->circuitGates_[gate.faninVector_[1]];
-				gateInputs[2] = pCircuit_->circuitGates_[gate.faninVector_[2]];
-				xorcc[0] = gateInputs[0].cc0_ + gateInputs[1].cc0_ + gateInputs[2].cc0_;
-				xorcc[1] = gateInputs[0].cc0_ + gateInputs[1].cc0_ + gateInputs[2].cc1_;
-				xorcc[2] = gateInputs[0].cc0_ + gateInputs[1].cc1_ + gateInputs[2].cc0_;
-				xorcc[3] = gateInputs[0].cc0_ + gateInputs[1].cc1_ + gateInputs[2].cc1_;
-				xorcc[4] = gateInputs[0].cc1_ + gateInputs[1].cc0_ + gateInputs[2].cc0_;
-				xorcc[5] = gateInputs[0].cc1_ + gateInputs[1].cc0_ + gateInputs[2].cc1_;
-				xorcc[6] = gateInputs[0].cc1_ + gateInputs[1].cc1_ + gateInputs[2].cc0_;
-				xorcc[7] = gateInputs[0].cc1_ + gateInputs[1].cc1_ + gateInputs[2].cc1_;
-				gate.cc1_ = std::min(xorcc[0], xorcc[7]);
-				for (int j = 1; j < 7; ++j)
-				{
-					if (j == 1 || xorcc[j] < gate.cc1_)
-					{
-						gate.cc0_ = xorcc[j];
-					}
-				}
-				++gate.cc0_;
-				++gate.cc1_;
-				break;
-			default:
-				std::cerr << "Bug: reach switch case default while calculating cc0_, cc1_";
-				std::cin.get();
-				break;
-		}
-	}
-
-	// calculate co_ starting from PO and PP
-	for (int gateID = 0; gateID < pCircuit_->totalGate_; ++gateID)
-	{
-		Gate &gate = pCircuit_->circuitGates_[gateID];
-		switch (gate.gateType_)
-		{
-			case Gate::PO:
-			case Gate::PPO:
-				gate.co_ = 0;
-				break;
-			case Gate::PPI:
-			case Gate::PI:
-			case Gate::BUF:
-				for (int j = 0; j < gate.numFO_; ++j)
-				{
-					if (j == 0 || pCircuit_->circuitGates_[gate.fanoutVector_[j]].co_ < gate.co_)
-					{
-						gate.co_ = pCircuit_->circuitGates_[gate.fanoutVector_[j]].co_;
-					}
-				}
-				break;
-			case Gate::INV:
-				gate.co_ = pCircuit_->circuitGates_[gate.fanoutVector_[0]].co_ + 1;
-				break;
-			case Gate::AND2:
-			case Gate::AND3:
-			case Gate::AND4:
-			case Gate::NAND2:
-			case Gate::NAND3:
-			case Gate::NAND4:
-				gate.co_ = pCircuit_->circuitGates_[gate.fanoutVector_[0]].co_ + 1;
-				for (int j = 0; j < pCircuit_->circuitGates_[gate.fanoutVector_[0]].numFI_; ++j)
-				{
-					if (pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j] != gateID)
-					{
-						Gate &gateSibling = pCircuit_->circuitGates_[pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j]];
-						gate.co_ += gateSibling.cc1_;
-					}
-				}
-				break;
-			case Gate::OR2:
-			case Gate::OR3:
-			case Gate::OR4:
-			case Gate::NOR2:
-			case Gate::NOR3:
-			case Gate::NOR4:
-				gate.co_ = pCircuit_->circuitGates_[gate.fanoutVector_[0]].co_ + 1;
-				for (int j = 0; j < pCircuit_->circuitGates_[gate.fanoutVector_[0]].numFI_; ++j)
-				{
-					if (pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j] != gateID)
-					{
-						Gate &gateSibling = pCircuit_->circuitGates_[pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j]];
-						gate.co_ += gateSibling.cc0_;
-					}
-				}
-				break;
-			case Gate::XOR2:
-			case Gate::XNOR2:
-			case Gate::XOR3:
-			case Gate::XNOR3:
-				gate.co_ = pCircuit_->circuitGates_[gate.fanoutVector_[0]].co_ + 1;
-				for (int j = 0; j < pCircuit_->circuitGates_[gate.fanoutVector_[0]].numFI_; ++j)
-				{
-					Gate &gateSibling = pCircuit_->circuitGates_[pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j]];
-					if (pCircuit_->circuitGates_[gate.fanoutVector_[0]].faninVector_[j] != gateID)
-					{
-						gate.co_ += std::min(gateSibling.cc0_, gateSibling.cc1_);
-					}
-				}
-				break;
-			default:
-				std::cerr << "Bug: reach switch case default while calculating co_";
-				std::cin.get();
-				break;
-		}
-	}
-
-	return;
-}
-
 // **************************************************************************
 // Function   [ Atpg::testClearFaultEffect ]
 // Commenter  [ CAL ]
@@ -8,27 +8,37 @@
 #ifndef _CORE_ATPG_H_
 #define _CORE_ATPG_H_
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <string>
 #include <vector> // added by wang
 #include <stack>	// added by wang
 #include <algorithm>
+#include "atpg_checkpoint.h"
 #include "decision_tree.h"
+#include "fault_cone.h"
+#include "multi_fault_atpg.h"
 #include "simulator.h"
+#include "timing.h"
 
 namespace CoreNs
 {
 	constexpr int BACKTRACK_LIMIT = 500;
 	constexpr int INFINITE = 0x7fffffff;
+	constexpr int SCOAP_LIMIT = 0x1000000; // SCOAP measures saturate here, so a sum of two never overflows
 	constexpr int MAX_LIST_SIZE = 1000;
 	constexpr int NO_UNIQUE_PATH = -1;
 	constexpr int UNIQUE_PATH_SENSITIZE_FAIL = -2;
+	constexpr int FAULT_CONE_CACHE_SIZE = 16;
 
 	class Atpg
 	{
 	public:
 		inline Atpg(Circuit *pCircuit, Simulator *pSimulator);
+		inline ~Atpg();
 
 		enum SINGLE_PATTERN_GENERATION_STATUS
 		{
@@ -66,10 +76,39 @@ namespace CoreNs
 			NO_CONTRADICTORY = 0,
 			CONTRADICTORY
 		};
+		enum FAULT_ORDER
+		{
+			EXTRACTION_ORDER = 0,
+			EASY_FIRST,
+			HARD_FIRST
+		};
 
 		// class Atpg main method
 		void generatePatternSet(PatternProcessor *pPatternProcessor, FaultListExtract *pFaultListExtractor, bool isMFO);
 
+		// checkpointing, see generatePatternSet
+		void setCheckpoint(const std::string &fname, const double &interval);
+		void setTimeBudget(const double &timeBudget);
+		bool loadCheckpoint(const std::string &fname, PatternProcessor *pPatternProcessor, FaultListExtract *pFaultListExtractor);
+		bool isStoppedByTimeBudget() const;
+
+		// stuck-at faults are first targeted in groups by MultiFaultAtpg
+		void setMultiFault(const bool &isMultiFault);
+		// stuck-at faults are targeted on the cone of their site, see FaultCone
+		void setFaultCone(const bool &isFaultCone);
+
+		// abort limit escalation, see generatePatternSet
+		void setBacktrackLimits(const std::vector<int> &backtrackLimits);
+		void setNumWorker(const int &numWorker);
+		void setDeadline(const double &deadline);
+		bool isStoppedByDeadline() const;
+
+		// SCOAP testability, see calSCOAP
+		void setFaultOrder(const FAULT_ORDER &faultOrder);
+		void setScoapGuided(const bool &isScoapGuided);
+		// longest paths through the site for transition faults, see findLongestPathToPO
+		void setTiming(const Timing *pTiming);
+
 	private:
 		Circuit *pCircuit_;																				// the circuit built on read verilog
 		Simulator *pSimulator_;																		// the simulator based on the built circuit
@@ -83,7 +122,15 @@ namespace CoreNs
 		std::vector<int> gateID_to_reachableByTargetFault_;				// 1 means this fanout is in fanout cone of target fault, 0 otherwise
 		std::vector<GATE_LINE_TYPE> gateID_to_lineType_;					// array of line types for all gates, i.e. FREE, HEAD, BOUND
 		std::vector<XPATH_STATE> gateID_to_xPathStatus_;					// gateID to its xPathStatus, i.e. XPATH_EXIST, NO_XPATH_EXIST, UNKNOWN
-		std::vector<std::vector<int>> gateID_to_uniquePath_;			// list of gates on the unique path associated with a D-frontier, when there is only one gate in D-frontier, xPathTracing will update this information.
+		std::vector<int> gateID_to_xPathStamp_;										// xPathStamp_ of the query which set the xPathStatus, see getXPathStatus
+		int xPathStamp_;																					// counts X-path queries
+		int xPathResetStamp_;																			// first query after the last resetXPathStatus
+		std::vector<ParallelValue> gateID_to_reachableOutputs_;		// bit k % WORD_SIZE is set if the k-th PO/PPO is reachable from the gate
+		std::vector<int> outputGateIDs_;													// PO/PPO in the order of gateID_to_reachableOutputs_
+		ParallelValue xOutputs_;																	// bits of the PO/PPO which are X, set by startXPathQuery
+		std::vector<std::pair<int, int>> xPathStack_;							// gateID and index of the next fanout for xPathTracing
+		std::vector<int> gateID_to_dominator_;										// immediate Dominator of the gate toward PO/PPO, totalGate_ if none
+		std::vector<std::vector<int>> gateID_to_uniquePath_;			// fanins of the Dominator reachable from the gate, see identifyGateUniquePath
 		std::vector<std::stack<int>> circuitLevel_to_EventStack_; // every circuit level has its own corresponding event stack
 		DecisionTree backtrackDecisionTree_;											// the whole tree store the order for later possible backtracking, DecisionTreeNode store the starting point in backtrackImplicatedGateIDs_
 		std::vector<int> backtrackImplicatedGateIDs_;							// backtrackImplicatedGateIDs_[backTrackPoint] = start point of associated gateID
@@ -97,17 +144,52 @@ namespace CoreNs
 		std::vector<int> dFrontiers_;															// D-frontier list
 		std::vector<int> isInEventStack_;													// 1 if a gate is in an event stack, 0 otherwise
 		Gate *firstTimeFrameHeadLine_;														// this parameter is for multiple time frame
+		int bridgeConstraintGateID_;															// the gate constrained while targeting a bridge fault, -1 if none
+		Value bridgeConstraintVal_;																// the value injected on bridgeConstraintGateID_
+		std::string checkpointFile_;															// checkpoint written during generatePatternSet, empty if none
+		double checkpointInterval_;																// seconds between two checkpoints
+		double timeBudget_;																				// seconds generatePatternSet may run, 0 if unlimited
+		bool isResuming_;																					// generatePatternSet continues from resumeCheckpoint_
+		bool isStoppedByTimeBudget_;															// the last generatePatternSet ran out of time
+		AtpgCheckpoint resumeCheckpoint_;													// checkpoint loaded by loadCheckpoint
+		bool isMultiFault_;																				// run multiFaultPatternGeneration before the scalar engine
+		bool isFaultCone_;																				// run generateSinglePatternOnFaultCone for stuck-at faults
+		std::vector<FaultCone *> faultCones_;											// cones of the latest fault sites, at most FAULT_CONE_CACHE_SIZE
+		std::vector<int> gateID_to_coneGateID_;										// scratch for FaultCone::extract
+		int numFaultConeUse_;																			// counts getFaultCone calls for the replacement of cones
+		std::vector<int> backtrackLimits_;												// backtrack limit of every phase of generatePatternSet
+		int backtrackLimit_;																			// backtrack limit of the current phase
+		int numWorker_;																						// threads running the phases after the first
+		double deadline_;																					// seconds generatePatternSet may search, 0 if unlimited
+		std::chrono::steady_clock::time_point deadlineTime_;			// deadline_ after the start of generatePatternSet
+		bool isStoppedByDeadline_;																// the last generatePatternSet reached the deadline
+		FAULT_ORDER faultOrder_;																	// order of the target faults by SCOAP testability
+		bool isScoapGuided_;																			// backtrace and D-frontier choices consult SCOAP
+		const Timing *pTiming_;																		// backtrace and D-frontier choices prefer long paths, NULL if not timed
 
 		// ---------------private methods----------------- //
 
 		void setupCircuitParameter();
 		void calculateGateDepthFromPO();
+		void calculateGateReachableOutputs();
+		void calSCOAP();
+		int calInputObservability(const Gate &gate, const int &faninIndex) const;
+		int calFaultTestability(const Fault &fault) const;
+		void orderFaultsByTestability(FaultPtrList &faultPtrList) const;
 		void identifyGateLineType();
 		void identifyGateDominator();
 		void identifyGateUniquePath();
 
 		void TransitionDelayFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults);
 		void StuckAtFaultATPG(FaultPtrList &faultListToGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults);
+		void BridgeFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults);
+		void multiFaultPatternGeneration(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor);
+		void parallelStuckAtFaultATPG(FaultPtrList &faultPtrListForGen, PatternProcessor *pPatternProcessor, int &numOfAtpgUntestableFaults);
+		void parallelStuckAtFaultWorker(const std::vector<Fault *> &faults, std::atomic<size_t> &nextFault, std::vector<SINGLE_PATTERN_GENERATION_STATUS> &results, std::vector<Pattern> &patterns) const;
+		inline bool isDeadlineReached() const;
+		inline bool isBacktrackLimitReached(const int &numOfBacktrack) const;
+		SINGLE_PATTERN_GENERATION_STATUS generateSinglePatternOnFaultCone(const Fault &targetFault);
+		FaultCone *getFaultCone(const int &siteGateID);
 
 		Gate *getGateForFaultActivation(const Fault &fault);
 		void setGateAtpgValAndRunImplication(Gate &gate, const Value &val);
@@ -144,6 +226,11 @@ namespace CoreNs
 
 		bool xPathExists(Gate *pGate);
 		bool xPathTracing(Gate *pGate);
+		inline void startXPathQuery();
+		inline void resetXPathStatus();
+		inline XPATH_STATE getXPathStatus(const int &gateID) const;
+		inline void setXPathStatus(const int &gateID, const XPATH_STATE &xPathStatus);
+		inline XPATH_STATE checkXPath(const int &gateID);
 
 		int setFaultyGate(Fault &fault);
 		Fault setFreeLineFaultyGate(Gate &gate);
@@ -154,6 +241,7 @@ namespace CoreNs
 		void initializeForMultipleBacktrace();
 		Gate *findEasiestInput(Gate *pGate, Value atpgValOfpGate);
 		Gate *findClosestToPO(std::vector<int> &gateVec, int &index);
+		Gate *findLongestPathToPO(std::vector<int> &gateVec, int &index);
 
 		IMPLICATION_STATUS evaluateAndSetGateAtpgVal(Gate *pGate);
 		IMPLICATION_STATUS evaluateAndSetFaultyGateAtpgVal(Gate *pGate);
@@ -162,9 +250,13 @@ namespace CoreNs
 		void staticTestCompressionByReverseFaultSimulation(PatternProcessor *pPatternProcessor, FaultPtrList &originalFaultList);
 
 		int setUpFirstTimeFrame(Fault &fault); // this function is for multiple time frame
+		int setBridgeConstraint();						 // this function is for bridge faults
 
 		inline Value evaluateGoodVal(Gate &gate);
 		inline Value evaluateFaultyVal(Gate &gate);
+		inline Rail evaluateRail(const Gate &gate, const int &faultyInput);
+		inline Rail getFaninRail(const Gate &gate, const int &faninIndex, const int &faultyInput);
+		inline Rail injectTargetFault(const Rail &rail);
 
 		inline void setGaten0n1(const int &gateID, const int &n0, const int &n1);
 
@@ -206,7 +298,6 @@ namespace CoreNs
 		// function not used or removed
 		void checkLevelInfo();																		// for debug use
 		std::string getValStr(Value val);													// for debug use
-		void calSCOAP();																					// heuristic not effective, currently not used, added by Wang Wei-Shen
 		void testClearFaultEffect(FaultPtrList &faultListToTest); // removed from generatePatternSet() for now seems like debug usage
 		void resetIsInEventStack();																// not used
 		void XFill(PatternProcessor *pPatternProcessor);					// redundant function, removed by wang
@@ -222,6 +313,8 @@ namespace CoreNs
 				gateID_to_reachableByTargetFault_(pCircuit->totalGate_),
 				gateID_to_lineType_(pCircuit->totalGate_, FREE_LINE),
 				gateID_to_xPathStatus_(pCircuit->totalGate_),
+				gateID_to_xPathStamp_(pCircuit->totalGate_, 0),
+				gateID_to_reachableOutputs_(pCircuit->totalGate_, PARA_H),
 				gateID_to_uniquePath_(pCircuit->totalGate_, std::vector<int>()),
 				circuitLevel_to_EventStack_(pCircuit->circuitLvl_)
 	{
@@ -235,79 +328,243 @@ namespace CoreNs
 		dFrontiers_.reserve(MAX_LIST_SIZE);
 		backtrackImplicatedGateIDs_.reserve(pCircuit->totalGate_);
 		firstTimeFrameHeadLine_ = NULL;
+		bridgeConstraintGateID_ = -1;
+		bridgeConstraintVal_ = X;
 		isInEventStack_.resize(pCircuit->totalGate_);
+		checkpointInterval_ = 0.0;
+		timeBudget_ = 0.0;
+		isResuming_ = false;
+		isStoppedByTimeBudget_ = false;
+		isMultiFault_ = false;
+		isFaultCone_ = false;
+		numFaultConeUse_ = 0;
+		backtrackLimits_.push_back(BACKTRACK_LIMIT);
+		backtrackLimit_ = BACKTRACK_LIMIT;
+		numWorker_ = 1;
+		xPathStamp_ = 0;
+		xPathResetStamp_ = 1;
+		xOutputs_ = PARA_H;
+		deadline_ = 0.0;
+		isStoppedByDeadline_ = false;
+		faultOrder_ = EXTRACTION_ORDER;
+		isScoapGuided_ = false;
+		pTiming_ = NULL;
+	}
+
+	inline Atpg::~Atpg()
+	{
+		for (FaultCone *pFaultCone : faultCones_)
+		{
+			delete pFaultCone;
+		}
+	}
+
+	inline void Atpg::setCheckpoint(const std::string &fname, const double &interval)
+	{
+		checkpointFile_ = fname;
+		checkpointInterval_ = interval;
+	}
+
+	inline void Atpg::setTimeBudget(const double &timeBudget)
+	{
+		timeBudget_ = timeBudget;
+	}
+
+	inline bool Atpg::isStoppedByTimeBudget() const
+	{
+		return isStoppedByTimeBudget_;
+	}
+
+	inline void Atpg::setMultiFault(const bool &isMultiFault)
+	{
+		isMultiFault_ = isMultiFault;
+	}
+
+	inline void Atpg::setFaultCone(const bool &isFaultCone)
+	{
+		isFaultCone_ = isFaultCone;
+	}
+
+	inline void Atpg::setBacktrackLimits(const std::vector<int> &backtrackLimits)
+	{
+		backtrackLimits_ = backtrackLimits;
+		backtrackLimit_ = backtrackLimits_[0];
+	}
+
+	inline void Atpg::setNumWorker(const int &numWorker)
+	{
+		numWorker_ = numWorker;
+	}
+
+	inline void Atpg::setDeadline(const double &deadline)
+	{
+		deadline_ = deadline;
+	}
+
+	inline void Atpg::setFaultOrder(const FAULT_ORDER &faultOrder)
+	{
+		faultOrder_ = faultOrder;
+	}
+
+	inline void Atpg::setScoapGuided(const bool &isScoapGuided)
+	{
+		isScoapGuided_ = isScoapGuided;
+	}
+
+	inline void Atpg::setTiming(const Timing *pTiming)
+	{
+		pTiming_ = pTiming;
+	}
+
+	inline bool Atpg::isStoppedByDeadline() const
+	{
+		return isStoppedByDeadline_;
+	}
+
+	inline bool Atpg::isDeadlineReached() const
+	{
+		return deadline_ > 0.0 && std::chrono::steady_clock::now() >= deadlineTime_;
+	}
+
+	// the deadline is checked together with the backtrack limit, so a
+	// search only stops where it would have counted a backtrack
+	inline bool Atpg::isBacktrackLimitReached(const int &numOfBacktrack) const
+	{
+		return numOfBacktrack > backtrackLimit_ || isDeadlineReached();
 	}
 
 	// **************************************************************************
-	// Function   [ Atpg::evaluateGoodVal ]
-	// Commenter  [ WYH WWS ]
-	// Synopsis   [ usage: Given the gate without fault, and generate the output,
-	//                     and return.
+	// Function   [ Atpg::evaluateRail ]
+	// Commenter  [ PYH ]
+	// Synopsis   [ usage: Evaluate a gate in dual-rail logic.
+	//
+	//              description:
+	// 								The fanin rails are folded with one bitwise operation
+	// 								each, so the fanin count does not matter and a D or B
+	// 								on an input propagates without case analysis. The
+	// 								N-input types take the same loops as the fixed ones.
 	//
 	//              arguments:
 	// 								[in] gate: The gate to evaluate.
+	// 								[in] faultyInput: Index of the fanin the target fault
+	// 								is injected on, -1 for none.
 	//
-	//              output: Evaluated value.
+	//              output: Evaluated rails of the gate output.
 	//            ]
-	// Date       [ WYH Ver. 1.0 started 2013/08/15 last modified 2023/01/06]
+	// Date       [ Ver. 1.0 started 2026/10/19 ]
 	// **************************************************************************
-	inline Value Atpg::evaluateGoodVal(Gate &gate)
+	inline Rail Atpg::evaluateRail(const Gate &gate, const int &faultyInput)
 	{
-		if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI)
+		if (gate.numFI_ == 0)
 		{
-			return gate.atpgVal_;
-		}
-
-		static Value v[4];
-		int index = 0;
-		for (const int &faninID : gate.faninVector_)
-		{
-			v[index++] = pCircuit_->circuitGates_[faninID].atpgVal_;
+			return valueToRail(gate.atpgVal_);
 		}
 
+		Rail out = getFaninRail(gate, 0, faultyInput);
 		switch (gate.gateType_)
 		{
-			case Gate::PO:
-			case Gate::PPO:
-			case Gate::BUF:
-				return v[0];
 			case Gate::INV:
-				return cINV(v[0]);
+				return railInv(out);
 			case Gate::AND2:
-				return cAND2(v[0], v[1]);
 			case Gate::AND3:
-				return cAND3(v[0], v[1], v[2]);
 			case Gate::AND4:
-				return cAND4(v[0], v[1], v[2], v[3]);
+			case Gate::ANDN:
 			case Gate::NAND2:
-				return cNAND2(v[0], v[1]);
 			case Gate::NAND3:
-				return cNAND3(v[0], v[1], v[2]);
 			case Gate::NAND4:
-				return cNAND4(v[0], v[1], v[2], v[3]);
+			case Gate::NANDN:
+				for (int i = 1; i < gate.numFI_; ++i)
+				{
+					out = railAnd(out, getFaninRail(gate, i, faultyInput));
+				}
+				break;
 			case Gate::OR2:
-				return cOR2(v[0], v[1]);
 			case Gate::OR3:
-				return cOR3(v[0], v[1], v[2]);
 			case Gate::OR4:
-				return cOR4(v[0], v[1], v[2], v[3]);
+			case Gate::ORN:
 			case Gate::NOR2:
-				return cNOR2(v[0], v[1]);
 			case Gate::NOR3:
-				return cNOR3(v[0], v[1], v[2]);
 			case Gate::NOR4:
-				return cNOR4(v[0], v[1], v[2], v[3]);
+			case Gate::NORN:
+				for (int i = 1; i < gate.numFI_; ++i)
+				{
+					out = railOr(out, getFaninRail(gate, i, faultyInput));
+				}
+				break;
 			case Gate::XOR2:
-				return cXOR2(v[0], v[1]);
 			case Gate::XOR3:
-				return cXOR3(v[0], v[1], v[2]);
+			case Gate::XORN:
 			case Gate::XNOR2:
-				return cXNOR2(v[0], v[1]);
 			case Gate::XNOR3:
-				return cXNOR3(v[0], v[1], v[2]);
+			case Gate::XNORN:
+				for (int i = 1; i < gate.numFI_; ++i)
+				{
+					out = railXor(out, getFaninRail(gate, i, faultyInput));
+				}
+				break;
+			case Gate::MUX: // fanins are IN0, IN1, CNT
+				return railMux(out, getFaninRail(gate, 1, faultyInput), getFaninRail(gate, 2, faultyInput));
 			default:
-				return v[0];
+				return out;
+		}
+		return gate.isInverse() == H ? railInv(out) : out;
+	}
+
+	// rails of fanin faninIndex of gate, with the target fault if it is on that fanin
+	inline Rail Atpg::getFaninRail(const Gate &gate, const int &faninIndex, const int &faultyInput)
+	{
+		const Rail rail = valueToRail(pCircuit_->circuitGates_[gate.faninVector_[faninIndex]].atpgVal_);
+		return faninIndex == faultyInput ? injectTargetFault(rail) : rail;
+	}
+
+	// **************************************************************************
+	// Function   [ Atpg::injectTargetFault ]
+	// Commenter  [ PYH ]
+	// Synopsis   [ usage: Force the faulty rail of currentTargetFault_.
+	//
+	//              arguments:
+	// 								[in] rail: Rails of the faulty line.
+	//
+	//              output: Rails with the faulty value stuck, unchanged for
+	// 								fault types without a stuck value.
+	//            ]
+	// Date       [ Ver. 1.0 started 2026/10/19 ]
+	// **************************************************************************
+	inline Rail Atpg::injectTargetFault(const Rail &rail)
+	{
+		switch (currentTargetFault_.faultType_)
+		{
+			case Fault::SA0:
+			case Fault::STR:
+				return railInject(rail, L);
+			case Fault::SA1:
+			case Fault::STF:
+				return railInject(rail, H);
+			default:
+				return rail;
+		}
+	}
+
+	// **************************************************************************
+	// Function   [ Atpg::evaluateGoodVal ]
+	// Commenter  [ WYH WWS ]
+	// Synopsis   [ usage: Given the gate without fault, and generate the output,
+	//                     and return.
+	//
+	//              arguments:
+	// 								[in] gate: The gate to evaluate.
+	//
+	//              output: Evaluated value.
+	//            ]
+	// Date       [ WYH Ver. 1.0 started 2013/08/15 last modified 2026/10/19]
+	// **************************************************************************
+	inline Value Atpg::evaluateGoodVal(Gate &gate)
+	{
+		if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI)
+		{
+			return gate.atpgVal_;
 		}
+		return railToValue(evaluateRail(gate, -1));
 	}
 
 	// **************************************************************************
@@ -316,398 +573,97 @@ namespace CoreNs
 	// Synopsis   [ usage: Given the gate with fault, and generate the output,
 	//                     and return.
 	//
+	// 							description:
+	// 								The fault is injected on the output rails for faultyLine_
+	// 								0 and on the rails of fanin faultyLine_ - 1 otherwise.
+	//
 	//              arguments:
 	// 								[in] gate: The gate to evaluate.
 	//
 	//              output: Evaluated value.
 	//            ]
-	// Date       [ Ver. 1.0 started 2013/08/13 last modified 2023/01/06 ]
+	// Date       [ Ver. 1.0 started 2013/08/13 last modified 2026/10/19 ]
 	// **************************************************************************
 	inline Value Atpg::evaluateFaultyVal(Gate &gate)
 	{
-		Value val;
+		if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI || gate.numFI_ == 0)
+		{
+			return gate.atpgVal_;
+		}
 		const int &faultyLine = currentTargetFault_.faultyLine_;
-		switch (gate.gateType_)
+		if (faultyLine == 0)
 		{
-			case Gate::PI:
-			case Gate::PPI:
-				return gate.atpgVal_;
-			case Gate::PO:
-			case Gate::PPO:
-			case Gate::BUF:
-				val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-				if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-				{
-					val = B; // logic D' (0/1)
-				}
-				if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-				{
-					val = D; // logic D  (1/0)
-				}
-				return val;
-			case Gate::INV:
-				val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-				if (faultyLine == 0)
-				{
-					val = cINV(val);
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-					return val;
-				}
-				else
-				{
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-					return cINV(val);
-				}
-			case Gate::AND2:
-			case Gate::AND3:
-			case Gate::AND4:
-				if (faultyLine == 0)
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-					for (int i = 1; i < gate.numFI_; ++i)
-					{
-						val = cAND2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-					}
-
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-
-					for (int i = 0; i < gate.numFI_; ++i)
-					{
-						if (i != faultyLine - 1)
-						{
-							val = cAND2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-						}
-					}
-				}
-				return val;
-			case Gate::NAND2:
-			case Gate::NAND3:
-			case Gate::NAND4:
-				if (faultyLine == 0)
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-					for (int i = 1; i < gate.numFI_; ++i)
-					{
-						val = cAND2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-					}
-
-					val = cINV(val);
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-
-					for (int i = 0; i < gate.numFI_; ++i)
-					{
-						if (i != faultyLine - 1)
-						{
-							val = cAND2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-						}
-					}
-					val = cINV(val);
-				}
-				return val;
-			case Gate::OR2:
-			case Gate::OR3:
-			case Gate::OR4:
-				if (faultyLine == 0)
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-					for (int i = 1; i < gate.numFI_; ++i)
-					{
-						val = cOR2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-					}
-
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-
-					for (int i = 0; i < gate.numFI_; ++i)
-					{
-						if (i != faultyLine - 1)
-						{
-							val = cOR2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-						}
-					}
-				}
-				return val;
-			case Gate::NOR2:
-			case Gate::NOR3:
-			case Gate::NOR4:
-				if (faultyLine == 0)
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_;
-					for (int i = 1; i < gate.numFI_; ++i)
-					{
-						val = cOR2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-					}
-
-					val = cINV(val);
-
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-					for (int i = 0; i < gate.numFI_; ++i)
-					{
-						if (i != faultyLine - 1)
-						{
-							val = cOR2(val, pCircuit_->circuitGates_[gate.faninVector_[i]].atpgVal_);
-						}
-					}
-					val = cINV(val);
-				}
-				return val;
-			case Gate::XOR2:
-			case Gate::XOR3:
-				if (faultyLine == 0)
-				{
-					if (gate.gateType_ == Gate::XOR2)
-					{
-						val = cXOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_);
-					}
-					else
-					{
-						val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_);
-					}
-
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-
-					if (gate.gateType_ == Gate::XOR2)
-					{
-						// if (faultyLine - 1 == 0)
-						// 	val = cXOR2(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, val);
-						// else
-						// 	val = cXOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-						switch (faultyLine - 1)
-						{
-							case 0:
-								val = cXOR2(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, val);
-								break;
-							case 1:
-								val = cXOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-								break;
-							default:
-								std::cerr << "switch case default, should not happen\n";
-								break;
-						}
-					}
-					else
-					{ // XOR3
-						// if (faultyLine - 1 == 0)
-						// 	val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-						// else if (faultyLine - 1 == 1)
-						// 	val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-						// else
-						// 	val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-						switch (faultyLine - 1)
-						{
-							case 0:
-								val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-								break;
-							case 1:
-								val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-								break;
-							case 2:
-								val = cXOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-								break;
-							default:
-								std::cerr << "switch case default, should not happen\n";
-								break;
-						}
-					}
-				}
-				return val;
-			case Gate::XNOR2:
-			case Gate::XNOR3:
-				if (faultyLine == 0)
-				{
-					if (gate.gateType_ == Gate::XNOR2)
-					{
-						val = cXNOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_);
-					}
-					else
-					{
-						val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_);
-					}
-
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-				}
-				else
-				{
-					val = pCircuit_->circuitGates_[gate.faninVector_[faultyLine - 1]].atpgVal_;
-					if (val == L && (currentTargetFault_.faultType_ == Fault::SA1 || currentTargetFault_.faultType_ == Fault::STF))
-					{
-						val = B;
-					}
-					if (val == H && (currentTargetFault_.faultType_ == Fault::SA0 || currentTargetFault_.faultType_ == Fault::STR))
-					{
-						val = D;
-					}
-
-					if (gate.gateType_ == Gate::XNOR2)
-					{
-						// if (faultyLine - 1 == 0)
-						// 	val = cXNOR2(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, val);
-						// else
-						// 	val = cXNOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-						switch (faultyLine - 1)
-						{
-							case 0:
-								val = cXNOR2(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, val);
-								break;
-							case 1:
-								val = cXNOR2(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-								break;
-							default:
-								std::cerr << "switch case default, should not happen\n";
-								break;
-						}
-					}
-					else
-					{ // XOR3
-						// change from if else to switch by wang
-						// if (faultyLine - 1 == 0)
-						// 	val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-						// else if (faultyLine - 1 == 1)
-						// 	val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-						// else
-						// 	val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-						switch (faultyLine - 1)
-						{
-							case 0:
-								val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-								break;
-							case 1:
-								val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[2]].atpgVal_, val);
-								break;
-							case 2:
-								val = cXNOR3(pCircuit_->circuitGates_[gate.faninVector_[1]].atpgVal_, pCircuit_->circuitGates_[gate.faninVector_[0]].atpgVal_, val);
-								break;
-							default:
-								std::cerr << "switch case default, should not happen\n";
-								break;
-						}
-					}
-				}
-				return val;
-			default:
-				return gate.atpgVal_;
+			return railToValue(injectTargetFault(evaluateRail(gate, -1)));
+		}
+		return railToValue(evaluateRail(gate, faultyLine - 1));
+	}
+
+	// Every X-path query starts with a new stamp. An XPATH_EXIST status is
+	// valid for its own query only, values may have been assigned since. A
+	// NO_XPATH_EXIST status stays valid until resetXPathStatus, values only
+	// get assigned until the next backtrack.
+	inline void Atpg::startXPathQuery()
+	{
+		if (xPathStamp_ == std::numeric_limits<int>::max())
+		{
+			std::fill(gateID_to_xPathStamp_.begin(), gateID_to_xPathStamp_.end(), 0);
+			xPathStamp_ = 0;
+			xPathResetStamp_ = 1;
 		}
+		++xPathStamp_;
+
+		xOutputs_ = outputGateIDs_.empty() ? PARA_H : PARA_L;
+		for (size_t k = 0; k < outputGateIDs_.size(); ++k)
+		{
+			if (pCircuit_->circuitGates_[outputGateIDs_[k]].atpgVal_ == X)
+			{
+				setBitValue(xOutputs_, k % WORD_SIZE, H);
+			}
+		}
+	}
+
+	inline void Atpg::resetXPathStatus()
+	{
+		xPathResetStamp_ = xPathStamp_ + 1;
+	}
+
+	inline Atpg::XPATH_STATE Atpg::getXPathStatus(const int &gateID) const
+	{
+		const int &stamp = gateID_to_xPathStamp_[gateID];
+		if (stamp < xPathResetStamp_ || (gateID_to_xPathStatus_[gateID] == XPATH_EXIST && stamp != xPathStamp_))
+		{
+			return UNKNOWN;
+		}
+		return gateID_to_xPathStatus_[gateID];
+	}
+
+	inline void Atpg::setXPathStatus(const int &gateID, const XPATH_STATE &xPathStatus)
+	{
+		gateID_to_xPathStatus_[gateID] = xPathStatus;
+		gateID_to_xPathStamp_[gateID] = xPathStamp_;
+	}
+
+	// settle the X-path status of a gate without looking at its fanouts
+	// if possible, UNKNOWN otherwise
+	inline Atpg::XPATH_STATE Atpg::checkXPath(const int &gateID)
+	{
+		const XPATH_STATE xPathStatus = getXPathStatus(gateID);
+		if (xPathStatus != UNKNOWN)
+		{
+			return xPathStatus;
+		}
+		const Gate &gate = pCircuit_->circuitGates_[gateID];
+		if (gate.atpgVal_ != X || (gateID_to_reachableOutputs_[gateID] & xOutputs_) == PARA_L)
+		{
+			setXPathStatus(gateID, NO_XPATH_EXIST);
+			return NO_XPATH_EXIST;
+		}
+		if (gate.gateType_ == Gate::PO || gate.gateType_ == Gate::PPO)
+		{
+			setXPathStatus(gateID, XPATH_EXIST);
+			return XPATH_EXIST;
+		}
+		return UNKNOWN;
 	}
 
 	inline void Atpg::setGaten0n1(const int &gateID, const int &n0, const int &n1)
@@ -885,37 +841,22 @@ namespace CoreNs
 		list.pop_back();
 	}
 
-	// 5-value logic evaluation functions
+	// 5-value logic evaluation functions, computed on the dual-rail encoding
 	inline Value Atpg::cINV(const Value &i1)
 	{
-		constexpr Value map[5] = {H, L, X, B, D};
-		if (i1 >= Z)
-		{
-			return Z;
-		}
-		return map[i1];
+		return railToValue(railInv(valueToRail(i1)));
 	}
 	inline Value Atpg::cAND2(const Value &i1, const Value &i2)
 	{
-		constexpr Value map[5][5] = {
-				{L, L, L, L, L},
-				{L, H, X, D, B},
-				{L, X, X, X, X},
-				{L, D, X, D, L},
-				{L, B, X, L, B}};
-		if (i1 >= Z || i2 >= Z)
-		{
-			return Z;
-		}
-		return map[i1][i2];
+		return railToValue(railAnd(valueToRail(i1), valueToRail(i2)));
 	}
 	inline Value Atpg::cAND3(const Value &i1, const Value &i2, const Value &i3)
 	{
-		return cAND2(i1, cAND2(i2, i3));
+		return railToValue(railAnd(valueToRail(i1), railAnd(valueToRail(i2), valueToRail(i3))));
 	}
 	inline Value Atpg::cAND4(const Value &i1, const Value &i2, const Value &i3, const Value &i4)
 	{
-		return cAND2(cAND2(i1, i2), cAND2(i3, i4));
+		return railToValue(railAnd(railAnd(valueToRail(i1), valueToRail(i2)), railAnd(valueToRail(i3), valueToRail(i4))));
 	}
 	inline Value Atpg::cNAND2(const Value &i1, const Value &i2)
 	{
@@ -931,25 +872,15 @@ namespace CoreNs
 	}
 	inline Value Atpg::cOR2(const Value &i1, const Value &i2)
 	{
-		constexpr Value map[5][5] = {
-				{L, H, X, D, B},
-				{H, H, H, H, H},
-				{X, H, X, X, X},
-				{D, H, X, D, H},
-				{B, H, X, H, B}};
-		if (i1 >= Z || i2 >= Z)
-		{
-			return Z;
-		}
-		return map[i1][i2];
+		return railToValue(railOr(valueToRail(i1), valueToRail(i2)));
 	}
 	inline Value Atpg::cOR3(const Value &i1, const Value &i2, const Value &i3)
 	{
-		return cOR2(i1, cOR2(i2, i3));
+		return railToValue(railOr(valueToRail(i1), railOr(valueToRail(i2), valueToRail(i3))));
 	}
 	inline Value Atpg::cOR4(const Value &i1, const Value &i2, const Value &i3, const Value &i4)
 	{
-		return cOR2(cOR2(i1, i2), cOR2(i3, i4));
+		return railToValue(railOr(railOr(valueToRail(i1), valueToRail(i2)), railOr(valueToRail(i3), valueToRail(i4))));
 	}
 	inline Value Atpg::cNOR2(const Value &i1, const Value &i2)
 	{
@@ -965,21 +896,11 @@ namespace CoreNs
 	}
 	inline Value Atpg::cXOR2(const Value &i1, const Value &i2)
 	{
-		constexpr Value map[5][5] = {
-				{L, H, X, D, B},
-				{H, L, X, B, D},
-				{X, X, X, X, X},
-				{D, B, X, L, H},
-				{B, D, X, H, L}};
-		if (i1 >= Z || i2 >= Z)
-		{
-			return Z;
-		}
-		return map[i1][i2];
+		return railToValue(railXor(valueToRail(i1), valueToRail(i2)));
 	}
 	inline Value Atpg::cXOR3(const Value &i1, const Value &i2, const Value &i3)
 	{
-		return cXOR2(i1, cXOR2(i2, i3));
+		return railToValue(railXor(valueToRail(i1), railXor(valueToRail(i2), valueToRail(i3))));
 	}
 	inline Value Atpg::cXNOR2(const Value &i1, const Value &i2)
 	{
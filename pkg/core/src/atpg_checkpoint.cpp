@@ -0,0 +1,251 @@
+// **************************************************************************
+// File       [ atpg_checkpoint.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ write and restore checkpoints of pattern generation ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+#include "atpg_checkpoint.h"
+#include "fault_rw.h"
+
+using namespace CoreNs;
+
+static const char CHECKPOINT_MAGIC[4] = {'F', 'A', 'N', 'C'};
+static const uint32_t CHECKPOINT_VERSION = 2;
+
+template <class T>
+static bool writeVal(FILE *fout, const T &val)
+{
+	return fwrite(&val, sizeof(T), 1, fout) == 1;
+}
+
+template <class T>
+static bool readVal(FILE *fin, T &val)
+{
+	return fread(&val, sizeof(T), 1, fin) == 1;
+}
+
+static bool writeValues(FILE *fout, const std::vector<Value> &values)
+{
+	const uint32_t size = values.size();
+	return writeVal(fout, size) && (size == 0 || fwrite(&values[0], sizeof(Value), size, fout) == size);
+}
+
+static bool readValues(FILE *fin, std::vector<Value> &values)
+{
+	uint32_t size;
+	// a pattern never holds more values than the circuit has gates, the
+	// bound keeps a corrupted size from allocating the whole memory
+	if (!readVal(fin, size) || size > (1u << 28))
+	{
+		return false;
+	}
+	values.resize(size);
+	return size == 0 || fread(&values[0], sizeof(Value), size, fin) == size;
+}
+
+static bool writeFaultIndices(FILE *fout, const FaultPtrList &faults, const std::map<const Fault *, uint32_t> &faultToIndex)
+{
+	const uint32_t size = faults.size();
+	bool isGood = writeVal(fout, size);
+	for (const Fault *pFault : faults)
+	{
+		isGood = isGood && writeVal(fout, faultToIndex.find(pFault)->second);
+	}
+	return isGood;
+}
+
+static bool readFaultIndices(FILE *fin, FaultPtrList &faults, const std::vector<Fault *> &indexToFault)
+{
+	uint32_t size;
+	if (!readVal(fin, size) || size > indexToFault.size())
+	{
+		return false;
+	}
+	faults.clear();
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		uint32_t index;
+		if (!readVal(fin, index) || index >= indexToFault.size())
+		{
+			return false;
+		}
+		faults.push_back(indexToFault[index]);
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ AtpgCheckpoint::write ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write the checkpoint together with the fault states
+//              	and the patterns generated so far.
+//              description:
+//              	The checkpoint is written to a temporary file which is
+//              	synced and renamed over fname, so a run killed while
+//              	writing leaves the previous checkpoint intact.
+//              arguments:
+//              	[in] fname : The checkpoint file.
+//              	[in] pFaultListExtract : The fault list being targeted.
+//              	[in] pPatternProcessor : The patterns generated so far.
+//              	[out] bool : False if the checkpoint cannot be written.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool AtpgCheckpoint::write(const char *const fname, FaultListExtract *pFaultListExtract, const PatternProcessor *pPatternProcessor) const
+{
+	const std::string tmpName = std::string(fname) + ".tmp";
+	FILE *fout = fopen(tmpName.c_str(), "wb");
+	if (!fout)
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::write(): cannot open `";
+		std::cerr << tmpName << "'\n";
+		return false;
+	}
+
+	std::map<const Fault *, uint32_t> faultToIndex;
+	const uint32_t numFault = pFaultListExtract->faultsInCircuit_.size();
+	bool isGood = fwrite(CHECKPOINT_MAGIC, 1, 4, fout) == 4 &&
+								writeVal(fout, CHECKPOINT_VERSION) &&
+								writeVal(fout, (uint32_t)pFaultListExtract->faultListType_) &&
+								writeVal(fout, numFault) &&
+								writeVal(fout, getFaultListSignature(pFaultListExtract));
+	for (const Fault *pFault : pFaultListExtract->faultsInCircuit_)
+	{
+		const uint32_t index = faultToIndex.size();
+		faultToIndex[pFault] = index;
+		isGood = isGood && writeVal(fout, (uint8_t)pFault->faultState_) && writeVal(fout, (uint32_t)pFault->detection_);
+	}
+
+	const int32_t currentFault = pCurrentFault_ ? (int32_t)faultToIndex[pCurrentFault_] : -1;
+	isGood = isGood && writeVal(fout, currentFault) && writeVal(fout, (int32_t)numOfAtpgUntestableFaults_) &&
+					 writeVal(fout, (int32_t)phase_) && writeVal(fout, (int32_t)backtrackLimit_) &&
+					 writeFaultIndices(fout, targetFaults_, faultToIndex) &&
+					 writeFaultIndices(fout, stcFaults_, faultToIndex) &&
+					 writeVal(fout, (uint32_t)pPatternProcessor->patternVector_.size());
+	for (const Pattern &pattern : pPatternProcessor->patternVector_)
+	{
+		isGood = isGood && writeValues(fout, pattern.PI1_) && writeValues(fout, pattern.PI2_) &&
+						 writeValues(fout, pattern.PPI_) && writeValues(fout, pattern.SI_) &&
+						 writeValues(fout, pattern.PO1_) && writeValues(fout, pattern.PO2_) &&
+						 writeValues(fout, pattern.PPO_);
+	}
+
+	isGood = isGood && fflush(fout) == 0 && fsync(fileno(fout)) == 0;
+	isGood = fclose(fout) == 0 && isGood;
+	if (!isGood || rename(tmpName.c_str(), fname) != 0)
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::write(): cannot write `";
+		std::cerr << fname << "'\n";
+		remove(tmpName.c_str());
+		return false;
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ AtpgCheckpoint::read ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Restore a checkpoint written by AtpgCheckpoint::write.
+//              description:
+//              	The fault list must be the one the checkpoint was taken
+//              	from, checked by its type, size and signature. The fault
+//              	states and detections are restored in place and the
+//              	patterns replace those of pPatternProcessor.
+//              arguments:
+//              	[in] fname : The checkpoint file.
+//              	[in, out] pFaultListExtract : The fault list to restore.
+//              	[out] pPatternProcessor : Receives the patterns.
+//              	[out] bool : False if the file is unreadable or mismatched.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool AtpgCheckpoint::read(const char *const fname, FaultListExtract *pFaultListExtract, PatternProcessor *pPatternProcessor)
+{
+	FILE *fin = fopen(fname, "rb");
+	if (!fin)
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::read(): cannot open `";
+		std::cerr << fname << "'\n";
+		return false;
+	}
+
+	char magic[4];
+	uint32_t version, faultListType, numFault;
+	uint64_t signature;
+	if (fread(magic, 1, 4, fin) != 4 || memcmp(magic, CHECKPOINT_MAGIC, 4) != 0 ||
+			!readVal(fin, version) || version != CHECKPOINT_VERSION ||
+			!readVal(fin, faultListType) || !readVal(fin, numFault) || !readVal(fin, signature))
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::read(): `" << fname;
+		std::cerr << "' is not an ATPG checkpoint\n";
+		fclose(fin);
+		return false;
+	}
+	if (faultListType != (uint32_t)pFaultListExtract->faultListType_ ||
+			numFault != pFaultListExtract->faultsInCircuit_.size() ||
+			signature != getFaultListSignature(pFaultListExtract))
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::read(): `" << fname;
+		std::cerr << "' was written for a different fault list\n";
+		fclose(fin);
+		return false;
+	}
+
+	// everything is read before anything is restored, so a truncated
+	// checkpoint leaves the fault list and the patterns untouched
+	std::vector<Fault *> indexToFault(pFaultListExtract->faultsInCircuit_.begin(), pFaultListExtract->faultsInCircuit_.end());
+	std::vector<uint8_t> states(numFault);
+	std::vector<uint32_t> detections(numFault);
+	bool isGood = true;
+	for (uint32_t i = 0; i < numFault && isGood; ++i)
+	{
+		isGood = readVal(fin, states[i]) && states[i] <= Fault::AB && readVal(fin, detections[i]);
+	}
+	int32_t currentFault, numOfAtpgUntestableFaults, phase, backtrackLimit;
+	uint32_t numPattern;
+	isGood = isGood && readVal(fin, currentFault) && currentFault >= -1 && currentFault < (int32_t)numFault &&
+					 readVal(fin, numOfAtpgUntestableFaults) &&
+					 readVal(fin, phase) && phase >= 0 && readVal(fin, backtrackLimit) &&
+					 readFaultIndices(fin, targetFaults_, indexToFault) &&
+					 readFaultIndices(fin, stcFaults_, indexToFault) &&
+					 readVal(fin, numPattern);
+	std::vector<Pattern> patterns;
+	for (uint32_t i = 0; i < numPattern && isGood; ++i)
+	{
+		patterns.push_back(Pattern());
+		Pattern &pattern = patterns.back();
+		isGood = readValues(fin, pattern.PI1_) && readValues(fin, pattern.PI2_) &&
+						 readValues(fin, pattern.PPI_) && readValues(fin, pattern.SI_) &&
+						 readValues(fin, pattern.PO1_) && readValues(fin, pattern.PO2_) &&
+						 readValues(fin, pattern.PPO_) &&
+						 pattern.PI1_.size() == (size_t)pPatternProcessor->numPI_ &&
+						 pattern.PPI_.size() == (size_t)pPatternProcessor->numPPI_;
+	}
+	fclose(fin);
+	if (!isGood)
+	{
+		std::cerr << "**ERROR AtpgCheckpoint::read(): `" << fname;
+		std::cerr << "' is truncated or corrupted\n";
+		return false;
+	}
+
+	for (uint32_t i = 0; i < numFault; ++i)
+	{
+		indexToFault[i]->faultState_ = (Fault::FAULT_STATE)states[i];
+		indexToFault[i]->detection_ = detections[i];
+	}
+	pCurrentFault_ = currentFault >= 0 ? indexToFault[currentFault] : NULL;
+	numOfAtpgUntestableFaults_ = numOfAtpgUntestableFaults;
+	phase_ = phase;
+	backtrackLimit_ = backtrackLimit;
+	pPatternProcessor->patternVector_.swap(patterns);
+	return true;
+}
@@ -48,6 +48,10 @@ bool Circuit::buildCircuit(Netlist *const pNetlist, const int &numFrame,
 	pNetlist->levelize();
 	techlib->levelize();
 
+	// Reduce the library cells to primitive networks, after levelize has
+	// put the primitives in their final order.
+	compileCellModels();
+
 	// Map the netlist to the circuit.
 	mapNetlistToCircuit();
 
@@ -62,6 +66,115 @@ bool Circuit::buildCircuit(Netlist *const pNetlist, const int &numFrame,
 	return true;
 }
 
+// **************************************************************************
+// Function   [ Circuit::compileCellModels ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Reduce every library cell to its primitive network.
+//              description:
+//              	Walk the nets of each library cell once and record, for
+//              	every primitive, its gate type, its fanins in the order
+//              	the nets list them and where its output goes. This is
+//              	the walk createCircuitPmt() used to do for every instance.
+//              	hasPmt() and getPortCells() are answered here as well,
+//              	they were asked once per instance and per PO and PPO.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Circuit::compileCellModels()
+{
+	Techlib *techlib = pNetlist_->getTechlib();
+
+	cellModels_.clear();
+	cellModels_.resize(techlib->getNCell());
+	for (int i = 0; i < (int)techlib->getNCell(); ++i)
+	{
+		const Cell *libCell = techlib->getCell(i);
+		CellModel &model = cellModels_[i];
+		model.isSeq_ = techlib->hasPmt(i, Pmt::DFF);
+		model.portToPmt_.assign(libCell->getNPort(), -1);
+		for (int j = 0; j < (int)libCell->getNPort(); ++j)
+		{
+			CellSet cs = libCell->getPortCells(j);
+			if (!cs.empty())
+			{
+				model.portToPmt_[j] = (*cs.begin())->id_;
+			}
+		}
+
+		const int numPmt = (int)libCell->getNCell();
+		model.gateTypes_.assign(numPmt, Gate::NA);
+		model.fanins_.resize(numPmt);
+		model.numInternalFanout_.assign(numPmt, 0);
+		model.outputPorts_.resize(numPmt);
+		for (int j = 0; j < numPmt; ++j)
+		{
+			const Cell *sub = libCell->getCell(j);
+			if (!sub->isPmt_)
+			{
+				continue;
+			}
+			const Pmt *pmt = (const Pmt *)sub;
+			model.gateTypes_[j] = determineGateType(pmt);
+
+			Port *outp = NULL;
+			for (int k = 0; k < (int)pmt->getNPort(); ++k)
+			{
+				Port *pmtPort = pmt->getPort(k);
+				if (pmtPort->type_ != Port::INPUT)
+				{
+					if (pmtPort->type_ == Port::OUTPUT && !outp)
+					{
+						outp = pmtPort;
+					}
+					continue;
+				}
+				// unconnected inputs only occur on flip-flops and latches
+				Net *nin = pmtPort->exNet_;
+				for (int l = 0; nin && l < (int)nin->getNPort(); ++l)
+				{
+					Port *port = nin->getPort(l);
+					if (port == pmtPort)
+					{
+						continue;
+					}
+					CellModel::Fanin fanin;
+					fanin.type_ = CellModel::NONE;
+					fanin.id_ = 0;
+					if (port->type_ == Port::OUTPUT && port->top_ != libCell)
+					{
+						fanin.type_ = CellModel::PMT;
+						fanin.id_ = port->top_->id_;
+					}
+					else if (port->type_ == Port::INPUT && port->top_ == libCell)
+					{
+						fanin.type_ = CellModel::PORT;
+						fanin.id_ = port->id_;
+					}
+					model.fanins_[j].push_back(fanin);
+				}
+			}
+
+			if (!outp || !outp->exNet_)
+			{
+				continue;
+			}
+			PortSet ps = libCell->getNetPorts(outp->exNet_->id_);
+			PortSet::iterator it = ps.begin();
+			for (; it != ps.end(); ++it)
+			{
+				if ((*it)->top_ != libCell && (*it)->top_ != pmt)
+				{
+					++model.numInternalFanout_[j];
+				}
+				else if ((*it)->top_ == libCell)
+				{
+					model.outputPorts_[j].push_back((*it)->id_);
+				}
+			}
+		}
+	}
+}
+
 // **************************************************************************
 // Function   [ Circuit::mapNetlistToCircuit ]
 // Commenter  [ littleshamoo, PYH ]
@@ -96,7 +209,6 @@ void Circuit::mapNetlistToCircuit()
 void Circuit::calculateNumGate()
 {
 	Cell *top = pNetlist_->getTop();
-	Techlib *techlib = pNetlist_->getTechlib();
 
 	numGate_ = 0; // number of gates
 
@@ -124,7 +236,7 @@ void Circuit::calculateNumGate()
 	{
 		cellIndexToGateIndex_[i] = numGate_;
 
-		if (techlib->hasPmt(top->getCell(i)->libc_->id_, Pmt::DFF)) // D flip flop, indicates a PPI (PPO).
+		if (cellModels_[top->getCell(i)->libc_->id_].isSeq_) // D flip flop, indicates a PPI (PPO).
 		{
 			++numPPI_;
 			++numGate_;
@@ -169,7 +281,6 @@ void Circuit::calculateNumGate()
 void Circuit::calculateNumNet()
 {
 	Cell *top = pNetlist_->getTop();
-	Techlib *techlib = pNetlist_->getTechlib();
 
 	numNet_ = 0;
 
@@ -197,7 +308,7 @@ void Circuit::calculateNumNet()
 	for (int i = 0; i < (int)top->getNCell(); ++i)
 	{
 		Cell *cellInTop = top->getCell(i);
-		if (!techlib->hasPmt(cellInTop->typeName_, Pmt::DFF))
+		if (!cellModels_[cellInTop->libc_->id_].isSeq_)
 		{
 			numNet_ += cellInTop->libc_->getNNet() - cellInTop->libc_->getNPort();
 		}
@@ -319,8 +430,7 @@ void Circuit::createCircuitComb()
 			circuitGates_[combGateID].cellId_ = cellInTop->id_;
 			circuitGates_[combGateID].primitiveId_ = j;
 
-			Pmt *pmt = (Pmt *)cellInTop->libc_->getCell(j);
-			createCircuitPmt(combGateID, cellInTop, pmt);
+			createCircuitPmt(combGateID, cellInTop, j);
 		}
 	}
 	if ((int)top->getNCell() > 0)
@@ -336,108 +446,80 @@ void Circuit::createCircuitComb()
 //              description:
 //              	Primitive is from Mentor .mdt . We have the relationship
 //              	cell => primitive => gate. But primitive is not actually in
-//              	our data structure. We then use the primitive to create the gate.
+//              	our data structure. The gate is created from the model of
+//              	the library cell, only the fanins and fanouts leaving the
+//              	cell are looked up in the netlist.
 //              arguments:
 //              	[in] gateID : The gateID of the gate we are going to create.
 //              	[in] cell : The cell which the gate located at.
-//              	[in] pmt : The primitive. It is an intermediate data type
-//              	           between cell and gate. We create the gate from
-//              	           this primitive.
+//              	[in] pmtID : The primitive in the library cell of the cell.
 //            ]
-// Date       [ Ver. 1.0 started 2013/08/11 last modified 2023/01/05 ]
+// Date       [ Ver. 1.0 started 2013/08/11 last modified 2026/10/19 ]
 // **************************************************************************
 void Circuit::createCircuitPmt(const int &gateID, const Cell *const cell,
-                               const Pmt *const pmt)
+                               const int &pmtID)
 {
+	const CellModel &model = cellModels_[cell->libc_->id_];
+	const std::vector<CellModel::Fanin> &fanins = model.fanins_[pmtID];
+
 	// Determine gate type.
-	determineGateType(gateID, cell, pmt);
+	circuitGates_[gateID].gateType_ = model.gateTypes_[pmtID];
 
 	// Determine fanin and level.
 	int maxLvl = -1;
-	for (int i = 0; i < (int)pmt->getNPort(); ++i)
+	circuitGates_[gateID].faninVector_.reserve(fanins.size());
+	for (const CellModel::Fanin &fanin : fanins)
 	{
-		if (pmt->getPort(i)->type_ != Port::INPUT)
+		int faninID = 0;
+		// Internal connection.
+		if (fanin.type_ == CellModel::PMT)
 		{
-			continue;
+			faninID = cellIndexToGateIndex_[cell->id_] + fanin.id_;
 		}
-		Net *nin = pmt->getPort(i)->exNet_;
-		circuitGates_[gateID].faninVector_.reserve(nin->getNPort());
-		for (int j = 0; j < (int)nin->getNPort(); ++j)
+		else if (fanin.type_ == CellModel::PORT) // External connection.
 		{
-			Port *port = nin->getPort(j);
-			if (port == pmt->getPort(i))
-			{
-				continue;
-			}
-
-			int faninID = 0;
-			// Internal connection.
-			if (port->type_ == Port::OUTPUT && port->top_ != cell->libc_)
-			{
-				faninID = cellIndexToGateIndex_[cell->id_] + port->top_->id_;
-			}
-			else if (port->type_ == Port::INPUT && port->top_ == cell->libc_) // External connection.
+			Net *nex = cell->getPort(fanin.id_)->exNet_;
+			PortSet ps = cell->top_->getNetPorts(nex->id_);
+			PortSet::iterator it = ps.begin();
+			for (; it != ps.end(); ++it)
 			{
-				Net *nex = cell->getPort(port->id_)->exNet_;
-				PortSet ps = cell->top_->getNetPorts(nex->id_);
-				PortSet::iterator it = ps.begin();
-				for (; it != ps.end(); ++it)
+				Cell *cin = (*it)->top_;
+				if ((*it)->type_ == Port::OUTPUT && cin != cell->top_)
 				{
-					Cell *cin = (*it)->top_;
-					if ((*it)->type_ == Port::OUTPUT && cin != cell->top_)
+					const CellModel &faninModel = cellModels_[cin->libc_->id_];
+					faninID = cellIndexToGateIndex_[cin->id_];
+					if (faninModel.isSeq_) // NE
 					{
-						CellSet cs = cin->libc_->getPortCells((*it)->id_);
-						faninID = cellIndexToGateIndex_[cin->id_];
-						if (pNetlist_->getTechlib()->hasPmt(cin->libc_->id_, Pmt::DFF)) // NE
-						{
-							break;
-						}
-						faninID += (*cs.begin())->id_;
-						break;
-					}
-					else if ((*it)->type_ == Port::INPUT && cin == cell->top_)
-					{
-						faninID = portIndexToGateIndex_[(*it)->id_];
 						break;
 					}
+					faninID += faninModel.portToPmt_[(*it)->id_];
+					break;
+				}
+				else if ((*it)->type_ == Port::INPUT && cin == cell->top_)
+				{
+					faninID = portIndexToGateIndex_[(*it)->id_];
+					break;
 				}
 			}
-			circuitGates_[gateID].faninVector_.push_back(faninID);
-			++circuitGates_[gateID].numFI_;
-			circuitGates_[faninID].fanoutVector_.push_back(gateID);
-			++circuitGates_[faninID].numFO_;
+		}
+		circuitGates_[gateID].faninVector_.push_back(faninID);
+		++circuitGates_[gateID].numFI_;
+		circuitGates_[faninID].fanoutVector_.push_back(gateID);
+		++circuitGates_[faninID].numFO_;
 
-			if (circuitGates_[faninID].numLevel_ > maxLvl)
-			{
-				maxLvl = circuitGates_[faninID].numLevel_;
-			}
+		if (circuitGates_[faninID].numLevel_ > maxLvl)
+		{
+			maxLvl = circuitGates_[faninID].numLevel_;
 		}
 	}
 	circuitGates_[gateID].numLevel_ = maxLvl + 1;
 
 	// Determine fanout size.
-	Port *outp = NULL;
-	int fanoutSize = 0;
-	for (int i = 0; i < (int)pmt->getNPort() && !outp; ++i)
-	{
-		if (pmt->getPort(i)->type_ == Port::OUTPUT)
-		{
-			outp = pmt->getPort(i);
-		}
-	}
-	PortSet ps = cell->libc_->getNetPorts(outp->exNet_->id_);
-	PortSet::iterator it = ps.begin();
-	for (; it != ps.end(); ++it)
+	int fanoutSize = model.numInternalFanout_[pmtID];
+	for (const int &portID : model.outputPorts_[pmtID])
 	{
-		if ((*it)->top_ != cell->libc_ && (*it)->top_ != pmt)
-		{
-			++fanoutSize;
-		}
-		else if ((*it)->top_ == cell->libc_)
-		{
-			int nid = cell->getPort((*it)->id_)->exNet_->id_;
-			fanoutSize += cell->top_->getNetPorts(nid).size() - 1;
-		}
+		int nid = cell->getPort(portID)->exNet_->id_;
+		fanoutSize += cell->top_->getNetPorts(nid).size() - 1;
 	}
 	circuitGates_[gateID].fanoutVector_.reserve(fanoutSize);
 }
@@ -447,145 +529,167 @@ void Circuit::createCircuitPmt(const int &gateID, const Cell *const cell,
 // Commenter  [ PYH ]
 // Synopsis   [ usage: Determine the type of the gate.
 //              description:
-//              	Determine and set the gateType_ class variable of the gates
-//              	with the gateID, cell and primitive.
+//              	Determine the gate type of a primitive of a library cell.
+//              	Called once per primitive by compileCellModels(). The
+//              	width comes from the inputs of the primitive itself, not
+//              	from the ports of the cell, so every primitive of a
+//              	multi-primitive cell gets its own width. AND/NAND/OR/NOR
+//              	wider than 4 and XOR/XNOR wider than 3 inputs map to the
+//              	N-input types instead of NA.
 //              arguments:
-//              	[in] gateID : The gateID of the gate.
-//              	[in] cell : The cell which the gate located at.
 //              	[in] pmt : The primitive. It is an intermediate data type
 //              	           between cell and gate. In fact, it is the gate.
+//              	[out] Gate::GateType : The type of the gate.
 //            ]
-// Date       [ Ver. 1.0 started 2013/08/11 last modified 2023/01/05 ]
+// Date       [ Ver. 1.0 started 2013/08/11 last modified 2026/10/19 ]
 // **************************************************************************
-void Circuit::determineGateType(const int &gateID, const Cell *const cell,
-                                const Pmt *const pmt)
+Gate::GateType Circuit::determineGateType(const Pmt *const pmt) const
 {
+	int numInput = 0;
+	for (size_t i = 0; i < pmt->getNPort(); ++i)
+	{
+		if (pmt->getPort(i)->type_ == Port::INPUT)
+		{
+			++numInput;
+		}
+	}
 	switch (pmt->type_)
 	{
 		case Pmt::BUF:
-			circuitGates_[gateID].gateType_ = Gate::BUF;
-			break;
+			return Gate::BUF;
 		case Pmt::INV:
 		case Pmt::INVF:
-			circuitGates_[gateID].gateType_ = Gate::INV;
-			break;
+			return Gate::INV;
 		case Pmt::MUX:
-			circuitGates_[gateID].gateType_ = Gate::MUX;
-			break;
+			return Gate::MUX;
 		case Pmt::AND:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
 			{
-				circuitGates_[gateID].gateType_ = Gate::AND2;
+				return Gate::AND2;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::AND3;
+				return Gate::AND3;
 			}
-			else if (cell->getNPort() == 5)
+			else if (numInput == 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::AND4;
+				return Gate::AND4;
+			}
+			else if (numInput > 4)
+			{
+				return Gate::ANDN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::NAND:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
+			{
+				return Gate::NAND2;
+			}
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NAND2;
+				return Gate::NAND3;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput == 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NAND3;
+				return Gate::NAND4;
 			}
-			else if (cell->getNPort() == 5)
+			else if (numInput > 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NAND4;
+				return Gate::NANDN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::OR:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
+			{
+				return Gate::OR2;
+			}
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::OR2;
+				return Gate::OR3;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput == 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::OR3;
+				return Gate::OR4;
 			}
-			else if (cell->getNPort() == 5)
+			else if (numInput > 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::OR4;
+				return Gate::ORN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::NOR:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NOR2;
+				return Gate::NOR2;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NOR3;
+				return Gate::NOR3;
 			}
-			else if (cell->getNPort() == 5)
+			else if (numInput == 4)
 			{
-				circuitGates_[gateID].gateType_ = Gate::NOR4;
+				return Gate::NOR4;
+			}
+			else if (numInput > 4)
+			{
+				return Gate::NORN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::XOR:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
+			{
+				return Gate::XOR2;
+			}
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::XOR2;
+				return Gate::XOR3;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput > 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::XOR3;
+				return Gate::XORN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::XNOR:
-			if (cell->getNPort() == 3)
+			if (numInput == 2)
+			{
+				return Gate::XNOR2;
+			}
+			else if (numInput == 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::XNOR2;
+				return Gate::XNOR3;
 			}
-			else if (cell->getNPort() == 4)
+			else if (numInput > 3)
 			{
-				circuitGates_[gateID].gateType_ = Gate::XNOR3;
+				return Gate::XNORN;
 			}
 			else
 			{
-				circuitGates_[gateID].gateType_ = Gate::NA;
+				return Gate::NA;
 			}
-			break;
 		case Pmt::TIE1:
-			circuitGates_[gateID].gateType_ = Gate::TIE1;
-			break;
+			return Gate::TIE1;
 		case Pmt::TIE0:
-			circuitGates_[gateID].gateType_ = Gate::TIE0;
-			break;
+			return Gate::TIE0;
 		case Pmt::TIEX:
-			circuitGates_[gateID].gateType_ = Gate::TIE0;
-			break;
+			return Gate::TIE0;
 		case Pmt::TIEZ:
-			circuitGates_[gateID].gateType_ = Gate::TIEZ;
-			break;
+			return Gate::TIEZ;
 		default:
-			circuitGates_[gateID].gateType_ = Gate::NA;
+			return Gate::NA;
 	}
 }
 
@@ -636,10 +740,10 @@ void Circuit::createCircuitPO()
 			else if ((*it)->top_ != top && (*it)->type_ == Port::OUTPUT)
 			{
 				faninID = cellIndexToGateIndex_[(*it)->top_->id_];
-				Cell *libc = (*it)->top_->libc_;
-				if (!pNetlist_->getTechlib()->hasPmt(libc->id_, Pmt::DFF)) // NE
+				const CellModel &model = cellModels_[(*it)->top_->libc_->id_];
+				if (!model.isSeq_) // NE
 				{
-					faninID += (*libc->getPortCells((*it)->id_).begin())->id_;
+					faninID += model.portToPmt_[(*it)->id_];
 				}
 			}
 			else
@@ -699,10 +803,10 @@ void Circuit::createCircuitPPO()
 			else if ((*it)->top_ != top && (*it)->type_ == Port::OUTPUT)
 			{
 				faninID = cellIndexToGateIndex_[(*it)->top_->id_];
-				Cell *libc = (*it)->top_->libc_;
-				if (!pNetlist_->getTechlib()->hasPmt(libc->id_, Pmt::DFF)) // NE
+				const CellModel &model = cellModels_[(*it)->top_->libc_->id_];
+				if (!model.isSeq_) // NE
 				{
-					faninID += (*libc->getPortCells((*it)->id_).begin())->id_;
+					faninID += model.portToPmt_[(*it)->id_];
 				}
 			}
 			else
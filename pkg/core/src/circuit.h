@@ -13,6 +13,36 @@
 
 namespace CoreNs
 {
+	// A cell of the technology library reduced to its primitive network.
+	// Primitive j of the cell is gate cellIndexToGateIndex_[cell] + j of
+	// every instance, so the models are compiled once per library cell and
+	// instances are expanded by looking them up instead of walking the
+	// nets of the library cell again.
+	struct CellModel
+	{
+		// PMT is another primitive of the cell, PORT an input port of the
+		// cell. NONE is any other port on the net, which the net walk
+		// connected to gate 0; it is kept so the circuit stays the same.
+		enum FANIN_TYPE
+		{
+			PMT = 0,
+			PORT,
+			NONE
+		};
+		struct Fanin
+		{
+			FANIN_TYPE type_;
+			int id_;
+		};
+
+		bool isSeq_;                                // Has a DFF, every instance is one PPI.
+		std::vector<Gate::GateType> gateTypes_;     // Gate type of each primitive.
+		std::vector<std::vector<Fanin>> fanins_;    // Fanins of each primitive, in net order.
+		std::vector<int> numInternalFanout_;        // Fanouts of each primitive inside the cell.
+		std::vector<std::vector<int>> outputPorts_; // Cell ports driven by each primitive.
+		std::vector<int> portToPmt_;                // Primitive behind each cell port, -1 if none.
+	};
+
 	class Circuit
 	{
 	public:
@@ -57,9 +87,11 @@ namespace CoreNs
 		std::vector<Gate> circuitGates_;        // Gates in the circuit.
 		std::vector<int> cellIndexToGateIndex_; // Map cells in the netlist to gates.
 		std::vector<int> portIndexToGateIndex_; // Map ports in the netlist to gates.
+		std::vector<CellModel> cellModels_;     // Models of the library cells, by cell ID.
 
 	protected:
 		// For circuit building.
+		void compileCellModels();
 		void mapNetlistToCircuit();
 		void calculateNumGate();
 		void calculateNumNet();
@@ -68,9 +100,8 @@ namespace CoreNs
 		void createCircuitPPI();
 		void createCircuitComb();
 		void createCircuitPmt(const int &gateID, const IntfNs::Cell *const cell,
-		                      const IntfNs::Pmt *const pmt);
-		void determineGateType(const int &gateID, const IntfNs::Cell *const cell,
-		                       const IntfNs::Pmt *const pmt);
+		                      const int &pmtID);
+		Gate::GateType determineGateType(const IntfNs::Pmt *const pmt) const;
 		void createCircuitPO();
 		void createCircuitPPO();
 		void connectMultipleTimeFrame();
@@ -89,6 +120,8 @@ namespace CoreNs
 		circuitLvl_ = -1;
 		numFrame_ = 1;
 		timeFrameConnectType_ = CAPTURE;
+		totalGate_ = 0;
+		totalLvl_ = -1;
 	}
 };
 
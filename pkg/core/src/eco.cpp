@@ -0,0 +1,503 @@
+// **************************************************************************
+// File       [ eco.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ write, read and map circuit images for incremental ATPG ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <unordered_map>
+
+#include "eco.h"
+
+using namespace IntfNs;
+using namespace CoreNs;
+
+static const char *const IMAGE_MAGIC = "FAN_ECO_IMAGE";
+static const int IMAGE_VERSION = 1;
+
+static std::string valuesToString(const std::vector<Value> &values)
+{
+	if (values.empty())
+	{
+		return "-";
+	}
+	std::string str(values.size(), 'X');
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		if (values[i] == L)
+		{
+			str[i] = '0';
+		}
+		else if (values[i] == H)
+		{
+			str[i] = '1';
+		}
+	}
+	return str;
+}
+
+static void stringToValues(const std::string &str, std::vector<Value> &values)
+{
+	values.clear();
+	if (str == "-")
+	{
+		return;
+	}
+	values.resize(str.size(), X);
+	for (size_t i = 0; i < str.size(); ++i)
+	{
+		if (str[i] == '0')
+		{
+			values[i] = L;
+		}
+		else if (str[i] == '1')
+		{
+			values[i] = H;
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ EcoImage::getGateKey ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Name a gate independent of its position.
+//              description:
+//              	The key is the port or cell name, the primitive inside
+//              	the cell and, for boundary gates, the gate type, since
+//              	the PPI and the PPO of a flip-flop share the cell name.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] gateID : A gate of the first time frame.
+//              	[out] std::string : The key.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+std::string EcoImage::getGateKey(Circuit *pCircuit, const int &gateID)
+{
+	const Gate &gate = pCircuit->circuitGates_[gateID];
+	Cell *top = pCircuit->pNetlist_->getTop();
+	std::ostringstream key;
+	switch (gate.gateType_)
+	{
+		case Gate::PI:
+			key << top->getPort((size_t)gate.cellId_)->name_ << "/PI";
+			break;
+		case Gate::PO:
+			key << top->getPort((size_t)gate.cellId_)->name_ << "/PO";
+			break;
+		case Gate::PPI:
+			key << top->getCell((size_t)gate.cellId_)->name_ << "/PPI";
+			break;
+		case Gate::PPO:
+			key << top->getCell((size_t)gate.cellId_)->name_ << "/PPO";
+			break;
+		default:
+			key << top->getCell((size_t)gate.cellId_)->name_ << "/" << gate.primitiveId_;
+			break;
+	}
+	return key.str();
+}
+
+// **************************************************************************
+// Function   [ EcoImage::write ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write the image of a finished ATPG run.
+//              arguments:
+//              	[in] fname : The image file.
+//              	[in] pCircuit : The circuit ATPG ran on.
+//              	[in] pFaultListExtract : The graded fault list.
+//              	[in] pPatternProcessor : The pattern set.
+//              	[out] bool : False if the file cannot be written.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool EcoImage::write(const char *const fname, Circuit *pCircuit, FaultListExtract *pFaultListExtract, PatternProcessor *pPatternProcessor) const
+{
+	std::ofstream fout(fname);
+	if (!fout)
+	{
+		std::cerr << "**ERROR EcoImage::write(): cannot open `" << fname << "'\n";
+		return false;
+	}
+
+	fout << IMAGE_MAGIC << " " << IMAGE_VERSION << "\n";
+	fout << "GATES " << pCircuit->numGate_ << "\n";
+	for (int i = 0; i < pCircuit->numGate_; ++i)
+	{
+		const Gate &gate = pCircuit->circuitGates_[i];
+		fout << getGateKey(pCircuit, i) << " " << gate.gateType_ << " " << gate.numFI_;
+		for (int j = 0; j < gate.numFI_; ++j)
+		{
+			fout << " " << gate.faninVector_[j];
+		}
+		fout << "\n";
+	}
+	fout << "PI " << pCircuit->numPI_;
+	for (int i = 0; i < pCircuit->numPI_; ++i)
+	{
+		fout << " " << i;
+	}
+	fout << "\nPPI " << pCircuit->numPPI_;
+	for (int i = 0; i < pCircuit->numPPI_; ++i)
+	{
+		fout << " " << pCircuit->numPI_ + i;
+	}
+	fout << "\nFAULTS " << pFaultListExtract->faultsInCircuit_.size() << "\n";
+	for (const Fault *pFault : pFaultListExtract->faultsInCircuit_)
+	{
+		fout << pFault->gateID_ << " " << pFault->aggr_ << " " << pFault->faultType_ << " ";
+		fout << pFault->faultyLine_ << " " << pFault->bridgeType_ << " " << pFault->faultState_ << "\n";
+	}
+	fout << "PATTERNS " << pPatternProcessor->patternVector_.size() << "\n";
+	for (const Pattern &pattern : pPatternProcessor->patternVector_)
+	{
+		fout << valuesToString(pattern.PI1_) << " " << valuesToString(pattern.PI2_) << " ";
+		fout << valuesToString(pattern.PPI_) << " " << valuesToString(pattern.SI_) << "\n";
+	}
+
+	fout.close();
+	if (!fout)
+	{
+		std::cerr << "**ERROR EcoImage::write(): cannot write `" << fname << "'\n";
+		return false;
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ EcoImage::read ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Read an image written by EcoImage::write.
+//              arguments:
+//              	[in] fname : The image file.
+//              	[out] bool : False if the file is unreadable or corrupted.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool EcoImage::read(const char *const fname)
+{
+	std::ifstream fin(fname);
+	if (!fin)
+	{
+		std::cerr << "**ERROR EcoImage::read(): cannot open `" << fname << "'\n";
+		return false;
+	}
+
+	std::string magic, section;
+	int version = 0;
+	int numGate = -1;
+	fin >> magic >> version >> section >> numGate;
+	bool isGood = fin && magic == IMAGE_MAGIC && version == IMAGE_VERSION && section == "GATES" && numGate >= 0;
+	if (isGood)
+	{
+		gateKeys_.resize(numGate);
+		gateTypes_.resize(numGate);
+		gateFanins_.assign(numGate, std::vector<int>());
+	}
+	for (int i = 0; i < numGate && isGood; ++i)
+	{
+		int numFI = -1;
+		fin >> gateKeys_[i] >> gateTypes_[i] >> numFI;
+		isGood = fin && numFI >= 0;
+		for (int j = 0; j < numFI && isGood; ++j)
+		{
+			int fanin = -1;
+			isGood = (fin >> fanin) && fanin >= 0 && fanin < numGate;
+			gateFanins_[i].push_back(fanin);
+		}
+	}
+
+	std::vector<int> *inputGates[2] = {&piGates_, &ppiGates_};
+	const char *const inputSections[2] = {"PI", "PPI"};
+	for (int k = 0; k < 2 && isGood; ++k)
+	{
+		int numInput = -1;
+		isGood = (fin >> section >> numInput) && section == inputSections[k] && numInput >= 0;
+		inputGates[k]->clear();
+		for (int i = 0; i < numInput && isGood; ++i)
+		{
+			int gate = -1;
+			isGood = (fin >> gate) && gate >= 0 && gate < numGate;
+			inputGates[k]->push_back(gate);
+		}
+	}
+
+	int numFault = -1;
+	isGood = isGood && (fin >> section >> numFault) && section == "FAULTS" && numFault >= 0;
+	faults_.clear();
+	for (int i = 0; i < numFault && isGood; ++i)
+	{
+		ImageFault fault;
+		isGood = (fin >> fault.gate_ >> fault.aggr_ >> fault.faultType_ >> fault.faultyLine_ >> fault.bridgeType_ >> fault.faultState_) &&
+						 fault.gate_ >= 0 && fault.gate_ < numGate && fault.aggr_ >= -1 && fault.aggr_ < numGate;
+		faults_.push_back(fault);
+	}
+
+	int numPattern = -1;
+	isGood = isGood && (fin >> section >> numPattern) && section == "PATTERNS" && numPattern >= 0;
+	patterns_.clear();
+	for (int i = 0; i < numPattern && isGood; ++i)
+	{
+		std::string pi1, pi2, ppi, si;
+		isGood = (bool)(fin >> pi1 >> pi2 >> ppi >> si);
+		patterns_.push_back(Pattern());
+		stringToValues(pi1, patterns_.back().PI1_);
+		stringToValues(pi2, patterns_.back().PI2_);
+		stringToValues(ppi, patterns_.back().PPI_);
+		stringToValues(si, patterns_.back().SI_);
+		isGood = isGood && patterns_.back().PI1_.size() == piGates_.size() && patterns_.back().PPI_.size() == ppiGates_.size();
+	}
+
+	if (!isGood)
+	{
+		std::cerr << "**ERROR EcoImage::read(): `" << fname << "' is not a valid circuit image\n";
+		return false;
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ EcoImage::mapCircuit ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Match the gates of the new circuit against the image.
+//              description:
+//              	A gate is changed if its key is unknown, or its type,
+//              	fanins or number of fanouts differ from the image. The
+//              	fanout count catches gates which lost a fanout to a
+//              	removed gate. The fanout cone of the changed gates is
+//              	affected, and so is every gate with a path into it, as
+//              	a changed side input can alter how its faults propagate.
+//              arguments:
+//              	[in] pCircuit : The new circuit.
+//              	[out] int : Number of changed gates.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+int EcoImage::mapCircuit(Circuit *pCircuit)
+{
+	pCircuit_ = pCircuit;
+	const int numGate = pCircuit->numGate_;
+	std::unordered_map<std::string, int> keyToImageGate;
+	for (size_t i = 0; i < gateKeys_.size(); ++i)
+	{
+		keyToImageGate[gateKeys_[i]] = i;
+	}
+	std::vector<int> imageNumFO(gateKeys_.size(), 0);
+	for (const std::vector<int> &fanins : gateFanins_)
+	{
+		for (const int &fanin : fanins)
+		{
+			++imageNumFO[fanin];
+		}
+	}
+
+	gateToImageGate_.assign(numGate, -1);
+	for (int i = 0; i < numGate; ++i)
+	{
+		std::unordered_map<std::string, int>::const_iterator it = keyToImageGate.find(getGateKey(pCircuit, i));
+		if (it != keyToImageGate.end())
+		{
+			gateToImageGate_[i] = it->second;
+		}
+	}
+
+	// fanouts into the next time frame are not part of the image
+	std::vector<int> changedGates;
+	for (int i = 0; i < numGate; ++i)
+	{
+		const Gate &gate = pCircuit->circuitGates_[i];
+		const int imageGate = gateToImageGate_[i];
+		int numFO = 0;
+		for (const int &fanout : gate.fanoutVector_)
+		{
+			numFO += fanout < numGate ? 1 : 0;
+		}
+		bool isChanged = imageGate < 0 || gateTypes_[imageGate] != gate.gateType_ ||
+										 (int)gateFanins_[imageGate].size() != gate.numFI_ || imageNumFO[imageGate] != numFO;
+		for (int j = 0; j < gate.numFI_ && !isChanged; ++j)
+		{
+			isChanged = gateToImageGate_[gate.faninVector_[j]] != gateFanins_[imageGate][j];
+		}
+		if (isChanged)
+		{
+			changedGates.push_back(i);
+		}
+	}
+
+	// the fanout cone of the changed gates, then every gate which reaches
+	// it: a fault whose path has a changed gate as a side input reaches the
+	// cone without being in the fanin of a changed gate
+	gateIsAffected_.assign(numGate, false);
+	for (int direction = 0; direction < 2; ++direction)
+	{
+		std::queue<int> events;
+		if (direction == 0)
+		{
+			for (const int &gateID : changedGates)
+			{
+				gateIsAffected_[gateID] = true;
+				events.push(gateID);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < numGate; ++i)
+			{
+				if (gateIsAffected_[i])
+				{
+					events.push(i);
+				}
+			}
+		}
+		while (!events.empty())
+		{
+			const Gate &gate = pCircuit->circuitGates_[events.front()];
+			events.pop();
+			const std::vector<int> &next = direction == 0 ? gate.fanoutVector_ : gate.faninVector_;
+			for (const int &nextGateID : next)
+			{
+				if (nextGateID < numGate && !gateIsAffected_[nextGateID])
+				{
+					gateIsAffected_[nextGateID] = true;
+					events.push(nextGateID);
+				}
+			}
+		}
+	}
+	numAffectedGate_ = 0;
+	for (int i = 0; i < numGate; ++i)
+	{
+		numAffectedGate_ += gateIsAffected_[i] ? 1 : 0;
+	}
+	return changedGates.size();
+}
+
+// **************************************************************************
+// Function   [ EcoImage::mapPatterns ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Carry the image patterns over to the new circuit.
+//              description:
+//              	PI and PPI values are matched by gate key, so reordered
+//              	inputs keep their values and new inputs are X. The PO
+//              	and PPO values are left empty for the simulator to fill.
+//              arguments:
+//              	[out] pPatternProcessor : Initialized for the new circuit,
+//              	receives the patterns.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void EcoImage::mapPatterns(PatternProcessor *pPatternProcessor) const
+{
+	std::vector<int> imageGateToPI(gateKeys_.size(), -1);
+	std::vector<int> imageGateToPPI(gateKeys_.size(), -1);
+	for (size_t i = 0; i < piGates_.size(); ++i)
+	{
+		imageGateToPI[piGates_[i]] = i;
+	}
+	for (size_t i = 0; i < ppiGates_.size(); ++i)
+	{
+		imageGateToPPI[ppiGates_[i]] = i;
+	}
+	std::vector<int> piMap(pCircuit_->numPI_, -1);
+	std::vector<int> ppiMap(pCircuit_->numPPI_, -1);
+	for (int i = 0; i < pCircuit_->numPI_; ++i)
+	{
+		const int imageGate = gateToImageGate_[i];
+		piMap[i] = imageGate >= 0 ? imageGateToPI[imageGate] : -1;
+	}
+	for (int i = 0; i < pCircuit_->numPPI_; ++i)
+	{
+		const int imageGate = gateToImageGate_[pCircuit_->numPI_ + i];
+		ppiMap[i] = imageGate >= 0 ? imageGateToPPI[imageGate] : -1;
+	}
+
+	pPatternProcessor->patternVector_.clear();
+	pPatternProcessor->patternVector_.reserve(patterns_.size());
+	for (const Pattern &imagePattern : patterns_)
+	{
+		Pattern pattern(pCircuit_);
+		for (int i = 0; i < pCircuit_->numPI_; ++i)
+		{
+			pattern.PI1_[i] = piMap[i] >= 0 ? imagePattern.PI1_[piMap[i]] : X;
+		}
+		for (int i = 0; i < pCircuit_->numPPI_; ++i)
+		{
+			pattern.PPI_[i] = ppiMap[i] >= 0 ? imagePattern.PPI_[ppiMap[i]] : X;
+		}
+		if (!imagePattern.PI2_.empty())
+		{
+			pattern.initForTransitionDelayFault(pCircuit_);
+			for (int i = 0; i < pCircuit_->numPI_; ++i)
+			{
+				pattern.PI2_[i] = piMap[i] >= 0 ? imagePattern.PI2_[piMap[i]] : X;
+			}
+			pattern.SI_ = imagePattern.SI_;
+		}
+		pPatternProcessor->patternVector_.push_back(pattern);
+	}
+}
+
+// **************************************************************************
+// Function   [ EcoImage::mapFaults ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Decide which faults of the new circuit need ATPG.
+//              description:
+//              	Called after the mapped patterns were fault simulated.
+//              	A fault is mapped if the image has the same fault on the
+//              	same gates. Undetected mapped faults outside the affected
+//              	region get their AU, AB, RE or TI state back, all other
+//              	undetected faults, the new ones included, are targeted.
+//              arguments:
+//              	[in, out] pFaultListExtract : The fault list of the new
+//              	circuit.
+//              	[out] targetFaults : Faults to run ATPG on.
+//              	[out] numMapped : Number of faults found in the image.
+//              	[out] numRestored : Number of faults given their old state.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void EcoImage::mapFaults(FaultListExtract *pFaultListExtract, FaultPtrList &targetFaults, int &numMapped, int &numRestored) const
+{
+	typedef std::map<std::vector<int>, int> FaultStateMap;
+	FaultStateMap imageFaultState;
+	for (const ImageFault &fault : faults_)
+	{
+		const std::vector<int> key = {fault.gate_, fault.aggr_, fault.faultType_, fault.faultyLine_, fault.bridgeType_};
+		imageFaultState[key] = fault.faultState_;
+	}
+
+	numMapped = 0;
+	numRestored = 0;
+	targetFaults.clear();
+	for (Fault *pFault : pFaultListExtract->faultsInCircuit_)
+	{
+		const int imageGate = gateToImageGate_[pFault->gateID_];
+		const int imageAggr = pFault->aggr_ >= 0 ? gateToImageGate_[pFault->aggr_] : -1;
+		FaultStateMap::const_iterator it = imageFaultState.end();
+		if (imageGate >= 0 && (pFault->aggr_ < 0 || imageAggr >= 0))
+		{
+			const std::vector<int> key = {imageGate, imageAggr, pFault->faultType_, pFault->faultyLine_, pFault->bridgeType_};
+			it = imageFaultState.find(key);
+		}
+		numMapped += it != imageFaultState.end() ? 1 : 0;
+
+		if (pFault->faultState_ == Fault::DT || pFault->faultState_ == Fault::RE || pFault->faultState_ == Fault::TI || pFault->faultyLine_ < 0)
+		{
+			continue;
+		}
+		const bool isAffected = gateIsAffected_[pFault->gateID_] || (pFault->aggr_ >= 0 && gateIsAffected_[pFault->aggr_]);
+		if (it != imageFaultState.end() && !isAffected &&
+				(it->second == Fault::AU || it->second == Fault::AB || it->second == Fault::RE || it->second == Fault::TI))
+		{
+			pFault->faultState_ = (Fault::FAULT_STATE)it->second;
+			++numRestored;
+			continue;
+		}
+		targetFaults.push_back(pFault);
+	}
+}
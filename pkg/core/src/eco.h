@@ -0,0 +1,91 @@
+// **************************************************************************
+// File       [ eco.h ]
+// Author     [ PYH ]
+// Synopsis   [ circuit image for incremental ATPG after netlist ECOs ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_ECO_H_
+#define _CORE_ECO_H_
+
+#include <string>
+#include <vector>
+
+#include "pattern.h"
+
+namespace CoreNs
+{
+
+	// An image holds what is needed to carry an ATPG run over to a changed
+	// netlist: the gates of the first time frame keyed by cell or port name,
+	// the final fault states and the pattern set.
+	//
+	// A gate of the new circuit is changed if its key is not in the image
+	// or its type or fanin keys differ. Faults in the fanout cone of changed
+	// gates, or on any gate with a path into that cone, are affected;
+	// outside that region a fault keeps a proven AU, AB, RE or TI state
+	// from the image and is not targeted again.
+	class EcoImage
+	{
+	public:
+		EcoImage();
+		~EcoImage();
+
+		bool write(const char *const fname, Circuit *pCircuit, FaultListExtract *pFaultListExtract, PatternProcessor *pPatternProcessor) const;
+		bool read(const char *const fname);
+
+		// match the gates of pCircuit, return the number of changed gates
+		int mapCircuit(Circuit *pCircuit);
+		// copy the image patterns into pPatternProcessor, which must be
+		// initialized for the new circuit; inputs missing in the image are X
+		void mapPatterns(PatternProcessor *pPatternProcessor) const;
+		// restore states of unaffected faults and collect the faults left
+		// to target, after the mapped patterns have been simulated
+		void mapFaults(FaultListExtract *pFaultListExtract, FaultPtrList &targetFaults, int &numMapped, int &numRestored) const;
+
+		int getNumAffectedGate() const;
+
+	private:
+		struct ImageFault
+		{
+			int gate_;
+			int aggr_;
+			int faultType_;
+			int faultyLine_;
+			int bridgeType_;
+			int faultState_;
+		};
+
+		static std::string getGateKey(Circuit *pCircuit, const int &gateID);
+
+		std::vector<std::string> gateKeys_;
+		std::vector<int> gateTypes_;
+		std::vector<std::vector<int>> gateFanins_;
+		std::vector<int> piGates_;
+		std::vector<int> ppiGates_;
+		std::vector<ImageFault> faults_;
+		std::vector<Pattern> patterns_;
+
+		// filled by mapCircuit, indexed by gates of the new circuit
+		Circuit *pCircuit_;
+		std::vector<int> gateToImageGate_;
+		std::vector<bool> gateIsAffected_;
+		int numAffectedGate_;
+	};
+
+	inline EcoImage::EcoImage()
+	{
+		pCircuit_ = NULL;
+		numAffectedGate_ = 0;
+	}
+
+	inline EcoImage::~EcoImage() {}
+
+	inline int EcoImage::getNumAffectedGate() const
+	{
+		return numAffectedGate_;
+	}
+
+};
+
+#endif
@@ -3,14 +3,29 @@
 // Author     [ littleshamoo, PYH ]
 // Synopsis   [ This program extract faults from the circuit.
 //              Currently there is no fault collapsing yet. 2014/8/26
-//              Implement fault collapsing. 2022/12/1 ]
+//              Implement fault collapsing. 2022/12/1
+//              Extract bridge faults from net pair files.
+//              Dominance collapsing and untestability marking. ]
 // Date       [ 2011/10/05 created ]
 // **************************************************************************
 
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
 #include "fault.h"
 
+using namespace IntfNs;
 using namespace CoreNs;
 
+static int getNetDriverGate(Circuit *pCircuit, const std::string &name);
+static bool isInFanoutCone(Circuit *pCircuit, const int &fromGateID, const int &toGateID, std::vector<int> &visited);
+static bool isOutputFaultDominated(const Gate &gate, const Fault::FAULT_TYPE &faultType);
+static void computeConstantValue(Circuit *pCircuit, const bool &useConstraint, std::vector<Value> &constantValue);
+static void computeObservability(Circuit *pCircuit, const std::vector<Value> &constantValue, std::vector<char> &isObservable);
+static bool isSideInputControlled(Circuit *pCircuit, const Gate &gate, const int &faninIndex, const std::vector<Value> &constantValue);
+static bool isFaultUntestable(Circuit *pCircuit, const Fault &fault, const std::vector<Value> &constantValue, const std::vector<char> &isObservable);
+
 // **************************************************************************
 // Function   [ FaultListExtract::extractFaultFromCircuit ]
 // Commenter  [ PYH ]
@@ -21,6 +36,9 @@ using namespace CoreNs;
 //              	Simple Equivalent Fault Collapsing. In addition, we calculate
 //              	the number of equivalent faults to recover the original
 //              	uncollapsed fault coverage.
+//              	The collapsing method is chosen by collapseType_. DOMINANCE
+//              	further reduces the equivalence collapsed list by
+//              	collapseFaultByDominance().
 //              	//TODO Currently the input fault and output fault don't
 //              	collapsed to the same fault for the correct fault coverage
 //              	with MFO DTC. Wish this problem can be solved for further speedup.
@@ -31,8 +49,6 @@ using namespace CoreNs;
 // **************************************************************************
 void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 {
-	bool useFC = true; // Should be able to set on or off in script like test compression.
-
 	// Since the function only called once, we don't need to clear faults initially.
 	// Reserve enough space for faults push_back, 10 * circuit->numGate_ is maximum possible faults in a circuit.
 	int reservedSize = 10 * pCircuit->numGate_;
@@ -42,6 +58,13 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 	// Resize gateIndexToFaultIndex to proper size.
 	gateIndexToFaultIndex_.resize(pCircuit->numGate_);
 
+	// Bridge faults are not derived from the circuit structure alone,
+	// they are read from a net pair file by extractBridgeFaultFromFile().
+	if (faultListType_ == BRF)
+	{
+		return;
+	}
+
 	// Add stuck-at faults.
 	if (faultListType_ == SAF)
 	{
@@ -81,7 +104,7 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 		}
 
 		// Extract faults.
-		if (!useFC) // Without Fault Collapsing.
+		if (collapseType_ == NO_COLLAPSE) // Without Fault Collapsing.
 		{
 			extractedFaults_.resize(uncollapsedFaults_.size());
 			extractedFaults_.assign(uncollapsedFaults_.begin(), uncollapsedFaults_.end());
@@ -99,6 +122,7 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 					case Gate::AND2:
 					case Gate::AND3:
 					case Gate::AND4:
+					case Gate::ANDN:
 						for (int j = 0; j < pCircuit->circuitGates_[i].numFI_; ++j)
 						{
 							SA0EquivalentOfInput = SA0Equivalent[pCircuit->circuitGates_[i].faninVector_[j]];
@@ -111,6 +135,7 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 					case Gate::NAND2:
 					case Gate::NAND3:
 					case Gate::NAND4:
+					case Gate::NANDN:
 						for (int j = 0; j < pCircuit->circuitGates_[i].numFI_; ++j)
 						{
 							SA0EquivalentOfInput = SA0Equivalent[pCircuit->circuitGates_[i].faninVector_[j]];
@@ -123,6 +148,7 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 					case Gate::OR2:
 					case Gate::OR3:
 					case Gate::OR4:
+					case Gate::ORN:
 						for (int j = 0; j < pCircuit->circuitGates_[i].numFI_; ++j)
 						{
 							SA0EquivalentOfInput = SA0Equivalent[pCircuit->circuitGates_[i].faninVector_[j]];
@@ -135,6 +161,7 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 					case Gate::NOR2:
 					case Gate::NOR3:
 					case Gate::NOR4:
+					case Gate::NORN:
 						for (int j = 0; j < pCircuit->circuitGates_[i].numFI_; ++j)
 						{
 							SA0EquivalentOfInput = SA0Equivalent[pCircuit->circuitGates_[i].faninVector_[j]];
@@ -211,6 +238,10 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 					extractedFaults_.push_back(Fault(i, Fault::SA1, -4, 1, Fault::UD));
 				}
 			}
+			if (collapseType_ == DOMINANCE)
+			{
+				collapseFaultByDominance(pCircuit);
+			}
 		}
 
 		// HYH try to fix the fault number @20141121.
@@ -311,4 +342,688 @@ void FaultListExtract::extractFaultFromCircuit(Circuit *pCircuit)
 		}
 	}
 	// End of adding transition faults.
-}
\ No newline at end of file
+}
+// **************************************************************************
+// Function   [ FaultListExtract::extractBridgeFaultFromFile ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Extract bridge faults from a net pair file.
+//              description:
+//              	Each line of the file describes one candidate bridge as
+//              	"<victim net> <aggressor net> [wand|wor|dom]". Empty lines
+//              	and lines starting with '#' are ignored. Net adjacency lists
+//              	exported from layout can be fed in the same two column form,
+//              	then every pair gets the default bridge type. Each net is
+//              	mapped to the gate driving it in the first time frame.
+//              	Pairs which cannot be resolved, short a net to itself or form
+//              	a feedback bridge (one net in the fanout cone of the other)
+//              	are skipped with a warning. The bridges are appended to
+//              	extractedFaults_ and uncollapsedFaults_.
+//              arguments:
+//              	[in] pCircuit : The circuit we want to extract faults from.
+//              	[in] fname : The net pair file.
+//              	[in] defaultType : Bridge type of pairs without a type field.
+//              	[out] bool : False if the file cannot be opened.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool FaultListExtract::extractBridgeFaultFromFile(Circuit *pCircuit, const char *const fname, const Fault::BRIDGE_TYPE &defaultType)
+{
+	std::ifstream fin(fname);
+	if (!fin)
+	{
+		std::cerr << "**ERROR FaultListExtract::extractBridgeFaultFromFile(): cannot open `";
+		std::cerr << fname << "'\n";
+		return false;
+	}
+
+	std::vector<int> visited(pCircuit->totalGate_, 0);
+	std::string line;
+	int lineNum = 0;
+	while (std::getline(fin, line))
+	{
+		++lineNum;
+		std::istringstream iss(line);
+		std::string victimName, aggressorName, typeName;
+		if (!(iss >> victimName) || victimName[0] == '#')
+		{
+			continue;
+		}
+		if (!(iss >> aggressorName))
+		{
+			std::cerr << "**WARN FaultListExtract::extractBridgeFaultFromFile(): line ";
+			std::cerr << lineNum << " needs two nets\n";
+			continue;
+		}
+
+		Fault::BRIDGE_TYPE bridgeType = defaultType;
+		if (iss >> typeName)
+		{
+			if (typeName == "wand" || typeName == "WAND")
+			{
+				bridgeType = Fault::WAND;
+			}
+			else if (typeName == "wor" || typeName == "WOR")
+			{
+				bridgeType = Fault::WOR;
+			}
+			else if (typeName == "dom" || typeName == "DOM")
+			{
+				bridgeType = Fault::DOM;
+			}
+			else
+			{
+				std::cerr << "**WARN FaultListExtract::extractBridgeFaultFromFile(): line ";
+				std::cerr << lineNum << " unknown bridge type `" << typeName << "'\n";
+				continue;
+			}
+		}
+
+		const int victim = getNetDriverGate(pCircuit, victimName);
+		const int aggressor = getNetDriverGate(pCircuit, aggressorName);
+		if (victim < 0 || aggressor < 0)
+		{
+			std::cerr << "**WARN FaultListExtract::extractBridgeFaultFromFile(): line ";
+			std::cerr << lineNum << " net `" << (victim < 0 ? victimName : aggressorName);
+			std::cerr << "' does not exist\n";
+			continue;
+		}
+		if (victim == aggressor)
+		{
+			continue;
+		}
+		// Feedback bridges would need sequential evaluation, skip them.
+		if (isInFanoutCone(pCircuit, victim, aggressor, visited) || isInFanoutCone(pCircuit, aggressor, victim, visited))
+		{
+			std::cerr << "**WARN FaultListExtract::extractBridgeFaultFromFile(): line ";
+			std::cerr << lineNum << " feedback bridge skipped\n";
+			continue;
+		}
+
+		uncollapsedFaults_.push_back(Fault(victim, aggressor, bridgeType));
+		extractedFaults_.push_back(Fault(victim, aggressor, bridgeType));
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ FaultListExtract::collapseFaultByDominance ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Shrink the equivalence collapsed fault list further.
+//              description:
+//              	Two reductions are applied to extractedFaults_ in one pass.
+//              	Checkpoint reduction: an input fault on a fanout free line
+//              	is the same fault as the output fault of the driving gate,
+//              	so it is merged into that fault. Only faults on stems and
+//              	fanout branches are left, as the checkpoint theorem
+//              	suggests.
+//              	Dominance collapsing: every test of an input SA1 of an
+//              	AND gate also detects its output SA1, so the output fault
+//              	needs no test of its own. NAND, OR and NOR gates are
+//              	handled the same way with the output SA0, SA0 and SA1.
+//              	Dominance only holds one way, an untestable input fault
+//              	says nothing of the output fault, so the dominated fault
+//              	stays in the list with its own equivalent_. It is only
+//              	left out of the ATPG targets and is marked DT by
+//              	markDominatedFaults() through dominance_.
+//              	The pass relies on fanins having smaller IDs than the gate
+//              	and on the input faults of a gate coming before its
+//              	output faults.
+//              arguments:
+//              	[in] pCircuit : The circuit the faults are extracted from.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void FaultListExtract::collapseFaultByDominance(Circuit *pCircuit)
+{
+	std::vector<Fault> collapsedFaults;
+	collapsedFaults.reserve(extractedFaults_.size());
+	dominance_.clear();
+	std::vector<int> outputFaultRep(2 * pCircuit->numGate_, -1); // Representative of output SA0/SA1 of each gate.
+	std::vector<int> inputFaultReps;                             // Representatives of the input faults of inputGateID.
+	int inputGateID = -1;
+
+	for (const Fault &fault : extractedFaults_)
+	{
+		if (fault.gateID_ < 0 || fault.faultyLine_ < 0)
+		{
+			collapsedFaults.push_back(fault);
+			continue;
+		}
+		const Gate &gate = pCircuit->circuitGates_[fault.gateID_];
+		const int stuckValue = fault.faultType_ == Fault::SA0 ? 0 : 1;
+		if (fault.gateID_ != inputGateID)
+		{
+			inputGateID = fault.gateID_;
+			inputFaultReps.clear();
+		}
+
+		int rep = -1;
+		if (fault.faultyLine_ > 0)
+		{
+			const int faninID = gate.faninVector_[fault.faultyLine_ - 1];
+			if (pCircuit->circuitGates_[faninID].numFO_ == 1)
+			{
+				rep = outputFaultRep[2 * faninID + stuckValue];
+			}
+		}
+
+		if (rep < 0)
+		{
+			rep = collapsedFaults.size();
+			collapsedFaults.push_back(fault);
+			if (fault.faultyLine_ == 0 && !inputFaultReps.empty() && isOutputFaultDominated(gate, fault.faultType_))
+			{
+				// the equivalence collapsed inputs of these gates only
+				// carry the faults which dominance needs
+				collapsedFaults[rep].isDominated_ = true;
+				for (const int &inputFaultRep : inputFaultReps)
+				{
+					dominance_.push_back(std::make_pair(rep, inputFaultRep));
+				}
+			}
+		}
+		else
+		{
+			collapsedFaults[rep].equivalent_ += fault.equivalent_;
+		}
+
+		if (fault.faultyLine_ == 0)
+		{
+			outputFaultRep[2 * fault.gateID_ + stuckValue] = rep;
+		}
+		else
+		{
+			inputFaultReps.push_back(rep);
+		}
+	}
+	extractedFaults_.swap(collapsedFaults);
+}
+
+// **************************************************************************
+// Function   [ FaultListExtract::markDominatedFaults ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Mark dominated faults detected by their dominating
+//                     faults.
+//              description:
+//              	A test of a dominating fault also detects the dominated
+//              	fault, so an undetected dominated fault becomes DT once any
+//              	of its dominating faults is DT. Other states are never
+//              	passed on, a dominated fault whose dominating faults are
+//              	all untestable or aborted stays undetected. dominance_ is
+//              	ordered by the dominated fault, so a chain of dominated
+//              	faults is settled in one pass.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void FaultListExtract::markDominatedFaults()
+{
+	for (const std::pair<int, int> &dominance : dominance_)
+	{
+		Fault &dominatedFault = extractedFaults_[dominance.first];
+		if (dominatedFault.faultState_ == Fault::UD && extractedFaults_[dominance.second].faultState_ == Fault::DT)
+		{
+			dominatedFault.faultState_ = Fault::DT;
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ FaultListExtract::markUntestableFaults ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Mark faults which are untestable by structure alone.
+//              description:
+//              	A cheap static pass run before ATPG, so that no backtracks
+//              	are spent on hopeless faults. Only undetected faults in
+//              	faultsInCircuit_ are examined.
+//              	RE : the faulty line has no structural path to any PO or PPO.
+//              	TI : the faulty line is tied by TIE0/TIE1 cells or by pin
+//              	     constraints (hasConstraint_) to the stuck value, or to
+//              	     any value for transition faults, or every path of the
+//              	     fault effect is blocked by a side input tied to the
+//              	     controlling value.
+//              	Constants are propagated forward in the first time frame
+//              	only, no implication or learning is done.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[out] numTied : Number of faults marked TI.
+//              	[out] numRedundant : Number of faults marked RE.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void FaultListExtract::markUntestableFaults(Circuit *pCircuit, int &numTied, int &numRedundant)
+{
+	numTied = 0;
+	numRedundant = 0;
+
+	std::vector<Value> noConstantValue(pCircuit->numGate_, X), tiedValue;
+	std::vector<char> isStructurallyObservable, isObservable;
+	computeObservability(pCircuit, noConstantValue, isStructurallyObservable);
+	computeConstantValue(pCircuit, true, tiedValue);
+	computeObservability(pCircuit, tiedValue, isObservable);
+
+	for (Fault *pFault : faultsInCircuit_)
+	{
+		if (pFault->faultState_ != Fault::UD || pFault->faultType_ == Fault::BR || pFault->gateID_ < 0 || pFault->faultyLine_ < 0)
+		{
+			continue;
+		}
+		if (isFaultUntestable(pCircuit, *pFault, noConstantValue, isStructurallyObservable))
+		{
+			pFault->faultState_ = Fault::RE;
+			++numRedundant;
+		}
+		else if (isFaultUntestable(pCircuit, *pFault, tiedValue, isObservable))
+		{
+			pFault->faultState_ = Fault::TI;
+			++numTied;
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ getNetDriverGate ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Find the gate driving a net of the top module.
+//              description:
+//              	The driver is either a primary input port or the output of a
+//              	cell. For a cell the primitive driving the cell output is
+//              	used, a flip-flop maps to its PPI gate.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] name : Name of the net or of a primary input port.
+//              	[out] int : The gate ID, -1 if not found.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+int getNetDriverGate(Circuit *pCircuit, const std::string &name)
+{
+	Cell *top = pCircuit->pNetlist_->getTop();
+	Net *net = top->getNet(name.c_str());
+	if (!net)
+	{
+		Port *port = top->getPort(name.c_str());
+		if (!port || port->type_ != Port::INPUT)
+		{
+			return -1;
+		}
+		return pCircuit->portIndexToGateIndex_[port->id_];
+	}
+
+	PortSet ps = top->getNetPorts(net->id_);
+	for (PortSet::iterator it = ps.begin(); it != ps.end(); ++it)
+	{
+		Cell *cin = (*it)->top_;
+		if ((*it)->type_ == Port::OUTPUT && cin != top)
+		{
+			int gateID = pCircuit->cellIndexToGateIndex_[cin->id_];
+			if (pCircuit->pNetlist_->getTechlib()->hasPmt(cin->libc_->id_, Pmt::DFF))
+			{
+				return gateID;
+			}
+			CellSet cs = cin->libc_->getPortCells((*it)->id_);
+			return gateID + (*cs.begin())->id_;
+		}
+		else if ((*it)->type_ == Port::INPUT && cin == top)
+		{
+			return pCircuit->portIndexToGateIndex_[(*it)->id_];
+		}
+	}
+	return -1;
+}
+
+// **************************************************************************
+// Function   [ isInFanoutCone ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check whether toGateID is in the fanout cone of fromGateID.
+//              description:
+//              	Depth first search through the fanouts. Gates with a level
+//              	higher than the level of toGateID cannot reach it and are
+//              	not expanded.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] fromGateID : Root of the fanout cone.
+//              	[in] toGateID : The gate to look for.
+//              	[in] visited : Scratch flags of size totalGate_, cleared on return.
+//              	[out] bool : True if toGateID is reachable.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool isInFanoutCone(Circuit *pCircuit, const int &fromGateID, const int &toGateID, std::vector<int> &visited)
+{
+	const int toLevel = pCircuit->circuitGates_[toGateID].numLevel_;
+	std::vector<int> stack(1, fromGateID);
+	std::vector<int> touched(1, fromGateID);
+	visited[fromGateID] = 1;
+	bool found = false;
+	while (!stack.empty() && !found)
+	{
+		const Gate &gate = pCircuit->circuitGates_[stack.back()];
+		stack.pop_back();
+		for (int i = 0; i < gate.numFO_; ++i)
+		{
+			const int fanoutID = gate.fanoutVector_[i];
+			if (fanoutID == toGateID)
+			{
+				found = true;
+				break;
+			}
+			if (visited[fanoutID] || pCircuit->circuitGates_[fanoutID].numLevel_ >= toLevel)
+			{
+				continue;
+			}
+			visited[fanoutID] = 1;
+			touched.push_back(fanoutID);
+			stack.push_back(fanoutID);
+		}
+	}
+	for (const int &gateID : touched)
+	{
+		visited[gateID] = 0;
+	}
+	return found;
+}
+
+// **************************************************************************
+// Function   [ isOutputFaultDominated ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check whether the output fault dominates the input faults.
+//              description:
+//              	True for the output fault of an AND, NAND, OR or NOR gate
+//              	whose stuck value is the non-controlled output value.
+//              arguments:
+//              	[in] gate : The faulty gate.
+//              	[in] faultType : Type of the output fault.
+//              	[out] bool : True if the output fault is dominated.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool isOutputFaultDominated(const Gate &gate, const Fault::FAULT_TYPE &faultType)
+{
+	switch (gate.gateType_)
+	{
+		case Gate::AND2:
+		case Gate::AND3:
+		case Gate::AND4:
+		case Gate::ANDN:
+		case Gate::NOR2:
+		case Gate::NOR3:
+		case Gate::NOR4:
+		case Gate::NORN:
+			return faultType == Fault::SA1;
+		case Gate::NAND2:
+		case Gate::NAND3:
+		case Gate::NAND4:
+		case Gate::NANDN:
+		case Gate::OR2:
+		case Gate::OR3:
+		case Gate::OR4:
+		case Gate::ORN:
+			return faultType == Fault::SA0;
+		default:
+			return false;
+	}
+}
+
+// **************************************************************************
+// Function   [ computeConstantValue ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Propagate tied values through the first time frame.
+//              description:
+//              	TIE0/TIE1 gates and, if asked, constrained gates are the
+//              	sources. A gate is constant if a fanin is at the
+//              	controlling value or all of its fanins are constant.
+//              	Everything else, including PIs and PPIs, is X.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] useConstraint : Take hasConstraint_ into account.
+//              	[out] constantValue : L, H or X for each gate.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void computeConstantValue(Circuit *pCircuit, const bool &useConstraint, std::vector<Value> &constantValue)
+{
+	constantValue.assign(pCircuit->numGate_, X);
+	for (int i = 0; i < pCircuit->numGate_; ++i)
+	{
+		const Gate &gate = pCircuit->circuitGates_[i];
+		if (useConstraint && gate.hasConstraint_)
+		{
+			constantValue[i] = gate.constraint_ == PARA_H ? H : L;
+			continue;
+		}
+		switch (gate.gateType_)
+		{
+			case Gate::TIE0:
+				constantValue[i] = L;
+				break;
+			case Gate::TIE1:
+				constantValue[i] = H;
+				break;
+			case Gate::PO:
+			case Gate::PPO:
+			case Gate::BUF:
+				constantValue[i] = constantValue[gate.faninVector_[0]];
+				break;
+			case Gate::INV:
+				if (constantValue[gate.faninVector_[0]] != X)
+				{
+					constantValue[i] = constantValue[gate.faninVector_[0]] == L ? H : L;
+				}
+				break;
+			case Gate::AND2:
+			case Gate::AND3:
+			case Gate::AND4:
+			case Gate::ANDN:
+			case Gate::NAND2:
+			case Gate::NAND3:
+			case Gate::NAND4:
+			case Gate::NANDN:
+			case Gate::OR2:
+			case Gate::OR3:
+			case Gate::OR4:
+			case Gate::ORN:
+			case Gate::NOR2:
+			case Gate::NOR3:
+			case Gate::NOR4:
+			case Gate::NORN:
+			{
+				const Value ctrlValue = gate.getInputCtrlValue();
+				bool isControlled = false;
+				bool isAllKnown = true;
+				for (const int &faninID : gate.faninVector_)
+				{
+					if (constantValue[faninID] == ctrlValue)
+					{
+						isControlled = true;
+					}
+					else if (constantValue[faninID] == X)
+					{
+						isAllKnown = false;
+					}
+				}
+				if (!isControlled && !isAllKnown)
+				{
+					break;
+				}
+				Value outputValue = isControlled ? ctrlValue : (ctrlValue == L ? H : L);
+				if (gate.isInverse() == H)
+				{
+					outputValue = outputValue == L ? H : L;
+				}
+				constantValue[i] = outputValue;
+				break;
+			}
+			case Gate::XOR2:
+			case Gate::XOR3:
+			case Gate::XORN:
+			case Gate::XNOR2:
+			case Gate::XNOR3:
+			case Gate::XNORN:
+			{
+				Value outputValue = gate.isInverse();
+				for (const int &faninID : gate.faninVector_)
+				{
+					if (constantValue[faninID] == X)
+					{
+						outputValue = X;
+						break;
+					}
+					outputValue = outputValue == constantValue[faninID] ? L : H;
+				}
+				constantValue[i] = outputValue;
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ computeObservability ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Find the gates whose value can reach a PO or PPO.
+//              description:
+//              	Gates are visited from the outputs backwards. A gate is
+//              	observable if it is a PO or PPO, or feeds an observable
+//              	gate through an input which is not blocked by a constant
+//              	side input. With all values X this is plain structural
+//              	reachability.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] constantValue : Tied values from computeConstantValue().
+//              	[out] isObservable : Flag for each gate.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void computeObservability(Circuit *pCircuit, const std::vector<Value> &constantValue, std::vector<char> &isObservable)
+{
+	isObservable.assign(pCircuit->numGate_, 0);
+	for (int i = pCircuit->numGate_ - 1; i >= 0; --i)
+	{
+		const Gate &gate = pCircuit->circuitGates_[i];
+		if (gate.gateType_ == Gate::PO || gate.gateType_ == Gate::PPO)
+		{
+			isObservable[i] = 1;
+			continue;
+		}
+		for (int j = 0; j < gate.numFO_ && !isObservable[i]; ++j)
+		{
+			const int fanoutID = gate.fanoutVector_[j];
+			if (fanoutID >= pCircuit->numGate_ || !isObservable[fanoutID])
+			{
+				continue;
+			}
+			const Gate &fanoutGate = pCircuit->circuitGates_[fanoutID];
+			for (int k = 0; k < fanoutGate.numFI_; ++k)
+			{
+				if (fanoutGate.faninVector_[k] == i && !isSideInputControlled(pCircuit, fanoutGate, k, constantValue))
+				{
+					isObservable[i] = 1;
+					break;
+				}
+			}
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ isSideInputControlled ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check whether a side input blocks the given input.
+//              description:
+//              	Only AND, NAND, OR and NOR gates have a controlling value.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] gate : The gate to pass.
+//              	[in] faninIndex : Index of the input carrying the fault effect.
+//              	[in] constantValue : Tied values from computeConstantValue().
+//              	[out] bool : True if another input is tied to the controlling value.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool isSideInputControlled(Circuit *pCircuit, const Gate &gate, const int &faninIndex, const std::vector<Value> &constantValue)
+{
+	switch (gate.gateType_)
+	{
+		case Gate::AND2:
+		case Gate::AND3:
+		case Gate::AND4:
+		case Gate::ANDN:
+		case Gate::NAND2:
+		case Gate::NAND3:
+		case Gate::NAND4:
+		case Gate::NANDN:
+		case Gate::OR2:
+		case Gate::OR3:
+		case Gate::OR4:
+		case Gate::ORN:
+		case Gate::NOR2:
+		case Gate::NOR3:
+		case Gate::NOR4:
+		case Gate::NORN:
+			break;
+		default:
+			return false;
+	}
+	const Value ctrlValue = gate.getInputCtrlValue();
+	for (int i = 0; i < gate.numFI_; ++i)
+	{
+		if (i != faninIndex && constantValue[gate.faninVector_[i]] == ctrlValue)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// **************************************************************************
+// Function   [ isFaultUntestable ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check whether a fault can neither be excited nor observed.
+//              description:
+//              	A stuck-at fault is not excitable if its line is tied to
+//              	the stuck value, a transition fault if its line is tied at
+//              	all. The effect of an input fault must further pass the
+//              	faulty gate itself.
+//              arguments:
+//              	[in] pCircuit : The circuit.
+//              	[in] fault : The fault, on a gate of the first time frame.
+//              	[in] constantValue : Tied values from computeConstantValue().
+//              	[in] isObservable : Flags from computeObservability().
+//              	[out] bool : True if the fault is untestable.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool isFaultUntestable(Circuit *pCircuit, const Fault &fault, const std::vector<Value> &constantValue, const std::vector<char> &isObservable)
+{
+	const Gate &gate = pCircuit->circuitGates_[fault.gateID_];
+	const int lineGateID = fault.faultyLine_ == 0 ? fault.gateID_ : gate.faninVector_[fault.faultyLine_ - 1];
+	const Value lineValue = constantValue[lineGateID];
+	switch (fault.faultType_)
+	{
+		case Fault::SA0:
+			if (lineValue == L)
+			{
+				return true;
+			}
+			break;
+		case Fault::SA1:
+			if (lineValue == H)
+			{
+				return true;
+			}
+			break;
+		default:
+			if (lineValue != X)
+			{
+				return true;
+			}
+			break;
+	}
+	if (!isObservable[fault.gateID_])
+	{
+		return true;
+	}
+	return fault.faultyLine_ > 0 && isSideInputControlled(pCircuit, gate, fault.faultyLine_ - 1, constantValue);
+}
@@ -0,0 +1,168 @@
+// **************************************************************************
+// File       [ fault_cone.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ compacted subcircuit around a fault site ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <algorithm>
+
+#include "fault_cone.h"
+#include "atpg.h"
+
+using namespace CoreNs;
+
+FaultCone::FaultCone()
+{
+	siteGateID_ = -1;
+	coneSiteGateID_ = -1;
+	pAtpg_ = NULL;
+	lastUse_ = 0;
+}
+
+FaultCone::~FaultCone()
+{
+	delete pAtpg_;
+}
+
+// **************************************************************************
+// Function   [ FaultCone::extract ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Build the cone of a fault site.
+//              description:
+//              	Collect the transitive fanout of the site, then the
+//              	transitive fanin of everything collected. The gates keep
+//              	their order in pCircuit, which already puts inputs first
+//              	and outputs last, and are levelized again the way
+//              	Circuit::buildCircuit does, minLevelOfFanins_ included.
+//              arguments:
+//              	[in] pCircuit : A single time frame circuit.
+//              	[in] siteGateID : The gate of the fault.
+//              	[in] maxNumGate : The largest cone worth building.
+//              	[in, out] gateToConeGate : Scratch, all -1.
+//              	[out] bool : False if the cone is too large.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool FaultCone::extract(Circuit *pCircuit, const int &siteGateID, const int &maxNumGate, std::vector<int> &gateToConeGate)
+{
+	std::vector<int> gates;
+	gates.push_back(siteGateID);
+	gateToConeGate[siteGateID] = 0;
+	for (size_t i = 0; i < gates.size() && (int)gates.size() <= maxNumGate; ++i)
+	{
+		for (const int &fanoutID : pCircuit->circuitGates_[gates[i]].fanoutVector_)
+		{
+			if (gateToConeGate[fanoutID] < 0)
+			{
+				gateToConeGate[fanoutID] = 0;
+				gates.push_back(fanoutID);
+			}
+		}
+	}
+	for (size_t i = 0; i < gates.size() && (int)gates.size() <= maxNumGate; ++i)
+	{
+		for (const int &faninID : pCircuit->circuitGates_[gates[i]].faninVector_)
+		{
+			if (gateToConeGate[faninID] < 0)
+			{
+				gateToConeGate[faninID] = 0;
+				gates.push_back(faninID);
+			}
+		}
+	}
+	if ((int)gates.size() > maxNumGate)
+	{
+		for (const int &gateID : gates)
+		{
+			gateToConeGate[gateID] = -1;
+		}
+		return false;
+	}
+
+	std::sort(gates.begin(), gates.end());
+	for (size_t i = 0; i < gates.size(); ++i)
+	{
+		gateToConeGate[gates[i]] = (int)i;
+	}
+
+	circuit_ = Circuit();
+	circuit_.pNetlist_ = pCircuit->pNetlist_;
+	circuit_.numFrame_ = 1;
+	circuit_.timeFrameConnectType_ = pCircuit->timeFrameConnectType_;
+	circuit_.numGate_ = (int)gates.size();
+	circuit_.totalGate_ = circuit_.numGate_;
+	circuit_.circuitGates_.resize(gates.size());
+	int maxCombLvl = 0;
+	for (size_t i = 0; i < gates.size(); ++i)
+	{
+		Gate &gate = circuit_.circuitGates_[i];
+		gate = pCircuit->circuitGates_[gates[i]];
+		gate.gateId_ = (int)i;
+		for (int &faninID : gate.faninVector_)
+		{
+			faninID = gateToConeGate[faninID];
+		}
+		gate.fanoutVector_.clear();
+		for (const int &fanoutID : pCircuit->circuitGates_[gates[i]].fanoutVector_)
+		{
+			if (gateToConeGate[fanoutID] >= 0)
+			{
+				gate.fanoutVector_.push_back(gateToConeGate[fanoutID]);
+			}
+		}
+		gate.numFO_ = (int)gate.fanoutVector_.size();
+
+		switch (gate.gateType_)
+		{
+			case Gate::PI:
+			case Gate::PPI:
+				gate.numLevel_ = 0;
+				++circuit_.numPI_;
+				break;
+			case Gate::PO:
+			case Gate::PPO:
+				++circuit_.numPO_;
+				break;
+			default:
+				gate.numLevel_ = 0;
+				for (const int &faninID : gate.faninVector_)
+				{
+					gate.numLevel_ = std::max(gate.numLevel_, circuit_.circuitGates_[faninID].numLevel_ + 1);
+				}
+				maxCombLvl = std::max(maxCombLvl, gate.numLevel_);
+				++circuit_.numComb_;
+				break;
+		}
+	}
+	circuit_.circuitLvl_ = maxCombLvl + 2;
+	circuit_.totalLvl_ = circuit_.circuitLvl_;
+	circuit_.numNet_ = circuit_.numGate_;
+	for (int i = circuit_.numGate_ - circuit_.numPO_; i < circuit_.numGate_; ++i)
+	{
+		circuit_.circuitGates_[i].numLevel_ = circuit_.circuitLvl_ - 1;
+	}
+	// as Circuit::assignMinLevelOfFanins, on the local levels
+	for (Gate &gate : circuit_.circuitGates_)
+	{
+		int minLvl = gate.numLevel_;
+		gate.minLevelOfFanins_ = -1;
+		for (const int &faninID : gate.faninVector_)
+		{
+			if (circuit_.circuitGates_[faninID].numLevel_ < minLvl)
+			{
+				minLvl = circuit_.circuitGates_[faninID].numLevel_;
+				gate.minLevelOfFanins_ = faninID;
+			}
+		}
+	}
+
+	coneGateToGate_.swap(gates);
+	siteGateID_ = siteGateID;
+	coneSiteGateID_ = gateToConeGate[siteGateID];
+	for (const int &gateID : coneGateToGate_)
+	{
+		gateToConeGate[gateID] = -1;
+	}
+	return true;
+}
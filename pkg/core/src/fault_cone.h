@@ -0,0 +1,51 @@
+// **************************************************************************
+// File       [ fault_cone.h ]
+// Author     [ PYH ]
+// Synopsis   [ compacted subcircuit around a fault site ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _CORE_FAULT_CONE_H_
+#define _CORE_FAULT_CONE_H_
+
+#include <vector>
+
+#include "circuit.h"
+
+namespace CoreNs
+{
+	class Atpg;
+
+	// The cone of a fault site is its transitive fanout up to the POs and
+	// PPOs together with the transitive fanin of all those gates. Every
+	// fanin of a cone gate is in the cone, fanouts leaving it are dropped:
+	// they can neither justify an objective nor observe the fault.
+	//
+	// The cone is built as a Circuit of its own with renumbered gates and
+	// local levels. PPIs are counted as PIs and PPOs as POs so the usual
+	// layout holds, inputs first and outputs last, numPPI_ is 0. Only
+	// single time frame circuits are supported.
+	class FaultCone
+	{
+	public:
+		FaultCone();
+		~FaultCone();
+
+		// gateToConeGate is scratch sized to totalGate_ and all -1, it is
+		// left that way; return false if the cone exceeds maxNumGate gates
+		bool extract(Circuit *pCircuit, const int &siteGateID, const int &maxNumGate, std::vector<int> &gateToConeGate);
+
+		Circuit circuit_;									// the cone
+		std::vector<int> coneGateToGate_; // gate of the cone to gate of the circuit
+		int siteGateID_;									// fault site in the circuit
+		int coneSiteGateID_;							// fault site in the cone
+		Atpg *pAtpg_;											// engine run on circuit_, owned
+		int lastUse_;											// for replacement in a cache of cones
+
+	private:
+		FaultCone(const FaultCone &);
+		FaultCone &operator=(const FaultCone &);
+	};
+};
+
+#endif
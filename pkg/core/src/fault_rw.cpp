@@ -0,0 +1,220 @@
+// **************************************************************************
+// File       [ fault_rw.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ read and write binary fault grading results ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+
+#include "fault_rw.h"
+
+using namespace CoreNs;
+
+static const char RESULT_MAGIC[4] = {'F', 'A', 'N', 'R'};
+static const uint32_t RESULT_VERSION = 1;
+
+struct ResultHeader
+{
+	uint32_t faultListType_;
+	uint32_t numFault_;
+	uint64_t signature_;
+	uint32_t shardIndex_;
+	uint32_t numShard_;
+	uint32_t numRecord_;
+};
+
+// **************************************************************************
+// Function   [ CoreNs::getFaultListSignature ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Hash the identity of every fault in faultsInCircuit_.
+//              description:
+//              	FNV-1a over gate, type, line and aggressor of the faults in
+//              	list order. Results are only merged into a fault list with
+//              	the same signature, that is the same faults in the same
+//              	order as the shards used.
+//              arguments:
+//              	[in] pFaultListExtract : The fault list.
+//              	[out] uint64_t : The signature.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+uint64_t CoreNs::getFaultListSignature(FaultListExtract *pFaultListExtract)
+{
+	uint64_t h = 14695981039346656037ULL;
+	for (const Fault *pFault : pFaultListExtract->faultsInCircuit_)
+	{
+		const int32_t key[4] = {pFault->gateID_, (int32_t)pFault->faultType_, pFault->faultyLine_, pFault->aggr_};
+		const unsigned char *byte = (const unsigned char *)key;
+		for (size_t i = 0; i < sizeof(key); ++i)
+		{
+			h = (h ^ byte[i]) * 1099511628211ULL;
+		}
+	}
+	return h;
+}
+
+static bool writeHeader(FILE *fout, const ResultHeader &header)
+{
+	return fwrite(RESULT_MAGIC, 1, 4, fout) == 4 &&
+				 fwrite(&RESULT_VERSION, sizeof(RESULT_VERSION), 1, fout) == 1 &&
+				 fwrite(&header.faultListType_, sizeof(header.faultListType_), 1, fout) == 1 &&
+				 fwrite(&header.numFault_, sizeof(header.numFault_), 1, fout) == 1 &&
+				 fwrite(&header.signature_, sizeof(header.signature_), 1, fout) == 1 &&
+				 fwrite(&header.shardIndex_, sizeof(header.shardIndex_), 1, fout) == 1 &&
+				 fwrite(&header.numShard_, sizeof(header.numShard_), 1, fout) == 1 &&
+				 fwrite(&header.numRecord_, sizeof(header.numRecord_), 1, fout) == 1;
+}
+
+static bool readHeader(FILE *fin, ResultHeader &header)
+{
+	char magic[4];
+	uint32_t version;
+	return fread(magic, 1, 4, fin) == 4 && memcmp(magic, RESULT_MAGIC, 4) == 0 &&
+				 fread(&version, sizeof(version), 1, fin) == 1 && version == RESULT_VERSION &&
+				 fread(&header.faultListType_, sizeof(header.faultListType_), 1, fin) == 1 &&
+				 fread(&header.numFault_, sizeof(header.numFault_), 1, fin) == 1 &&
+				 fread(&header.signature_, sizeof(header.signature_), 1, fin) == 1 &&
+				 fread(&header.shardIndex_, sizeof(header.shardIndex_), 1, fin) == 1 &&
+				 fread(&header.numShard_, sizeof(header.numShard_), 1, fin) == 1 &&
+				 fread(&header.numRecord_, sizeof(header.numRecord_), 1, fin) == 1;
+}
+
+// **************************************************************************
+// Function   [ FaultResultWriter::writeResult ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write state and detections of the faults of one shard.
+//              description:
+//              	Faults at negative lines, which are classified at
+//              	extraction, are written as well, so the merged list gives
+//              	the same statistics as a single run.
+//              arguments:
+//              	[in] fname : The result file.
+//              	[in] shardIndex : Shard to write, 0 to numShard - 1.
+//              	[in] numShard : Number of shards, 1 writes every fault.
+//              	[out] bool : False if the file cannot be written.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool FaultResultWriter::writeResult(const char *const fname, const int &shardIndex, const int &numShard)
+{
+	FILE *fout = fopen(fname, "wb");
+	if (!fout)
+	{
+		std::cerr << "**ERROR FaultResultWriter::writeResult(): cannot open `";
+		std::cerr << fname << "'\n";
+		return false;
+	}
+
+	const size_t numFault = pFaultListExtract_->faultsInCircuit_.size();
+	ResultHeader header;
+	header.faultListType_ = pFaultListExtract_->faultListType_;
+	header.numFault_ = numFault;
+	header.signature_ = getFaultListSignature(pFaultListExtract_);
+	header.shardIndex_ = shardIndex;
+	header.numShard_ = numShard;
+	header.numRecord_ = numFault / numShard + (shardIndex < (int)(numFault % numShard) ? 1 : 0);
+	bool isGood = writeHeader(fout, header);
+
+	size_t faultIndex = 0;
+	for (const Fault *pFault : pFaultListExtract_->faultsInCircuit_)
+	{
+		if (isGood && isFaultInShard(faultIndex, shardIndex, numShard))
+		{
+			const uint32_t index = faultIndex;
+			const uint32_t detection = pFault->detection_;
+			const uint8_t state = pFault->faultState_;
+			isGood = fwrite(&index, sizeof(index), 1, fout) == 1 &&
+							 fwrite(&detection, sizeof(detection), 1, fout) == 1 &&
+							 fwrite(&state, sizeof(state), 1, fout) == 1;
+		}
+		++faultIndex;
+	}
+
+	if (fclose(fout) != 0 || !isGood)
+	{
+		std::cerr << "**ERROR FaultResultWriter::writeResult(): cannot write `";
+		std::cerr << fname << "'\n";
+		return false;
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ FaultResultReader::mergeResult ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Merge one result file into faultsInCircuit_.
+//              description:
+//              	The file must come from the same fault list, checked by
+//              	its type, size and signature. A fault takes the state of
+//              	the record if the record is DT or the fault is still UD,
+//              	so overlapping results, e.g. from pattern slices, merge
+//              	correctly as well. Detections are added up.
+//              arguments:
+//              	[in] fname : The result file.
+//              	[out] numRecord : Number of merged records.
+//              	[out] bool : False if the file is unreadable or mismatched.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool FaultResultReader::mergeResult(const char *const fname, int &numRecord)
+{
+	numRecord = 0;
+	FILE *fin = fopen(fname, "rb");
+	if (!fin)
+	{
+		std::cerr << "**ERROR FaultResultReader::mergeResult(): cannot open `";
+		std::cerr << fname << "'\n";
+		return false;
+	}
+
+	ResultHeader header;
+	if (!readHeader(fin, header))
+	{
+		std::cerr << "**ERROR FaultResultReader::mergeResult(): `" << fname;
+		std::cerr << "' is not a fault result file\n";
+		fclose(fin);
+		return false;
+	}
+	const size_t numFault = pFaultListExtract_->faultsInCircuit_.size();
+	if (header.faultListType_ != (uint32_t)pFaultListExtract_->faultListType_ ||
+			header.numFault_ != numFault ||
+			header.signature_ != getFaultListSignature(pFaultListExtract_))
+	{
+		std::cerr << "**ERROR FaultResultReader::mergeResult(): `" << fname;
+		std::cerr << "' was written for a different fault list\n";
+		fclose(fin);
+		return false;
+	}
+
+	// random access into the list
+	std::vector<Fault *> faults(pFaultListExtract_->faultsInCircuit_.begin(), pFaultListExtract_->faultsInCircuit_.end());
+	for (uint32_t i = 0; i < header.numRecord_; ++i)
+	{
+		uint32_t index;
+		uint32_t detection;
+		uint8_t state;
+		if (fread(&index, sizeof(index), 1, fin) != 1 ||
+				fread(&detection, sizeof(detection), 1, fin) != 1 ||
+				fread(&state, sizeof(state), 1, fin) != 1 ||
+				index >= numFault || state > Fault::AB)
+		{
+			std::cerr << "**ERROR FaultResultReader::mergeResult(): `" << fname;
+			std::cerr << "' is truncated or corrupted\n";
+			fclose(fin);
+			return false;
+		}
+		Fault *pFault = faults[index];
+		if (state == Fault::DT || pFault->faultState_ == Fault::UD)
+		{
+			pFault->faultState_ = (Fault::FAULT_STATE)state;
+		}
+		pFault->detection_ += detection;
+		++numRecord;
+	}
+	fclose(fin);
+	return true;
+}
@@ -0,0 +1,595 @@
+// **************************************************************************
+// File       [ multi_fault_atpg.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ bit-parallel test generation for a group of stuck-at faults ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <algorithm>
+
+#include "multi_fault_atpg.h"
+
+using namespace CoreNs;
+
+// evaluate one gate on 3-valued words, low bit = 0, high bit = 1, none = X
+static void evaluateWord(const Gate &gate, const ParallelValue *l, const ParallelValue *h, ParallelValue &outLow, ParallelValue &outHigh)
+{
+	ParallelValue low = PARA_L;
+	ParallelValue high = PARA_L;
+	switch (gate.gateType_)
+	{
+		case Gate::PO:
+		case Gate::PPO:
+		case Gate::BUF:
+		case Gate::INV:
+			low = l[0];
+			high = h[0];
+			break;
+		case Gate::AND2:
+		case Gate::AND3:
+		case Gate::AND4:
+		case Gate::NAND2:
+		case Gate::NAND3:
+		case Gate::NAND4:
+		case Gate::ANDN:
+		case Gate::NANDN:
+			high = PARA_H;
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				low |= l[i];
+				high &= h[i];
+			}
+			break;
+		case Gate::OR2:
+		case Gate::OR3:
+		case Gate::OR4:
+		case Gate::NOR2:
+		case Gate::NOR3:
+		case Gate::NOR4:
+		case Gate::ORN:
+		case Gate::NORN:
+			low = PARA_H;
+			for (int i = 0; i < gate.numFI_; ++i)
+			{
+				low &= l[i];
+				high |= h[i];
+			}
+			break;
+		case Gate::XOR2:
+		case Gate::XOR3:
+		case Gate::XNOR2:
+		case Gate::XNOR3:
+		case Gate::XORN:
+		case Gate::XNORN:
+			low = l[0];
+			high = h[0];
+			for (int i = 1; i < gate.numFI_; ++i)
+			{
+				const ParallelValue nextLow = (low & l[i]) | (high & h[i]);
+				high = (low & h[i]) | (high & l[i]);
+				low = nextLow;
+			}
+			break;
+		case Gate::MUX:
+			// fanins are IN0, IN1 and the select line
+			low = (l[0] & l[2]) | (l[1] & h[2]) | (l[0] & l[1]);
+			high = (h[0] & l[2]) | (h[1] & h[2]) | (h[0] & h[1]);
+			break;
+		case Gate::TIE0:
+			low = PARA_H;
+			break;
+		case Gate::TIE1:
+			high = PARA_H;
+			break;
+		default:
+			break;
+	}
+	if (gate.isInverse() == H)
+	{
+		outLow = high;
+		outHigh = low;
+	}
+	else
+	{
+		outLow = low;
+		outHigh = high;
+	}
+}
+
+MultiFaultAtpg::MultiFaultAtpg(Circuit *pCircuit)
+		: pCircuit_(pCircuit),
+			goodLow_(pCircuit->totalGate_, PARA_L),
+			goodHigh_(pCircuit->totalGate_, PARA_L),
+			faultLow_(pCircuit->totalGate_, PARA_L),
+			faultHigh_(pCircuit->totalGate_, PARA_L),
+			injectBegin_(pCircuit->totalGate_ + 1, 0),
+			dFrontier_(pCircuit->totalGate_, PARA_L),
+			isInDFrontierGates_(pCircuit->totalGate_, 0),
+			events_(pCircuit->totalLvl_),
+			isInEvents_(pCircuit->totalGate_, 0),
+			detected_(PARA_L)
+{
+	int maxNumFI = 0;
+	for (int gateID = 0; gateID < pCircuit->totalGate_; ++gateID)
+	{
+		const int &numFI = pCircuit->circuitGates_[gateID].numFI_;
+		injectBegin_[gateID + 1] = injectBegin_[gateID] + numFI + 1;
+		maxNumFI = std::max(maxNumFI, numFI);
+	}
+	injectLow_.assign(injectBegin_[pCircuit->totalGate_], PARA_L);
+	injectHigh_.assign(injectBegin_[pCircuit->totalGate_], PARA_L);
+	faninGoodLow_.resize(maxNumFI);
+	faninGoodHigh_.resize(maxNumFI);
+	faninFaultLow_.resize(maxNumFI);
+	faninFaultHigh_.resize(maxNumFI);
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::generatePattern ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Generate one pattern shared by a group of faults.
+//              description:
+//              	Starting from all inputs X, every round splits off the
+//              	lanes that are detected or can no longer be detected by
+//              	the assignment so far, takes the
+//              	first remaining lane, and assigns the input reached by
+//              	backtracing its objective: fault activation first, then a
+//              	non-controlling side input of its D-frontier gate closest
+//              	to an output. The assignment is implied in all lanes.
+//              	Each round fixes one input, so the search ends after at
+//              	most numPI_ + numPPI_ rounds.
+//              arguments:
+//              	[in] faults : Stuck-at faults, at most WORD_SIZE.
+//              	[out] pattern : The PI1_ and PPI_ of the shared assignment,
+//              	unassigned inputs are X.
+//              	[out] ParallelValue : The lanes detected by pattern.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+ParallelValue MultiFaultAtpg::generatePattern(const std::vector<Fault *> &faults, Pattern &pattern)
+{
+	reset(faults);
+	ParallelValue active = faults.size() < (size_t)WORD_SIZE ? (((ParallelValue)1 << faults.size()) - 1) : PARA_H;
+	while (true)
+	{
+		active &= ~detected_;
+		ParallelValue hasDFrontier = PARA_L;
+		for (const int &gateID : dFrontierGates_)
+		{
+			hasDFrontier |= dFrontier_[gateID];
+		}
+		for (size_t lane = 0; lane < faults.size(); ++lane)
+		{
+			const ParallelValue mask = (ParallelValue)1 << lane;
+			if (!(active & mask))
+			{
+				continue;
+			}
+			const Value siteVal = getGoodVal(activationGates_[lane]);
+			if (siteVal == stuckVals_[lane] || (siteVal != X && !(hasDFrontier & mask)))
+			{
+				active &= ~mask;
+			}
+		}
+		if (active == PARA_L)
+		{
+			break;
+		}
+
+		int lane = 0;
+		while (!(active & ((ParallelValue)1 << lane)))
+		{
+			++lane;
+		}
+		int objGateID = -1;
+		Value objVal = X;
+		int inputGateID = -1;
+		Value inputVal = X;
+		if (!getObjective(lane, objGateID, objVal) || !backtrace(objGateID, objVal, inputGateID, inputVal))
+		{
+			active &= ~((ParallelValue)1 << lane);
+			continue;
+		}
+		assignInput(inputGateID, inputVal);
+	}
+
+	for (int i = 0; i < pCircuit_->numPI_; ++i)
+	{
+		pattern.PI1_[i] = getGoodVal(i);
+	}
+	for (int i = 0; i < pCircuit_->numPPI_; ++i)
+	{
+		pattern.PPI_[i] = getGoodVal(pCircuit_->numPI_ + i);
+	}
+	return detected_;
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::reset ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Inject the faults and evaluate the circuit with all
+//              inputs X.
+//              arguments:
+//              	[in] faults : Fault k is injected in lane k.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void MultiFaultAtpg::reset(const std::vector<Fault *> &faults)
+{
+	for (const int &gateID : injectedGates_)
+	{
+		std::fill(injectLow_.begin() + injectBegin_[gateID], injectLow_.begin() + injectBegin_[gateID + 1], PARA_L);
+		std::fill(injectHigh_.begin() + injectBegin_[gateID], injectHigh_.begin() + injectBegin_[gateID + 1], PARA_L);
+	}
+	injectedGates_.clear();
+	for (const int &gateID : dFrontierGates_)
+	{
+		dFrontier_[gateID] = PARA_L;
+		isInDFrontierGates_[gateID] = 0;
+	}
+	dFrontierGates_.clear();
+	detected_ = PARA_L;
+
+	for (size_t lane = 0; lane < faults.size(); ++lane)
+	{
+		const Fault &fault = *faults[lane];
+		const ParallelValue mask = (ParallelValue)1 << lane;
+		if (fault.faultType_ == Fault::SA0)
+		{
+			injectLow_[injectBegin_[fault.gateID_] + fault.faultyLine_] |= mask;
+			stuckVals_[lane] = L;
+		}
+		else
+		{
+			injectHigh_[injectBegin_[fault.gateID_] + fault.faultyLine_] |= mask;
+			stuckVals_[lane] = H;
+		}
+		injectedGates_.push_back(fault.gateID_);
+		const Gate &gate = pCircuit_->circuitGates_[fault.gateID_];
+		activationGates_[lane] = fault.faultyLine_ == 0 ? fault.gateID_ : gate.faninVector_[fault.faultyLine_ - 1];
+	}
+
+	// gate indices are in topological order
+	for (int gateID = 0; gateID < pCircuit_->totalGate_; ++gateID)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[gateID];
+		if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI)
+		{
+			goodLow_[gateID] = PARA_L;
+			goodHigh_[gateID] = PARA_L;
+		}
+		evaluate(gateID);
+	}
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::evaluate ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Evaluate the good and faulty values of a gate.
+//              description:
+//              	Inputs keep their good value. Lanes whose fault effect
+//              	reaches a fanin while the output is still unknown are
+//              	recorded in the D-frontier, lanes with a fault effect on
+//              	a PO or PPO are detected.
+//              arguments:
+//              	[in] gateID : The gate to evaluate.
+//              	[out] bool : True if any value of the gate changed.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool MultiFaultAtpg::evaluate(const int &gateID)
+{
+	const Gate &gate = pCircuit_->circuitGates_[gateID];
+	const ParallelValue *const injectLow = &injectLow_[injectBegin_[gateID]];
+	const ParallelValue *const injectHigh = &injectHigh_[injectBegin_[gateID]];
+	ParallelValue *const gl = faninGoodLow_.data();
+	ParallelValue *const gh = faninGoodHigh_.data();
+	ParallelValue *const fl = faninFaultLow_.data();
+	ParallelValue *const fh = faninFaultHigh_.data();
+	ParallelValue faninDiff = PARA_L;
+	for (int i = 0; i < gate.numFI_; ++i)
+	{
+		const int &faninID = gate.faninVector_[i];
+		gl[i] = goodLow_[faninID];
+		gh[i] = goodHigh_[faninID];
+		fl[i] = (faultLow_[faninID] & ~injectHigh[i + 1]) | injectLow[i + 1];
+		fh[i] = (faultHigh_[faninID] & ~injectLow[i + 1]) | injectHigh[i + 1];
+		faninDiff |= (gl[i] & fh[i]) | (gh[i] & fl[i]);
+	}
+
+	ParallelValue goodLow, goodHigh, faultLow, faultHigh;
+	if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI)
+	{
+		goodLow = goodLow_[gateID];
+		goodHigh = goodHigh_[gateID];
+		faultLow = goodLow;
+		faultHigh = goodHigh;
+	}
+	else
+	{
+		evaluateWord(gate, gl, gh, goodLow, goodHigh);
+		evaluateWord(gate, fl, fh, faultLow, faultHigh);
+	}
+	faultLow = (faultLow & ~injectHigh[0]) | injectLow[0];
+	faultHigh = (faultHigh & ~injectLow[0]) | injectHigh[0];
+
+	const ParallelValue diff = (goodLow & faultHigh) | (goodHigh & faultLow);
+	if (gate.gateType_ == Gate::PO || gate.gateType_ == Gate::PPO)
+	{
+		detected_ |= diff;
+	}
+	if (faninDiff != PARA_L)
+	{
+		const ParallelValue unknown = ~(goodLow | goodHigh) | ~(faultLow | faultHigh);
+		dFrontier_[gateID] = faninDiff & ~diff & unknown;
+		if (!isInDFrontierGates_[gateID])
+		{
+			isInDFrontierGates_[gateID] = 1;
+			dFrontierGates_.push_back(gateID);
+		}
+	}
+
+	const bool isChanged = goodLow != goodLow_[gateID] || goodHigh != goodHigh_[gateID] || faultLow != faultLow_[gateID] || faultHigh != faultHigh_[gateID];
+	goodLow_[gateID] = goodLow;
+	goodHigh_[gateID] = goodHigh;
+	faultLow_[gateID] = faultLow;
+	faultHigh_[gateID] = faultHigh;
+	return isChanged;
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::assignInput ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Assign a PI or PPI and imply it in all lanes.
+//              description:
+//              	Event driven, level by level. Values only go from X to
+//              	known, so nothing has to be undone.
+//              arguments:
+//              	[in] gateID : The PI or PPI.
+//              	[in] val : L or H.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void MultiFaultAtpg::assignInput(const int &gateID, const Value &val)
+{
+	goodLow_[gateID] = val == L ? PARA_H : PARA_L;
+	goodHigh_[gateID] = val == H ? PARA_H : PARA_L;
+	evaluate(gateID);
+	for (const int &fanoutID : pCircuit_->circuitGates_[gateID].fanoutVector_)
+	{
+		if (!isInEvents_[fanoutID])
+		{
+			isInEvents_[fanoutID] = 1;
+			events_[pCircuit_->circuitGates_[fanoutID].numLevel_].push_back(fanoutID);
+		}
+	}
+	for (int level = pCircuit_->circuitGates_[gateID].numLevel_ + 1; level < pCircuit_->totalLvl_; ++level)
+	{
+		while (!events_[level].empty())
+		{
+			const int eventID = events_[level].back();
+			events_[level].pop_back();
+			isInEvents_[eventID] = 0;
+			if (!evaluate(eventID))
+			{
+				continue;
+			}
+			for (const int &fanoutID : pCircuit_->circuitGates_[eventID].fanoutVector_)
+			{
+				if (!isInEvents_[fanoutID])
+				{
+					isInEvents_[fanoutID] = 1;
+					events_[pCircuit_->circuitGates_[fanoutID].numLevel_].push_back(fanoutID);
+				}
+			}
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::getObjective ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Find the next objective of a lane.
+//              description:
+//              	Activate the fault if its site is X. Otherwise pick the
+//              	D-frontier gate of the lane with the smallest depthFromPo_
+//              	and set its hardest X side input, the one with the
+//              	highest level, to the non-controlling value. The select
+//              	line of a MUX is set to pass the fault effect instead.
+//              arguments:
+//              	[in] lane : The lane.
+//              	[out] gateID, val : The objective.
+//              	[out] bool : False if the lane has no objective.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool MultiFaultAtpg::getObjective(const int &lane, int &gateID, Value &val) const
+{
+	if (getGoodVal(activationGates_[lane]) == X)
+	{
+		gateID = activationGates_[lane];
+		val = stuckVals_[lane] == L ? H : L;
+		return true;
+	}
+
+	const ParallelValue mask = (ParallelValue)1 << lane;
+	int dFrontierID = -1;
+	for (const int &candidateID : dFrontierGates_)
+	{
+		if ((dFrontier_[candidateID] & mask) && (dFrontierID < 0 || pCircuit_->circuitGates_[candidateID].depthFromPo_ < pCircuit_->circuitGates_[dFrontierID].depthFromPo_))
+		{
+			dFrontierID = candidateID;
+		}
+	}
+	if (dFrontierID < 0)
+	{
+		return false;
+	}
+
+	const Gate &gate = pCircuit_->circuitGates_[dFrontierID];
+	if (gate.gateType_ == Gate::MUX && getGoodVal(gate.faninVector_[2]) == X)
+	{
+		// select IN1 unless the fault effect is on IN0
+		const int &in0 = gate.faninVector_[0];
+		const ParallelValue faultLow = (faultLow_[in0] & ~injectHigh_[injectBegin_[dFrontierID] + 1]) | injectLow_[injectBegin_[dFrontierID] + 1];
+		const ParallelValue faultHigh = (faultHigh_[in0] & ~injectLow_[injectBegin_[dFrontierID] + 1]) | injectHigh_[injectBegin_[dFrontierID] + 1];
+		const bool isOnIn0 = ((goodLow_[in0] & faultHigh) | (goodHigh_[in0] & faultLow)) & mask;
+		gateID = gate.faninVector_[2];
+		val = isOnIn0 ? L : H;
+		return true;
+	}
+
+	gateID = -1;
+	for (const int &faninID : gate.faninVector_)
+	{
+		if (getGoodVal(faninID) == X && (gateID < 0 || pCircuit_->circuitGates_[faninID].numLevel_ > pCircuit_->circuitGates_[gateID].numLevel_))
+		{
+			gateID = faninID;
+		}
+	}
+	switch (gate.gateType_)
+	{
+		case Gate::AND2:
+		case Gate::AND3:
+		case Gate::AND4:
+		case Gate::NAND2:
+		case Gate::NAND3:
+		case Gate::NAND4:
+		case Gate::OR2:
+		case Gate::OR3:
+		case Gate::OR4:
+		case Gate::NOR2:
+		case Gate::NOR3:
+		case Gate::NOR4:
+		case Gate::ANDN:
+		case Gate::NANDN:
+		case Gate::ORN:
+		case Gate::NORN:
+			val = gate.getInputNonCtrlValue();
+			break;
+		default:
+			val = L;
+			break;
+	}
+	return gateID >= 0;
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::backtrace ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Backtrace an objective to an unassigned input.
+//              description:
+//              	Follows X fanins only. A controlling value goes to the
+//              	easiest fanin, the one with the lowest level, any other
+//              	value to the hardest one. XOR gates account for the parity
+//              	of their known fanins, a MUX with an X select line
+//              	backtraces the select line towards a data input that
+//              	already has the value.
+//              arguments:
+//              	[in] gateID, val : The objective, gateID must be X.
+//              	[out] inputGateID, inputVal : The input assignment.
+//              	[out] bool : False if no input is reached.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool MultiFaultAtpg::backtrace(int gateID, Value val, int &inputGateID, Value &inputVal) const
+{
+	while (true)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[gateID];
+		if (gate.gateType_ == Gate::PI || gate.gateType_ == Gate::PPI)
+		{
+			inputGateID = gateID;
+			inputVal = val;
+			return true;
+		}
+		if (gate.isInverse() == H)
+		{
+			val = val == L ? H : L;
+		}
+
+		int nextID = -1;
+		switch (gate.gateType_)
+		{
+			case Gate::MUX:
+			{
+				const Value selectVal = getGoodVal(gate.faninVector_[2]);
+				if (selectVal != X)
+				{
+					nextID = gate.faninVector_[selectVal == L ? 0 : 1];
+				}
+				else
+				{
+					nextID = gate.faninVector_[2];
+					val = (getGoodVal(gate.faninVector_[1]) == val && getGoodVal(gate.faninVector_[0]) != val) ? H : L;
+				}
+				break;
+			}
+			case Gate::XOR2:
+			case Gate::XOR3:
+			case Gate::XNOR2:
+			case Gate::XNOR3:
+			case Gate::XORN:
+			case Gate::XNORN:
+			{
+				Value xVal = val;
+				for (const int &faninID : gate.faninVector_)
+				{
+					const Value faninVal = getGoodVal(faninID);
+					if (faninVal == X)
+					{
+						nextID = nextID < 0 ? faninID : nextID;
+					}
+					else if (faninVal == H)
+					{
+						xVal = xVal == L ? H : L;
+					}
+				}
+				val = xVal;
+				break;
+			}
+			default:
+			{
+				const bool isControlling = gate.numFI_ > 1 && val == gate.getInputCtrlValue();
+				for (const int &faninID : gate.faninVector_)
+				{
+					if (getGoodVal(faninID) != X)
+					{
+						continue;
+					}
+					const int &level = pCircuit_->circuitGates_[faninID].numLevel_;
+					const int &bestLevel = nextID < 0 ? level : pCircuit_->circuitGates_[nextID].numLevel_;
+					if (nextID < 0 || (isControlling ? level < bestLevel : level > bestLevel))
+					{
+						nextID = faninID;
+					}
+				}
+				break;
+			}
+		}
+		if (nextID < 0)
+		{
+			return false;
+		}
+		gateID = nextID;
+	}
+}
+
+// **************************************************************************
+// Function   [ MultiFaultAtpg::getGoodVal ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Return the good value of a gate, L, H or X. ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+Value MultiFaultAtpg::getGoodVal(const int &gateID) const
+{
+	if (goodLow_[gateID] != PARA_L)
+	{
+		return L;
+	}
+	if (goodHigh_[gateID] != PARA_L)
+	{
+		return H;
+	}
+	return X;
+}
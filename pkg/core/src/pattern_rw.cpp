@@ -9,10 +9,249 @@
 #include <fstream>
 #include <map>
 #include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace IntfNs;
 using namespace CoreNs;
 
+// storage of the in-class constant, std::min takes it by reference
+constexpr int PatternBlock::PATTERNS_PER_BLOCK;
+
+namespace
+{
+	const char PATTERN_MAGIC[4] = {'F', 'A', 'N', 'P'};
+	const uint32_t PATTERN_VERSION = 1;
+	const uint64_t RUN_BIT = (uint64_t)1 << 63;
+	// a shorter run costs as much as the words themselves
+	const size_t MIN_RUN = 3;
+
+	static_assert(sizeof(ParallelValue) == sizeof(uint64_t), "pattern blocks are copied as 64-bit words");
+
+	template <class T>
+	bool writeVal(FILE *fout, const T &val)
+	{
+		return fwrite(&val, sizeof(T), 1, fout) == 1;
+	}
+
+	bool writeName(FILE *fout, const char *const name)
+	{
+		const uint32_t len = strlen(name);
+		return writeVal(fout, len) && (len == 0 || fwrite(name, 1, len, fout) == len);
+	}
+
+	template <class T>
+	bool readVal(const char *&pCur, const char *const pEnd, T &val)
+	{
+		if ((size_t)(pEnd - pCur) < sizeof(T))
+		{
+			return false;
+		}
+		memcpy(&val, pCur, sizeof(T));
+		pCur += sizeof(T);
+		return true;
+	}
+
+	bool readName(const char *&pCur, const char *const pEnd, char *const name)
+	{
+		uint32_t len;
+		if (!readVal(pCur, pEnd, len) || len >= (uint32_t)NAME_LEN || (size_t)(pEnd - pCur) < len)
+		{
+			return false;
+		}
+		memcpy(name, pCur, len);
+		name[len] = '\0';
+		pCur += len;
+		return true;
+	}
+
+	const std::vector<Value> &getField(const Pattern &pattern, const int &field)
+	{
+		switch (field)
+		{
+			case PatternBlock::PI1:
+				return pattern.PI1_;
+			case PatternBlock::PI2:
+				return pattern.PI2_;
+			case PatternBlock::PPI:
+				return pattern.PPI_;
+			case PatternBlock::SI:
+				return pattern.SI_;
+			case PatternBlock::PO1:
+				return pattern.PO1_;
+			case PatternBlock::PO2:
+				return pattern.PO2_;
+			default:
+				return pattern.PPO_;
+		}
+	}
+
+	std::vector<Value> &getField(Pattern &pattern, const int &field)
+	{
+		return const_cast<std::vector<Value> &>(getField((const Pattern &)pattern, field));
+	}
+
+	void flushLiteral(const std::vector<uint64_t> &words, const size_t &begin, const size_t &end,
+										std::vector<uint64_t> &stored)
+	{
+		if (begin < end)
+		{
+			stored.push_back(end - begin);
+			stored.insert(stored.end(), words.begin() + begin, words.begin() + end);
+		}
+	}
+
+	// runs of equal words are common: all-care planes of filled patterns,
+	// all-zero planes of fields a pattern does not use
+	void compressWords(const std::vector<uint64_t> &words, std::vector<uint64_t> &stored)
+	{
+		stored.clear();
+		size_t literalBegin = 0;
+		size_t i = 0;
+		while (i < words.size())
+		{
+			size_t runEnd = i + 1;
+			while (runEnd < words.size() && words[runEnd] == words[i])
+			{
+				++runEnd;
+			}
+			if (runEnd - i >= MIN_RUN)
+			{
+				flushLiteral(words, literalBegin, i, stored);
+				stored.push_back(RUN_BIT | (runEnd - i));
+				stored.push_back(words[i]);
+				literalBegin = runEnd;
+			}
+			i = runEnd;
+		}
+		flushLiteral(words, literalBegin, words.size(), stored);
+	}
+
+	// patterns formatted into one buffer by writeFormatted
+	const int PATTERNS_PER_CHUNK = 256;
+
+	// high bit of every zero byte of w, exact unlike the usual test
+	inline uint64_t zeroBytes(const uint64_t &w)
+	{
+		const uint64_t low7 = 0x7f7f7f7f7f7f7f7fULL;
+		return ~(((w & low7) + low7) | w | low7);
+	}
+
+	// Appends size values as the characters chars[0] for L, chars[1] for
+	// H and chars[2] for anything else, eight values per step as bytes of
+	// a word. Missing values are unknown.
+	void appendValues(std::string &buf, const std::vector<Value> &values, const int &size,
+										const char *const chars, const bool &isReversed)
+	{
+		if (size <= 0)
+		{
+			return;
+		}
+		const size_t begin = buf.size();
+		if ((int)values.size() < size)
+		{
+			buf.append(size, chars[2]);
+			return;
+		}
+		buf.resize(begin + size);
+		char *pOut = &buf[begin];
+		const uint64_t ones = 0x0101010101010101ULL;
+		const uint64_t lowChars = ones * (unsigned char)chars[0];
+		const uint64_t highChars = ones * (unsigned char)chars[1];
+		const uint64_t unknownChars = ones * (unsigned char)chars[2];
+		int j = 0;
+		for (; j + 8 <= size; j += 8)
+		{
+			uint64_t w;
+			memcpy(&w, &values[j], 8);
+			const uint64_t isLow = (zeroBytes(w) >> 7) * 0xff;
+			const uint64_t isHigh = (zeroBytes(w ^ ones) >> 7) * 0xff;
+			const uint64_t out = (lowChars & isLow) | (highChars & isHigh) | (unknownChars & ~(isLow | isHigh));
+			memcpy(pOut + j, &out, 8);
+		}
+		for (; j < size; ++j)
+		{
+			pOut[j] = values[j] == L ? chars[0] : (values[j] == H ? chars[1] : chars[2]);
+		}
+		if (isReversed)
+		{
+			std::reverse(pOut, pOut + size);
+		}
+	}
+
+	void appendInt(std::string &buf, const int &num)
+	{
+		char text[16];
+		buf.append(text, snprintf(text, sizeof(text), "%d", num));
+	}
+}
+
+// **************************************************************************
+// Function   [ PatternReader::read ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Read a pattern file of either format.
+//              description:
+//              	A binary pattern file is decoded block by block into
+//              	patternVector_, which is then in circuit order. Other files
+//              	go through the pattern grammar.
+//              arguments:
+//              	[in] fname : The pattern file.
+//              	[in] verbose : Verbose parsing of a text pattern file.
+//              	[out] bool : Patterns read successfully or not.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternReader::read(const char *const fname, const bool &verbose)
+{
+	if (!PatternBlockReader::isBinaryPatternFile(fname))
+	{
+		return PatFile::read(fname, verbose);
+	}
+
+	PatternBlockReader reader(pPatternProcessor_, pCircuit_);
+	if (!reader.open(fname))
+	{
+		success_ = false;
+		return false;
+	}
+	std::vector<Pattern> &patterns = pPatternProcessor_->patternVector_;
+	patterns.assign(reader.getNumPattern(), Pattern());
+	curPattern_ = 0;
+	PatternBlock block;
+	for (int b = 0; b < reader.getNumBlock(); ++b)
+	{
+		if (!reader.readBlock(b, block))
+		{
+			success_ = false;
+			return false;
+		}
+		for (int j = 0; j < block.numPattern_; ++j, ++curPattern_)
+		{
+			for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+			{
+				const PatternBlock::Field field = (PatternBlock::Field)f;
+				const int numSignal = block.getNumSignal(field);
+				if (numSignal == 0)
+				{
+					continue;
+				}
+				std::vector<Value> &values = getField(patterns[curPattern_], f);
+				values.resize(numSignal);
+				for (int s = 0; s < numSignal; ++s)
+				{
+					values[s] = block.getValue(field, s, j);
+				}
+			}
+		}
+	}
+	return true;
+}
+
 // **************************************************************************
 // Function   [ PatternReader::setPiOrder ]
 // Commenter  [ CHT ]
@@ -528,108 +767,65 @@ bool PatternWriter::writeLht(const char *const fname)
 		return false;
 	}
 
-	for (size_t i = 0; i < pPatternProcessor_->patternVector_.size(); ++i)
-	{
-		fprintf(fout, "%d: ", (int)i + 1);
-		if (!pPatternProcessor_->patternVector_[i].PI1_.empty())
-		{
-			for (int j = 0; j < pPatternProcessor_->numPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PI1_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PI1_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		if (!pPatternProcessor_->patternVector_[i].PI2_.empty())
-		{
-			fprintf(fout, "->");
-			for (int j = 0; j < pPatternProcessor_->numPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PI2_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PI2_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		fprintf(fout, "_");
-		if (!pPatternProcessor_->patternVector_[i].PPI_.empty())
-		{
-			fprintf(fout, "->");
-			for (int j = 0; j < pPatternProcessor_->numPPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PPI_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PPI_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		if (!pPatternProcessor_->patternVector_[i].SI_.empty())
-		{
-			fprintf(fout, "@");
-			for (int j = 0; j < pPatternProcessor_->numSI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].SI_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].SI_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		fprintf(fout, " | ");
+	bool isGood = writeFormatted(fout, &PatternWriter::formatLht);
+	fprintf(fout, "\n");
+	isGood = fclose(fout) == 0 && isGood;
 
-		if (!pPatternProcessor_->patternVector_[i].PO1_.empty() && pPatternProcessor_->type_ == PatternProcessor::BASIC_SCAN)
-		{
-			for (int j = 0; j < pPatternProcessor_->numPO_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PO1_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PO1_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
+	return isGood;
+}
 
-		if (!pPatternProcessor_->patternVector_[i].PO2_.empty() && (pPatternProcessor_->type_ == PatternProcessor::LAUNCH_CAPTURE || pPatternProcessor_->type_ == PatternProcessor::LAUNCH_SHIFT))
-		{
-			for (int j = 0; j < pPatternProcessor_->numPO_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PO2_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PO2_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		fprintf(fout, "_");
-		if (!pPatternProcessor_->patternVector_[i].PPO_.empty())
-		{
-			fprintf(fout, "->");
-			for (int j = 0; j < pPatternProcessor_->numPPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PPO_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PPO_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-		}
-		fprintf(fout, "\n");
+// **************************************************************************
+// Function   [ PatternWriter::formatLht ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Append one pattern in Ling Hsio-Ting's format.
+//              arguments:
+//              	[in] patternIndex : The pattern.
+//              	[in, out] buf : The text of its chunk.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternWriter::formatLht(const int &patternIndex, std::string &buf) const
+{
+	const Pattern &pattern = pPatternProcessor_->patternVector_[patternIndex];
+	appendInt(buf, patternIndex + 1);
+	buf += ": ";
+	if (!pattern.PI1_.empty())
+	{
+		appendValues(buf, pattern.PI1_, pPatternProcessor_->numPI_, "01X", false);
 	}
-	fprintf(fout, "\n");
-	fclose(fout);
+	if (!pattern.PI2_.empty())
+	{
+		buf += "->";
+		appendValues(buf, pattern.PI2_, pPatternProcessor_->numPI_, "01X", false);
+	}
+	buf += "_";
+	if (!pattern.PPI_.empty())
+	{
+		buf += "->";
+		appendValues(buf, pattern.PPI_, pPatternProcessor_->numPPI_, "01X", false);
+	}
+	if (!pattern.SI_.empty())
+	{
+		buf += "@";
+		appendValues(buf, pattern.SI_, pPatternProcessor_->numSI_, "01X", false);
+	}
+	buf += " | ";
 
-	return true;
+	if (!pattern.PO1_.empty() && pPatternProcessor_->type_ == PatternProcessor::BASIC_SCAN)
+	{
+		appendValues(buf, pattern.PO1_, pPatternProcessor_->numPO_, "01X", false);
+	}
+	if (!pattern.PO2_.empty() && (pPatternProcessor_->type_ == PatternProcessor::LAUNCH_CAPTURE || pPatternProcessor_->type_ == PatternProcessor::LAUNCH_SHIFT))
+	{
+		appendValues(buf, pattern.PO2_, pPatternProcessor_->numPO_, "01X", false);
+	}
+	buf += "_";
+	if (!pattern.PPO_.empty())
+	{
+		buf += "->";
+		appendValues(buf, pattern.PPO_, pPatternProcessor_->numPPI_, "01X", false);
+	}
+	buf += "\n";
 }
 
 // **************************************************************************
@@ -763,129 +959,21 @@ bool PatternWriter::writeAscii(const char *const fname)
 	fprintf(fout, "SCAN_TEST =\n");
 	// fprintf(fout, "apply \"test_setup\" 1 0;\n");
 
-	for (int i = 0; i < (int)pPatternProcessor_->patternVector_.size(); ++i)
-	{
-		fprintf(fout, "pattern = %d", i);
-		if (!pPatternProcessor_->patternVector_[i].PI2_.empty())
-			fprintf(fout, " clock_sequential;\n");
-		else
-			fprintf(fout, ";\n");
+	hasClock_ = seqCircuitCheck;
+	bool isGood = writeFormatted(fout, &PatternWriter::formatAscii);
+	fprintf(fout, "end;\n");
 
-		if (pPatternProcessor_->numPPI_)
-		{
-			fprintf(fout, "apply  \"group1_load\" 0 =\n");
-			fprintf(fout, "chain \"chain1\" = \"");
-			for (int j = pPatternProcessor_->numPPI_ - 1; j >= 0; --j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PPI_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PPI_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\";\n");
-			fprintf(fout, "end;\n");
-		}
-		if (!pPatternProcessor_->patternVector_[i].PI1_.empty())
-		{
-			fprintf(fout, "force \"PI\" \"");
-			if (seqCircuitCheck)
-				fprintf(fout, "000");
-			for (int j = 0; j < pPatternProcessor_->numPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PI1_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PI1_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\" 1;\n");
-		}
-		// fprintf(fout, "pulse \"/CK\" 2;\n");
-		if (!pPatternProcessor_->patternVector_[i].PI2_.empty())
-		{
-			if (seqCircuitCheck)
-				fprintf(fout, "pulse \"/CK\" 2;\n");
-			fprintf(fout, "force \"PI\" \"");
-			if (seqCircuitCheck)
-				fprintf(fout, "000");
-			for (int j = 0; j < pPatternProcessor_->numPI_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PI2_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PI2_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\" 3;\n");
-		}
-		if (!pPatternProcessor_->patternVector_[i].PO2_.empty())
+	// scan cells
+	if (seqCircuitCheck)
+	{
+		fprintf(fout, "SCAN_CELLS =\n");
+		fprintf(fout, "scan_group \"group1\" =\n");
+		fprintf(fout, "scan_chain \"chain1\" =\n");
+		for (int i = pCircuit_->numPI_ + pCircuit_->numPPI_ - 1; i >= pCircuit_->numPI_; --i)
 		{
-			fprintf(fout, "measure \"PO\" \"");
-			if (seqCircuitCheck)
-				fprintf(fout, "X");
-			for (int j = 0; j < pPatternProcessor_->numPO_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PO2_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PO2_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\" 4;\n");
-		}
-		else if (!pPatternProcessor_->patternVector_[i].PO1_.empty())
-		{
-			fprintf(fout, "measure \"PO\" \"");
-			if (seqCircuitCheck)
-				fprintf(fout, "X");
-			for (int j = 0; j < pPatternProcessor_->numPO_; ++j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PO1_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PO1_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\" 4;\n");
-		}
-
-		if (pPatternProcessor_->numPPI_)
-		{
-			fprintf(fout, "pulse \"/CK\" 5;\n");
-			fprintf(fout, "apply  \"group1_unload\" 6 =\n");
-			fprintf(fout, "chain \"chain1\" = \"");
-			for (int j = pPatternProcessor_->numPPI_ - 1; j >= 0; --j)
-			{
-				if (pPatternProcessor_->patternVector_[i].PPO_[j] == L)
-					fprintf(fout, "0");
-				else if (pPatternProcessor_->patternVector_[i].PPO_[j] == H)
-					fprintf(fout, "1");
-				else
-					fprintf(fout, "X");
-			}
-			fprintf(fout, "\";\n");
-			fprintf(fout, "end;\n");
-		}
-	}
-	fprintf(fout, "end;\n");
-
-	// scan cells
-	if (seqCircuitCheck)
-	{
-		fprintf(fout, "SCAN_CELLS =\n");
-		fprintf(fout, "scan_group \"group1\" =\n");
-		fprintf(fout, "scan_chain \"chain1\" =\n");
-		for (int i = pCircuit_->numPI_ + pCircuit_->numPPI_ - 1; i >= pCircuit_->numPI_; --i)
-		{
-			fprintf(fout,
-							"scan_cell = %d MASTER FFFF \"/%s\" \"I1\" \"SI\" \"Q\";\n",
-							pCircuit_->numPI_ + pCircuit_->numPPI_ - 1 - i, pCircuit_->pNetlist_->getTop()->getCell(pCircuit_->circuitGates_[i].cellId_)->name_);
+			fprintf(fout,
+							"scan_cell = %d MASTER FFFF \"/%s\" \"I1\" \"SI\" \"Q\";\n",
+							pCircuit_->numPI_ + pCircuit_->numPPI_ - 1 - i, pCircuit_->pNetlist_->getTop()->getCell(pCircuit_->circuitGates_[i].cellId_)->name_);
 		}
 
 		fprintf(fout, "end;\n");
@@ -893,9 +981,76 @@ bool PatternWriter::writeAscii(const char *const fname)
 		fprintf(fout, "end;\n");
 	}
 	fprintf(fout, "\n");
-	fclose(fout);
+	isGood = fclose(fout) == 0 && isGood;
 
-	return true;
+	return isGood;
+}
+
+// **************************************************************************
+// Function   [ PatternWriter::formatAscii ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Append one pattern of the SCAN_TEST section of the
+//                     Mentor ASCII format.
+//              arguments:
+//              	[in] patternIndex : The pattern.
+//              	[in, out] buf : The text of its chunk.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternWriter::formatAscii(const int &patternIndex, std::string &buf) const
+{
+	const Pattern &pattern = pPatternProcessor_->patternVector_[patternIndex];
+	buf += "pattern = ";
+	appendInt(buf, patternIndex);
+	if (!pattern.PI2_.empty())
+		buf += " clock_sequential;\n";
+	else
+		buf += ";\n";
+
+	if (pPatternProcessor_->numPPI_)
+	{
+		buf += "apply  \"group1_load\" 0 =\n";
+		buf += "chain \"chain1\" = \"";
+		appendValues(buf, pattern.PPI_, pPatternProcessor_->numPPI_, "01X", true);
+		buf += "\";\n";
+		buf += "end;\n";
+	}
+	if (!pattern.PI1_.empty())
+	{
+		buf += "force \"PI\" \"";
+		if (hasClock_)
+			buf += "000";
+		appendValues(buf, pattern.PI1_, pPatternProcessor_->numPI_, "01X", false);
+		buf += "\" 1;\n";
+	}
+	if (!pattern.PI2_.empty())
+	{
+		if (hasClock_)
+			buf += "pulse \"/CK\" 2;\n";
+		buf += "force \"PI\" \"";
+		if (hasClock_)
+			buf += "000";
+		appendValues(buf, pattern.PI2_, pPatternProcessor_->numPI_, "01X", false);
+		buf += "\" 3;\n";
+	}
+	if (!pattern.PO2_.empty() || !pattern.PO1_.empty())
+	{
+		buf += "measure \"PO\" \"";
+		if (hasClock_)
+			buf += "X";
+		appendValues(buf, pattern.PO2_.empty() ? pattern.PO1_ : pattern.PO2_, pPatternProcessor_->numPO_, "01X", false);
+		buf += "\" 4;\n";
+	}
+
+	if (pPatternProcessor_->numPPI_)
+	{
+		buf += "pulse \"/CK\" 5;\n";
+		buf += "apply  \"group1_unload\" 6 =\n";
+		buf += "chain \"chain1\" = \"";
+		appendValues(buf, pattern.PPO_, pPatternProcessor_->numPPI_, "01X", true);
+		buf += "\";\n";
+		buf += "end;\n";
+	}
 }
 
 // **************************************************************************
@@ -919,8 +1074,6 @@ bool PatternWriter::writeSTIL(const char *const fname)
 	std::vector<std::string> SCAN_Order;
 	std::vector<std::string> PO_Order;
 
-	std::cout << "==========\n"; //
-
 	PI_Order.push_back("CK");
 	PI_Order.push_back("test_si");
 	PI_Order.push_back("test_se");
@@ -942,119 +1095,16 @@ bool PatternWriter::writeSTIL(const char *const fname)
 		PO_Order.push_back(pCircuit_->pNetlist_->getTop()->getPort(pCircuit_->circuitGates_[i].cellId_)->name_);
 	}
 
-	std::cout << "PI_ORDER ";
-	for (std::string pi : PI_Order)
-	{
-		std::cout << pi << " ";
-	}
-	std::cout << "\n";
-
-	std::cout << "SCAN_ORDER ";
-	for (std::string scan : SCAN_Order)
-	{
-		std::cout << scan << " ";
-	}
-	std::cout << "\n";
-	std::cout << "PO_ORDER ";
-	for (std::string po : PO_Order)
+	FILE *fout = fopen(fname, "w");
+	if (!fout)
 	{
-		std::cout << po << " ";
+		fprintf(stderr, "**ERROR PatternWriter::writeSTIL(): file");
+		fprintf(stderr, "`%s' cannot be opened\n", fname);
+		return false;
 	}
-	std::cout << "\n";
-
-	std::string Processor_Mode = "";
 	int pattern_size = (int)pPatternProcessor_->patternVector_.size();
 
-	switch (pPatternProcessor_->type_)
-	{
-		case PatternProcessor::BASIC_SCAN:
-			Processor_Mode = "BASIC_SCAN";
-			break;
-		case PatternProcessor::LAUNCH_CAPTURE:
-			Processor_Mode = "LAUNCH_ON_CAPTURE";
-			break;
-		case PatternProcessor::LAUNCH_SHIFT:
-			Processor_Mode = "LAUNCH_ON_SHIFT";
-			break;
-	}
-
-	std::cout << Processor_Mode << " " << pattern_size << "\n"; //
-	std::vector<std::map<std::string, std::string>> patternList;
-	for (Pattern pattern : pPatternProcessor_->patternVector_)
-	{
-		std::map<std::string, std::string> map_pattern;
-
-		if (!pattern.PI1_.empty())
-		{
-			map_pattern["pPI1"] = "";
-			for (int j = 0; j < pPatternProcessor_->numPI_; ++j)
-			{
-				if (pattern.PI1_[j] == L)
-					map_pattern["pPI1"] += "0";
-				else if (pattern.PI1_[j] == H)
-					map_pattern["pPI1"] += "1";
-				else
-					map_pattern["pPI1"] += "N";
-			}
-		}
-
-		if (!pattern.PPI_.empty())
-		{
-			map_pattern["pPPI1"] = "";
-			for (int j = 0; j < pPatternProcessor_->numPPI_; ++j)
-			{
-				if (pattern.PPI_[j] == L)
-					map_pattern["pPPI1"] += "0";
-				else if (pattern.PPI_[j] == H)
-					map_pattern["pPPI1"] += "1";
-				else
-					map_pattern["pPPI1"] += "N";
-			}
-			reverse(map_pattern["pPPI1"].begin(), map_pattern["pPPI1"].end());
-		}
-		if (!pattern.PO1_.empty())
-		{
-			map_pattern["pPO1"] = "";
-			for (int j = 0; j < pPatternProcessor_->numPO_; ++j)
-			{
-				if (pattern.PO1_[j] == L)
-					map_pattern["pPO1"] += "L";
-				else if (pattern.PO1_[j] == H)
-					map_pattern["pPO1"] += "H";
-				else
-					map_pattern["pPO1"] += "N";
-			}
-		}
-
-		if (!pattern.PPI_.empty())
-		{
-			map_pattern["pPPO"] = "";
-			for (int j = 0; j < pPatternProcessor_->numPPI_; ++j)
-			{
-				if (pattern.PPO_[j] == L)
-					map_pattern["pPPO"] += "L";
-				else if (pattern.PPO_[j] == H)
-					map_pattern["pPPO"] += "H";
-				else
-					map_pattern["pPPO"] += "N";
-			}
-			std::reverse(map_pattern["pPPO"].begin(), map_pattern["pPPO"].end());
-		}
-		patternList.push_back(map_pattern);
-	}
-	for (size_t i = 0; i < patternList.size(); ++i)
-	{
-		std::cout << "\npattern_" << i + 1 << "\n";
-		std::map<std::string, std::string>::iterator iter;
-		for (iter = patternList[i].begin(); iter != patternList[i].end(); iter++)
-		{
-			std::cout << iter->first << " " << iter->second << "\n";
-		}
-	} //
-
-	std::cout << "==========\n";
-
-	std::ofstream os(fname);
+	std::ostringstream os;
 	os << "STIL 1.0;\n\n";
 
 	/////signals/////
@@ -1214,41 +1264,302 @@ bool PatternWriter::writeSTIL(const char *const fname)
 	os << "   \"precondition all Signals\": C { \"_pi\"=\\r" << PI_Order.size() << " 0 ; \"_po\"=\\r" << PO_Order.size() << " X ; }\n";
 	os << "   Macro \"test_setup\";\n";
 
-	for (int i = 0; i < pattern_size; ++i)
+	const std::string header = os.str();
+	bool isGood = fwrite(header.data(), 1, header.size(), fout) == header.size();
+	numStilPI_ = (int)PI_Order.size();
+	numStilPO_ = (int)PO_Order.size();
+	isGood = isGood && writeFormatted(fout, &PatternWriter::formatStil);
+
+	std::string tail = "   \"end ";
+	appendInt(tail, pattern_size - 1);
+	tail += " unload\":\n";
+	tail += "       Call \"load_unload\" {\n";
+	tail += "           \"test_so\"=";
+	if (pattern_size > 0 && !pPatternProcessor_->patternVector_[pattern_size - 1].PPI_.empty())
 	{
-		os << "   \"pattern " << i << "\":\n";
-		os << "       Call \"load_unload\" {\n";
-		if (i > 0)
+		appendValues(tail, pPatternProcessor_->patternVector_[pattern_size - 1].PPO_, pPatternProcessor_->numPPI_, "LHN", true);
+	}
+	tail += ";\n";
+	tail += "       }\n";
+	tail += "}";
+	isGood = isGood && fwrite(tail.data(), 1, tail.size(), fout) == tail.size();
+	isGood = fclose(fout) == 0 && isGood;
+
+	return isGood;
+}
+
+// **************************************************************************
+// Function   [ PatternWriter::formatStil ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Append one pattern of the STIL pattern block.
+//              description:
+//              	The scan out of a pattern is unloaded while the next one
+//              	is loaded, so the expected PPO values come from the
+//              	previous pattern. Missing PI and PO values are padded to
+//              	the width of the signal groups.
+//              arguments:
+//              	[in] patternIndex : The pattern.
+//              	[in, out] buf : The text of its chunk.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternWriter::formatStil(const int &patternIndex, std::string &buf) const
+{
+	const Pattern &pattern = pPatternProcessor_->patternVector_[patternIndex];
+	buf += "   \"pattern ";
+	appendInt(buf, patternIndex);
+	buf += "\":\n";
+	buf += "       Call \"load_unload\" {\n";
+	if (patternIndex > 0)
+	{
+		const Pattern &previous = pPatternProcessor_->patternVector_[patternIndex - 1];
+		buf += "           \"test_so\"=";
+		if (!previous.PPI_.empty())
+		{
+			appendValues(buf, previous.PPO_, pPatternProcessor_->numPPI_, "LHN", true);
+		}
+		buf += ";\n";
+	}
+	buf += "           \"test_si\"=";
+	if (!pattern.PPI_.empty())
+	{
+		appendValues(buf, pattern.PPI_, pPatternProcessor_->numPPI_, "01N", true);
+	}
+	buf += ";\n";
+	buf += "       }\n";
+	buf += "       Call \"capture_CK\" {\n";
+	buf += "           \"_pi\"=";
+	const int numPI = pattern.PI1_.empty() ? 0 : pPatternProcessor_->numPI_;
+	if (numStilPI_ > numPI)
+	{
+		buf.append(numStilPI_ - numPI, '0');
+	}
+	appendValues(buf, pattern.PI1_, numPI, "01N", false);
+	buf += ";\n";
+	buf += "           \"_po\"=";
+	const int numPO = pattern.PO1_.empty() ? 0 : pPatternProcessor_->numPO_;
+	if (numStilPO_ > numPO)
+	{
+		buf.append(numStilPO_ - numPO, 'L');
+	}
+	appendValues(buf, pattern.PO1_, numPO, "LHN", false);
+	buf += ";\n";
+	buf += "       }\n";
+}
+
+// **************************************************************************
+// Function   [ PatternWriter::writeFormatted ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write the text of all patterns.
+//              description:
+//              	Up to numThread_ chunks are formatted at once, the first
+//              	on this thread, the others on workers. The buffers are
+//              	kept from one round to the next and written in order, so
+//              	the output is the same for any number of threads.
+//              arguments:
+//              	[in] fout : The opened file.
+//              	[in] format : Formatter of one pattern.
+//              	[out] bool : Written successfully or not.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternWriter::writeFormatted(FILE *fout, const PatternFormat &format) const
+{
+	const int numPattern = (int)pPatternProcessor_->patternVector_.size();
+	const int numChunk = (numPattern + PATTERNS_PER_CHUNK - 1) / PATTERNS_PER_CHUNK;
+	const int numWorker = std::max(1, std::min(numThread_, numChunk));
+	std::vector<std::string> bufs(numWorker);
+	std::vector<std::thread> workers;
+	bool isGood = true;
+	for (int roundBegin = 0; roundBegin < numChunk && isGood; roundBegin += numWorker)
+	{
+		const int numRoundChunk = std::min(numWorker, numChunk - roundBegin);
+		for (int c = 1; c < numRoundChunk; ++c)
 		{
-			os << "           \"test_so\"=" << patternList[i - 1]["pPPO"] << ";\n";
+			workers.push_back(std::thread(&PatternWriter::formatChunk, this, format, roundBegin + c, &bufs[c]));
 		}
-		os << "           \"test_si\"=" << patternList[i]["pPPI1"] << ";\n";
-		os << "       }\n";
-		os << "       Call \"capture_CK\" {\n";
-		os << "           \"_pi\"=";
-		for (size_t j = patternList[i]["pPI1"].length(); j < PI_Order.size(); ++j)
+		formatChunk(format, roundBegin, &bufs[0]);
+		for (std::thread &worker : workers)
 		{
-			os << "0";
+			worker.join();
 		}
-		os << patternList[i]["pPI1"] << ";\n";
-		os << "           \"_po\"=";
-		for (size_t j = patternList[i]["pPO1"].length(); j < PO_Order.size(); ++j)
+		workers.clear();
+		for (int c = 0; c < numRoundChunk && isGood; ++c)
 		{
-			os << "L";
+			isGood = fwrite(bufs[c].data(), 1, bufs[c].size(), fout) == bufs[c].size();
 		}
-		os << patternList[i]["pPO1"] << ";\n";
-		os << "       }\n";
 	}
+	return isGood;
+}
 
-	os << "   \"end " << pattern_size - 1 << " unload\":\n";
-	os << "       Call \"load_unload\" {\n";
-	os << "           \"test_so\"=" << patternList[pattern_size - 1]["pPPO"] << ";\n";
-	os << "       }\n";
-	os << "}";
+void PatternWriter::formatChunk(const PatternFormat format, const int chunkIndex, std::string *pBuf) const
+{
+	pBuf->clear();
+	const int begin = chunkIndex * PATTERNS_PER_CHUNK;
+	const int end = std::min(begin + PATTERNS_PER_CHUNK, (int)pPatternProcessor_->patternVector_.size());
+	for (int i = begin; i < end; ++i)
+	{
+		(this->*format)(i, *pBuf);
+	}
+}
 
-	os.close();
+// **************************************************************************
+// Function   [ PatternWriter::writeBinary ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write the patterns to a binary pattern file.
+//              description:
+//              	The layout is described in pattern_rw.h. A field is
+//              	stored if any pattern has it, a pattern without it gets
+//              	X there. The block offsets are written as zeros first and
+//              	filled in once the blocks are out.
+//              arguments:
+//              	[in] fname : The file name to be written to.
+//              	[in] isCompressed : Run-length compress the blocks.
+//              	[out] bool : Output written successfully or not.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternWriter::writeBinary(const char *const fname, const bool &isCompressed)
+{
+	if (pPatternProcessor_->numPI_ != pCircuit_->numPI_ || pPatternProcessor_->numPPI_ != pCircuit_->numPPI_ ||
+			pPatternProcessor_->numPO_ != pCircuit_->numPO_)
+	{
+		fprintf(stderr, "**ERROR PatternWriter::writeBinary(): patterns do not match the circuit\n");
+		return false;
+	}
 
-	return true;
+	const std::vector<Pattern> &patterns = pPatternProcessor_->patternVector_;
+	int numSignal[PatternBlock::NUM_FIELD] = {pPatternProcessor_->numPI_, pPatternProcessor_->numPI_,
+																						pPatternProcessor_->numPPI_, pPatternProcessor_->numSI_,
+																						pPatternProcessor_->numPO_, pPatternProcessor_->numPO_,
+																						pPatternProcessor_->numPPI_};
+	uint32_t fields = 0;
+	for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+	{
+		for (size_t i = 0; i < patterns.size(); ++i)
+		{
+			if (!getField(patterns[i], f).empty())
+			{
+				fields |= 1u << f;
+				break;
+			}
+		}
+		if (!(fields & (1u << f)))
+		{
+			numSignal[f] = 0;
+		}
+	}
+
+	FILE *fout = fopen(fname, "wb");
+	if (!fout)
+	{
+		fprintf(stderr, "**ERROR PatternWriter::writeBinary(): file ");
+		fprintf(stderr, "`%s' cannot be opened\n", fname);
+		return false;
+	}
+
+	const int numPattern = (int)patterns.size();
+	const int numBlock = (numPattern + PatternBlock::PATTERNS_PER_BLOCK - 1) / PatternBlock::PATTERNS_PER_BLOCK;
+	bool isGood = fwrite(PATTERN_MAGIC, 1, 4, fout) == 4 &&
+								writeVal(fout, PATTERN_VERSION) &&
+								writeVal(fout, (uint32_t)pPatternProcessor_->type_) &&
+								writeVal(fout, (uint32_t)(isCompressed ? 1 : 0)) &&
+								writeVal(fout, fields) &&
+								writeVal(fout, (uint32_t)pPatternProcessor_->numPI_) &&
+								writeVal(fout, (uint32_t)pPatternProcessor_->numPPI_) &&
+								writeVal(fout, (uint32_t)pPatternProcessor_->numSI_) &&
+								writeVal(fout, (uint32_t)pPatternProcessor_->numPO_) &&
+								writeVal(fout, (uint64_t)numPattern) &&
+								writeVal(fout, (uint32_t)PatternBlock::PATTERNS_PER_BLOCK) &&
+								writeVal(fout, (uint32_t)numBlock);
+
+	Cell *pTop = pCircuit_->pNetlist_->getTop();
+	for (int i = 0; i < pCircuit_->numPI_ && isGood; ++i)
+	{
+		isGood = writeName(fout, pTop->getPort(pCircuit_->circuitGates_[i].cellId_)->name_);
+	}
+	for (int i = pCircuit_->numPI_; i < pCircuit_->numPI_ + pCircuit_->numPPI_ && isGood; ++i)
+	{
+		isGood = writeName(fout, pTop->getCell(pCircuit_->circuitGates_[i].cellId_)->name_);
+	}
+	const int poStart = pCircuit_->numPI_ + pCircuit_->numPPI_ + pCircuit_->numComb_;
+	for (int i = poStart; i < poStart + pCircuit_->numPO_ && isGood; ++i)
+	{
+		isGood = writeName(fout, pTop->getPort(pCircuit_->circuitGates_[i].cellId_)->name_);
+	}
+	while (isGood && ftell(fout) % sizeof(uint64_t) != 0)
+	{
+		isGood = fputc(0, fout) != EOF;
+	}
+
+	const long tablePos = ftell(fout);
+	std::vector<uint64_t> offsets(numBlock + 1, 0);
+	isGood = isGood && tablePos >= 0 && fwrite(&offsets[0], sizeof(uint64_t), offsets.size(), fout) == offsets.size();
+
+	std::vector<uint64_t> words;
+	std::vector<uint64_t> stored;
+	for (int b = 0; b < numBlock && isGood; ++b)
+	{
+		offsets[b] = ftell(fout);
+		const int begin = b * PatternBlock::PATTERNS_PER_BLOCK;
+		const int numBlockPattern = std::min(PatternBlock::PATTERNS_PER_BLOCK, numPattern - begin);
+		const int numWord = (numBlockPattern + WORD_SIZE - 1) / WORD_SIZE;
+
+		// value and care planes of every stored signal, in file order
+		size_t numPlaneWord = 0;
+		for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+		{
+			numPlaneWord += (size_t)numSignal[f] * 2 * numWord;
+		}
+		words.assign(numPlaneWord, 0);
+		size_t plane = 0;
+		for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+		{
+			for (int j = 0; j < numBlockPattern; ++j)
+			{
+				const std::vector<Value> &values = getField(patterns[begin + j], f);
+				if (values.empty())
+				{
+					continue;
+				}
+				const uint64_t bit = (uint64_t)1 << (j % WORD_SIZE);
+				for (int s = 0; s < numSignal[f]; ++s)
+				{
+					const size_t valueWord = plane + (size_t)s * 2 * numWord + j / WORD_SIZE;
+					if (values[s] == H)
+					{
+						words[valueWord] |= bit;
+						words[valueWord + numWord] |= bit;
+					}
+					else if (values[s] == L)
+					{
+						words[valueWord + numWord] |= bit;
+					}
+				}
+			}
+			plane += (size_t)numSignal[f] * 2 * numWord;
+		}
+
+		if (isCompressed)
+		{
+			compressWords(words, stored);
+			isGood = stored.empty() || fwrite(&stored[0], sizeof(uint64_t), stored.size(), fout) == stored.size();
+		}
+		else
+		{
+			isGood = words.empty() || fwrite(&words[0], sizeof(uint64_t), words.size(), fout) == words.size();
+		}
+	}
+	offsets[numBlock] = ftell(fout);
+
+	isGood = isGood && fseek(fout, tablePos, SEEK_SET) == 0 &&
+					 fwrite(&offsets[0], sizeof(uint64_t), offsets.size(), fout) == offsets.size();
+	isGood = fclose(fout) == 0 && isGood;
+	if (!isGood)
+	{
+		fprintf(stderr, "**ERROR PatternWriter::writeBinary(): cannot write `%s'\n", fname);
+	}
+	return isGood;
 }
 
 // **************************************************************************
@@ -1312,3 +1623,472 @@ bool ProcedureWriter::writeProcedure(const char *const fname)
 	fclose(fout);
 	return true;
 }
+
+// **************************************************************************
+// Function   [ PatternBlockReader::isBinaryPatternFile ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check whether a file starts with the binary pattern
+//                     magic.
+//              arguments:
+//              	[in] fname : The file.
+//              	[out] bool : True for a binary pattern file.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternBlockReader::isBinaryPatternFile(const char *const fname)
+{
+	FILE *fin = fopen(fname, "rb");
+	if (!fin)
+	{
+		return false;
+	}
+	char magic[4];
+	const bool isBinary = fread(magic, 1, 4, fin) == 4 && memcmp(magic, PATTERN_MAGIC, 4) == 0;
+	fclose(fin);
+	return isBinary;
+}
+
+// **************************************************************************
+// Function   [ PatternBlockReader::open ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Map a binary pattern file and read its header.
+//              description:
+//              	The sizes must be those of the circuit and every name
+//              	must be one of its PIs, PPIs or POs. The block offsets are
+//              	checked here so that readBlock() only has to check what
+//              	it decodes. The PatternProcessor gets the type and sizes
+//              	of the file and the circuit orders.
+//              arguments:
+//              	[in] fname : The binary pattern file.
+//              	[out] bool : Header read successfully or not.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternBlockReader::open(const char *const fname)
+{
+	close();
+	if (!pCircuit_ || !pCircuit_->pNetlist_)
+	{
+		return false;
+	}
+
+	const int fd = ::open(fname, O_RDONLY);
+	if (fd < 0)
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): file ");
+		fprintf(stderr, "`%s' cannot be opened\n", fname);
+		return false;
+	}
+	struct stat st;
+	void *buf = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	::close(fd);
+	if (buf == MAP_FAILED)
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): file ");
+		fprintf(stderr, "`%s' cannot be mapped\n", fname);
+		return false;
+	}
+	buf_ = (const char *)buf;
+	size_ = st.st_size;
+	madvise(buf, size_, MADV_SEQUENTIAL);
+
+	const char *pCur = buf_;
+	const char *const pEnd = buf_ + size_;
+	char magic[4];
+	uint32_t version, type, flags, fields, numPI, numPPI, numSI, numPO, patternsPerBlock, numBlock;
+	uint64_t numPattern;
+	bool isGood = readVal(pCur, pEnd, magic) && memcmp(magic, PATTERN_MAGIC, 4) == 0 &&
+								readVal(pCur, pEnd, version) && version == PATTERN_VERSION &&
+								readVal(pCur, pEnd, type) && type <= PatternProcessor::LAUNCH_SHIFT &&
+								readVal(pCur, pEnd, flags) && readVal(pCur, pEnd, fields) &&
+								readVal(pCur, pEnd, numPI) && readVal(pCur, pEnd, numPPI) &&
+								readVal(pCur, pEnd, numSI) && readVal(pCur, pEnd, numPO) &&
+								readVal(pCur, pEnd, numPattern) && numPattern < (1u << 31) &&
+								readVal(pCur, pEnd, patternsPerBlock) && patternsPerBlock > 0 &&
+								patternsPerBlock % WORD_SIZE == 0 && patternsPerBlock < (1u << 24) &&
+								readVal(pCur, pEnd, numBlock) &&
+								numBlock == (numPattern + patternsPerBlock - 1) / patternsPerBlock;
+	if (!isGood)
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): `%s' has a bad header\n", fname);
+		close();
+		return false;
+	}
+	if ((int)numPI != pCircuit_->numPI_ || (int)numPPI != pCircuit_->numPPI_ || (int)numPO != pCircuit_->numPO_ ||
+			numSI > 1)
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): `%s' does not match the circuit\n", fname);
+		close();
+		return false;
+	}
+
+	isCompressed_ = flags & 1;
+	numPattern_ = (int)numPattern;
+	patternsPerBlock_ = (int)patternsPerBlock;
+	numBlock_ = (int)numBlock;
+	const int numSignal[PatternBlock::NUM_FIELD] = {(int)numPI, (int)numPI, (int)numPPI, (int)numSI,
+																									(int)numPO, (int)numPO, (int)numPPI};
+	for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+	{
+		numSignal_[f] = (fields & (1u << f)) ? numSignal[f] : 0;
+	}
+
+	if (!readOrder(pCur, PatternBlock::PI1, numPI) || !readOrder(pCur, PatternBlock::PPI, numPPI) ||
+			!readOrder(pCur, PatternBlock::PO1, numPO))
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): `%s' does not match the circuit\n", fname);
+		close();
+		return false;
+	}
+	order_[PatternBlock::PI2] = order_[PatternBlock::PI1];
+	order_[PatternBlock::PO2] = order_[PatternBlock::PO1];
+	order_[PatternBlock::PPO] = order_[PatternBlock::PPI];
+	order_[PatternBlock::SI].assign(numSI, 0);
+
+	// the offset table and the blocks are aligned to their words
+	pCur += (sizeof(uint64_t) - (pCur - buf_) % sizeof(uint64_t)) % sizeof(uint64_t);
+	isGood = pCur <= pEnd && (size_t)(pEnd - pCur) / sizeof(uint64_t) > numBlock;
+	if (isGood)
+	{
+		blockOffset_ = (const uint64_t *)pCur;
+		const uint64_t dataBegin = (pCur - buf_) + (numBlock + 1) * sizeof(uint64_t);
+		for (int b = 0; b <= numBlock_ && isGood; ++b)
+		{
+			isGood = blockOffset_[b] % sizeof(uint64_t) == 0 && blockOffset_[b] <= size_ &&
+							 blockOffset_[b] >= (b == 0 ? dataBegin : blockOffset_[b - 1]);
+		}
+	}
+	if (!isGood)
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::open(): `%s' is truncated\n", fname);
+		close();
+		return false;
+	}
+
+	if (pPatternProcessor_)
+	{
+		pPatternProcessor_->init(pCircuit_);
+		pPatternProcessor_->type_ = (PatternProcessor::Type)type;
+		pPatternProcessor_->numSI_ = numSI;
+		pPatternProcessor_->patternVector_.clear();
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ PatternBlockReader::close ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Unmap the file.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternBlockReader::close()
+{
+	if (buf_)
+	{
+		munmap((void *)buf_, size_);
+	}
+	buf_ = NULL;
+	size_ = 0;
+	blockOffset_ = NULL;
+	numPattern_ = 0;
+	numBlock_ = 0;
+}
+
+// **************************************************************************
+// Function   [ PatternBlockReader::readBlock ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Decode one block.
+//              description:
+//              	The planes of every stored signal are copied to the
+//              	position of the signal in the circuit. A compressed block
+//              	is expanded first.
+//              arguments:
+//              	[in] blockIndex : The block, from 0.
+//              	[out] block : Its patterns.
+//              	[out] bool : False if the block is corrupted.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternBlockReader::readBlock(const int &blockIndex, PatternBlock &block) const
+{
+	if (blockIndex < 0 || blockIndex >= numBlock_)
+	{
+		return false;
+	}
+	const int begin = blockIndex * patternsPerBlock_;
+	block.init(numSignal_, std::min(patternsPerBlock_, numPattern_ - begin));
+
+	const size_t numWord = block.numWord_;
+	const uint64_t *pWord = (const uint64_t *)(buf_ + blockOffset_[blockIndex]);
+	const size_t numStored = (blockOffset_[blockIndex + 1] - blockOffset_[blockIndex]) / sizeof(uint64_t);
+	std::vector<uint64_t> words;
+	if (isCompressed_)
+	{
+		words.resize(block.planes_.size());
+		if (!decodeBlock(pWord, numStored, words))
+		{
+			fprintf(stderr, "**ERROR PatternBlockReader::readBlock(): block %d is corrupted\n", blockIndex);
+			return false;
+		}
+		pWord = words.empty() ? NULL : &words[0];
+	}
+	else if (numStored != block.planes_.size())
+	{
+		fprintf(stderr, "**ERROR PatternBlockReader::readBlock(): block %d is corrupted\n", blockIndex);
+		return false;
+	}
+
+	for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+	{
+		const PatternBlock::Field field = (PatternBlock::Field)f;
+		for (int s = 0; s < numSignal_[f]; ++s)
+		{
+			memcpy(block.getValuePlane(field, order_[f][s]), pWord, numWord * sizeof(uint64_t));
+			memcpy(block.getCarePlane(field, order_[f][s]), pWord + numWord, numWord * sizeof(uint64_t));
+			pWord += 2 * numWord;
+		}
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ PatternBlockReader::readOrder ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Map the names of one field to circuit positions.
+//              description:
+//              	PIs and POs are ports of the top cell, PPIs are its
+//              	flip-flops, as in PatternReader::setPiOrder and the
+//              	others. Each position may be named once.
+//              arguments:
+//              	[in, out] pCur : The names, moved past them.
+//              	[in] field : PI1, PPI or PO1.
+//              	[in] numSignal : Number of names.
+//              	[out] bool : False for an unknown or repeated name.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternBlockReader::readOrder(const char *&pCur, const PatternBlock::Field &field, const int &numSignal)
+{
+	Cell *pTop = pCircuit_->pNetlist_->getTop();
+	int base = 0;
+	if (field == PatternBlock::PPI)
+	{
+		base = pCircuit_->numPI_;
+	}
+	else if (field == PatternBlock::PO1)
+	{
+		base = pCircuit_->numGate_ - pCircuit_->numPO_ - pCircuit_->numPPI_;
+	}
+
+	std::vector<char> isNamed(numSignal, 0);
+	order_[field].resize(numSignal);
+	char name[NAME_LEN];
+	for (int s = 0; s < numSignal; ++s)
+	{
+		if (!readName(pCur, buf_ + size_, name))
+		{
+			return false;
+		}
+		int gateID = -1;
+		if (field == PatternBlock::PPI)
+		{
+			Cell *pCell = pTop->getCell(name);
+			gateID = pCell ? pCircuit_->cellIndexToGateIndex_[pCell->id_] : -1;
+		}
+		else
+		{
+			Port *pPort = pTop->getPort(name);
+			gateID = pPort ? pCircuit_->portIndexToGateIndex_[pPort->id_] : -1;
+		}
+		const int index = gateID - base;
+		if (gateID < 0 || index < 0 || index >= numSignal || isNamed[index])
+		{
+			fprintf(stderr, "**ERROR PatternBlockReader::readOrder(): `%s' not found\n", name);
+			return false;
+		}
+		isNamed[index] = 1;
+		order_[field][s] = index;
+	}
+	return true;
+}
+
+// **************************************************************************
+// Function   [ PatternBlockReader::decodeBlock ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Expand a compressed block.
+//              arguments:
+//              	[in] pWord : The stored words.
+//              	[in] numStored : Number of stored words.
+//              	[out] words : The planes, sized by the caller.
+//              	[out] bool : False unless the block fills words exactly.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool PatternBlockReader::decodeBlock(const uint64_t *pWord, const size_t &numStored, std::vector<uint64_t> &words) const
+{
+	size_t out = 0;
+	size_t i = 0;
+	while (i < numStored)
+	{
+		const uint64_t control = pWord[i++];
+		const uint64_t count = control & ~RUN_BIT;
+		if (count > words.size() - out)
+		{
+			return false;
+		}
+		if (control & RUN_BIT)
+		{
+			if (i >= numStored)
+			{
+				return false;
+			}
+			std::fill(words.begin() + out, words.begin() + out + count, pWord[i++]);
+		}
+		else
+		{
+			if (count > numStored - i)
+			{
+				return false;
+			}
+			std::copy(pWord + i, pWord + i + count, words.begin() + out);
+			i += count;
+		}
+		out += count;
+	}
+	return out == words.size();
+}
+
+// **************************************************************************
+// Function   [ PatternBlockStream::start ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Start the reader thread.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternBlockStream::start()
+{
+	reader_ = std::thread(&PatternBlockStream::run, this);
+}
+
+// **************************************************************************
+// Function   [ PatternBlockStream::acquire ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Wait for the next decoded block.
+//              description:
+//              	Blocks decoded before the reader failed or was stopped are
+//              	still handed out; isFailed() tells a corrupted file from
+//              	the end of it.
+//              arguments:
+//              	[out] const PatternBlock * : The block, NULL if there is
+//              	                             none left.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+const PatternBlock *PatternBlockStream::acquire()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (numProduced_ == numConsumed_ && !isStopped_ && numProduced_ < pReader_->getNumBlock())
+	{
+		notEmpty_.wait(lock);
+	}
+	if (numProduced_ == numConsumed_)
+	{
+		return NULL;
+	}
+	return &slots_[numConsumed_ % slots_.size()];
+}
+
+// **************************************************************************
+// Function   [ PatternBlockStream::release ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Give the block of the last acquire() back to the
+//                     reader.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternBlockStream::release()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++numConsumed_;
+	}
+	notFull_.notify_one();
+}
+
+// **************************************************************************
+// Function   [ PatternBlockStream::stop ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Stop the reader and join it.
+//              description:
+//              	Called when the simulation needs no more patterns, and by
+//              	the destructor.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternBlockStream::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isStopped_ = true;
+	}
+	notFull_.notify_all();
+	notEmpty_.notify_all();
+	if (reader_.joinable())
+	{
+		reader_.join();
+	}
+}
+
+// **************************************************************************
+// Function   [ PatternBlockStream::run ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Body of the reader thread.
+//              description:
+//              	A slot is decoded outside the lock: the consumer only
+//              	reads slots of produced blocks, and the reader only
+//              	writes a slot once the block that held it was released.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void PatternBlockStream::run()
+{
+	const int numSlot = (int)slots_.size();
+	for (int blockIndex = 0; blockIndex < pReader_->getNumBlock(); ++blockIndex)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			while (!isStopped_ && numProduced_ - numConsumed_ >= numSlot)
+			{
+				notFull_.wait(lock);
+			}
+			if (isStopped_)
+			{
+				return;
+			}
+		}
+		const bool isGood = pReader_->readBlock(blockIndex, slots_[blockIndex % numSlot]);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (isGood)
+			{
+				++numProduced_;
+			}
+			else if (!isStopped_)
+			{
+				// a block read after stop() is not needed, nor is its error
+				isFailed_ = true;
+				isStopped_ = true;
+			}
+		}
+		notEmpty_.notify_one();
+		if (!isGood)
+		{
+			return;
+		}
+	}
+}
@@ -8,6 +8,12 @@
 #ifndef _CORE_PATTERN_RW_H_
 #define _CORE_PATTERN_RW_H_
 
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+
 #include "interface/pat_file.h"
 
 #include "circuit.h"
@@ -21,6 +27,9 @@ namespace CoreNs
 	public:
 		PatternReader(PatternProcessor *pPatternProcessor, Circuit *pCircuit);
 		~PatternReader();
+		// a binary pattern file is recognized by its magic and read
+		// through PatternBlockReader, anything else by the pattern grammar
+		virtual bool read(const char *const fname, const bool &verbose = false);
 		virtual void setPiOrder(const IntfNs::PatNames *const pPIs);
 		virtual void setPpiOrder(const IntfNs::PatNames *const pPPIs);
 		virtual void setPoOrder(const IntfNs::PatNames *const pPOs);
@@ -58,20 +67,194 @@ namespace CoreNs
 		bool writeLht(const char *const fname); // no longer supported
 		bool writeAscii(const char *const fname);
 		bool writeSTIL(const char *const fname); // 2016 summer train
+		bool writeBinary(const char *const fname, const bool &isCompressed = false);
+		// threads formatting the patterns of writeLht, writeAscii and
+		// writeSTIL
+		inline void setNumThread(const int &numThread);
 
 	protected:
+		// Appends the text of one pattern to a buffer.
+		typedef void (PatternWriter::*PatternFormat)(const int &patternIndex, std::string &buf) const;
+
+		// The patterns are formatted in chunks, one buffer per chunk and up
+		// to numThread_ chunks at a time, and the buffers are written in
+		// pattern order with one fwrite each.
+		bool writeFormatted(FILE *fout, const PatternFormat &format) const;
+		void formatChunk(const PatternFormat format, const int chunkIndex, std::string *pBuf) const;
+		void formatLht(const int &patternIndex, std::string &buf) const;
+		void formatAscii(const int &patternIndex, std::string &buf) const;
+		void formatStil(const int &patternIndex, std::string &buf) const;
+
 		PatternProcessor *pPatternProcessor_;
 		Circuit *pCircuit_;
+		int numThread_;
+		bool hasClock_;	 // ASCII, the top cell has a CK port
+		int numStilPI_; // STIL, PIs with the clock and scan ports
+		int numStilPO_;
 	};
 
 	inline PatternWriter::PatternWriter(PatternProcessor *pPatternProcessor, Circuit *pCircuit)
 	{
 		pPatternProcessor_ = pPatternProcessor;
 		pCircuit_ = pCircuit;
+		numThread_ = 1;
+		hasClock_ = false;
+		numStilPI_ = 0;
+		numStilPO_ = 0;
 	}
 
 	inline PatternWriter::~PatternWriter() {}
 
+	inline void PatternWriter::setNumThread(const int &numThread)
+	{
+		numThread_ = numThread < 1 ? 1 : numThread;
+	}
+
+	// ************************************
+	// * binary pattern file, native byte order
+	// *     char[4]  magic "FANP"
+	// *     uint32   version
+	// *     uint32   pattern type, PatternProcessor::Type
+	// *     uint32   flags, bit 0 set if the blocks are compressed
+	// *     uint32   fields, bit f set if PatternBlock::Field f is stored
+	// *     uint32   number of PIs, PPIs, SIs and POs
+	// *     uint64   number of patterns
+	// *     uint32   patterns per block, a multiple of 64
+	// *     uint32   number of blocks
+	// *     names    of the PIs, PPIs and POs, uint32 length and the
+	// *              characters, no terminator
+	// *     padding  to 8 bytes
+	// *     uint64   offset of every block, then the end of the last one
+	// *     blocks   of uint64 words, for every stored field and every
+	// *              signal the value plane, then the care plane
+	// * A compressed block is a run of control words: with bit 63 set,
+	// * the next word repeated by the low bits; otherwise that many
+	// * words copied as they are.
+	// ************************************
+
+	// Maps a binary pattern file and decodes it one block at a time, so
+	// a pattern set need not be held in a PatternProcessor to be
+	// simulated. open() matches the names in the header against the
+	// circuit and sets the type, sizes and orders of the
+	// PatternProcessor; blocks come out in circuit order. readBlock() does
+	// not change the reader and can be called from several threads.
+	class PatternBlockReader
+	{
+	public:
+		PatternBlockReader(PatternProcessor *pPatternProcessor, Circuit *pCircuit);
+		~PatternBlockReader();
+
+		static bool isBinaryPatternFile(const char *const fname);
+
+		bool open(const char *const fname);
+		void close();
+		bool readBlock(const int &blockIndex, PatternBlock &block) const;
+		inline int getNumPattern() const;
+		inline int getNumBlock() const;
+
+	private:
+		bool readOrder(const char *&pCur, const PatternBlock::Field &field, const int &numSignal);
+		bool decodeBlock(const uint64_t *pWord, const size_t &numStored, std::vector<uint64_t> &words) const;
+
+		PatternProcessor *pPatternProcessor_;
+		Circuit *pCircuit_;
+		const char *buf_;
+		size_t size_;
+		bool isCompressed_;
+		int numSignal_[PatternBlock::NUM_FIELD]; // stored signals of each field
+		int numPattern_;
+		int patternsPerBlock_;
+		int numBlock_;
+		const uint64_t *blockOffset_;
+		std::vector<int> order_[PatternBlock::NUM_FIELD]; // circuit index of each stored signal
+	};
+
+	inline PatternBlockReader::PatternBlockReader(PatternProcessor *pPatternProcessor, Circuit *pCircuit)
+	{
+		pPatternProcessor_ = pPatternProcessor;
+		pCircuit_ = pCircuit;
+		buf_ = NULL;
+		size_ = 0;
+		isCompressed_ = false;
+		numPattern_ = 0;
+		patternsPerBlock_ = 0;
+		numBlock_ = 0;
+		blockOffset_ = NULL;
+		for (int f = 0; f < PatternBlock::NUM_FIELD; ++f)
+		{
+			numSignal_[f] = 0;
+		}
+	}
+
+	inline PatternBlockReader::~PatternBlockReader()
+	{
+		close();
+	}
+
+	inline int PatternBlockReader::getNumPattern() const
+	{
+		return numPattern_;
+	}
+
+	inline int PatternBlockReader::getNumBlock() const
+	{
+		return numBlock_;
+	}
+
+	// Decodes the blocks of a PatternBlockReader on a thread of its own
+	// into a ring of numSlot blocks, which the simulation takes in order.
+	// The reader waits while the ring is full, so memory does not grow
+	// with the number of patterns.
+	class PatternBlockStream
+	{
+	public:
+		PatternBlockStream(const PatternBlockReader *pReader, const int &numSlot = 4);
+		~PatternBlockStream();
+
+		void start();
+		// The next block, NULL after the last one or once the reader
+		// failed or was stopped. It stays valid until release().
+		const PatternBlock *acquire();
+		void release();
+		// Lets the reader quit at its next block and waits for it.
+		void stop();
+		inline bool isFailed() const;
+
+	private:
+		void run();
+
+		const PatternBlockReader *pReader_;
+		std::vector<PatternBlock> slots_;
+		int numProduced_; // blocks decoded, block b goes to slot b % numSlot
+		int numConsumed_; // blocks released
+		bool isStopped_;
+		bool isFailed_;
+		std::mutex mutex_;
+		std::condition_variable notFull_;
+		std::condition_variable notEmpty_;
+		std::thread reader_;
+	};
+
+	inline PatternBlockStream::PatternBlockStream(const PatternBlockReader *pReader, const int &numSlot)
+			: pReader_(pReader),
+				slots_(numSlot < 1 ? 1 : numSlot)
+	{
+		numProduced_ = 0;
+		numConsumed_ = 0;
+		isStopped_ = false;
+		isFailed_ = false;
+	}
+
+	inline PatternBlockStream::~PatternBlockStream()
+	{
+		stop();
+	}
+
+	inline bool PatternBlockStream::isFailed() const
+	{
+		return isFailed_;
+	}
+
 	class ProcedureWriter
 	{
 	public:
@@ -5,7 +5,12 @@
 // Date       [ 2011/09/14 created ]
 // **************************************************************************
 
+#include <algorithm>
+
 #include "simulator.h"
+#include "timing.h"
+#include "pattern_rw.h"
+#include "common/trace.h"
 
 using namespace IntfNs;
 using namespace CoreNs;
@@ -74,11 +79,12 @@ void Simulator::eventFaultSim()
 // **************************************************************************
 void Simulator::parallelFaultFaultSimWithAllPattern(PatternProcessor *pPatternCollector, FaultListExtract *pFaultListExtract)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelFaultFaultSimWithAllPattern");
 	// Undetected faults are remaining faults.
 	FaultPtrList remainingFaults;
 	for (Fault *const &pFault : pFaultListExtract->faultsInCircuit_)
 	{
-		bool faultNotDetect = pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultyLine_ >= 0;
+		bool faultNotDetect = pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultState_ != Fault::TI && pFault->faultyLine_ >= 0;
 		if (faultNotDetect)
 		{
 			remainingFaults.push_back(pFault);
@@ -114,6 +120,7 @@ void Simulator::parallelFaultFaultSimWithAllPattern(PatternProcessor *pPatternCo
 // **************************************************************************
 void Simulator::parallelFaultFaultSimWithOnePattern(const Pattern &pattern, FaultPtrList &remainingFaults)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelFaultFaultSimWithOnePattern");
 	// Assign pattern to circuit PI & PPI for further fault simulation.
 	assignPatternToCircuitInputs(pattern);
 	parallelFaultFaultSim(remainingFaults);
@@ -136,6 +143,7 @@ void Simulator::parallelFaultFaultSimWithOnePattern(const Pattern &pattern, Faul
 // **************************************************************************
 void Simulator::parallelFaultFaultSim(FaultPtrList &remainingFaults)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelFaultFaultSim");
 	if (remainingFaults.size() == 0)
 	{
 		return;
@@ -177,6 +185,7 @@ void Simulator::parallelFaultFaultSim(FaultPtrList &remainingFaults)
 // **************************************************************************
 void Simulator::parallelPatternGoodSimWithAllPattern(PatternProcessor *pPatternCollector)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelPatternGoodSimWithAllPattern");
 	for (int patternStartIndex = 0; patternStartIndex < (int)pPatternCollector->patternVector_.size(); patternStartIndex += WORD_SIZE)
 	{
 		parallelPatternSetPattern(pPatternCollector, patternStartIndex);
@@ -184,6 +193,59 @@ void Simulator::parallelPatternGoodSimWithAllPattern(PatternProcessor *pPatternC
 	}
 }
 
+// **************************************************************************
+// Function   [ Simulator::parallelPatternWriteGoodSimValToPatternPO ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Recompute the PO and PPO values of all patterns.
+//              description:
+//              	Same as parallelPatternGoodSimWithAllPattern, but the good
+//              	values of the PO/PPO gates are written back to PO1_, PO2_
+//              	and PPO_ of every pattern, as Atpg does for one pattern.
+//              	Used when patterns are applied to a circuit other than the
+//              	one they were generated on.
+//              arguments:
+//              	[in, out] pPatternCollector : The patterns to update.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Simulator::parallelPatternWriteGoodSimValToPatternPO(PatternProcessor *pPatternCollector)
+{
+	CommonNs::TraceScope traceScope("Simulator::parallelPatternWriteGoodSimValToPatternPO");
+	const int poOffset = pCircuit_->numGate_ - pCircuit_->numPO_ - pCircuit_->numPPI_;
+	const int ppoOffset = pCircuit_->numGate_ - pCircuit_->numPPI_ + (pCircuit_->numFrame_ > 1 ? pCircuit_->numGate_ : 0);
+	for (int patternStartIndex = 0; patternStartIndex < (int)pPatternCollector->patternVector_.size(); patternStartIndex += WORD_SIZE)
+	{
+		parallelPatternSetPattern(pPatternCollector, patternStartIndex);
+		goodSim();
+		const int endpat = std::min((int)pPatternCollector->patternVector_.size(), patternStartIndex + (int)WORD_SIZE);
+		for (int j = patternStartIndex; j < endpat; ++j)
+		{
+			Pattern &pattern = pPatternCollector->patternVector_[j];
+			const ParallelValue mask = (ParallelValue)0x01 << (j - patternStartIndex);
+			pattern.PO1_.resize(pCircuit_->numPO_);
+			pattern.PPO_.resize(pCircuit_->numPPI_);
+			for (int i = 0; i < pCircuit_->numPO_; ++i)
+			{
+				const Gate &gate = pCircuit_->circuitGates_[poOffset + i];
+				pattern.PO1_[i] = (gate.goodSimLow_ & mask) ? L : ((gate.goodSimHigh_ & mask) ? H : X);
+			}
+			if (!pattern.PO2_.empty() && pCircuit_->numFrame_ > 1)
+			{
+				for (int i = 0; i < pCircuit_->numPO_; ++i)
+				{
+					const Gate &gate = pCircuit_->circuitGates_[poOffset + i + pCircuit_->numGate_];
+					pattern.PO2_[i] = (gate.goodSimLow_ & mask) ? L : ((gate.goodSimHigh_ & mask) ? H : X);
+				}
+			}
+			for (int i = 0; i < pCircuit_->numPPI_; ++i)
+			{
+				const Gate &gate = pCircuit_->circuitGates_[ppoOffset + i];
+				pattern.PPO_[i] = (gate.goodSimLow_ & mask) ? L : ((gate.goodSimHigh_ & mask) ? H : X);
+			}
+		}
+	}
+}
+
 // **************************************************************************
 // Function   [ Simulator::parallelPatternFaultSimWithAllPattern ]
 // Commenter  [ littleshamoo, PYH ]
@@ -202,11 +264,12 @@ void Simulator::parallelPatternGoodSimWithAllPattern(PatternProcessor *pPatternC
 // **************************************************************************
 void Simulator::parallelPatternFaultSimWithAllPattern(PatternProcessor *pPatternCollector, FaultListExtract *pFaultListExtract)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelPatternFaultSimWithAllPattern");
 	// Undetected faults are remaining faults.
 	FaultPtrList remainingFaults;
 	for (Fault *const &pFault : pFaultListExtract->faultsInCircuit_)
 	{
-		bool faultNotDetect = pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultyLine_ >= 0;
+		bool faultNotDetect = pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultState_ != Fault::TI && pFault->faultyLine_ >= 0;
 		if (faultNotDetect)
 		{
 			remainingFaults.push_back(pFault);
@@ -221,6 +284,60 @@ void Simulator::parallelPatternFaultSimWithAllPattern(PatternProcessor *pPattern
 	}
 }
 
+// **************************************************************************
+// Function   [ Simulator::parallelPatternFaultSimWithPatternBlocks ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Perform parallel pattern fault simulation on the
+//                     patterns of a binary pattern file.
+//              description:
+//              	A reader thread decodes the blocks into a small ring, so
+//              	the pattern set is never held as a whole. The simulation
+//              	ends early once every fault is detected.
+//              arguments:
+//              	[in] pReader : The opened binary pattern file.
+//              	[in] pFaultListExtract : The list of faults to be simulated.
+//              	[out] bool : False if a block cannot be decoded.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool Simulator::parallelPatternFaultSimWithPatternBlocks(const PatternBlockReader *pReader, FaultListExtract *pFaultListExtract)
+{
+	CommonNs::TraceScope traceScope("Simulator::parallelPatternFaultSimWithPatternBlocks");
+	FaultPtrList remainingFaults;
+	for (Fault *const &pFault : pFaultListExtract->faultsInCircuit_)
+	{
+		bool faultNotDetect = pFault->faultState_ != Fault::DT && pFault->faultState_ != Fault::RE && pFault->faultState_ != Fault::TI && pFault->faultyLine_ >= 0;
+		if (faultNotDetect)
+		{
+			remainingFaults.push_back(pFault);
+		}
+	}
+
+	// blocks are decoded ahead on the reader thread while these are
+	// simulated; reading stops as soon as no fault is left
+	PatternBlockStream stream(pReader);
+	stream.start();
+	bool isDrained = false;
+	while (!remainingFaults.empty())
+	{
+		const PatternBlock *pBlock = stream.acquire();
+		if (!pBlock)
+		{
+			isDrained = true;
+			break;
+		}
+		for (int wordIndex = 0; wordIndex < pBlock->numWord_ && !remainingFaults.empty(); ++wordIndex)
+		{
+			parallelPatternSetPattern(*pBlock, wordIndex);
+			parallelPatternFaultSim(remainingFaults);
+		}
+		stream.release();
+	}
+	stream.stop();
+	// a block the reader failed on ahead of an early exit was never needed
+	return !isDrained || !stream.isFailed();
+}
+
 // **************************************************************************
 // Function   [ Simulator::parallelPatternFaultSim ]
 // Commenter  [ Bill, PYH ]
@@ -237,6 +354,7 @@ void Simulator::parallelPatternFaultSimWithAllPattern(PatternProcessor *pPattern
 // **************************************************************************
 void Simulator::parallelPatternFaultSim(FaultPtrList &remainingFaults)
 {
+	CommonNs::TraceScope traceScope("Simulator::parallelPatternFaultSim");
 	if (remainingFaults.size() == 0)
 	{
 		return;
@@ -252,10 +370,18 @@ void Simulator::parallelPatternFaultSim(FaultPtrList &remainingFaults)
 		{
 			parallelPatternFaultInjection((*it));
 			eventFaultSim();
-			parallelPatternCheckDetection((*it));
+			if (isTimedFault(*it))
+			{
+				parallelPatternCheckTimedDetection((*it));
+			}
+			else
+			{
+				parallelPatternCheckDetection((*it));
+			}
 			parallelPatternReset();
 		}
-		if ((*it)->faultState_ == Fault::DT)
+		// A timed fault is kept until no path through it can have less slack.
+		if ((*it)->faultState_ == Fault::DT && (!isTimedFault(*it) || (*it)->detectionSlack_ <= pTiming_->getFaultSlack(**it)))
 		{
 			it = remainingFaults.erase(it);
 		}
@@ -285,8 +411,8 @@ void Simulator::parallelFaultReset()
 	}
 	numRecover_ = 0;
 	std::fill(processed_.begin(), processed_.end(), 0);
-	std::fill(faultInjectLow_.begin(), faultInjectLow_.end(), std::array<ParallelValue, 5>({0, 0, 0, 0, 0}));
-	std::fill(faultInjectHigh_.begin(), faultInjectHigh_.end(), std::array<ParallelValue, 5>({0, 0, 0, 0, 0}));
+	std::fill(faultInjectLow_.begin(), faultInjectLow_.end(), PARA_L);
+	std::fill(faultInjectHigh_.begin(), faultInjectHigh_.end(), PARA_L);
 
 	numInjectedFaults_ = 0;
 }
@@ -331,6 +457,10 @@ bool Simulator::parallelFaultCheckActivation(const Fault *const pfault)
 				return false;
 			}
 			return (faultyGateGoodSimHigh & pCircuit_->circuitGates_[faultyGate + pCircuit_->numGate_].goodSimLow_) != PARA_L;
+		case Fault::BR:
+			// A bridge is activated when the victim and the aggressor carry opposite values.
+			return ((faultyGateGoodSimLow & pCircuit_->circuitGates_[pfault->aggr_].goodSimHigh_) |
+			        (faultyGateGoodSimHigh & pCircuit_->circuitGates_[pfault->aggr_].goodSimLow_)) != PARA_L;
 		default:
 			break;
 	}
@@ -357,18 +487,21 @@ void Simulator::parallelFaultFaultInjection(const Fault *const pfault, const siz
 	switch (pfault->faultType_)
 	{
 		case Fault::SA0:
-			setBitValue(faultInjectLow_[faultyGate][pfault->faultyLine_], injectFaultIndex, H);
+			setBitValue(faultInjectLow_[faultInjectBegin_[faultyGate] + pfault->faultyLine_], injectFaultIndex, H);
 			break;
 		case Fault::SA1:
-			setBitValue(faultInjectHigh_[faultyGate][pfault->faultyLine_], injectFaultIndex, H);
+			setBitValue(faultInjectHigh_[faultInjectBegin_[faultyGate] + pfault->faultyLine_], injectFaultIndex, H);
 			break;
 		case Fault::STR:
 			faultyGate += pCircuit_->numGate_;
-			setBitValue(faultInjectLow_[faultyGate][pfault->faultyLine_], injectFaultIndex, H);
+			setBitValue(faultInjectLow_[faultInjectBegin_[faultyGate] + pfault->faultyLine_], injectFaultIndex, H);
 			break;
 		case Fault::STF:
 			faultyGate += pCircuit_->numGate_;
-			setBitValue(faultInjectHigh_[faultyGate][pfault->faultyLine_], injectFaultIndex, H);
+			setBitValue(faultInjectHigh_[faultInjectBegin_[faultyGate] + pfault->faultyLine_], injectFaultIndex, H);
+			break;
+		case Fault::BR:
+			parallelFaultBridgeInjection(pfault, injectFaultIndex);
 			break;
 		default:
 			break;
@@ -382,6 +515,53 @@ void Simulator::parallelFaultFaultInjection(const Fault *const pfault, const siz
 	}
 }
 
+// **************************************************************************
+// Function   [ Simulator::parallelFaultBridgeInjection ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Inject a bridge fault on one bit and push the faulty nets
+//                     into event list.
+//              description:
+//              	The good values are the same on all bits in parallel fault
+//              	simulation, so only the bit of this fault is forced. A wired-AND
+//              	pulls the net carrying one down, a wired-OR pulls the net
+//              	carrying zero up, and a dominant bridge forces the victim to the
+//              	aggressor value. The bridge has already been activated, so the
+//              	victim and the aggressor carry opposite values.
+//              arguments:
+//              	[in] pfault : The bridge fault we want to inject.
+//              	[in] injectFaultIndex : The index we want to inject to.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Simulator::parallelFaultBridgeInjection(const Fault *const pfault, const size_t &injectFaultIndex)
+{
+	const int &victim = pfault->gateID_;
+	const int &aggressor = pfault->aggr_;
+	const bool victimIsHigh = pCircuit_->circuitGates_[victim].goodSimHigh_ != PARA_L;
+	int forcedGate = victim;
+	switch (pfault->bridgeType_)
+	{
+		case Fault::WAND:
+			forcedGate = victimIsHigh ? victim : aggressor;
+			setBitValue(faultInjectLow_[faultInjectBegin_[forcedGate]], injectFaultIndex, H);
+			break;
+		case Fault::WOR:
+			forcedGate = victimIsHigh ? aggressor : victim;
+			setBitValue(faultInjectHigh_[faultInjectBegin_[forcedGate]], injectFaultIndex, H);
+			break;
+		case Fault::DOM:
+			setBitValue(victimIsHigh ? faultInjectLow_[faultInjectBegin_[victim]] : faultInjectHigh_[faultInjectBegin_[victim]], injectFaultIndex, H);
+			break;
+	}
+
+	// The victim is pushed by the caller.
+	if (!processed_[forcedGate])
+	{
+		events_[pCircuit_->circuitGates_[forcedGate].numLevel_].push(forcedGate);
+		processed_[forcedGate] = 1;
+	}
+}
+
 // **************************************************************************
 // Function   [ Simulator::parallelFaultCheckDetectionDropFaults ]
 // Commenter  [ CJY, CBH, PYH ]
@@ -439,8 +619,8 @@ void Simulator::parallelPatternReset()
 	}
 	numRecover_ = 0;
 	std::fill(processed_.begin(), processed_.end(), 0);
-	std::fill(faultInjectLow_.begin(), faultInjectLow_.end(), std::array<ParallelValue, 5>({0, 0, 0, 0, 0}));
-	std::fill(faultInjectHigh_.begin(), faultInjectHigh_.end(), std::array<ParallelValue, 5>({0, 0, 0, 0, 0}));
+	std::fill(faultInjectLow_.begin(), faultInjectLow_.end(), PARA_L);
+	std::fill(faultInjectHigh_.begin(), faultInjectHigh_.end(), PARA_L);
 	activated_ = PARA_L;
 }
 
@@ -489,6 +669,11 @@ bool Simulator::parallelPatternCheckActivation(const Fault *const pfault)
 			}
 			activated_ = (faultyGateGoodSimHigh & pCircuit_->circuitGates_[faultyGate + pCircuit_->numGate_].goodSimLow_);
 			return activated_ != PARA_L;
+		case Fault::BR:
+			// A bridge is activated by the patterns where the victim and the aggressor carry opposite values.
+			activated_ = (faultyGateGoodSimLow & pCircuit_->circuitGates_[pfault->aggr_].goodSimHigh_) |
+			             (faultyGateGoodSimHigh & pCircuit_->circuitGates_[pfault->aggr_].goodSimLow_);
+			return activated_ != PARA_L;
 		default:
 			break;
 	}
@@ -513,18 +698,21 @@ void Simulator::parallelPatternFaultInjection(const Fault *const pfault)
 	switch (pfault->faultType_)
 	{
 		case Fault::SA0:
-			faultInjectLow_[faultyGate][pfault->faultyLine_] = PARA_H;
+			faultInjectLow_[faultInjectBegin_[faultyGate] + pfault->faultyLine_] = PARA_H;
 			break;
 		case Fault::SA1:
-			faultInjectHigh_[faultyGate][pfault->faultyLine_] = PARA_H;
+			faultInjectHigh_[faultInjectBegin_[faultyGate] + pfault->faultyLine_] = PARA_H;
 			break;
 		case Fault::STR:
 			faultyGate += pCircuit_->numGate_;
-			faultInjectLow_[faultyGate][pfault->faultyLine_] = PARA_H;
+			faultInjectLow_[faultInjectBegin_[faultyGate] + pfault->faultyLine_] = PARA_H;
 			break;
 		case Fault::STF:
 			faultyGate += pCircuit_->numGate_;
-			faultInjectHigh_[faultyGate][pfault->faultyLine_] = PARA_H;
+			faultInjectHigh_[faultInjectBegin_[faultyGate] + pfault->faultyLine_] = PARA_H;
+			break;
+		case Fault::BR:
+			parallelPatternBridgeInjection(pfault);
 			break;
 		default:
 			break;
@@ -538,6 +726,52 @@ void Simulator::parallelPatternFaultInjection(const Fault *const pfault)
 	}
 }
 
+// **************************************************************************
+// Function   [ Simulator::parallelPatternBridgeInjection ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Inject a bridge fault on the activated patterns and push
+//                     the faulty nets into event list.
+//              description:
+//              	Both nets of the bridge are handled in the same sweep. For a
+//              	wired-AND the victim takes zero where the aggressor is zero
+//              	and vice versa, a wired-OR does the same with one, and a
+//              	dominant bridge copies the aggressor value onto the victim.
+//              	Only the bits in activated_ are forced.
+//              arguments:
+//              	[in] pfault : The bridge fault we want to inject.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Simulator::parallelPatternBridgeInjection(const Fault *const pfault)
+{
+	const int &victim = pfault->gateID_;
+	const int &aggressor = pfault->aggr_;
+	const Gate &victimGate = pCircuit_->circuitGates_[victim];
+	const Gate &aggressorGate = pCircuit_->circuitGates_[aggressor];
+	switch (pfault->bridgeType_)
+	{
+		case Fault::WAND:
+			faultInjectLow_[faultInjectBegin_[victim]] = aggressorGate.goodSimLow_ & activated_;
+			faultInjectLow_[faultInjectBegin_[aggressor]] = victimGate.goodSimLow_ & activated_;
+			break;
+		case Fault::WOR:
+			faultInjectHigh_[faultInjectBegin_[victim]] = aggressorGate.goodSimHigh_ & activated_;
+			faultInjectHigh_[faultInjectBegin_[aggressor]] = victimGate.goodSimHigh_ & activated_;
+			break;
+		case Fault::DOM:
+			faultInjectLow_[faultInjectBegin_[victim]] = aggressorGate.goodSimLow_ & activated_;
+			faultInjectHigh_[faultInjectBegin_[victim]] = aggressorGate.goodSimHigh_ & activated_;
+			return;
+	}
+
+	// The victim is pushed by the caller.
+	if (!processed_[aggressor])
+	{
+		events_[aggressorGate.numLevel_].push(aggressor);
+		processed_[aggressor] = 1;
+	}
+}
+
 // **************************************************************************
 // Function   [ Simulator::parallelPatternCheckDetection ]
 // Commenter  [ Bill, PYH ]
@@ -579,6 +813,134 @@ void Simulator::parallelPatternCheckDetection(Fault *const pfault)
 	}
 }
 
+// **************************************************************************
+// Function   [ Simulator::parallelPatternCheckTimedDetection ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Check detection of the injected transition fault by
+//                     paths with little enough slack.
+//              description:
+//              	The patterns reaching a gate with the fault effect are
+//              	split by the length of their longest sensitized path from
+//              	the fault site, a word of patterns per length. The site
+//              	starts at its static arrival time. A gate takes the path
+//              	lengths of its fanins plus the arc delays, and the longest
+//              	one of every pattern, the gates in the order eventFaultSim
+//              	processed them. So the work is by path length, not by
+//              	pattern, and a gate rarely holds more than a few lengths.
+//              	At a PO or PPO the slack is its required time less the
+//              	path length. Patterns with at most slackThreshold_ slack
+//              	count as detections, the least slack of any is kept in
+//              	Fault::detectionSlack_.
+//              arguments:
+//              	[in] pfault : The STR or STF fault we want to check.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Simulator::parallelPatternCheckTimedDetection(Fault *const pfault)
+{
+	const int numGate = pCircuit_->numGate_;
+	const int siteGateID = pfault->gateID_ + numGate;
+	paths_.clear();
+	for (int i = 0; i < numRecover_; ++i)
+	{
+		const int gateID = recoverGates_[i];
+		const Gate &gate = pCircuit_->circuitGates_[gateID];
+		const ParallelValue difference = ((gate.goodSimLow_ & gate.faultSimHigh_) | (gate.goodSimHigh_ & gate.faultSimLow_)) & activated_;
+		pathBegin_[gateID] = paths_.size();
+		if (difference == PARA_L || gateID < numGate)
+		{
+			pathEnd_[gateID] = paths_.size();
+			continue;
+		}
+		if (gateID == siteGateID)
+		{
+			const PathLength site = {pTiming_->getFaultArrival(*pfault), difference};
+			paths_.push_back(site);
+			pathEnd_[gateID] = paths_.size();
+			continue;
+		}
+
+		// Only gates with the fault effect were processed, their path lengths are current.
+		faninPaths_.clear();
+		for (int j = 0; j < gate.numFI_; ++j)
+		{
+			const Gate &fanin = pCircuit_->circuitGates_[gate.faninVector_[j]];
+			if (((fanin.goodSimLow_ & fanin.faultSimHigh_) | (fanin.goodSimHigh_ & fanin.faultSimLow_)) == PARA_L)
+			{
+				continue;
+			}
+			const float arcDelay = pTiming_->getArcDelay(gateID - numGate, j);
+			for (int k = pathBegin_[fanin.gateId_]; k < pathEnd_[fanin.gateId_]; ++k)
+			{
+				const PathLength path = {paths_[k].length_ + arcDelay, paths_[k].patterns_ & difference};
+				if (path.patterns_ != PARA_L)
+				{
+					faninPaths_.push_back(path);
+				}
+			}
+		}
+
+		// Longest first, every pattern keeps the first length it has.
+		std::sort(faninPaths_.begin(), faninPaths_.end(), isLongerPath);
+		ParallelValue remaining = difference;
+		for (const PathLength &path : faninPaths_)
+		{
+			const PathLength longest = {path.length_, path.patterns_ & remaining};
+			if (longest.patterns_ == PARA_L)
+			{
+				continue;
+			}
+			paths_.push_back(longest);
+			remaining &= ~longest.patterns_;
+			if (remaining == PARA_L)
+			{
+				break;
+			}
+		}
+		pathEnd_[gateID] = paths_.size();
+	}
+
+	ParallelValue detected = PARA_L;
+	const int start = pCircuit_->totalGate_ - pCircuit_->numPO_ - pCircuit_->numPPI_;
+	for (int i = 0; i < numRecover_; ++i)
+	{
+		const int gateID = recoverGates_[i];
+		if (gateID < start)
+		{
+			continue;
+		}
+		const float required = pTiming_->getRequired(gateID - numGate).rise_;
+		for (int k = pathBegin_[gateID]; k < pathEnd_[gateID]; ++k)
+		{
+			const float slack = required - paths_[k].length_;
+			pfault->detectionSlack_ = std::min(pfault->detectionSlack_, slack);
+			if (slack <= slackThreshold_)
+			{
+				detected |= paths_[k].patterns_;
+			}
+		}
+	}
+
+	// Set fault state to DT for fault drop.
+	if (pfault->faultState_ == Fault::DT)
+	{
+		return;
+	}
+	for (int i = 0; i < WORD_SIZE; ++i)
+	{
+		if (getBitValue(detected, i) == L)
+		{
+			continue;
+		}
+		++(pfault->detection_);
+		if (pfault->detection_ >= numDetection_)
+		{
+			pfault->faultState_ = Fault::DT;
+			break;
+		}
+	}
+}
+
 // **************************************************************************
 // Function   [ Simulator::parallelPatternSetPattern  ]
 // Commenter  [ Bill, PYH ]
@@ -674,3 +1036,57 @@ void Simulator::parallelPatternSetPattern(PatternProcessor *pPatternProcessor, c
 		}
 	}
 }
+
+// **************************************************************************
+// Function   [ Simulator::parallelPatternSetPattern  ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Apply one word of a pattern block to PIs and PPIs.
+//              description:
+//              	Same as the PatternProcessor version, the low and high
+//              	words of every input are taken from the bitplanes as
+//              	they are.
+//              arguments:
+//              	[in] block : The decoded patterns.
+//              	[in] wordIndex : The WORD_SIZE patterns of the block to
+//              	                 apply.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Simulator::parallelPatternSetPattern(const PatternBlock &block, const int &wordIndex)
+{
+	for (int j = 0; j < pCircuit_->numPI_ + pCircuit_->numPPI_; ++j)
+	{
+		for (int k = 0; k < pCircuit_->numFrame_; ++k)
+		{
+			pCircuit_->circuitGates_[j + k * pCircuit_->numGate_].goodSimLow_ = PARA_L;
+			pCircuit_->circuitGates_[j + k * pCircuit_->numGate_].goodSimHigh_ = PARA_L;
+		}
+	}
+
+	for (int k = 0; k < block.getNumSignal(PatternBlock::PI1); ++k)
+	{
+		pCircuit_->circuitGates_[k].goodSimLow_ = block.getLow(PatternBlock::PI1, k, wordIndex);
+		pCircuit_->circuitGates_[k].goodSimHigh_ = block.getHigh(PatternBlock::PI1, k, wordIndex);
+	}
+	if (pCircuit_->numFrame_ > 1)
+	{
+		for (int k = 0; k < block.getNumSignal(PatternBlock::PI2); ++k)
+		{
+			const int index = k + pCircuit_->numGate_;
+			pCircuit_->circuitGates_[index].goodSimLow_ = block.getLow(PatternBlock::PI2, k, wordIndex);
+			pCircuit_->circuitGates_[index].goodSimHigh_ = block.getHigh(PatternBlock::PI2, k, wordIndex);
+		}
+	}
+	for (int k = 0; k < block.getNumSignal(PatternBlock::PPI); ++k)
+	{
+		const int index = k + pCircuit_->numPI_;
+		pCircuit_->circuitGates_[index].goodSimLow_ = block.getLow(PatternBlock::PPI, k, wordIndex);
+		pCircuit_->circuitGates_[index].goodSimHigh_ = block.getHigh(PatternBlock::PPI, k, wordIndex);
+	}
+	if (block.getNumSignal(PatternBlock::SI) > 0 && pCircuit_->numFrame_ > 1 && pCircuit_->timeFrameConnectType_ == Circuit::SHIFT)
+	{
+		const int index = pCircuit_->numGate_ + pCircuit_->numPI_;
+		pCircuit_->circuitGates_[index].goodSimLow_ = block.getLow(PatternBlock::SI, 0, wordIndex);
+		pCircuit_->circuitGates_[index].goodSimHigh_ = block.getHigh(PatternBlock::SI, 0, wordIndex);
+	}
+}
@@ -0,0 +1,866 @@
+// **************************************************************************
+// File       [ timing.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ SDF delays on the gates and static timing over them ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include "timing.h"
+
+using namespace IntfNs;
+using namespace CoreNs;
+
+// a level is split over threads only if every thread gets this many gates
+static const int MIN_GATES_PER_THREAD = 1024;
+static const float INFINITE_TIME = std::numeric_limits<float>::infinity();
+// density of the delay defects of size s ns is DEFECT_SCALE * exp(-DEFECT_DECAY * s)
+static const double DEFECT_SCALE = 1.58e-3;
+static const double DEFECT_DECAY = 2.1;
+
+Timing::Timing(Circuit *pCircuit)
+{
+	pCircuit_ = pCircuit;
+	const int numGate = pCircuit_->numGate_;
+	const Delay zero = {0, 0};
+
+	unateness_.resize(numGate);
+	pinBegin_.resize(numGate + 1);
+	int maxLevel = 0;
+	for (int i = 0; i < numGate; ++i)
+	{
+		const Gate &gate = pCircuit_->circuitGates_[i];
+		pinBegin_[i + 1] = pinBegin_[i] + gate.numFI_;
+		if (gate.getOutputCtrlValue() == X || gate.gateType_ == Gate::MUX)
+		{
+			unateness_[i] = NON_UNATE;
+		}
+		else
+		{
+			unateness_[i] = gate.isInverse() == H ? NEGATIVE : POSITIVE;
+		}
+		if (gate.numLevel_ > maxLevel)
+		{
+			maxLevel = gate.numLevel_;
+		}
+	}
+	cellDelay_.assign(pinBegin_[numGate], zero);
+	wireDelay_.assign(pinBegin_[numGate], zero);
+	sourceDelay_.assign(numGate, zero);
+	inputDelay_.assign(numGate, 0);
+	outputDelay_.assign(numGate, 0);
+	arrival_.assign(numGate, zero);
+	required_.assign(numGate, zero);
+
+	// bucket the gates by level, a counting sort keeps the order by ID
+	levelBegin_.assign(maxLevel + 2, 0);
+	for (int i = 0; i < numGate; ++i)
+	{
+		++levelBegin_[pCircuit_->circuitGates_[i].numLevel_ + 1];
+	}
+	for (int l = 0; l <= maxLevel; ++l)
+	{
+		levelBegin_[l + 1] += levelBegin_[l];
+	}
+	levelGates_.resize(numGate);
+	std::vector<int> next(levelBegin_.begin(), levelBegin_.end() - 1);
+	for (int i = 0; i < numGate; ++i)
+	{
+		levelGates_[next[pCircuit_->circuitGates_[i].numLevel_]++] = i;
+	}
+
+	userPeriod_ = 0;
+	clockPeriod_ = 0;
+	longestPath_ = 0;
+	isUpdated_ = false;
+	periodChanged_ = false;
+	forwardEvents_.resize(maxLevel + 1);
+	backwardEvents_.resize(maxLevel + 1);
+	isForwardQueued_.assign(numGate, 0);
+	isBackwardQueued_.assign(numGate, 0);
+}
+
+void Timing::addCellDelay(const int &gateID, const int &faninIndex, const Delay &delay, const bool &isIncrement)
+{
+	Delay &arc = cellDelay_[pinBegin_[gateID] + faninIndex];
+	arc.rise_ = isIncrement ? arc.rise_ + delay.rise_ : std::max(arc.rise_, delay.rise_);
+	arc.fall_ = isIncrement ? arc.fall_ + delay.fall_ : std::max(arc.fall_, delay.fall_);
+	isUpdated_ = false;
+}
+
+void Timing::addWireDelay(const int &gateID, const int &faninIndex, const Delay &delay, const bool &isIncrement)
+{
+	Delay &arc = wireDelay_[pinBegin_[gateID] + faninIndex];
+	arc.rise_ = isIncrement ? arc.rise_ + delay.rise_ : std::max(arc.rise_, delay.rise_);
+	arc.fall_ = isIncrement ? arc.fall_ + delay.fall_ : std::max(arc.fall_, delay.fall_);
+	isUpdated_ = false;
+}
+
+void Timing::addSourceDelay(const int &gateID, const Delay &delay, const bool &isIncrement)
+{
+	Delay &source = sourceDelay_[gateID];
+	source.rise_ = isIncrement ? source.rise_ + delay.rise_ : std::max(source.rise_, delay.rise_);
+	source.fall_ = isIncrement ? source.fall_ + delay.fall_ : std::max(source.fall_, delay.fall_);
+	isUpdated_ = false;
+}
+
+void Timing::setClockPeriod(const float &period)
+{
+	userPeriod_ = period;
+	periodChanged_ = true;
+}
+
+void Timing::setInputDelay(const int &gateID, const float &delay)
+{
+	inputDelay_[gateID] = delay;
+	pushEvent(gateID, true);
+}
+
+void Timing::setOutputDelay(const int &gateID, const float &delay)
+{
+	outputDelay_[gateID] = delay;
+	pushEvent(gateID, false);
+	// the longest path may end here
+	periodChanged_ = true;
+}
+
+// **************************************************************************
+// Function   [ Timing::update ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Compute arrival and required times of all gates.
+//              description:
+//              	Arrival times level by level from the inputs, then the
+//              	clock period, then required times level by level from
+//              	the outputs. A gate reads only gates of other levels, so
+//              	the gates of one level are split over the threads, each
+//              	writing its own part. Pending events are dropped, the
+//              	pass covers them.
+//              arguments:
+//              	[in] numThread : Threads for the wide levels.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Timing::update(const int &numThread)
+{
+	for (int l = 0; l < (int)forwardEvents_.size(); ++l)
+	{
+		for (const int &gateID : forwardEvents_[l])
+		{
+			isForwardQueued_[gateID] = 0;
+		}
+		for (const int &gateID : backwardEvents_[l])
+		{
+			isBackwardQueued_[gateID] = 0;
+		}
+		forwardEvents_[l].clear();
+		backwardEvents_[l].clear();
+	}
+
+	updateLevels(true, numThread);
+	findClockPeriod();
+	updateLevels(false, numThread);
+	isUpdated_ = true;
+	periodChanged_ = false;
+}
+
+// **************************************************************************
+// Function   [ Timing::updateIncremental ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Bring the times up to date after constraint changes.
+//              description:
+//              	Arrival times are evaluated again from the queued gates
+//              	forward, required times from the queued gates backward,
+//              	both level by level like the event stacks of the ATPG.
+//              	A gate whose time stays the same stops the wave. If the
+//              	clock period changes every output is queued backward.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Timing::updateIncremental()
+{
+	if (!isUpdated_)
+	{
+		update();
+		return;
+	}
+
+	const int numLevel = (int)forwardEvents_.size();
+	const int numGate = pCircuit_->numGate_;
+	for (int l = 0; l < numLevel; ++l)
+	{
+		// evaluating a gate queues only gates of higher levels
+		for (size_t i = 0; i < forwardEvents_[l].size(); ++i)
+		{
+			const int gateID = forwardEvents_[l][i];
+			isForwardQueued_[gateID] = 0;
+			if (!evaluateArrival(gateID))
+			{
+				continue;
+			}
+			for (const int &fanoutID : pCircuit_->circuitGates_[gateID].fanoutVector_)
+			{
+				if (fanoutID < numGate)
+				{
+					pushEvent(fanoutID, true);
+				}
+			}
+			// the longest path may end here
+			if (gateID >= numGate - pCircuit_->numPO_ - pCircuit_->numPPI_)
+			{
+				periodChanged_ = true;
+			}
+		}
+		forwardEvents_[l].clear();
+	}
+
+	if (periodChanged_ && findClockPeriod())
+	{
+		for (int i = numGate - pCircuit_->numPO_ - pCircuit_->numPPI_; i < numGate; ++i)
+		{
+			pushEvent(i, false);
+		}
+	}
+	periodChanged_ = false;
+
+	for (int l = numLevel - 1; l >= 0; --l)
+	{
+		for (size_t i = 0; i < backwardEvents_[l].size(); ++i)
+		{
+			const int gateID = backwardEvents_[l][i];
+			isBackwardQueued_[gateID] = 0;
+			if (!evaluateRequired(gateID))
+			{
+				continue;
+			}
+			for (const int &faninID : pCircuit_->circuitGates_[gateID].faninVector_)
+			{
+				pushEvent(faninID, false);
+			}
+		}
+		backwardEvents_[l].clear();
+	}
+}
+
+// **************************************************************************
+// Function   [ Timing::getFaultSlack ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Slack of the longest path through a fault site.
+//              arguments:
+//              	[in] fault : A fault of the first time frame.
+//              	[out] float : Required time less arrival time at the
+//              	              site, on the edge the fault delays.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+float Timing::getFaultSlack(const Fault &fault) const
+{
+	Delay arrival = arrival_[fault.gateID_];
+	Delay required = required_[fault.gateID_];
+	if (fault.faultyLine_ > 0)
+	{
+		getPinArrival(fault.gateID_, fault.faultyLine_ - 1, arrival);
+		getPinRequired(fault.gateID_, fault.faultyLine_ - 1, required);
+	}
+	const float riseSlack = required.rise_ - arrival.rise_;
+	const float fallSlack = required.fall_ - arrival.fall_;
+	if (fault.faultType_ == Fault::STR)
+	{
+		return riseSlack;
+	}
+	if (fault.faultType_ == Fault::STF)
+	{
+		return fallSlack;
+	}
+	return std::min(riseSlack, fallSlack);
+}
+
+// **************************************************************************
+// Function   [ Timing::getFaultArrival ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Arrival time of the transition a fault delays.
+//              arguments:
+//              	[in] fault : A fault of the first time frame.
+//              	[out] float : Arrival time at the output of the faulty
+//              	              gate. STR and STF take the edge they delay
+//              	              at the site, other faults the later one.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+float Timing::getFaultArrival(const Fault &fault) const
+{
+	const bool isRise = fault.faultType_ == Fault::STR;
+	const bool isFall = fault.faultType_ == Fault::STF;
+	if (fault.faultyLine_ == 0)
+	{
+		const Delay &arrival = arrival_[fault.gateID_];
+		return isRise ? arrival.rise_ : isFall ? arrival.fall_ : std::max(arrival.rise_, arrival.fall_);
+	}
+
+	Delay pin;
+	getPinArrival(fault.gateID_, fault.faultyLine_ - 1, pin);
+	const Delay &cell = cellDelay_[pinBegin_[fault.gateID_] + fault.faultyLine_ - 1];
+	float riseOutput; // output of a rising pin
+	float fallOutput;
+	switch (unateness_[fault.gateID_])
+	{
+		case POSITIVE:
+			riseOutput = pin.rise_ + cell.rise_;
+			fallOutput = pin.fall_ + cell.fall_;
+			break;
+		case NEGATIVE:
+			riseOutput = pin.rise_ + cell.fall_;
+			fallOutput = pin.fall_ + cell.rise_;
+			break;
+		default:
+			riseOutput = std::max(pin.rise_, pin.fall_) + std::max(cell.rise_, cell.fall_);
+			fallOutput = riseOutput;
+			break;
+	}
+	return isRise ? riseOutput : isFall ? fallOutput : std::max(riseOutput, fallOutput);
+}
+
+// **************************************************************************
+// Function   [ Timing::getSmallDelayQualityLevel ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: SDQL of the transition faults.
+//              description:
+//              	Every fault site adds the delay defects between its slack
+//              	and its detection slack, weighted by the defect size
+//              	density. Undetected faults let every defect above their
+//              	slack escape. A detected fault not graded with timing
+//              	is taken as detected at the clock period, redundant and
+//              	tied faults add nothing.
+//              arguments:
+//              	[in] faults : Faults of the first time frame.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+double Timing::getSmallDelayQualityLevel(const FaultPtrList &faults) const
+{
+	double sdql = 0;
+	for (const Fault *pFault : faults)
+	{
+		// the clock and scan pins are not in the circuit
+		if ((pFault->faultType_ != Fault::STR && pFault->faultType_ != Fault::STF) ||
+		    pFault->gateID_ < 0 || pFault->faultyLine_ < 0 ||
+		    pFault->faultState_ == Fault::RE || pFault->faultState_ == Fault::TI)
+		{
+			continue;
+		}
+		const double margin = std::max(0.0f, getFaultSlack(*pFault));
+		double detection = INFINITE_TIME;
+		if (pFault->faultState_ == Fault::DT)
+		{
+			detection = std::min(pFault->detectionSlack_, clockPeriod_);
+		}
+		if (detection <= margin)
+		{
+			continue;
+		}
+		sdql += pFault->equivalent_ * DEFECT_SCALE / DEFECT_DECAY * (std::exp(-DEFECT_DECAY * margin) - std::exp(-DEFECT_DECAY * detection));
+	}
+	return sdql;
+}
+
+// **************************************************************************
+// Function   [ Timing::evaluateArrival ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Arrival time of a gate from its pins.
+//              arguments:
+//              	[in] gateID : A gate of the first time frame.
+//              	[out] bool : True if the arrival time changed.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool Timing::evaluateArrival(const int &gateID)
+{
+	const Gate &gate = pCircuit_->circuitGates_[gateID];
+	Delay arrival;
+	if (gate.numFI_ == 0)
+	{
+		arrival.rise_ = inputDelay_[gateID] + sourceDelay_[gateID].rise_;
+		arrival.fall_ = inputDelay_[gateID] + sourceDelay_[gateID].fall_;
+	}
+	else
+	{
+		arrival.rise_ = -INFINITE_TIME;
+		arrival.fall_ = -INFINITE_TIME;
+		for (int i = 0; i < gate.numFI_; ++i)
+		{
+			const Delay &cell = cellDelay_[pinBegin_[gateID] + i];
+			Delay pin;
+			getPinArrival(gateID, i, pin);
+			if (unateness_[gateID] == NEGATIVE)
+			{
+				std::swap(pin.rise_, pin.fall_);
+			}
+			else if (unateness_[gateID] == NON_UNATE)
+			{
+				pin.rise_ = std::max(pin.rise_, pin.fall_);
+				pin.fall_ = pin.rise_;
+			}
+			arrival.rise_ = std::max(arrival.rise_, pin.rise_ + cell.rise_);
+			arrival.fall_ = std::max(arrival.fall_, pin.fall_ + cell.fall_);
+		}
+	}
+
+	Delay &old = arrival_[gateID];
+	if (old.rise_ == arrival.rise_ && old.fall_ == arrival.fall_)
+	{
+		return false;
+	}
+	old = arrival;
+	return true;
+}
+
+// **************************************************************************
+// Function   [ Timing::evaluateRequired ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Required time of a gate from its fanouts.
+//              description:
+//              	POs and PPOs are required at the clock period less their
+//              	output delay. Other gates take the tightest pin they
+//              	drive, a gate driving none has no requirement.
+//              arguments:
+//              	[in] gateID : A gate of the first time frame.
+//              	[out] bool : True if the required time changed.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool Timing::evaluateRequired(const int &gateID)
+{
+	const Gate &gate = pCircuit_->circuitGates_[gateID];
+	Delay required;
+	// by position, the PPOs are BUFs into the next frame in a multi-frame circuit
+	if (gateID >= pCircuit_->numGate_ - pCircuit_->numPO_ - pCircuit_->numPPI_)
+	{
+		required.rise_ = clockPeriod_ - outputDelay_[gateID];
+		required.fall_ = required.rise_;
+	}
+	else
+	{
+		required.rise_ = INFINITE_TIME;
+		required.fall_ = INFINITE_TIME;
+		for (const int &fanoutID : gate.fanoutVector_)
+		{
+			if (fanoutID >= pCircuit_->numGate_)
+			{
+				continue;
+			}
+			const Gate &fanout = pCircuit_->circuitGates_[fanoutID];
+			for (int i = 0; i < fanout.numFI_; ++i)
+			{
+				if (fanout.faninVector_[i] != gateID)
+				{
+					continue;
+				}
+				const Delay &wire = wireDelay_[pinBegin_[fanoutID] + i];
+				Delay pin;
+				getPinRequired(fanoutID, i, pin);
+				required.rise_ = std::min(required.rise_, pin.rise_ - wire.rise_);
+				required.fall_ = std::min(required.fall_, pin.fall_ - wire.fall_);
+			}
+		}
+	}
+
+	Delay &old = required_[gateID];
+	if (old.rise_ == required.rise_ && old.fall_ == required.fall_)
+	{
+		return false;
+	}
+	old = required;
+	return true;
+}
+
+void Timing::getPinArrival(const int &gateID, const int &faninIndex, Delay &arrival) const
+{
+	const Delay &driver = arrival_[pCircuit_->circuitGates_[gateID].faninVector_[faninIndex]];
+	const Delay &wire = wireDelay_[pinBegin_[gateID] + faninIndex];
+	arrival.rise_ = driver.rise_ + wire.rise_;
+	arrival.fall_ = driver.fall_ + wire.fall_;
+}
+
+void Timing::getPinRequired(const int &gateID, const int &faninIndex, Delay &required) const
+{
+	const Delay &output = required_[gateID];
+	const Delay &cell = cellDelay_[pinBegin_[gateID] + faninIndex];
+	const float riseRequired = output.rise_ - cell.rise_; // of the pin edge that makes the output rise
+	const float fallRequired = output.fall_ - cell.fall_;
+	switch (unateness_[gateID])
+	{
+		case POSITIVE:
+			required.rise_ = riseRequired;
+			required.fall_ = fallRequired;
+			break;
+		case NEGATIVE:
+			required.rise_ = fallRequired;
+			required.fall_ = riseRequired;
+			break;
+		default:
+			required.rise_ = std::min(riseRequired, fallRequired);
+			required.fall_ = required.rise_;
+			break;
+	}
+}
+
+// **************************************************************************
+// Function   [ Timing::updateLevels ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Evaluate all gates, one level after the other.
+//              arguments:
+//              	[in] isForward : Arrival times from level 0 up, required
+//              	                 times from the top level down.
+//              	[in] numThread : Threads for the wide levels.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+void Timing::updateLevels(const bool &isForward, const int &numThread)
+{
+	const int numLevel = (int)levelBegin_.size() - 1;
+	std::vector<std::thread> workers;
+	for (int i = 0; i < numLevel; ++i)
+	{
+		const int level = isForward ? i : numLevel - 1 - i;
+		const int begin = levelBegin_[level];
+		const int end = levelBegin_[level + 1];
+		const int numPart = std::max(1, std::min(numThread, (end - begin) / MIN_GATES_PER_THREAD));
+		if (numPart == 1)
+		{
+			updateLevelRange(isForward, level, begin, end);
+			continue;
+		}
+		const int partSize = (end - begin + numPart - 1) / numPart;
+		for (int part = 1; part < numPart; ++part)
+		{
+			const int partBegin = begin + part * partSize;
+			workers.push_back(std::thread(&Timing::updateLevelRange, this, isForward, level, partBegin, std::min(end, partBegin + partSize)));
+		}
+		updateLevelRange(isForward, level, begin, begin + partSize);
+		for (std::thread &worker : workers)
+		{
+			worker.join();
+		}
+		workers.clear();
+	}
+}
+
+void Timing::updateLevelRange(const bool &isForward, const int &level, const int &begin, const int &end)
+{
+	for (int i = begin; i < end; ++i)
+	{
+		if (isForward)
+		{
+			evaluateArrival(levelGates_[i]);
+		}
+		else
+		{
+			evaluateRequired(levelGates_[i]);
+		}
+	}
+}
+
+// **************************************************************************
+// Function   [ Timing::findClockPeriod ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Set the longest path and the clock period in use.
+//              arguments:
+//              	[out] bool : True if the clock period changed.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool Timing::findClockPeriod()
+{
+	const int numGate = pCircuit_->numGate_;
+	longestPath_ = 0;
+	for (int i = numGate - pCircuit_->numPO_ - pCircuit_->numPPI_; i < numGate; ++i)
+	{
+		const float path = std::max(arrival_[i].rise_, arrival_[i].fall_) + outputDelay_[i];
+		longestPath_ = std::max(longestPath_, path);
+	}
+	const float period = userPeriod_ > 0 ? userPeriod_ : longestPath_;
+	if (period == clockPeriod_)
+	{
+		return false;
+	}
+	clockPeriod_ = period;
+	return true;
+}
+
+void Timing::pushEvent(const int &gateID, const bool &isForward)
+{
+	std::vector<char> &isQueued = isForward ? isForwardQueued_ : isBackwardQueued_;
+	if (isQueued[gateID])
+	{
+		return;
+	}
+	isQueued[gateID] = 1;
+	const int level = pCircuit_->circuitGates_[gateID].numLevel_;
+	(isForward ? forwardEvents_ : backwardEvents_)[level].push_back(gateID);
+}
+
+SdfDelayBuilder::SdfDelayBuilder(Timing *pTiming, const CORNER &corner)
+{
+	pTiming_ = pTiming;
+	corner_ = corner;
+	scale_ = 1;
+	hierChar_ = '.';
+	cell_ = NULL;
+	numAnnotated_ = 0;
+	numUnmatched_ = 0;
+}
+
+bool SdfDelayBuilder::addTimeScale(const float &num, const char *const unit)
+{
+	SdfFile::addTimeScale(num, unit);
+	if (!strcmp(unit, "us"))
+	{
+		scale_ = num * 1000;
+	}
+	else if (!strcmp(unit, "ns"))
+	{
+		scale_ = num;
+	}
+	else if (!strcmp(unit, "ps"))
+	{
+		scale_ = num / 1000;
+	}
+	else
+	{
+		fprintf(stderr, "**WARN SdfDelayBuilder::addTimeScale(): ");
+		fprintf(stderr, "unit `%s' not supported, ns assumed\n", unit);
+		scale_ = num;
+	}
+	return true;
+}
+
+bool SdfDelayBuilder::addHierChar(const char &hier)
+{
+	SdfFile::addHierChar(hier);
+	hierChar_ = hier;
+	return true;
+}
+
+// **************************************************************************
+// Function   [ SdfDelayBuilder::addCell ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Start a CELL entry.
+//              description:
+//              	The instance is looked up in the top cell, as written
+//              	and with the SDF escapes removed. The design itself,
+//              	an empty INSTANCE, and wildcards leave no instance.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool SdfDelayBuilder::addCell(const char *const type, const char *const name)
+{
+	SdfFile::addCell(type, name);
+	cell_ = NULL;
+	if (name[0] == '\0' || !strcmp(name, "*"))
+	{
+		return true;
+	}
+	Cell *top = pTiming_->pCircuit_->pNetlist_->getTop();
+	cell_ = top->getCell(name);
+	if (!cell_)
+	{
+		char plain[NAME_LEN];
+		int j = 0;
+		for (int i = 0; name[i] != '\0'; ++i)
+		{
+			if (name[i] != '\\')
+			{
+				plain[j++] = name[i];
+			}
+		}
+		plain[j] = '\0';
+		cell_ = top->getCell(plain);
+	}
+	return true;
+}
+
+bool SdfDelayBuilder::addIoDelay(const SdfDelayType &type, const SdfPortSpec &spec,
+                                 const char *const port, const SdfDelayValueList &v)
+{
+	SdfFile::addIoDelay(type, spec, port, v);
+	Delay delay;
+	if (!getDelay(v, delay))
+	{
+		return true;
+	}
+	if (!cell_ || !cell_->getPort(port))
+	{
+		++numUnmatched_;
+		return true;
+	}
+
+	const Circuit *pCircuit = pTiming_->pCircuit_;
+	const bool isIncrement = type == DELAY_INCREMENT;
+	if (pCircuit->cellModels_[cell_->libc_->id_].isSeq_)
+	{
+		// clock to Q, the PPI is the flip-flop
+		pTiming_->addSourceDelay(pCircuit->cellIndexToGateIndex_[cell_->id_], delay, isIncrement);
+		++numAnnotated_;
+		return true;
+	}
+	if (!annotatePort(cell_, spec.port, delay, isIncrement, false))
+	{
+		++numUnmatched_;
+		return true;
+	}
+	++numAnnotated_;
+	return true;
+}
+
+// **************************************************************************
+// Function   [ SdfDelayBuilder::addInterconnectDelay ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Put the wire delay on the pins the wire ends at.
+//              description:
+//              	Only the end counts, a pin has one driver. It is an
+//              	input of an instance, "instance<hier>port", or an output
+//              	port of the design.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool SdfDelayBuilder::addInterconnectDelay(const SdfDelayType &type,
+                                           const char *const from,
+                                           const char *const to,
+                                           const SdfDelayValueList &v)
+{
+	SdfFile::addInterconnectDelay(type, from, to, v);
+	Delay delay;
+	if (!getDelay(v, delay))
+	{
+		return true;
+	}
+
+	const Circuit *pCircuit = pTiming_->pCircuit_;
+	const bool isIncrement = type == DELAY_INCREMENT;
+	Cell *top = pCircuit->pNetlist_->getTop();
+	const char *hier = strrchr(to, hierChar_);
+	if (!hier)
+	{
+		Port *port = top->getPort(to);
+		if (!port || port->type_ != Port::OUTPUT)
+		{
+			++numUnmatched_;
+			return true;
+		}
+		if (!strcmp(port->name_, "test_so")) // scan output, not in the circuit
+		{
+			return true;
+		}
+		pTiming_->addWireDelay(pCircuit->portIndexToGateIndex_[port->id_], 0, delay, isIncrement);
+		++numAnnotated_;
+		return true;
+	}
+
+	char instName[NAME_LEN];
+	strncpy(instName, to, hier - to);
+	instName[hier - to] = '\0';
+	Cell *cell = top->getCell(instName);
+	if (!cell || !annotatePort(cell, hier + 1, delay, isIncrement, true))
+	{
+		++numUnmatched_;
+		return true;
+	}
+	++numAnnotated_;
+	return true;
+}
+
+// **************************************************************************
+// Function   [ SdfDelayBuilder::getDelay ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Rise and fall delay of an SDF value list in ns.
+//              description:
+//              	One value is both, otherwise the first two are 0->1 and
+//              	1->0. Of a triple the value of the corner is taken.
+//              arguments:
+//              	[out] bool : False if the list has no value.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool SdfDelayBuilder::getDelay(const SdfDelayValueList &v, Delay &delay) const
+{
+	if (v.n < 1)
+	{
+		return false;
+	}
+	float edge[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		const SdfValue &value = v.v[i < v.n ? i : 0].v[0];
+		if (value.n == 0)
+		{
+			return false;
+		}
+		edge[i] = (value.n == 1 ? value.v[0] : value.v[corner_]) * scale_;
+	}
+	delay.rise_ = edge[0];
+	delay.fall_ = edge[1];
+	return true;
+}
+
+// **************************************************************************
+// Function   [ SdfDelayBuilder::annotatePort ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Put a delay on the arcs an input port of an instance
+//              enters the circuit through.
+//              description:
+//              	For a combinational cell these are the primitive pins
+//              	reading the port, found in the model of the library
+//              	cell. The D input of a flip-flop is the pin of its PPO,
+//              	other flip-flop inputs, clocks among them, have no arc
+//              	and are skipped.
+//              arguments:
+//              	[out] bool : False if the port is not an input.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool SdfDelayBuilder::annotatePort(Cell *const cell, const char *const portName, const Delay &delay, const bool &isIncrement, const bool &isWire)
+{
+	const Circuit *pCircuit = pTiming_->pCircuit_;
+	Port *port = cell->getPort(portName);
+	if (!port || port->type_ != Port::INPUT)
+	{
+		return false;
+	}
+
+	const CellModel &model = pCircuit->cellModels_[cell->libc_->id_];
+	if (model.isSeq_)
+	{
+		if (isWire && !strcmp(port->name_, "D"))
+		{
+			pTiming_->addWireDelay(pCircuit->numGate_ - pCircuit->numPPI_ + cell->id_, 0, delay, isIncrement);
+		}
+		return true;
+	}
+
+	const int firstGateID = pCircuit->cellIndexToGateIndex_[cell->id_];
+	for (int i = 0; i < (int)model.fanins_.size(); ++i)
+	{
+		for (int j = 0; j < (int)model.fanins_[i].size(); ++j)
+		{
+			const CellModel::Fanin &fanin = model.fanins_[i][j];
+			if (fanin.type_ != CellModel::PORT || fanin.id_ != port->id_)
+			{
+				continue;
+			}
+			if (isWire)
+			{
+				pTiming_->addWireDelay(firstGateID + i, j, delay, isIncrement);
+			}
+			else
+			{
+				pTiming_->addCellDelay(firstGateID + i, j, delay, isIncrement);
+			}
+		}
+	}
+	return true;
+}
@@ -5,11 +5,16 @@
 // Date       [ 2011/09/28 created ]
 // **************************************************************************
 
+#include <cstdio>
 #include <cstdlib>
 #include <iomanip>
 #include <fstream>
+#include <limits>
+#include <sstream>
 
 #include "atpg_cmd.h"
+#include "core/eco.h"
+#include "core/fault_rw.h"
 #include "core/pattern_rw.h"
 #include "core/simulator.h"
 
@@ -233,6 +238,14 @@ AddFaultCmd::AddFaultCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 	opt->addFlag("a");
 	opt->addFlag("all");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "default bridge type of the fault file. Can be wand, wor, dom", "TYPE");
+	opt->addFlag("t");
+	opt->addFlag("type");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "fault collapsing. Can be none, equivalence, dominance", "TYPE");
+	opt->addFlag("c");
+	opt->addFlag("collapse");
+	optMgr_.regOpt(opt);
 }
 
 AddFaultCmd::~AddFaultCmd() {}
@@ -258,6 +271,70 @@ bool AddFaultCmd::exec(const std::vector<std::string> &argv)
 		fanMgr_->fListExtract = new FaultListExtract;
 	}
 
+	if (optMgr_.isFlagSet("c"))
+	{
+		std::string collapse = optMgr_.getFlagVar("c");
+		if (collapse == "none")
+		{
+			fanMgr_->fListExtract->collapseType_ = FaultListExtract::NO_COLLAPSE;
+		}
+		else if (collapse == "equivalence")
+		{
+			fanMgr_->fListExtract->collapseType_ = FaultListExtract::EQUIVALENCE;
+		}
+		else if (collapse == "dominance")
+		{
+			fanMgr_->fListExtract->collapseType_ = FaultListExtract::DOMINANCE;
+		}
+		else
+		{
+			std::cerr << "**ERROR AddFaultCmd::exec(): unknown collapse type `";
+			std::cerr << collapse << "'\n";
+			return false;
+		}
+	}
+
+	// bridge faults come from a net pair file
+	if (fanMgr_->fListExtract->faultListType_ == FaultListExtract::BRF)
+	{
+		if (!optMgr_.isFlagSet("f"))
+		{
+			std::cerr << "**ERROR AddFaultCmd::exec(): bridge fault needs ";
+			std::cerr << "a net pair file\n";
+			return false;
+		}
+		Fault::BRIDGE_TYPE bridgeType = Fault::WAND;
+		if (optMgr_.isFlagSet("t"))
+		{
+			std::string type = optMgr_.getFlagVar("t");
+			if (type == "wor")
+			{
+				bridgeType = Fault::WOR;
+			}
+			else if (type == "dom")
+			{
+				bridgeType = Fault::DOM;
+			}
+			else if (type != "wand")
+			{
+				std::cerr << "**ERROR AddFaultCmd::exec(): unknown bridge type `";
+				std::cerr << type << "'\n";
+				return false;
+			}
+		}
+		// faultsInCircuit_ points into extractedFaults_, rebuild both
+		fanMgr_->fListExtract->faultsInCircuit_.clear();
+		fanMgr_->fListExtract->extractedFaults_.clear();
+		fanMgr_->fListExtract->uncollapsedFaults_.clear();
+		fanMgr_->fListExtract->extractFaultFromCircuit(fanMgr_->cir);
+		if (!fanMgr_->fListExtract->extractBridgeFaultFromFile(fanMgr_->cir, optMgr_.getFlagVar("f").c_str(), bridgeType))
+		{
+			return false;
+		}
+		addAllFault();
+		return true;
+	}
+
 	fanMgr_->fListExtract->extractFaultFromCircuit(fanMgr_->cir);
 
 	// add all faults
@@ -1060,6 +1137,15 @@ bool ReportStatsCmd::exec(const std::vector<std::string> &argv)
 	std::cout << std::setw(5) << fc << "%\n";
 	std::cout << "#    atpg effectiveness                       ";
 	std::cout << std::setw(5) << ae << "%\n";
+	// small delay defects escaping the transition fault test, see read_sdf
+	if (fanMgr_->timing && fanMgr_->fListExtract->faultListType_ == FaultListExtract::TDF)
+	{
+		std::cout << "#  -------------------------------------------------\n";
+		std::cout << "#  Delay test quality                             \n";
+		std::cout << "#    --------------------------  -------------------\n";
+		std::cout << "#    SDQL                        " << std::setw(19);
+		std::cout << fanMgr_->timing->getSmallDelayQualityLevel(fanMgr_->fListExtract->faultsInCircuit_) << "\n";
+	}
 	std::cout << "#  -------------------------------------------------\n";
 	std::cout << "#  #Patterns                     " << std::setw(19) << npat << "\n";
 	std::cout << "#  -------------------------------------------------\n";
@@ -1209,6 +1295,22 @@ RunFaultSimCmd::RunFaultSimCmd(const std::string &name, FanMgr *fanMgr) : Cmd(na
 	opt->addFlag("m");
 	opt->addFlag("method");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "only simulate faults k with k % N == I", "I/N");
+	opt->addFlag("s");
+	opt->addFlag("shard");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "write the fault results of the shard to FILE", "FILE");
+	opt->addFlag("o");
+	opt->addFlag("output");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "after read_sdf, credit a transition fault only through paths with at most NS slack. Default is any slack", "NS");
+	opt->addFlag("t");
+	opt->addFlag("slack");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "stream the patterns of a binary pattern FILE instead of the ones read. pp only", "FILE");
+	opt->addFlag("f");
+	opt->addFlag("file");
+	optMgr_.regOpt(opt);
 }
 RunFaultSimCmd::~RunFaultSimCmd() {}
 
@@ -1228,27 +1330,111 @@ bool RunFaultSimCmd::exec(const std::vector<std::string> &argv)
 		return false;
 	}
 
-	if (!fanMgr_->pcoll)
+	const bool isStreamed = optMgr_.isFlagSet("f");
+	if (!fanMgr_->pcoll && !isStreamed)
 	{
 		std::cerr << "**ERROR RunFaultSimCmd::exec(): pattern needed\n";
 		return false;
 	}
 
+	if (isStreamed && optMgr_.isFlagSet("m") && optMgr_.getFlagVar("m") == "pf")
+	{
+		std::cerr << "**ERROR RunFaultSimCmd::exec(): a pattern file is streamed by pp only\n";
+		return false;
+	}
+
 	if (!fanMgr_->fListExtract || fanMgr_->fListExtract->faultsInCircuit_.size() == 0)
 	{
 		std::cerr << "**ERROR RunFaultSimCmd::exec(): fault list needed\n";
 		return false;
 	}
 
+	int shardIndex = 0;
+	int numShard = 1;
+	if (optMgr_.isFlagSet("s"))
+	{
+		const std::string shard = optMgr_.getFlagVar("s");
+		char tail;
+		if (sscanf(shard.c_str(), "%d/%d%c", &shardIndex, &numShard, &tail) != 2 ||
+				numShard < 1 || shardIndex < 0 || shardIndex >= numShard)
+		{
+			std::cerr << "**ERROR RunFaultSimCmd::exec(): invalid shard `";
+			std::cerr << shard << "'\n";
+			return false;
+		}
+	}
+
 	if (!fanMgr_->sim)
 	{
 		fanMgr_->sim = new Simulator(fanMgr_->cir);
 	}
 
+	// only with -t the parallel pattern simulator grades transition faults
+	// by path slack, otherwise faults are dropped at their first detection
+	Timing *pTiming = NULL;
+	float slackThreshold = std::numeric_limits<float>::infinity();
+	if (optMgr_.isFlagSet("t"))
+	{
+		if (!fanMgr_->timing)
+		{
+			std::cerr << "**ERROR RunFaultSimCmd::exec(): SDF needed for a slack threshold\n";
+			return false;
+		}
+		if (optMgr_.isFlagSet("m") && optMgr_.getFlagVar("m") == "pf")
+		{
+			std::cerr << "**ERROR RunFaultSimCmd::exec(): a slack threshold is graded by pp only\n";
+			return false;
+		}
+		if (fanMgr_->fListExtract->faultListType_ == FaultListExtract::TDF)
+		{
+			pTiming = fanMgr_->timing;
+		}
+		slackThreshold = (float)atof(optMgr_.getFlagVar("t").c_str());
+	}
+
+	// the header is checked before any fault is touched
+	PatternProcessor streamedPatterns;
+	PatternBlockReader reader(&streamedPatterns, fanMgr_->cir);
+	if (isStreamed && !reader.open(optMgr_.getFlagVar("f").c_str()))
+	{
+		std::cerr << "**ERROR RunFaultSimCmd::exec(): pattern file error\n";
+		return false;
+	}
+
+	// the simulator is shared with the other commands, so the timing is
+	// set for this run only
+	fanMgr_->sim->setTiming(pTiming, slackThreshold);
+
 	std::cout << "#  Performing fault simulation ...\n";
 	fanMgr_->tmusg.periodStart();
 
-	if (optMgr_.isFlagSet("m") && optMgr_.getFlagVar("m") == "pf")
+	// the simulators grade faultsInCircuit_, so the shard is swapped in
+	// for the run and the full list is restored afterwards
+	FaultPtrList shardFaults;
+	if (numShard > 1)
+	{
+		size_t faultIndex = 0;
+		for (Fault *pFault : fanMgr_->fListExtract->faultsInCircuit_)
+		{
+			if (isFaultInShard(faultIndex, shardIndex, numShard))
+			{
+				shardFaults.push_back(pFault);
+			}
+			++faultIndex;
+		}
+		shardFaults.swap(fanMgr_->fListExtract->faultsInCircuit_);
+		std::cout << "#  Shard " << shardIndex << "/" << numShard << ": ";
+		std::cout << fanMgr_->fListExtract->faultsInCircuit_.size() << " faults\n";
+	}
+
+	bool isSimulated = true;
+	if (isStreamed)
+	{
+		std::cout << "#  Streaming " << reader.getNumPattern() << " patterns from `";
+		std::cout << optMgr_.getFlagVar("f") << "'\n";
+		isSimulated = fanMgr_->sim->parallelPatternFaultSimWithPatternBlocks(&reader, fanMgr_->fListExtract);
+	}
+	else if (optMgr_.isFlagSet("m") && optMgr_.getFlagVar("m") == "pf")
 	{
 		fanMgr_->sim->parallelFaultFaultSimWithAllPattern(fanMgr_->pcoll, fanMgr_->fListExtract);
 	}
@@ -1256,6 +1442,27 @@ bool RunFaultSimCmd::exec(const std::vector<std::string> &argv)
 	{
 		fanMgr_->sim->parallelPatternFaultSimWithAllPattern(fanMgr_->pcoll, fanMgr_->fListExtract);
 	}
+	fanMgr_->sim->setTiming(NULL, std::numeric_limits<float>::infinity());
+
+	if (numShard > 1)
+	{
+		shardFaults.swap(fanMgr_->fListExtract->faultsInCircuit_);
+	}
+
+	if (!isSimulated)
+	{
+		std::cerr << "**ERROR RunFaultSimCmd::exec(): pattern file error\n";
+		return false;
+	}
+
+	if (optMgr_.isFlagSet("o"))
+	{
+		FaultResultWriter writer(fanMgr_->fListExtract);
+		if (!writer.writeResult(optMgr_.getFlagVar("o").c_str(), shardIndex, numShard))
+		{
+			return false;
+		}
+	}
 
 	TmStat stat;
 	fanMgr_->tmusg.getPeriodUsage(stat);
@@ -1267,6 +1474,67 @@ bool RunFaultSimCmd::exec(const std::vector<std::string> &argv)
 	return true;
 }
 
+MergeFaultResultsCmd::MergeFaultResultsCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("merge fault simulation results");
+	optMgr_.setDes("merges fault results written by run_fault_sim -o into the current fault list");
+	optMgr_.regArg(new Arg(Arg::REQ_INF, "fault result files", "FILE"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+}
+
+MergeFaultResultsCmd::~MergeFaultResultsCmd() {}
+
+bool MergeFaultResultsCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR MergeFaultResultsCmd::exec(): fault result file needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->fListExtract || fanMgr_->fListExtract->faultsInCircuit_.size() == 0)
+	{
+		std::cerr << "**ERROR MergeFaultResultsCmd::exec(): fault list needed\n";
+		return false;
+	}
+
+	fanMgr_->tmusg.periodStart();
+
+	FaultResultReader reader(fanMgr_->fListExtract);
+	int numRecord = 0;
+	for (size_t i = 0; i < optMgr_.getNParsedArg(); ++i)
+	{
+		int numFileRecord = 0;
+		if (!reader.mergeResult(optMgr_.getParsedArg(i).c_str(), numFileRecord))
+		{
+			return false;
+		}
+		numRecord += numFileRecord;
+	}
+
+	TmStat stat;
+	fanMgr_->tmusg.getPeriodUsage(stat);
+	std::cout << "#  Merged " << numRecord << " fault results from ";
+	std::cout << optMgr_.getNParsedArg() << " files";
+	std::cout << "    " << (double)stat.rTime / 1000000.0 << " s";
+	std::cout << "    " << (double)stat.vmSize / 1024.0 << " MB\n";
+
+	return true;
+}
+
 RunAtpgCmd::RunAtpgCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 {
 	fanMgr_ = fanMgr;
@@ -1277,6 +1545,54 @@ RunAtpgCmd::RunAtpgCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 	opt->addFlag("h");
 	opt->addFlag("help");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "periodically write a checkpoint to FILE", "FILE");
+	opt->addFlag("c");
+	opt->addFlag("checkpoint");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "seconds between two checkpoints. Default is 600", "SEC");
+	opt->addFlag("i");
+	opt->addFlag("interval");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "stop with a checkpoint after SEC seconds", "SEC");
+	opt->addFlag("b");
+	opt->addFlag("budget");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "continue from checkpoint FILE. Further checkpoints go to FILE unless -c is given", "FILE");
+	opt->addFlag("r");
+	opt->addFlag("resume");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "first target stuck-at faults in groups of 64 with bit-parallel implication", "");
+	opt->addFlag("m");
+	opt->addFlag("multi-fault");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "generate each stuck-at pattern on the cone of the fault site", "");
+	opt->addFlag("e");
+	opt->addFlag("fault-cone");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "retarget aborted faults with each backtrack limit in turn. Default is 500", "L1,L2,...");
+	opt->addFlag("l");
+	opt->addFlag("limits");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "retarget aborted stuck-at faults on N threads. Default is 1", "N");
+	opt->addFlag("w");
+	opt->addFlag("workers");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "abort the faults left after SEC seconds", "SEC");
+	opt->addFlag("d");
+	opt->addFlag("deadline");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "target faults by SCOAP testability, `easy' or `hard' first", "ORDER");
+	opt->addFlag("o");
+	opt->addFlag("order");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "let SCOAP guide backtrace and D-frontier choices", "");
+	opt->addFlag("s");
+	opt->addFlag("scoap");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "after read_sdf, sensitize transition faults along their longest paths", "");
+	opt->addFlag("t");
+	opt->addFlag("timing");
+	optMgr_.regOpt(opt);
 }
 
 RunAtpgCmd::~RunAtpgCmd() {}
@@ -1313,8 +1629,110 @@ bool RunAtpgCmd::exec(const std::vector<std::string> &argv)
 		fanMgr_->sim = new Simulator(fanMgr_->cir);
 	}
 
+	std::string checkpointFile;
+	if (optMgr_.isFlagSet("c"))
+	{
+		checkpointFile = optMgr_.getFlagVar("c");
+	}
+	else if (optMgr_.isFlagSet("r"))
+	{
+		checkpointFile = optMgr_.getFlagVar("r");
+	}
+	const double interval = optMgr_.isFlagSet("i") ? atof(optMgr_.getFlagVar("i").c_str()) : 600.0;
+	const double budget = optMgr_.isFlagSet("b") ? atof(optMgr_.getFlagVar("b").c_str()) : 0.0;
+	if (interval <= 0.0 || budget < 0.0)
+	{
+		std::cerr << "**ERROR RunAtpgCmd::exec(): interval and budget must be positive\n";
+		return false;
+	}
+	if (budget > 0.0 && checkpointFile.empty())
+	{
+		std::cerr << "**ERROR RunAtpgCmd::exec(): checkpoint file needed for a time budget\n";
+		return false;
+	}
+
+	std::vector<int> backtrackLimits;
+	if (optMgr_.isFlagSet("l"))
+	{
+		std::stringstream ss(optMgr_.getFlagVar("l"));
+		std::string limit;
+		while (std::getline(ss, limit, ','))
+		{
+			backtrackLimits.push_back(atoi(limit.c_str()));
+			if (backtrackLimits.back() <= 0)
+			{
+				std::cerr << "**ERROR RunAtpgCmd::exec(): backtrack limits must be positive\n";
+				return false;
+			}
+		}
+	}
+	const int numWorker = optMgr_.isFlagSet("w") ? atoi(optMgr_.getFlagVar("w").c_str()) : 1;
+	const double deadline = optMgr_.isFlagSet("d") ? atof(optMgr_.getFlagVar("d").c_str()) : 0.0;
+	if (numWorker <= 0 || deadline < 0.0)
+	{
+		std::cerr << "**ERROR RunAtpgCmd::exec(): workers and deadline must be positive\n";
+		return false;
+	}
+	Atpg::FAULT_ORDER faultOrder = Atpg::EXTRACTION_ORDER;
+	if (optMgr_.isFlagSet("o"))
+	{
+		if (optMgr_.getFlagVar("o") == "easy")
+		{
+			faultOrder = Atpg::EASY_FIRST;
+		}
+		else if (optMgr_.getFlagVar("o") == "hard")
+		{
+			faultOrder = Atpg::HARD_FIRST;
+		}
+		else
+		{
+			std::cerr << "**ERROR RunAtpgCmd::exec(): unknown fault order `" << optMgr_.getFlagVar("o") << "'\n";
+			return false;
+		}
+	}
+
 	delete fanMgr_->atpg;
 	fanMgr_->atpg = new Atpg(fanMgr_->cir, fanMgr_->sim);
+	fanMgr_->atpg->setCheckpoint(checkpointFile, interval);
+	fanMgr_->atpg->setTimeBudget(budget);
+	fanMgr_->atpg->setMultiFault(optMgr_.isFlagSet("m"));
+	fanMgr_->atpg->setFaultCone(optMgr_.isFlagSet("e"));
+	if (!backtrackLimits.empty())
+	{
+		fanMgr_->atpg->setBacktrackLimits(backtrackLimits);
+	}
+	fanMgr_->atpg->setNumWorker(numWorker);
+	fanMgr_->atpg->setDeadline(deadline);
+	fanMgr_->atpg->setFaultOrder(faultOrder);
+	fanMgr_->atpg->setScoapGuided(optMgr_.isFlagSet("s"));
+	if (optMgr_.isFlagSet("t"))
+	{
+		if (!fanMgr_->timing || fanMgr_->fListExtract->faultListType_ != FaultListExtract::TDF)
+		{
+			std::cerr << "**ERROR RunAtpgCmd::exec(): SDF and transition faults needed for timing\n";
+			return false;
+		}
+		fanMgr_->atpg->setTiming(fanMgr_->timing);
+	}
+
+	if (optMgr_.isFlagSet("r"))
+	{
+		if (!fanMgr_->atpg->loadCheckpoint(optMgr_.getFlagVar("r"), fanMgr_->pcoll, fanMgr_->fListExtract))
+		{
+			return false;
+		}
+		std::cout << "#  Resumed with " << fanMgr_->pcoll->patternVector_.size();
+		std::cout << " patterns from `" << optMgr_.getFlagVar("r") << "'\n";
+	}
+	// constraints may be added after the faults, so mark right before ATPG
+	else if (fanMgr_->fListExtract->collapseType_ == FaultListExtract::DOMINANCE)
+	{
+		int numTied = 0;
+		int numRedundant = 0;
+		fanMgr_->fListExtract->markUntestableFaults(fanMgr_->cir, numTied, numRedundant);
+		std::cout << "#  Marked " << numTied << " tied and " << numRedundant;
+		std::cout << " redundant faults\n";
+	}
 
 	std::cout << "#  Performing pattern generation ...\n";
 	fanMgr_->tmusg.periodStart();
@@ -1322,6 +1740,15 @@ bool RunAtpgCmd::exec(const std::vector<std::string> &argv)
 	fanMgr_->atpg->generatePatternSet(fanMgr_->pcoll, fanMgr_->fListExtract, true);
 
 	fanMgr_->tmusg.getPeriodUsage(fanMgr_->atpgStat);
+	if (fanMgr_->atpg->isStoppedByTimeBudget())
+	{
+		std::cout << "#  Time budget reached, checkpoint written to `";
+		std::cout << checkpointFile << "'\n";
+	}
+	if (fanMgr_->atpg->isStoppedByDeadline())
+	{
+		std::cout << "#  Deadline reached, the faults left are aborted\n";
+	}
 	std::cout << "#  Finished pattern generation";
 	std::cout << "    " << (double)fanMgr_->atpgStat.rTime / 1000000.0 << " s";
 	std::cout << "    " << (double)fanMgr_->atpgStat.vmSize / 1024.0 << " MB";
@@ -1331,6 +1758,178 @@ bool RunAtpgCmd::exec(const std::vector<std::string> &argv)
 	return true;
 }
 
+WriteEcoImageCmd::WriteEcoImageCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("write circuit image");
+	optMgr_.setDes("writes gates, fault states and patterns to FILE for a later eco_atpg");
+	optMgr_.regArg(new Arg(Arg::REQ, "output image file", "FILE"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+}
+
+WriteEcoImageCmd::~WriteEcoImageCmd() {}
+
+bool WriteEcoImageCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR WriteEcoImageCmd::exec(): output file needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->cir)
+	{
+		std::cerr << "**ERROR WriteEcoImageCmd::exec(): circuit needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->pcoll)
+	{
+		std::cerr << "**ERROR WriteEcoImageCmd::exec(): pattern needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->fListExtract)
+	{
+		std::cerr << "**ERROR WriteEcoImageCmd::exec(): fault list needed\n";
+		return false;
+	}
+
+	EcoImage image;
+	if (!image.write(optMgr_.getParsedArg(0).c_str(), fanMgr_->cir, fanMgr_->fListExtract, fanMgr_->pcoll))
+	{
+		return false;
+	}
+	std::cout << "#  Wrote image of " << fanMgr_->cir->numGate_ << " gates, ";
+	std::cout << fanMgr_->fListExtract->faultsInCircuit_.size() << " faults and ";
+	std::cout << fanMgr_->pcoll->patternVector_.size() << " patterns\n";
+	return true;
+}
+
+EcoAtpgCmd::EcoAtpgCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("run incremental ATPG after an ECO");
+	optMgr_.setDes("maps the circuit image of the original netlist onto the current circuit, regrades its patterns and generates top-up patterns for the faults left");
+	optMgr_.regArg(new Arg(Arg::REQ, "image written by write_eco_image", "FILE"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+}
+
+EcoAtpgCmd::~EcoAtpgCmd() {}
+
+bool EcoAtpgCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR EcoAtpgCmd::exec(): image file needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->cir)
+	{
+		std::cerr << "**ERROR EcoAtpgCmd::exec(): circuit needed\n";
+		return false;
+	}
+
+	if (!fanMgr_->pcoll)
+	{
+		fanMgr_->pcoll = new PatternProcessor;
+	}
+
+	if (!fanMgr_->fListExtract)
+	{
+		fanMgr_->fListExtract = new FaultListExtract;
+		fanMgr_->fListExtract->extractFaultFromCircuit(fanMgr_->cir);
+	}
+
+	if (!fanMgr_->sim)
+	{
+		fanMgr_->sim = new Simulator(fanMgr_->cir);
+	}
+
+	fanMgr_->tmusg.periodStart();
+
+	EcoImage image;
+	if (!image.read(optMgr_.getParsedArg(0).c_str()))
+	{
+		return false;
+	}
+	const int numChanged = image.mapCircuit(fanMgr_->cir);
+	std::cout << "#  Found " << numChanged << " changed gates, ";
+	std::cout << image.getNumAffectedGate() << " gates affected\n";
+
+	if (fanMgr_->fListExtract->collapseType_ == FaultListExtract::DOMINANCE)
+	{
+		int numTied = 0;
+		int numRedundant = 0;
+		fanMgr_->fListExtract->markUntestableFaults(fanMgr_->cir, numTied, numRedundant);
+		std::cout << "#  Marked " << numTied << " tied and " << numRedundant;
+		std::cout << " redundant faults\n";
+	}
+
+	// regrade the old pattern set on the new circuit
+	fanMgr_->pcoll->init(fanMgr_->cir);
+	image.mapPatterns(fanMgr_->pcoll);
+	fanMgr_->sim->parallelPatternFaultSimWithAllPattern(fanMgr_->pcoll, fanMgr_->fListExtract);
+	fanMgr_->sim->parallelPatternWriteGoodSimValToPatternPO(fanMgr_->pcoll);
+
+	FaultPtrList targetFaults;
+	int numMapped = 0;
+	int numRestored = 0;
+	image.mapFaults(fanMgr_->fListExtract, targetFaults, numMapped, numRestored);
+	std::cout << "#  Mapped " << numMapped << " faults, kept " << numRestored;
+	std::cout << " untestable or aborted, " << targetFaults.size() << " to target\n";
+
+	// top-up patterns are generated separately, only for the target faults,
+	// and appended to the regraded ones
+	PatternProcessor topUp;
+	topUp.staticCompression_ = fanMgr_->pcoll->staticCompression_;
+	topUp.dynamicCompression_ = fanMgr_->pcoll->dynamicCompression_;
+	topUp.XFill_ = fanMgr_->pcoll->XFill_;
+	topUp.type_ = fanMgr_->pcoll->type_;
+	delete fanMgr_->atpg;
+	fanMgr_->atpg = new Atpg(fanMgr_->cir, fanMgr_->sim);
+	targetFaults.swap(fanMgr_->fListExtract->faultsInCircuit_);
+	fanMgr_->atpg->generatePatternSet(&topUp, fanMgr_->fListExtract, true);
+	targetFaults.swap(fanMgr_->fListExtract->faultsInCircuit_);
+	const size_t numOldPattern = fanMgr_->pcoll->patternVector_.size();
+	fanMgr_->pcoll->patternVector_.insert(fanMgr_->pcoll->patternVector_.end(), topUp.patternVector_.begin(), topUp.patternVector_.end());
+
+	fanMgr_->tmusg.getPeriodUsage(fanMgr_->atpgStat);
+	std::cout << "#  Finished ECO pattern generation, " << numOldPattern << " regraded and ";
+	std::cout << topUp.patternVector_.size() << " top-up patterns";
+	std::cout << "    " << (double)fanMgr_->atpgStat.rTime / 1000000.0 << " s";
+	std::cout << "    " << (double)fanMgr_->atpgStat.vmSize / 1024.0 << " MB";
+	std::cout << "\n";
+	rtime = (double)fanMgr_->atpgStat.rTime / 1000000.0;
+
+	return true;
+}
+
 WritePatCmd::WritePatCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 {
 	fanMgr_ = fanMgr;
@@ -1343,10 +1942,18 @@ WritePatCmd::WritePatCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 	opt->addFlag("h");
 	opt->addFlag("help");
 	optMgr_.regOpt(opt);
-	opt = new Opt(Opt::STR_REQ, "pattern format. Currently supports `pat' and `ascii'", "FORMAT");
+	opt = new Opt(Opt::STR_REQ, "pattern format. Currently supports `pat', `ascii' and `bin'", "FORMAT");
 	opt->addFlag("f");
 	opt->addFlag("format");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "compress the blocks of a `bin' pattern file", "");
+	opt->addFlag("c");
+	opt->addFlag("compress");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "format the patterns of `lht' and `ascii' on N threads. Default is 1", "N");
+	opt->addFlag("w");
+	opt->addFlag("workers");
+	optMgr_.regOpt(opt);
 }
 
 WritePatCmd::~WritePatCmd() {}
@@ -1383,6 +1990,10 @@ bool WritePatCmd::exec(const std::vector<std::string> &argv)
 	std::cout << "#  Writing pattern to `" << optMgr_.getParsedArg(0) << "' ...";
 	std::cout << "\n";
 	PatternWriter writer(fanMgr_->pcoll, fanMgr_->cir);
+	if (optMgr_.isFlagSet("w"))
+	{
+		writer.setNumThread(atoi(optMgr_.getFlagVar("w").c_str()));
+	}
 	if (optMgr_.getFlagVar("f") == "lht")
 	{
 		if (!writer.writeLht(optMgr_.getParsedArg(0).c_str()))
@@ -1399,6 +2010,14 @@ bool WritePatCmd::exec(const std::vector<std::string> &argv)
 			return false;
 		}
 	}
+	else if (optMgr_.getFlagVar("f") == "bin")
+	{
+		if (!writer.writeBinary(optMgr_.getParsedArg(0).c_str(), optMgr_.isFlagSet("c")))
+		{
+			std::cerr << "**ERROR WritePatternCmd::exec(): writer failed\n";
+			return false;
+		}
+	}
 	else if (optMgr_.getFlagVar("f") == "pat" || optMgr_.getFlagVar("f") == "")
 	{
 		if (!writer.writePattern(optMgr_.getParsedArg(0).c_str()))
@@ -1518,6 +2137,10 @@ WriteStilCmd::WriteStilCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 	opt->addFlag("f");
 	opt->addFlag("format");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "format the patterns on N threads. Default is 1", "N");
+	opt->addFlag("w");
+	opt->addFlag("workers");
+	optMgr_.regOpt(opt);
 }
 
 WriteStilCmd::~WriteStilCmd() {}
@@ -1553,6 +2176,10 @@ bool WriteStilCmd::exec(const std::vector<std::string> &argv)
 
 	std::cout << "#  Writing pattern to STIL...\n";
 	PatternWriter writer(fanMgr_->pcoll, fanMgr_->cir);
+	if (optMgr_.isFlagSet("w"))
+	{
+		writer.setNumThread(atoi(optMgr_.getFlagVar("w").c_str()));
+	}
 
 	if (!writer.writeSTIL(optMgr_.getParsedArg(0).c_str()))
 	{
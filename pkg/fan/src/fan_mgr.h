@@ -14,6 +14,7 @@
 #include "interface/techlib.h"
 
 #include "core/atpg.h"
+#include "core/timing.h"
 
 namespace FanNs {
 
@@ -27,6 +28,7 @@ public:
         cir            = NULL;
         sim            = NULL;
         atpg           = NULL;
+        timing         = NULL;
         atpgStat.rTime = 0;
     }
     ~FanMgr() {}
@@ -38,6 +40,7 @@ public:
     CoreNs::Circuit     *cir;
     CoreNs::Simulator   *sim;
     CoreNs::Atpg        *atpg;
+    CoreNs::Timing      *timing;
     CommonNs::TmUsage   tmusg;
     CommonNs::TmStat    atpgStat;
 };
@@ -46,6 +46,12 @@ int main(int argc, char **argv)
 	initCmd(cmdMgr, fanMgr);
 	CmdMgr::Result res = CmdMgr::SUCCESS;
 
+	// per command telemetry
+	if (optMgr.isFlagSet("t") && !cmdMgr.setTelemetry(optMgr.getFlagVar("t")))
+	{
+		exit(1);
+	}
+
 	// welcome message
 	printWelcome();
 
@@ -169,6 +175,10 @@ void initOpt(OptMgr &mgr)
 	opt = new Opt(Opt::STR_REQ, "execute command file at startup", "file");
 	opt->addFlag("f");
 	mgr.regOpt(opt);
+
+	opt = new Opt(Opt::STR_REQ, "append resource usage of every command to file as JSON lines", "file");
+	opt->addFlag("t");
+	mgr.regOpt(opt);
 }
 
 void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
@@ -183,6 +193,7 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	Cmd *quitCmd = new SysExitCmd("quit", &cmdMgr);
 	Cmd *sourceCmd = new SysSourceCmd("source", &cmdMgr);
 	Cmd *helpCmd = new SysHelpCmd("help", &cmdMgr);
+	Cmd *serveCmd = new SysServeCmd("serve", &cmdMgr);
 	cmdMgr.regCmd("SYSTEM", listCmd);
 	cmdMgr.regCmd("SYSTEM", cdCmd);
 	cmdMgr.regCmd("SYSTEM", catCmd);
@@ -192,6 +203,7 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	cmdMgr.regCmd("SYSTEM", quitCmd);
 	cmdMgr.regCmd("SYSTEM", sourceCmd);
 	cmdMgr.regCmd("SYSTEM", helpCmd);
+	cmdMgr.regCmd("SYSTEM", serveCmd);
 
 	// setup commands
 	Cmd *readLibCmd = new ReadLibCmd("read_lib", &fanMgr);
@@ -205,6 +217,9 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	Cmd *setStaticCompressionCmd = new SetStaticCompressionCmd("set_static_compression", &fanMgr);
 	Cmd *setDynamicCompressionCmd = new SetDynamicCompressionCmd("set_dynamic_compression", &fanMgr);
 	Cmd *setXFillCmd = new SetXFillCmd("set_X-Fill", &fanMgr);
+	Cmd *readSdfCmd = new ReadSdfCmd("read_sdf", &fanMgr);
+	Cmd *setClockPeriodCmd = new SetClockPeriodCmd("set_clock_period", &fanMgr);
+	Cmd *setIoDelayCmd = new SetIoDelayCmd("set_io_delay", &fanMgr);
 	cmdMgr.regCmd("SETUP", readLibCmd);
 	cmdMgr.regCmd("SETUP", readNlCmd);
 	cmdMgr.regCmd("SETUP", setFaultTypeCmd);
@@ -216,6 +231,9 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	cmdMgr.regCmd("SETUP", setStaticCompressionCmd);
 	cmdMgr.regCmd("SETUP", setDynamicCompressionCmd);
 	cmdMgr.regCmd("SETUP", setXFillCmd);
+	cmdMgr.regCmd("SETUP", readSdfCmd);
+	cmdMgr.regCmd("SETUP", setClockPeriodCmd);
+	cmdMgr.regCmd("SETUP", setIoDelayCmd);
 
 	// ATPG commands
 	Cmd *readPatCmd = new ReadPatCmd("read_pattern", &fanMgr);
@@ -225,7 +243,10 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	Cmd *addPinConsCmd = new AddPinConsCmd("add_pin_constraint", &fanMgr);
 	Cmd *runLogicSimCmd = new RunLogicSimCmd("run_logic_sim", &fanMgr);
 	Cmd *runFaultSimCmd = new RunFaultSimCmd("run_fault_sim", &fanMgr);
+	Cmd *mergeFaultResultsCmd = new MergeFaultResultsCmd("merge_fault_results", &fanMgr);
 	Cmd *runAtpgCmd = new RunAtpgCmd("run_atpg", &fanMgr);
+	Cmd *ecoAtpgCmd = new EcoAtpgCmd("eco_atpg", &fanMgr);
+	Cmd *writeEcoImageCmd = new WriteEcoImageCmd("write_eco_image", &fanMgr);
 	Cmd *reportCircuitCmd = new ReportCircuitCmd("report_circuit", &fanMgr);
 	Cmd *reportGateCmd = new ReportGateCmd("report_gate", &fanMgr);
 	Cmd *reportValueCmd = new ReportValueCmd("report_value", &fanMgr);
@@ -241,12 +262,15 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	cmdMgr.regCmd("ATPG", addPinConsCmd);
 	cmdMgr.regCmd("ATPG", runLogicSimCmd);
 	cmdMgr.regCmd("ATPG", runFaultSimCmd);
+	cmdMgr.regCmd("ATPG", mergeFaultResultsCmd);
 	cmdMgr.regCmd("ATPG", runAtpgCmd);
+	cmdMgr.regCmd("ATPG", ecoAtpgCmd);
 	cmdMgr.regCmd("ATPG", reportCircuitCmd);
 	cmdMgr.regCmd("ATPG", reportGateCmd);
 	cmdMgr.regCmd("ATPG", reportValueCmd);
 	cmdMgr.regCmd("ATPG", reportStatsCmd);
 	cmdMgr.regCmd("ATPG", writePatCmd);
+	cmdMgr.regCmd("ATPG", writeEcoImageCmd);
 	cmdMgr.regCmd("ATPG", writeStilCmd);
 	cmdMgr.regCmd("ATPG", writeProcCmd);
 	cmdMgr.regCmd("ATPG", addScanChainsCmd);
@@ -254,8 +278,12 @@ void initCmd(CmdMgr &cmdMgr, FanMgr &fanMgr)
 	// misc commands
 	Cmd *reportPatFormatCmd = new ReportPatFormatCmd("report_pattern_format");
 	Cmd *reportMemUsgCmd = new ReportMemUsgCmd("report_memory_usage");
+	Cmd *setTraceCmd = new SetTraceCmd("set_trace");
+	Cmd *writeTraceCmd = new WriteTraceCmd("write_trace");
 	cmdMgr.regCmd("MISC", reportPatFormatCmd);
 	cmdMgr.regCmd("MISC", reportMemUsgCmd);
+	cmdMgr.regCmd("MISC", setTraceCmd);
+	cmdMgr.regCmd("MISC", writeTraceCmd);
 
 	// user interface
 	cmdMgr.setComment('#');
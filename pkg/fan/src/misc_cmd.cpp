@@ -5,7 +5,10 @@
 // Date       [ 2011/09/28 created ]
 // **************************************************************************
 
+#include <cstdlib>
+
 #include "common/tm_usage.h"
+#include "common/trace.h"
 
 #include "misc_cmd.h"
 
@@ -74,4 +77,114 @@ bool ReportMemUsgCmd::exec(const std::vector<std::string> &argv)
 	std::cout << "peak " << (double)stat.vmPeak / 1024.0 << " MB" << "\n";
 
 	return true;
-}
\ No newline at end of file
+}
+
+SetTraceCmd::SetTraceCmd(const std::string &name) : Cmd(name)
+{
+	optMgr_.setName(name);
+	optMgr_.setShortDes("set event tracing");
+	optMgr_.setDes("set event tracing of ATPG and simulation on/off. Each thread keeps its latest events in a ring buffer, see write_trace");
+	optMgr_.regArg(new Arg(Arg::REQ, "either on or off", "on/off"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "events kept per thread. Default 65536", "NUM");
+	opt->addFlag("s");
+	opt->addFlag("size");
+	optMgr_.regOpt(opt);
+}
+
+SetTraceCmd::~SetTraceCmd() {}
+
+bool SetTraceCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR SetTraceCmd::exec(): on/off needed\n";
+		return false;
+	}
+
+	if (optMgr_.getParsedArg(0) == "on")
+	{
+		size_t size = 1 << 16;
+		if (optMgr_.isFlagSet("s"))
+		{
+			int num = atoi(optMgr_.getFlagVar("s").c_str());
+			if (num <= 0)
+			{
+				std::cerr << "**ERROR SetTraceCmd::exec(): invalid size `";
+				std::cerr << optMgr_.getFlagVar("s") << "'\n";
+				return false;
+			}
+			size = num;
+		}
+		Trace::enable(size);
+		std::cout << "#  Tracing set to on\n";
+	}
+	else if (optMgr_.getParsedArg(0) == "off")
+	{
+		Trace::disable();
+		std::cout << "#  Tracing set to off\n";
+	}
+	else
+	{
+		std::cerr << "**ERROR SetTraceCmd::exec(): unknown setting `";
+		std::cerr << optMgr_.getParsedArg(0) << "'\n";
+		return false;
+	}
+	return true;
+}
+
+WriteTraceCmd::WriteTraceCmd(const std::string &name) : Cmd(name)
+{
+	optMgr_.setName(name);
+	optMgr_.setShortDes("write trace events");
+	optMgr_.setDes("writes the recorded trace events to FILE in Chrome trace format, which chrome://tracing and Perfetto can open");
+	optMgr_.regArg(new Arg(Arg::REQ, "output trace file", "FILE"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "drop the written events", "");
+	opt->addFlag("c");
+	opt->addFlag("clear");
+	optMgr_.regOpt(opt);
+}
+
+WriteTraceCmd::~WriteTraceCmd() {}
+
+bool WriteTraceCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR WriteTraceCmd::exec(): output file needed\n";
+		return false;
+	}
+
+	if (!Trace::dump(optMgr_.getParsedArg(0).c_str()))
+	{
+		return false;
+	}
+	if (optMgr_.isFlagSet("c"))
+	{
+		Trace::clear();
+	}
+	return true;
+}
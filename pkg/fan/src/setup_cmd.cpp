@@ -5,8 +5,11 @@
 // Date       [ 2011/08/30 created ]
 // **************************************************************************
 
+#include <limits>
+
 #include "interface/netlist_builder.h"
 #include "interface/techlib_builder.h"
+#include "interface/techlib_cache.h"
 
 #include "setup_cmd.h"
 
@@ -31,6 +34,10 @@ ReadLibCmd::ReadLibCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
 	opt->addFlag("v");
 	opt->addFlag("verbose");
 	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "binary cache of the library. Read instead of the library if it was written for the same library file, written after reading the library otherwise", "FILE");
+	opt->addFlag("c");
+	opt->addFlag("cache");
+	optMgr_.regOpt(opt);
 }
 
 ReadLibCmd::~ReadLibCmd() {}
@@ -52,25 +59,52 @@ bool ReadLibCmd::exec(const std::vector<std::string> &argv)
 		return false;
 	}
 
-	// create library and library builder
+	const std::string libName = optMgr_.getParsedArg(0);
+	const bool useCache = optMgr_.isFlagSet("c");
+	const std::string cacheName = useCache ? optMgr_.getFlagVar("c") : "";
+	uint64_t key = 0;
+	if (useCache && !TechlibCache::hashFile(libName.c_str(), key))
+	{
+		std::cerr << "**ERROR ReadLibCmd::exec(): cannot read `" << libName << "'\n";
+		return false;
+	}
+
+	// create library
 	delete fanMgr_->lib;
 	fanMgr_->lib = new Techlib;
-	MdtFile *libBlder = new MdtLibBuilder(fanMgr_->lib);
 
-	// read library
 	fanMgr_->tmusg.periodStart();
 	std::cout << "#  Reading technology library ..."
 						<< "\n";
 	bool verbose = optMgr_.isFlagSet("v");
-	if (!libBlder->read(optMgr_.getParsedArg(0).c_str(), verbose))
+
+	// read the cache, a corrupted one is replaced by parsing the library
+	TechlibCache::Status cacheStatus = TechlibCache::MISS;
+	if (useCache)
 	{
-		std::cerr << "**ERROR ReadLibCmd::exec(): MDT lib builder error"
-							<< "\n";
+		cacheStatus = TechlibCache(fanMgr_->lib).read(cacheName.c_str(), key);
+		if (cacheStatus == TechlibCache::FAIL)
+		{
+			delete fanMgr_->lib;
+			fanMgr_->lib = new Techlib;
+		}
+	}
+
+	// read library
+	if (cacheStatus != TechlibCache::SUCCESS)
+	{
+		MdtFile *libBlder = new MdtLibBuilder(fanMgr_->lib);
+		bool isRead = libBlder->read(libName.c_str(), verbose);
 		delete libBlder;
-		delete fanMgr_->lib;
 		libBlder = NULL;
-		fanMgr_->lib = NULL;
-		return false;
+		if (!isRead)
+		{
+			std::cerr << "**ERROR ReadLibCmd::exec(): MDT lib builder error"
+								<< "\n";
+			delete fanMgr_->lib;
+			fanMgr_->lib = NULL;
+			return false;
+		}
 	}
 
 	// check library
@@ -78,24 +112,26 @@ bool ReadLibCmd::exec(const std::vector<std::string> &argv)
 	{
 		std::cerr << "**ERROR ReadLibCmd::exec(): MDT lib error"
 							<< "\n";
-		delete libBlder;
 		delete fanMgr_->lib;
-		libBlder = NULL;
 		fanMgr_->lib = NULL;
 		return false;
 	}
 
+	// a failed write only costs the next read_lib the parse
+	if (useCache && cacheStatus != TechlibCache::SUCCESS)
+	{
+		TechlibCache(fanMgr_->lib).write(cacheName.c_str(), key);
+	}
+
 	TmStat stat;
 	if (!fanMgr_->tmusg.getPeriodUsage(stat))
 	{
 		std::cout << "fishy ...\n";
 	}
-	std::cout << "#  Finished reading library `" << optMgr_.getParsedArg(0) << "'";
+	std::cout << "#  Finished reading library `" << libName << "'";
 	std::cout << "    " << (double)stat.rTime / 1000000.0 << " s";
 	std::cout << "    " << (double)stat.vmSize / 1024.0 << " MB\n";
-
-	delete libBlder;
-	libBlder = NULL;
+	std::cout << "#    reader: " << (cacheStatus == TechlibCache::SUCCESS ? "cache" : "mdt") << "\n";
 	return true;
 }
 
@@ -182,9 +218,33 @@ bool ReadNlCmd::exec(const std::vector<std::string> &argv)
 	std::cout << "    " << (double)stat.rTime / 1000000.0 << " s";
 	std::cout << "    " << (double)stat.vmSize / 1024.0 << " MB"
 						<< "\n";
+	std::cout << "#    reader: " << (nlBlder->isFastPath() ? "memory mapped" : "bison");
+	if (stat.rTime > 0)
+	{
+		std::cout << "    " << (double)nlBlder->getNBytes() / (double)stat.rTime << " MB/s";
+	}
+	std::cout << "\n";
 
 	delete nlBlder;
 	nlBlder = NULL;
+
+	// levelize here so build_circuit finds the netlist levelized
+	fanMgr_->tmusg.periodStart();
+	std::cout << "#  Levelizing netlist ..."
+						<< "\n";
+	if (!fanMgr_->nl->levelize())
+	{
+		std::cerr << "**ERROR ReadNlCmd()::exec(): levelization error"
+							<< "\n";
+		delete fanMgr_->nl;
+		fanMgr_->nl = NULL;
+		return false;
+	}
+	fanMgr_->tmusg.getPeriodUsage(stat);
+	std::cout << "#  Finished levelizing netlist";
+	std::cout << "    " << (double)stat.rTime / 1000000.0 << " s";
+	std::cout << "    " << (double)stat.vmSize / 1024.0 << " MB"
+						<< "\n";
 	return true;
 }
 
@@ -193,8 +253,8 @@ SetFaultTypeCmd::SetFaultTypeCmd(const std::string &name, FanMgr *fanMgr) : Cmd(
 	fanMgr_ = fanMgr;
 	optMgr_.setName(name);
 	optMgr_.setShortDes("set fault type");
-	optMgr_.setDes("set fault type. Currently supports stuck-at fault and transition delay fault");
-	optMgr_.regArg(new Arg(Arg::REQ, "either saf or tdf",
+	optMgr_.setDes("set fault type. Currently supports stuck-at fault, transition delay fault and bridge fault");
+	optMgr_.regArg(new Arg(Arg::REQ, "saf, tdf or brf",
 												 "fault_type"));
 	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
 	opt->addFlag("h");
@@ -237,6 +297,12 @@ bool SetFaultTypeCmd::exec(const std::vector<std::string> &argv)
 							<< "\n";
 		fanMgr_->fListExtract->faultListType_ = FaultListExtract::TDF;
 	}
+	else if (optMgr_.getParsedArg(0) == "brf")
+	{
+		std::cout << "#  fault type set to bridge fault"
+							<< "\n";
+		fanMgr_->fListExtract->faultListType_ = FaultListExtract::BRF;
+	}
 	else
 	{
 		std::cerr << "**ERROR SetFaultTypeCmd::exec(): unknown fault type `";
@@ -488,6 +554,15 @@ bool BuildCircuitCmd::exec(const std::vector<std::string> &argv)
 		nframe = nframe < 1 ? 1 : nframe;
 	}
 
+	// the timing belongs to the circuit it was annotated on, and the
+	// simulator must not keep pointing at it
+	if (fanMgr_->sim)
+	{
+		fanMgr_->sim->setTiming(NULL, std::numeric_limits<float>::infinity());
+	}
+	delete fanMgr_->timing;
+	fanMgr_->timing = NULL;
+
 	fanMgr_->cir = new Circuit;
 	// build circuit
 	fanMgr_->tmusg.periodStart();
@@ -767,4 +842,250 @@ bool SetXFillCmd::exec(const std::vector<std::string> &argv)
 
 	return true;
 }
+ReadSdfCmd::ReadSdfCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("read SDF");
+	optMgr_.setDes("reads the delays of an SDF file onto the circuit and times it");
+	optMgr_.regArg(new Arg(Arg::REQ, "SDF file", "FILE"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::BOOL, "verbose on. Default is off", "");
+	opt->addFlag("v");
+	opt->addFlag("verbose");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "delay of a min:typ:max triple. Can be min, typ, max. Default is max", "CORNER");
+	opt->addFlag("c");
+	opt->addFlag("corner");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "clock period in ns. Default is the longest path", "NS");
+	opt->addFlag("p");
+	opt->addFlag("period");
+	optMgr_.regOpt(opt);
+	opt = new Opt(Opt::STR_REQ, "time the circuit on N threads. Default is 1", "N");
+	opt->addFlag("w");
+	opt->addFlag("workers");
+	optMgr_.regOpt(opt);
+}
+
+ReadSdfCmd::~ReadSdfCmd() {}
+
+bool ReadSdfCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (!fanMgr_->cir)
+	{
+		std::cerr << "**ERROR ReadSdfCmd::exec(): circuit needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR ReadSdfCmd::exec(): SDF file needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	SdfDelayBuilder::CORNER corner = SdfDelayBuilder::MAX;
+	if (optMgr_.isFlagSet("c"))
+	{
+		std::string cornerStr = optMgr_.getFlagVar("c");
+		if (cornerStr == "min")
+		{
+			corner = SdfDelayBuilder::MIN;
+		}
+		else if (cornerStr == "typ")
+		{
+			corner = SdfDelayBuilder::TYP;
+		}
+		else if (cornerStr != "max")
+		{
+			std::cerr << "**ERROR ReadSdfCmd::exec(): unknown corner `";
+			std::cerr << cornerStr << "'"
+								<< "\n";
+			return false;
+		}
+	}
+
+	int numThread = 1;
+	if (optMgr_.isFlagSet("w"))
+	{
+		numThread = atoi(optMgr_.getFlagVar("w").c_str());
+		numThread = numThread < 1 ? 1 : numThread;
+	}
+
+	if (fanMgr_->sim)
+	{
+		fanMgr_->sim->setTiming(NULL, std::numeric_limits<float>::infinity());
+	}
+	delete fanMgr_->timing;
+	fanMgr_->timing = new Timing(fanMgr_->cir);
+	SdfDelayBuilder *sdfBlder = new SdfDelayBuilder(fanMgr_->timing, corner);
+
+	// read SDF
+	fanMgr_->tmusg.periodStart();
+	std::cout << "#  Reading SDF ..."
+						<< "\n";
+	if (!sdfBlder->read(optMgr_.getParsedArg(0).c_str(), optMgr_.isFlagSet("v")))
+	{
+		std::cerr << "**ERROR ReadSdfCmd::exec(): SDF builder error"
+							<< "\n";
+		delete fanMgr_->timing;
+		delete sdfBlder;
+		fanMgr_->timing = NULL;
+		sdfBlder = NULL;
+		return false;
+	}
+
+	if (optMgr_.isFlagSet("p"))
+	{
+		fanMgr_->timing->setClockPeriod((float)atof(optMgr_.getFlagVar("p").c_str()));
+	}
+	fanMgr_->timing->update(numThread);
+
+	TmStat stat;
+	fanMgr_->tmusg.getPeriodUsage(stat);
+	std::cout << "#  Finished reading SDF `" << optMgr_.getParsedArg(0) << "'";
+	std::cout << "    " << (double)stat.rTime / 1000000.0 << " s";
+	std::cout << "    " << (double)stat.vmSize / 1024.0 << " MB"
+						<< "\n";
+	std::cout << "#    annotated: " << sdfBlder->numAnnotated_;
+	std::cout << "    unmatched: " << sdfBlder->numUnmatched_ << "\n";
+	std::cout << "#    longest path: " << fanMgr_->timing->getLongestPath() << " ns";
+	std::cout << "    clock period: " << fanMgr_->timing->getClockPeriod() << " ns";
+	std::cout << "    worst slack: " << fanMgr_->timing->getClockPeriod() - fanMgr_->timing->getLongestPath() << " ns"
+						<< "\n";
+
+	delete sdfBlder;
+	sdfBlder = NULL;
+	return true;
+}
+
+SetClockPeriodCmd::SetClockPeriodCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("set clock period");
+	optMgr_.setDes("sets the clock period the required times are taken from. 0 is the longest path");
+	optMgr_.regArg(new Arg(Arg::REQ, "clock period in ns", "NS"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+}
+
+SetClockPeriodCmd::~SetClockPeriodCmd() {}
+
+bool SetClockPeriodCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (!fanMgr_->timing)
+	{
+		std::cerr << "**ERROR SetClockPeriodCmd::exec(): SDF needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	if (optMgr_.getNParsedArg() < 1)
+	{
+		std::cerr << "**ERROR SetClockPeriodCmd::exec(): clock period needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	fanMgr_->timing->setClockPeriod((float)atof(optMgr_.getParsedArg(0).c_str()));
+	fanMgr_->timing->updateIncremental();
+	std::cout << "#  clock period set to " << fanMgr_->timing->getClockPeriod() << " ns";
+	std::cout << "    worst slack: " << fanMgr_->timing->getClockPeriod() - fanMgr_->timing->getLongestPath() << " ns"
+						<< "\n";
+
+	return true;
+}
+
+SetIoDelayCmd::SetIoDelayCmd(const std::string &name, FanMgr *fanMgr) : Cmd(name)
+{
+	fanMgr_ = fanMgr;
+	optMgr_.setName(name);
+	optMgr_.setShortDes("set input or output delay");
+	optMgr_.setDes("sets the delay outside the circuit of a primary input or output. Only the affected gates are timed again");
+	optMgr_.regArg(new Arg(Arg::REQ, "primary input or output", "PORT"));
+	optMgr_.regArg(new Arg(Arg::REQ, "delay in ns", "NS"));
+	Opt *opt = new Opt(Opt::BOOL, "print usage", "");
+	opt->addFlag("h");
+	opt->addFlag("help");
+	optMgr_.regOpt(opt);
+}
+
+SetIoDelayCmd::~SetIoDelayCmd() {}
+
+bool SetIoDelayCmd::exec(const std::vector<std::string> &argv)
+{
+	optMgr_.parse(argv);
+
+	if (optMgr_.isFlagSet("h"))
+	{
+		optMgr_.usage();
+		return true;
+	}
+
+	if (!fanMgr_->timing)
+	{
+		std::cerr << "**ERROR SetIoDelayCmd::exec(): SDF needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	if (optMgr_.getNParsedArg() < 2)
+	{
+		std::cerr << "**ERROR SetIoDelayCmd::exec(): port and delay needed";
+		std::cerr << "\n";
+		return false;
+	}
+
+	// clock and scan ports have no gates, as in Circuit::buildCircuit()
+	const std::string portName = optMgr_.getParsedArg(0);
+	Port *port = fanMgr_->nl->getTop()->getPort(portName.c_str());
+	if (!port || (port->type_ != Port::INPUT && port->type_ != Port::OUTPUT) || !strcmp(portName.c_str(), "CK") || !strcmp(portName.c_str(), "test_si") || !strcmp(portName.c_str(), "test_se") || !strcmp(portName.c_str(), "test_so"))
+	{
+		std::cerr << "**ERROR SetIoDelayCmd::exec(): primary input or output `";
+		std::cerr << portName << "' not found"
+							<< "\n";
+		return false;
+	}
+
+	const int gateID = fanMgr_->cir->portIndexToGateIndex_[port->id_];
+	const float delay = (float)atof(optMgr_.getParsedArg(1).c_str());
+	if (port->type_ == Port::INPUT)
+	{
+		fanMgr_->timing->setInputDelay(gateID, delay);
+	}
+	else
+	{
+		fanMgr_->timing->setOutputDelay(gateID, delay);
+	}
+	fanMgr_->timing->updateIncremental();
+	std::cout << "#  delay of `" << optMgr_.getParsedArg(0) << "' set to " << delay << " ns";
+	std::cout << "    worst slack: " << fanMgr_->timing->getClockPeriod() - fanMgr_->timing->getLongestPath() << " ns"
+						<< "\n";
+
+	return true;
+}
 // Ne
\ No newline at end of file
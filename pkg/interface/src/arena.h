@@ -0,0 +1,132 @@
+// **************************************************************************
+// File       [ arena.h ]
+// Author     [ PYH ]
+// Synopsis   [ block allocator for netlist objects ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _INTF_ARENA_H_
+#define _INTF_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace IntfNs
+{
+
+	// Objects are carved out of large blocks and are never freed one by
+	// one. clear() or the destructor runs the destructors of all created
+	// objects and then releases every block at once.
+	class Arena
+	{
+	public:
+		Arena(const size_t &blockSize = 1 << 20);
+		~Arena();
+
+		void *alloc(size_t size);
+		template <class T>
+		T *create(const char *const name);
+		void clear();
+		size_t getNBytes() const;
+
+	private:
+		Arena(const Arena &);
+		Arena &operator=(const Arena &);
+
+		template <class T>
+		static void destroy(void *const obj);
+
+		struct Object
+		{
+			void (*destroy_)(void *const);
+			void *obj_;
+		};
+
+		std::vector<char *> blocks_;
+		std::vector<Object> objs_;
+		char *cur_;
+		size_t left_;
+		size_t blockSize_;
+		size_t nBytes_;
+	};
+
+	inline Arena::Arena(const size_t &blockSize)
+	{
+		cur_ = NULL;
+		left_ = 0;
+		blockSize_ = blockSize;
+		nBytes_ = 0;
+	}
+
+	inline Arena::~Arena()
+	{
+		clear();
+	}
+
+	inline void *Arena::alloc(size_t size)
+	{
+		const size_t align = alignof(std::max_align_t);
+		size = (size + align - 1) & ~(align - 1);
+		nBytes_ += size;
+		// oversized requests get a block of their own, the current block
+		// is kept for the following small ones
+		if (size > blockSize_)
+		{
+			char *block = (char *)::operator new(size);
+			blocks_.push_back(block);
+			return block;
+		}
+		if (size > left_)
+		{
+			cur_ = (char *)::operator new(blockSize_);
+			left_ = blockSize_;
+			blocks_.push_back(cur_);
+		}
+		void *p = cur_;
+		cur_ += size;
+		left_ -= size;
+		return p;
+	}
+
+	template <class T>
+	inline T *Arena::create(const char *const name)
+	{
+		T *obj = new (alloc(sizeof(T))) T(name);
+		Object o;
+		o.destroy_ = &Arena::destroy<T>;
+		o.obj_ = obj;
+		objs_.push_back(o);
+		return obj;
+	}
+
+	template <class T>
+	inline void Arena::destroy(void *const obj)
+	{
+		((T *)obj)->~T();
+	}
+
+	inline void Arena::clear()
+	{
+		for (size_t i = objs_.size(); i > 0; --i)
+		{
+			objs_[i - 1].destroy_(objs_[i - 1].obj_);
+		}
+		for (size_t i = 0; i < blocks_.size(); ++i)
+		{
+			::operator delete(blocks_[i]);
+		}
+		objs_.clear();
+		blocks_.clear();
+		cur_ = NULL;
+		left_ = 0;
+		nBytes_ = 0;
+	}
+
+	inline size_t Arena::getNBytes() const
+	{
+		return nBytes_;
+	}
+};
+
+#endif
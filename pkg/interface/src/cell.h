@@ -10,9 +10,9 @@
 
 #include <set>
 #include <vector>
-#include <map>
 
 #include "global.h"
+#include "name_map.h"
 
 namespace IntfNs
 {
@@ -23,15 +23,15 @@ namespace IntfNs
 
 	typedef std::vector<Cell *> CellVec;
 	typedef std::set<Cell *> CellSet;
-	typedef std::map<NameKey, Cell *> CellMap;
+	typedef NameMap<Cell> CellMap;
 
 	typedef std::vector<Port *> PortVec;
 	typedef std::set<Port *> PortSet;
-	typedef std::map<NameKey, Port *> PortMap;
+	typedef NameMap<Port> PortMap;
 
 	typedef std::vector<Net *> NetVec;
 	typedef std::set<Net *> NetSet;
-	typedef std::map<NameKey, Net *> NetMap;
+	typedef NameMap<Net> NetMap;
 
 	class Port
 	{
@@ -265,8 +265,7 @@ namespace IntfNs
 
 	inline Cell *Cell::getCell(const char *const name) const
 	{
-		CellMap::const_iterator it = nameToCell_.find(name);
-		return it == nameToCell_.end() ? NULL : it->second;
+		return nameToCell_.find(name);
 	}
 
 	inline Cell *Cell::getCell(const size_t &i) const
@@ -276,11 +275,9 @@ namespace IntfNs
 
 	inline bool Cell::addCell(Cell *const c)
 	{
-		CellMap::iterator it = nameToCell_.find(c->name_);
-		if (it != nameToCell_.end())
+		if (!nameToCell_.insert(c))
 			return false;
 		cells_.push_back(c);
-		nameToCell_[c->name_] = c;
 		c->id_ = cells_.size() - 1;
 		c->top_ = this;
 		return true;
@@ -298,17 +295,14 @@ namespace IntfNs
 
 	inline Net *Cell::getNet(const char *const name) const
 	{
-		NetMap::const_iterator it = nameToNet_.find(name);
-		return it == nameToNet_.end() ? NULL : it->second;
+		return nameToNet_.find(name);
 	}
 
 	inline bool Cell::addNet(Net *const n)
 	{
-		NetMap::iterator it = nameToNet_.find(n->name_);
-		if (it != nameToNet_.end())
+		if (!nameToNet_.insert(n))
 			return false;
 		nets_.push_back(n);
-		nameToNet_[n->name_] = n;
 		n->id_ = nets_.size() - 1;
 		n->top_ = this;
 		return true;
@@ -331,12 +325,12 @@ namespace IntfNs
 
 	inline bool Cell::removeNet(const char *const name)
 	{
-		std::map<NameKey, Net *>::iterator it = nameToNet_.find(name);
-		if (it == nameToNet_.end())
+		Net *n = nameToNet_.find(name);
+		if (!n)
 		{
 			return false;
 		}
-		return removeNet(it->second->id_);
+		return removeNet(n->id_);
 	}
 
 	inline size_t Cell::getNPort() const
@@ -351,19 +345,16 @@ namespace IntfNs
 
 	inline Port *Cell::getPort(const char *const name) const
 	{
-		PortMap::const_iterator it = nameToPort_.find(name);
-		return it == nameToPort_.end() ? NULL : it->second;
+		return nameToPort_.find(name);
 	}
 
 	inline bool Cell::addPort(Port *const p)
 	{
-		PortMap::iterator it = nameToPort_.find(p->name_);
-		if (it != nameToPort_.end())
+		if (!nameToPort_.insert(p))
 		{
 			return false;
 		}
 		ports_.push_back(p);
-		nameToPort_[p->name_] = p;
 		p->id_ = ports_.size() - 1;
 		p->top_ = this;
 		return true;
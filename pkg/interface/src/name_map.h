@@ -0,0 +1,174 @@
+// **************************************************************************
+// File       [ name_map.h ]
+// Author     [ PYH ]
+// Synopsis   [ flat hash table from name to object ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#ifndef _INTF_NAME_MAP_H_
+#define _INTF_NAME_MAP_H_
+
+#include <cstring>
+#include <vector>
+
+namespace IntfNs
+{
+
+	// Open addressing table with linear probing. The key of an object is
+	// its own name_, so nothing is copied on insertion and the object must
+	// not be renamed while it is in the table.
+	template <class T>
+	class NameMap
+	{
+	public:
+		NameMap();
+
+		T *find(const char *const name) const;
+		bool insert(T *const obj);
+		bool erase(const char *const name);
+		void clear();
+		size_t size() const;
+
+	private:
+		static size_t hash(const char *const name);
+		size_t findSlot(const char *const name, const size_t &h) const;
+		void rehash(const size_t &nSlot);
+
+		std::vector<T *> slots_;
+		std::vector<size_t> hashes_;
+		size_t size_;
+	};
+
+	template <class T>
+	inline NameMap<T>::NameMap()
+	{
+		size_ = 0;
+	}
+
+	// FNV-1a
+	template <class T>
+	inline size_t NameMap<T>::hash(const char *const name)
+	{
+		size_t h = 2166136261u;
+		for (const unsigned char *c = (const unsigned char *)name; *c; ++c)
+		{
+			h = (h ^ *c) * 16777619u;
+		}
+		return h;
+	}
+
+	// return the slot holding name, or the empty slot ending its probe
+	template <class T>
+	inline size_t NameMap<T>::findSlot(const char *const name, const size_t &h) const
+	{
+		const size_t mask = slots_.size() - 1;
+		size_t i = h & mask;
+		while (slots_[i] && (hashes_[i] != h || strcmp(slots_[i]->name_, name)))
+		{
+			i = (i + 1) & mask;
+		}
+		return i;
+	}
+
+	template <class T>
+	inline T *NameMap<T>::find(const char *const name) const
+	{
+		if (slots_.empty())
+		{
+			return NULL;
+		}
+		return slots_[findSlot(name, hash(name))];
+	}
+
+	template <class T>
+	inline bool NameMap<T>::insert(T *const obj)
+	{
+		// keep the load factor under one half
+		if ((size_ + 1) * 2 > slots_.size())
+		{
+			rehash(slots_.empty() ? 16 : slots_.size() * 2);
+		}
+		const size_t h = hash(obj->name_);
+		const size_t i = findSlot(obj->name_, h);
+		if (slots_[i])
+		{
+			return false;
+		}
+		slots_[i] = obj;
+		hashes_[i] = h;
+		++size_;
+		return true;
+	}
+
+	// backward shift deletion, no tombstones are left behind
+	template <class T>
+	inline bool NameMap<T>::erase(const char *const name)
+	{
+		if (slots_.empty())
+		{
+			return false;
+		}
+		const size_t mask = slots_.size() - 1;
+		size_t i = findSlot(name, hash(name));
+		if (!slots_[i])
+		{
+			return false;
+		}
+		slots_[i] = NULL;
+		for (size_t j = (i + 1) & mask; slots_[j]; j = (j + 1) & mask)
+		{
+			const size_t home = hashes_[j] & mask;
+			const bool stay = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+			if (stay)
+			{
+				continue;
+			}
+			slots_[i] = slots_[j];
+			hashes_[i] = hashes_[j];
+			slots_[j] = NULL;
+			i = j;
+		}
+		--size_;
+		return true;
+	}
+
+	template <class T>
+	inline void NameMap<T>::clear()
+	{
+		slots_.clear();
+		hashes_.clear();
+		size_ = 0;
+	}
+
+	template <class T>
+	inline size_t NameMap<T>::size() const
+	{
+		return size_;
+	}
+
+	template <class T>
+	inline void NameMap<T>::rehash(const size_t &nSlot)
+	{
+		std::vector<T *> oldSlots(nSlot, (T *)NULL);
+		std::vector<size_t> oldHashes(nSlot, 0);
+		oldSlots.swap(slots_);
+		oldHashes.swap(hashes_);
+		const size_t mask = nSlot - 1;
+		for (size_t i = 0; i < oldSlots.size(); ++i)
+		{
+			if (!oldSlots[i])
+			{
+				continue;
+			}
+			size_t j = oldHashes[i] & mask;
+			while (slots_[j])
+			{
+				j = (j + 1) & mask;
+			}
+			slots_[j] = oldSlots[i];
+			hashes_[j] = oldHashes[i];
+		}
+	}
+};
+
+#endif
@@ -6,6 +6,7 @@
 // **************************************************************************
 
 #include <algorithm>
+#include <vector>
 
 #include "netlist.h"
 
@@ -329,8 +330,8 @@ bool Netlist::removeFloatingNets()
 					p->exNet_ = NULL;
 				}
 			}
+			// the net stays in the arena until the netlist is destroyed
 			top_->removeNet(i);
-			delete n;
 			n = NULL;
 			--i;
 		}
@@ -338,6 +339,10 @@ bool Netlist::removeFloatingNets()
 	return true;
 }
 
+// Levelize the top module by counting indegrees over a prebuilt fanout
+// adjacency. Flip-flops and cells without inputs are level 0, any other
+// cell is one above its highest fanin. A loop which does not go through a
+// flip-flop is an error.
 bool Netlist::levelize()
 {
 	if (!top_)
@@ -351,135 +356,236 @@ bool Netlist::levelize()
 		fprintf(stderr, "not set\n");
 		return false;
 	}
-
-	bool processed[top_->getNCell()];
-	bool levelized[top_->getNCell()];
-	for (size_t i = 0; i < top_->getNCell(); ++i)
+	// levelized already and the top has not changed since
+	if (lvl_ >= 0)
 	{
-		processed[i] = false;
-		levelized[i] = false;
+		return true;
 	}
 
-	std::queue<Cell *> cque;
+	const size_t nCell = top_->getNCell();
+	const size_t nNet = top_->getNNet();
 
-	// process PPIs
-	for (size_t i = 0; i < top_->getNCell(); ++i)
+	// group equivalent nets into classes
+	std::vector<int> netClass(nNet, -1);
+	std::vector<Net *> nstack;
+	int nClass = 0;
+	for (size_t i = 0; i < nNet; ++i)
 	{
-		Cell *c = top_->getCell(i);
-		if (!lib_->hasPmt(c->libc_->id_, Pmt::DFF))
+		if (netClass[i] >= 0)
 		{
 			continue;
 		}
-		c->lvl_ = 0;
-		processed[i] = true;
-		levelized[i] = true;
-		CellSet cells = top_->getFanout(i);
-		for (CellSet::iterator it = cells.begin(); it != cells.end(); ++it)
+		netClass[i] = nClass;
+		nstack.push_back(top_->getNet(i));
+		while (!nstack.empty())
 		{
-			if (processed[(*it)->id_] || lib_->hasPmt((*it)->libc_->id_, Pmt::DFF))
+			Net *n = nstack.back();
+			nstack.pop_back();
+			for (size_t j = 0; j < n->getNEqv(); ++j)
 			{
-				continue;
+				Net *eqv = n->getEqv(j);
+				if (netClass[eqv->id_] < 0)
+				{
+					netClass[eqv->id_] = nClass;
+					nstack.push_back(eqv);
+				}
 			}
-			processed[(*it)->id_] = true;
-			cque.push((*it));
 		}
+		++nClass;
 	}
 
-	// process cells with no inputs
-	for (size_t i = 0; i < top_->getNCell(); ++i)
+	// driving cells of every net class
+	std::vector<size_t> drvBegin(nClass + 1, 0);
+	for (size_t i = 0; i < nCell; ++i)
 	{
 		Cell *c = top_->getCell(i);
-		bool hasInput = false;
 		for (size_t j = 0; j < c->getNPort(); ++j)
 		{
-			if (c->getPort(j)->type_ == Port::INPUT)
+			Port *p = c->getPort(j);
+			if (p->type_ == Port::OUTPUT && p->exNet_)
 			{
-				hasInput = true;
-				break;
+				++drvBegin[netClass[p->exNet_->id_] + 1];
 			}
 		}
-		if (hasInput)
-		{
-			continue;
-		}
-		c->lvl_ = 0;
-		processed[i] = true;
-		levelized[i] = true;
-		CellSet cells = top_->getFanout(i);
-		for (CellSet::iterator it = cells.begin(); it != cells.end(); ++it)
+	}
+	for (int k = 0; k < nClass; ++k)
+	{
+		drvBegin[k + 1] += drvBegin[k];
+	}
+	std::vector<int> drvs(drvBegin[nClass]);
+	std::vector<size_t> drvEnd(drvBegin.begin(), drvBegin.end() - 1);
+	for (size_t i = 0; i < nCell; ++i)
+	{
+		Cell *c = top_->getCell(i);
+		for (size_t j = 0; j < c->getNPort(); ++j)
 		{
-			if (processed[(*it)->id_])
+			Port *p = c->getPort(j);
+			if (p->type_ == Port::OUTPUT && p->exNet_)
 			{
-				continue;
+				drvs[drvEnd[netClass[p->exNet_->id_]]++] = i;
 			}
-			processed[(*it)->id_] = true;
-			cque.push((*it));
 		}
 	}
 
-	// process PIs Modified by NE
+	// net classes reached from primary inputs
+	std::vector<bool> piClass(nClass, false);
 	for (size_t i = 0; i < top_->getNPort(); ++i)
 	{
 		Port *p = top_->getPort(i);
-		if (p->type_ != Port::INPUT)
+		if (p->type_ == Port::INPUT && p->inNet_)
 		{
-			continue;
+			piClass[netClass[p->inNet_->id_]] = true;
 		}
-		CellSet cells = top_->getPortCells(i);
-		for (CellSet::iterator it = cells.begin(); it != cells.end(); ++it)
+	}
+
+	// fanin edges, each distinct driver once per cell
+	std::vector<bool> isSource(nCell, false);
+	std::vector<bool> onPi(nCell, false);
+	std::vector<int> indeg(nCell, 0);
+	std::vector<int> stamp(nCell, -1);
+	std::vector<std::pair<int, int> > edges;
+	edges.reserve(nCell * 2);
+	for (size_t i = 0; i < nCell; ++i)
+	{
+		Cell *c = top_->getCell(i);
+		bool hasInput = false;
+		for (size_t j = 0; j < c->getNPort(); ++j)
 		{
-			if (processed[(*it)->id_])
+			Port *p = c->getPort(j);
+			if (p->type_ == Port::INPUT)
+			{
+				hasInput = true;
+			}
+			if (!p->exNet_)
+			{
+				continue;
+			}
+			const int k = netClass[p->exNet_->id_];
+			if (piClass[k])
+			{
+				onPi[i] = true;
+			}
+			if (p->type_ != Port::INPUT)
 			{
 				continue;
 			}
-			processed[(*it)->id_] = true;
-			cque.push((*it));
+			for (size_t d = drvBegin[k]; d < drvBegin[k + 1]; ++d)
+			{
+				if (stamp[drvs[d]] == (int)i)
+				{
+					continue;
+				}
+				stamp[drvs[d]] = i;
+				edges.push_back(std::make_pair(drvs[d], (int)i));
+				++indeg[i];
+			}
 		}
+		isSource[i] = !hasInput || lib_->hasPmt(c->libc_->id_, Pmt::DFF);
+	}
+
+	// fanout adjacency in CSR form
+	std::vector<size_t> foBegin(nCell + 1, 0);
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		++foBegin[edges[e].first + 1];
+	}
+	for (size_t i = 0; i < nCell; ++i)
+	{
+		foBegin[i + 1] += foBegin[i];
+	}
+	std::vector<int> fos(edges.size());
+	std::vector<size_t> foEnd(foBegin.begin(), foBegin.end() - 1);
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		fos[foEnd[edges[e].first]++] = edges[e].second;
 	}
 
-	while (!cque.empty())
+	// sources first, then cells driven only by primary inputs, then cells
+	// whose inputs are all floating
+	std::vector<int> ready;
+	ready.reserve(nCell);
+	for (size_t i = 0; i < nCell; ++i)
 	{
-		Cell *c = cque.front();
-		cque.pop();
+		top_->getCell(i)->lvl_ = -1;
+		if (isSource[i])
+		{
+			ready.push_back(i);
+		}
+	}
+	for (size_t i = 0; i < nCell; ++i)
+	{
+		if (!isSource[i] && indeg[i] == 0 && onPi[i])
+		{
+			ready.push_back(i);
+		}
+	}
+	for (size_t i = 0; i < nCell; ++i)
+	{
+		if (!isSource[i] && indeg[i] == 0 && !onPi[i])
+		{
+			ready.push_back(i);
+		}
+	}
 
-		// check if cell is ready to process
-		int maxLvl = 0;
-		bool ready = true;
-		CellSet fis = top_->getFanin(c->id_);
-		for (CellSet::iterator it = fis.begin(); it != fis.end(); ++it)
+	std::vector<int> maxFaninLvl(nCell, 0);
+	int maxLvl = 0;
+	for (size_t r = 0; r < ready.size(); ++r)
+	{
+		const int i = ready[r];
+		Cell *c = top_->getCell(i);
+		c->lvl_ = isSource[i] ? 0 : maxFaninLvl[i] + 1;
+		if (c->lvl_ > maxLvl)
+		{
+			maxLvl = c->lvl_;
+		}
+		for (size_t j = foBegin[i]; j < foBegin[i + 1]; ++j)
 		{
-			if (!levelized[(*it)->id_])
+			const int fo = fos[j];
+			if (isSource[fo])
 			{
-				ready = false;
-				break;
+				continue;
 			}
-			if ((*it)->lvl_ > maxLvl)
+			if (c->lvl_ > maxFaninLvl[fo])
 			{
-				maxLvl = (*it)->lvl_;
+				maxFaninLvl[fo] = c->lvl_;
+			}
+			if (--indeg[fo] == 0)
+			{
+				ready.push_back(fo);
 			}
 		}
-		if (!ready)
-		{
-			cque.push(c);
-			continue;
-		}
-
-		// set cell level
-		c->lvl_ = maxLvl + 1;
-		levelized[c->id_] = true;
+	}
 
-		// put fanout into the queue
-		CellSet fos = top_->getFanout(c->id_);
-		for (CellSet::iterator it = fos.begin(); it != fos.end(); ++it)
+	// cells left are on a combinational loop or behind one; walk back
+	// over unlevelized fanins until a cell repeats to name one on the loop
+	if (ready.size() != nCell)
+	{
+		std::vector<int> pred(nCell, -1);
+		for (size_t e = 0; e < edges.size(); ++e)
 		{
-			if (processed[(*it)->id_])
+			const int from = edges[e].first;
+			const int to = edges[e].second;
+			if (!isSource[to] && top_->getCell(from)->lvl_ < 0 && top_->getCell(to)->lvl_ < 0)
 			{
-				continue;
+				pred[to] = from;
 			}
-			cque.push((*it));
-			processed[(*it)->id_] = true;
 		}
+		int i = 0;
+		while (top_->getCell(i)->lvl_ >= 0)
+		{
+			++i;
+		}
+		std::vector<bool> isVisited(nCell, false);
+		while (!isVisited[i])
+		{
+			isVisited[i] = true;
+			i = pred[i];
+		}
+		fprintf(stderr, "**ERROR Netlist::levelize(): combinational loop ");
+		fprintf(stderr, "through cell `%s'\n", top_->getCell(i)->name_);
+		return false;
 	}
+	std::vector<std::pair<int, int> >().swap(edges);
 
 	// sort the vector
 	stable_sort(top_->getCells()->begin(), top_->getCells()->end(),
@@ -491,5 +597,6 @@ bool Netlist::levelize()
 		top_->getCell(i)->id_ = i;
 	}
 
+	lvl_ = maxLvl;
 	return true;
 }
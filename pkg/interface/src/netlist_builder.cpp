@@ -37,7 +37,7 @@ void VlogNlBuilder::addModule(const char *const name)
 		success_ = false;
 		return;
 	}
-	curModule_ = new Cell(name);
+	curModule_ = nl_->createCell(name);
 	nl_->addModule(curModule_);
 	nl_->setTop(name);
 }
@@ -51,20 +51,11 @@ void VlogNlBuilder::addPorts(VlogNames *const ports)
 	VlogNames *port = ports->head;
 	while (port)
 	{
-		if (curModule_->getPort(port->name))
+		if (!addPort(port->name))
 		{
-			if (verbose_)
-			{
-				fprintf(stderr, "**ERROR VlogNlBuilder::addPorts(): port ");
-				fprintf(stderr, "`%s/%s' ", curModule_->name_, port->name);
-				fprintf(stderr, "already exists\n");
-			}
 			success_ = false;
 			return;
 		}
-		Port *p = new Port(port->name);
-		p->top_ = curModule_;
-		curModule_->addPort(p);
 		port = port->next;
 	}
 }
@@ -75,16 +66,14 @@ void VlogNlBuilder::setInputNets(VlogNames *const nets)
 	{
 		return;
 	}
-	if (!addPortNets(nets->head))
-	{
-		success_ = false;
-		return;
-	}
 	VlogNames *net = nets->head;
 	while (net)
 	{
-		Port *p = curModule_->getPort(net->name);
-		p->type_ = Port::INPUT;
+		if (!addPortNet(net->name, Port::INPUT))
+		{
+			success_ = false;
+			return;
+		}
 		net = net->next;
 	}
 }
@@ -95,16 +84,14 @@ void VlogNlBuilder::setOutputNets(VlogNames *const nets)
 	{
 		return;
 	}
-	if (!addPortNets(nets->head))
-	{
-		success_ = false;
-		return;
-	}
 	VlogNames *net = nets->head;
 	while (net)
 	{
-		Port *p = curModule_->getPort(net->name);
-		p->type_ = Port::OUTPUT;
+		if (!addPortNet(net->name, Port::OUTPUT))
+		{
+			success_ = false;
+			return;
+		}
 		net = net->next;
 	}
 }
@@ -115,16 +102,14 @@ void VlogNlBuilder::setInoutNets(VlogNames *const nets)
 	{
 		return;
 	}
-	if (!addPortNets(nets->head))
-	{
-		success_ = false;
-		return;
-	}
 	VlogNames *net = nets->head;
 	while (net)
 	{
-		Port *p = curModule_->getPort(net->name);
-		p->type_ = Port::INOUT;
+		if (!addPortNet(net->name, Port::INOUT))
+		{
+			success_ = false;
+			return;
+		}
 		net = net->next;
 	}
 }
@@ -138,11 +123,7 @@ void VlogNlBuilder::setWireNets(VlogNames *const nets)
 	VlogNames *net = nets->head;
 	while (net)
 	{
-		if (!curModule_->getNet(net->name))
-		{
-			Net *n = new Net(net->name);
-			curModule_->addNet(n);
-		}
+		addWireNet(net->name);
 		net = net->next;
 	}
 }
@@ -152,88 +133,20 @@ void VlogNlBuilder::addCell(const char *const type, const char *const name,
 {
 	if (!success_)
 		return;
-	char cname[NAME_LEN];
-	if (!strcmp(name, ""))
-		sprintf(cname, "LOO%d", (int)curModule_->getNCell());
-	else
-		strcpy(cname, name);
-	if (curModule_->getCell(cname))
+	Cell *c = createInst(type, name);
+	if (!c)
 	{
-		if (verbose_)
-		{
-			fprintf(stderr, "**ERROR VlogNlBuilder::addCell(): cell ");
-			fprintf(stderr, "`%s/%s'\n", curModule_->name_, cname);
-		}
 		success_ = false;
 		return;
 	}
-	Cell *c = new Cell(cname);
-	c->top_ = curModule_;
-	strcpy(c->typeName_, type);
-	bool hasLib = nl_->getTechlib() && nl_->getTechlib()->getCell(type);
-	if (hasLib)
-	{
-		Cell *libCell = nl_->getTechlib()->getCell(type);
-		c->libc_ = libCell;
-		for (size_t i = 0; i < libCell->getNPort(); ++i)
-		{
-			Port *p = new Port(libCell->getPort(i)->name_);
-			p->top_ = c;
-			p->type_ = libCell->getPort(i)->type_;
-			c->addPort(p);
-		}
-	}
-	else
-	{
-		if (verbose_)
-		{
-			fprintf(stderr, "**WARN VlogNlBuilder::addCell(): cell ");
-			fprintf(stderr, "`%s/%s' ", curModule_->name_, cname);
-			fprintf(stderr, "set as black box\n");
-		}
-	}
 	VlogPortToNet *p2n = portToNet->head;
 	while (p2n)
 	{
-		Net *n = curModule_->getNet(p2n->net);
-		if (!n)
-		{
-			if (verbose_)
-			{
-				fprintf(stderr, "**WARN VlogNlBuilder::addCell(): net ");
-				fprintf(stderr, "`%s/%s' ", curModule_->name_, p2n->net);
-				fprintf(stderr, "set as wire\n");
-			}
-			n = new Net(p2n->net);
-			n->top_ = curModule_;
-			curModule_->addNet(n);
-		}
-		Port *p;
-		if (hasLib)
-		{
-			p = c->getPort(p2n->port);
-			if (!p)
-			{
-				if (verbose_)
-				{
-					fprintf(stderr, "**ERROR VlogNlBuilder::addCell(): port");
-					fprintf(stderr, " `%s/ ", curModule_->name_);
-					fprintf(stderr, "%s' ", p2n->port);
-					fprintf(stderr, "does not match library cell\n");
-				}
-				success_ = false;
-				return;
-			}
-		}
-		else
+		if (!connectInst(c, p2n->port, p2n->net))
 		{
-			p = new Port(p2n->port);
-			p->top_ = c;
-			c->addPort(p);
+			success_ = false;
+			return;
 		}
-		p->exNet_ = n;
-		n->addPort(p);
-
 		p2n = p2n->next;
 	}
 
@@ -255,7 +168,7 @@ void VlogNlBuilder::addAssign(const char *const n1, const char *const n2)
 			fprintf(stderr, "`%s/%s' ", curModule_->name_, n1);
 			fprintf(stderr, "set as wire\n");
 		}
-		net1 = new Net(n1);
+		net1 = nl_->createNet(n1);
 		net1->top_ = curModule_;
 		curModule_->addNet(net1);
 	}
@@ -268,7 +181,7 @@ void VlogNlBuilder::addAssign(const char *const n1, const char *const n2)
 			fprintf(stderr, "`%s/%s' ", curModule_->name_, n2);
 			fprintf(stderr, "set as wire\n");
 		}
-		net2 = new Net(n2);
+		net2 = nl_->createNet(n2);
 		net2->top_ = curModule_;
 		curModule_->addNet(net2);
 	}
@@ -276,34 +189,234 @@ void VlogNlBuilder::addAssign(const char *const n1, const char *const n2)
 	net2->addEqv(net1);
 }
 
-bool VlogNlBuilder::addPortNets(VlogNames *const nets)
+bool VlogNlBuilder::addPort(const char *const name)
 {
-	VlogNames *net = nets->head;
-	while (net)
+	if (curModule_->getPort(name))
+	{
+		if (verbose_)
+		{
+			fprintf(stderr, "**ERROR VlogNlBuilder::addPorts(): port ");
+			fprintf(stderr, "`%s/%s' ", curModule_->name_, name);
+			fprintf(stderr, "already exists\n");
+		}
+		return false;
+	}
+	Port *p = nl_->createPort(name);
+	p->top_ = curModule_;
+	curModule_->addPort(p);
+	return true;
+}
+
+bool VlogNlBuilder::addPortNet(const char *const name, const Port::Type &type)
+{
+	Port *p = curModule_->getPort(name);
+	if (!p)
+	{
+		if (verbose_)
+		{
+			fprintf(stderr, "**ERROR MdtLibBuilder::addPortNets(): port");
+			fprintf(stderr, " `%s/%s' ", curModule_->name_, name);
+			fprintf(stderr, "does not exist\n");
+		}
+		return false;
+	}
+	Net *n = curModule_->getNet(name);
+	if (!n)
 	{
-		Port *p = curModule_->getPort(net->name);
+		n = nl_->createNet(name);
+		n->top_ = curModule_;
+		curModule_->addNet(n);
+	}
+	n->addPort(p);
+	p->inNet_ = n;
+	p->type_ = type;
+	return true;
+}
+
+void VlogNlBuilder::addWireNet(const char *const name)
+{
+	if (!curModule_->getNet(name))
+	{
+		Net *n = nl_->createNet(name);
+		curModule_->addNet(n);
+	}
+}
+
+// create an instance with its library ports, the caller connects it and
+// adds it to the module
+Cell *VlogNlBuilder::createInst(const char *const type, const char *const name)
+{
+	char cname[NAME_LEN];
+	if (!strcmp(name, ""))
+		sprintf(cname, "LOO%d", (int)curModule_->getNCell());
+	else
+		strcpy(cname, name);
+	if (curModule_->getCell(cname))
+	{
+		if (verbose_)
+		{
+			fprintf(stderr, "**ERROR VlogNlBuilder::addCell(): cell ");
+			fprintf(stderr, "`%s/%s'\n", curModule_->name_, cname);
+		}
+		return NULL;
+	}
+	Cell *c = nl_->createCell(cname);
+	c->top_ = curModule_;
+	strcpy(c->typeName_, type);
+	Cell *libCell = nl_->getTechlib() ? nl_->getTechlib()->getCell(type) : NULL;
+	if (libCell)
+	{
+		c->libc_ = libCell;
+		for (size_t i = 0; i < libCell->getNPort(); ++i)
+		{
+			Port *p = nl_->createPort(libCell->getPort(i)->name_);
+			p->top_ = c;
+			p->type_ = libCell->getPort(i)->type_;
+			c->addPort(p);
+		}
+	}
+	else
+	{
+		if (verbose_)
+		{
+			fprintf(stderr, "**WARN VlogNlBuilder::addCell(): cell ");
+			fprintf(stderr, "`%s/%s' ", curModule_->name_, cname);
+			fprintf(stderr, "set as black box\n");
+		}
+	}
+	return c;
+}
+
+bool VlogNlBuilder::connectInst(Cell *const c, const char *const port,
+																const char *const net)
+{
+	Net *n = curModule_->getNet(net);
+	if (!n)
+	{
+		if (verbose_)
+		{
+			fprintf(stderr, "**WARN VlogNlBuilder::addCell(): net ");
+			fprintf(stderr, "`%s/%s' ", curModule_->name_, net);
+			fprintf(stderr, "set as wire\n");
+		}
+		n = nl_->createNet(net);
+		n->top_ = curModule_;
+		curModule_->addNet(n);
+	}
+	Port *p;
+	if (c->libc_)
+	{
+		p = c->getPort(port);
 		if (!p)
 		{
 			if (verbose_)
 			{
-				fprintf(stderr, "**ERROR MdtLibBuilder::addPortNets(): port");
-				fprintf(stderr, " `%s/%s' ", curModule_->name_, net->name);
-				fprintf(stderr, "does not exist\n");
+				fprintf(stderr, "**ERROR VlogNlBuilder::addCell(): port");
+				fprintf(stderr, " `%s/ ", curModule_->name_);
+				fprintf(stderr, "%s' ", port);
+				fprintf(stderr, "does not match library cell\n");
 			}
 			return false;
 		}
-		Net *n = curModule_->getNet(net->name);
-		if (!n)
+	}
+	else
+	{
+		p = nl_->createPort(port);
+		p->top_ = c;
+		c->addPort(p);
+	}
+	p->exNet_ = n;
+	n->addPort(p);
+	return true;
+}
+
+bool VlogNlBuilder::read(const char *const fname, const bool &verbose)
+{
+	VlogFastFile file;
+	VlogFastFile::Status res = file.read(fname);
+	if (res == VlogFastFile::UNSUPPORTED)
+	{
+		return VlogFile::read(fname, verbose);
+	}
+	if (res == VlogFastFile::FAIL)
+	{
+		fprintf(stderr, "**ERROR VlogNlBuilder::read(): cannot open netlist file");
+		fprintf(stderr, "`%s'\n", fname);
+		return false;
+	}
+
+	verbose_ = verbose;
+	success_ = true;
+	nBytes_ = file.getNBytes();
+	fastPath_ = true;
+	return build(file);
+}
+
+// build the netlist from the statements of the memory mapped reader, the
+// names point into the mapping and are not copied until they are stored
+bool VlogNlBuilder::build(const VlogFastFile &file)
+{
+	for (size_t i = 0; i < file.getNStmt() && success_; ++i)
+	{
+		const VlogFastFile::Stmt &stmt = file.getStmt(i);
+		switch (stmt.type_)
 		{
-			n = new Net(net->name);
-			n->top_ = curModule_;
-			curModule_->addNet(n);
+			case VlogFastFile::Stmt::MODULE:
+				addModule(file.getName(stmt.begin_));
+				for (size_t j = stmt.begin_ + 1; j < stmt.end_ && success_; ++j)
+				{
+					success_ = addPort(file.getName(j));
+				}
+				break;
+			case VlogFastFile::Stmt::INPUT:
+			case VlogFastFile::Stmt::OUTPUT:
+			case VlogFastFile::Stmt::INOUT:
+			{
+				Port::Type type = Port::INPUT;
+				if (stmt.type_ == VlogFastFile::Stmt::OUTPUT)
+				{
+					type = Port::OUTPUT;
+				}
+				else if (stmt.type_ == VlogFastFile::Stmt::INOUT)
+				{
+					type = Port::INOUT;
+				}
+				for (size_t j = stmt.begin_; j < stmt.end_ && success_; ++j)
+				{
+					success_ = addPortNet(file.getName(j), type);
+				}
+				break;
+			}
+			case VlogFastFile::Stmt::WIRE:
+				for (size_t j = stmt.begin_; j < stmt.end_; ++j)
+				{
+					addWireNet(file.getName(j));
+				}
+				break;
+			case VlogFastFile::Stmt::ASSIGN:
+				addAssign(file.getName(stmt.begin_), file.getName(stmt.begin_ + 1));
+				break;
+			case VlogFastFile::Stmt::CELL:
+			{
+				Cell *c = createInst(file.getName(stmt.begin_), file.getName(stmt.begin_ + 1));
+				if (!c)
+				{
+					success_ = false;
+					break;
+				}
+				for (size_t j = stmt.begin_ + 2; j + 1 < stmt.end_ && success_; j += 2)
+				{
+					success_ = connectInst(c, file.getName(j), file.getName(j + 1));
+				}
+				if (success_)
+				{
+					curModule_->addCell(c);
+				}
+				break;
+			}
 		}
-		n->addPort(p);
-		p->inNet_ = n;
-		net = net->next;
 	}
-	return true;
+	return success_;
 }
 
 void VlogNlBuilder::setRegNets(VlogNames *const nets) {}
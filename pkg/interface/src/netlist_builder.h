@@ -9,6 +9,7 @@
 #define _INTF_NETLIST_BUILDER_H_
 
 #include "vlog_file.h"
+#include "vlog_fast_file.h"
 #include "netlist.h"
 
 namespace IntfNs {
@@ -18,6 +19,10 @@ public:
                  VlogNlBuilder(Netlist * const nl);
     virtual      ~VlogNlBuilder();
 
+    // try the memory mapped reader first, fall back to the bison parser
+    // when the netlist uses constructs it does not handle
+    virtual bool read(const char * const fname, const bool &verbose = false);
+
     virtual void addModule(const char * const name);
     virtual void addPorts(VlogNames * const ports);
     virtual void setInputNets(VlogNames * const nets);
@@ -38,7 +43,13 @@ public:
     virtual void addAssign(const char * const n1, const char * const n2);
 
 protected:
-    bool    addPortNets(VlogNames * const nets);
+    bool    build(const VlogFastFile &file);
+    bool    addPort(const char * const name);
+    bool    addPortNet(const char * const name, const Port::Type &type);
+    void    addWireNet(const char * const name);
+    Cell    *createInst(const char * const type, const char * const name);
+    bool    connectInst(Cell * const c, const char * const port,
+                        const char * const net);
     Netlist *nl_;
     Cell    *curModule_;
 };
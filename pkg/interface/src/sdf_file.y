@@ -270,7 +270,32 @@ te_defs
 
 deltype
     : '(' pathtype del_path ')'
-    | '(' valuetype del_defs ')'
+    | '(' valuetype del_defs ')' {
+        SdfDelayDef *def = $3->head;
+        while (def) {
+            switch (def->type) {
+                case SdfDelayDef::IO_DELAY:
+                    sdf->addIoDelay($2, def->pspec, def->p1, def->vlist);
+                    break;
+                case SdfDelayDef::IO_RETAIN:
+                    sdf->addIoRetain($2, def->pspec, def->p1, def->vlist);
+                    break;
+                case SdfDelayDef::PORT_DELAY:
+                    sdf->addPortDelay($2, def->p1, def->vlist);
+                    break;
+                case SdfDelayDef::INTER_DELAY:
+                    sdf->addInterconnectDelay($2, def->p1, def->p2,
+                                              def->vlist);
+                    break;
+                case SdfDelayDef::DEVICE_DELAY:
+                    sdf->addDeviceDelay($2, def->p1, def->vlist);
+                    break;
+            }
+            SdfDelayDef *next = def->next;
+            delete def;
+            def = next;
+        }
+    }
     ;
 
 
@@ -296,9 +321,10 @@ del_path
 
 del_defs
     : del_defs del_def {
-        $$ = $1;
+        $$ = $2;
         $1->next = $2;
         $2->head = $1->head;
+        $2->next = NULL;
     }
     | del_def {
         $$ = $1;
@@ -494,7 +520,7 @@ port_spec
     : port_instance { $$.type = SdfPortSpec::EDGE_NA;
                       strcpy($$.port, $1);            }
     | port_edge     { $$.type = $1.type;
-                      strcpy($$.port, $$.port);       }
+                      strcpy($$.port, $1.port);       }
     ;
 
 
@@ -645,8 +671,8 @@ delval
                                   sdfValueCopy($$.v[1], $3); }
     | '(' value value value ')' { $$.n = 3;
                                   sdfValueCopy($$.v[0], $2);
-                                  sdfValueCopy($$.v[0], $3);
-                                  sdfValueCopy($$.v[1], $4); }
+                                  sdfValueCopy($$.v[1], $3);
+                                  sdfValueCopy($$.v[2], $4); }
     ;
 
 
@@ -658,7 +684,7 @@ delval_list
     | delval delval {
         $$.n = 2;
         sdfDelayValueCopy($$.v[0], $1);
-        sdfDelayValueCopy($$.v[1], $1);
+        sdfDelayValueCopy($$.v[1], $2);
     }
     | delval delval delval {
         $$.n = 3;
@@ -41,11 +41,9 @@ inline Techlib::Techlib() {}
 inline Techlib::~Techlib() {}
 
 inline bool Techlib::addCell(Cell *c) {
-    CellMap::iterator it = nameToCell_.find(c->name_);
-    if (it != nameToCell_.end())
+    if (!nameToCell_.insert(c))
         return false;
     cells_.push_back(c);
-    nameToCell_[c->name_] = c;
     c->id_ = cells_.size() - 1;
     return true;
 }
@@ -59,8 +57,7 @@ inline Cell *Techlib::getCell(const size_t &i) const {
 }
 
 inline Cell *Techlib::getCell(const char * const name) const {
-    CellMap::const_iterator it = nameToCell_.find(name);
-    return it == nameToCell_.end() ? NULL : it->second;
+    return nameToCell_.find(name);
 }
 
 inline bool Techlib::hasPmt(const size_t &i, const Pmt::Type &type) const {
@@ -84,10 +81,10 @@ inline bool Techlib::hasPmt(const size_t &i, const Pmt::Type &type) const {
 
 inline bool Techlib::hasPmt(const char * const name,
                             const Pmt::Type &type) const {
-    CellMap::const_iterator it = nameToCell_.find(name);
-    if (it == nameToCell_.end())
+    Cell *c = nameToCell_.find(name);
+    if (!c)
         return false;
-    return hasPmt(it->second->id_, type);
+    return hasPmt(c->id_, type);
 }
 
 };
@@ -0,0 +1,363 @@
+// **************************************************************************
+// File       [ techlib_cache.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include "techlib_cache.h"
+
+using namespace IntfNs;
+
+namespace
+{
+	const char CACHE_MAGIC[4] = {'F', 'A', 'N', 'L'};
+	const uint32_t CACHE_VERSION = 1;
+
+	template <class T>
+	bool writeVal(FILE *fout, const T &val)
+	{
+		return fwrite(&val, sizeof(T), 1, fout) == 1;
+	}
+
+	template <class T>
+	bool readVal(FILE *fin, T &val)
+	{
+		return fread(&val, sizeof(T), 1, fin) == 1;
+	}
+
+	bool writeName(FILE *fout, const char *const name)
+	{
+		const uint32_t len = strlen(name);
+		return writeVal(fout, len) && (len == 0 || fwrite(name, 1, len, fout) == len);
+	}
+
+	bool readName(FILE *fin, char *const name)
+	{
+		uint32_t len;
+		if (!readVal(fin, len) || len >= (uint32_t)NAME_LEN)
+		{
+			return false;
+		}
+		name[len] = '\0';
+		return len == 0 || fread(name, 1, len, fin) == len;
+	}
+
+	// a size never exceeds what the file can hold, the bound keeps a
+	// corrupted one from allocating the whole memory
+	bool readSize(FILE *fin, uint32_t &size)
+	{
+		return readVal(fin, size) && size < (1u << 24);
+	}
+}
+
+// **************************************************************************
+// Function   [ TechlibCache::hashFile ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Compute the key of an MDT file.
+//              description:
+//              	FNV-1a over the bytes of the file. Any edit of the library
+//              	changes the key and invalidates its cache.
+//              arguments:
+//              	[in] fname : The MDT file.
+//              	[out] key : The key.
+//              	[out] bool : False if the file cannot be read.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool TechlibCache::hashFile(const char *const fname, uint64_t &key)
+{
+	FILE *fin = fopen(fname, "rb");
+	if (!fin)
+	{
+		return false;
+	}
+	key = 14695981039346656037ULL;
+	unsigned char buf[1 << 16];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), fin)) > 0)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			key ^= buf[i];
+			key *= 1099511628211ULL;
+		}
+	}
+	const bool isGood = !ferror(fin);
+	fclose(fin);
+	return isGood;
+}
+
+// **************************************************************************
+// Function   [ TechlibCache::read ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Restore the library from a cache.
+//              description:
+//              	Cells, ports and nets are created in the order they were
+//              	written, which gives them their old IDs. Instances get
+//              	their library cell back by type name once all cells are
+//              	read, as MdtLibBuilder::checkInstances does.
+//              arguments:
+//              	[in] fname : The cache file.
+//              	[in] key : The key of the MDT file the cache must be for.
+//              	[out] Status : MISS if there is no usable cache, FAIL if
+//              	               it is corrupted.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+TechlibCache::Status TechlibCache::read(const char *const fname, const uint64_t &key)
+{
+	FILE *fin = fopen(fname, "rb");
+	if (!fin)
+	{
+		return MISS;
+	}
+
+	char magic[4];
+	uint32_t version;
+	uint64_t cacheKey;
+	if (fread(magic, 1, 4, fin) != 4 || memcmp(magic, CACHE_MAGIC, 4) != 0 ||
+			!readVal(fin, version) || version != CACHE_VERSION ||
+			!readVal(fin, cacheKey) || cacheKey != key)
+	{
+		fclose(fin);
+		return MISS;
+	}
+
+	uint32_t nCell;
+	bool isGood = readSize(fin, nCell);
+	char name[NAME_LEN];
+	char typeName[NAME_LEN];
+	for (uint32_t i = 0; i < nCell && isGood; ++i)
+	{
+		isGood = readName(fin, name);
+		if (!isGood)
+		{
+			break;
+		}
+		Cell *c = new Cell(name);
+		isGood = lib_->addCell(c);
+
+		uint32_t nPort;
+		isGood = isGood && readSize(fin, nPort);
+		for (uint32_t j = 0; j < nPort && isGood; ++j)
+		{
+			int32_t type;
+			isGood = readName(fin, name) && readVal(fin, type);
+			if (isGood)
+			{
+				Port *p = new Port(name);
+				p->type_ = (Port::Type)type;
+				isGood = c->addPort(p);
+			}
+		}
+
+		uint32_t nNet;
+		isGood = isGood && readSize(fin, nNet);
+		for (uint32_t j = 0; j < nNet && isGood; ++j)
+		{
+			isGood = readName(fin, name) && c->addNet(new Net(name));
+		}
+
+		uint32_t nSub;
+		isGood = isGood && readSize(fin, nSub);
+		for (uint32_t j = 0; j < nSub && isGood; ++j)
+		{
+			uint8_t isPmt;
+			int32_t pmtType, lvl;
+			uint32_t nSubPort;
+			isGood = readVal(fin, isPmt) && readName(fin, name) && readName(fin, typeName) &&
+							 readVal(fin, pmtType) && readVal(fin, lvl) && readSize(fin, nSubPort);
+			if (!isGood)
+			{
+				break;
+			}
+			Cell *sub = NULL;
+			if (isPmt)
+			{
+				Pmt *pmt = new Pmt(name);
+				pmt->type_ = (Pmt::Type)pmtType;
+				sub = pmt;
+			}
+			else
+			{
+				sub = new Cell(name);
+			}
+			strcpy(sub->typeName_, typeName);
+			sub->lvl_ = lvl;
+			isGood = c->addCell(sub);
+			for (uint32_t k = 0; k < nSubPort && isGood; ++k)
+			{
+				int32_t type, net;
+				isGood = readName(fin, name) && readVal(fin, type) && readVal(fin, net) &&
+								 net >= -1 && net < (int32_t)nNet;
+				if (isGood)
+				{
+					Port *p = new Port(name);
+					p->type_ = (Port::Type)type;
+					p->exNet_ = net >= 0 ? c->getNet(net) : NULL;
+					isGood = sub->addPort(p);
+				}
+			}
+		}
+
+		for (uint32_t j = 0; j < nPort && isGood; ++j)
+		{
+			int32_t net;
+			isGood = readVal(fin, net) && net >= -1 && net < (int32_t)nNet;
+			if (isGood)
+			{
+				c->getPort(j)->inNet_ = net >= 0 ? c->getNet(net) : NULL;
+			}
+		}
+
+		for (uint32_t j = 0; j < nNet && isGood; ++j)
+		{
+			Net *n = c->getNet(j);
+			uint32_t nNetPort, nEqv;
+			isGood = readSize(fin, nNetPort);
+			for (uint32_t k = 0; k < nNetPort && isGood; ++k)
+			{
+				int32_t sub;
+				uint32_t port;
+				isGood = readVal(fin, sub) && readVal(fin, port) && sub >= -1 && sub < (int32_t)nSub;
+				Cell *top = sub >= 0 ? c->getCell(sub) : c;
+				isGood = isGood && port < top->getNPort() && n->addPort(top->getPort(port));
+			}
+			isGood = isGood && readSize(fin, nEqv);
+			for (uint32_t k = 0; k < nEqv && isGood; ++k)
+			{
+				int32_t eqv;
+				isGood = readVal(fin, eqv) && eqv >= 0 && eqv < (int32_t)nNet && n->addEqv(c->getNet(eqv));
+			}
+		}
+	}
+	isGood = isGood && fgetc(fin) == EOF;
+	fclose(fin);
+
+	for (size_t i = 0; i < lib_->getNCell() && isGood; ++i)
+	{
+		Cell *c = lib_->getCell(i);
+		for (size_t j = 0; j < c->getNCell() && isGood; ++j)
+		{
+			Cell *inst = c->getCell(j);
+			if (!inst->isPmt_)
+			{
+				inst->libc_ = lib_->getCell(inst->typeName_);
+				isGood = inst->libc_ != NULL;
+			}
+		}
+	}
+
+	if (!isGood)
+	{
+		fprintf(stderr, "**ERROR TechlibCache::read(): `%s' ", fname);
+		fprintf(stderr, "is corrupted\n");
+		return FAIL;
+	}
+	return SUCCESS;
+}
+
+// **************************************************************************
+// Function   [ TechlibCache::write ]
+// Commenter  [ PYH ]
+// Synopsis   [ usage: Write the library to a cache.
+//              description:
+//              	The cache is written to a temporary file and renamed, so
+//              	a concurrent reader sees either the old cache or the new.
+//              arguments:
+//              	[in] fname : The cache file.
+//              	[in] key : The key of the MDT file the library was read from.
+//              	[out] bool : False if the cache cannot be written.
+//            ]
+// Date       [ Ver. 1.0 started 2026/10/19 ]
+// **************************************************************************
+bool TechlibCache::write(const char *const fname, const uint64_t &key) const
+{
+	const std::string tmpName = std::string(fname) + ".tmp";
+	FILE *fout = fopen(tmpName.c_str(), "wb");
+	if (!fout)
+	{
+		fprintf(stderr, "**ERROR TechlibCache::write(): cannot open ");
+		fprintf(stderr, "`%s'\n", tmpName.c_str());
+		return false;
+	}
+
+	bool isGood = fwrite(CACHE_MAGIC, 1, 4, fout) == 4 &&
+								writeVal(fout, CACHE_VERSION) &&
+								writeVal(fout, key) &&
+								writeVal(fout, (uint32_t)lib_->getNCell());
+	for (size_t i = 0; i < lib_->getNCell() && isGood; ++i)
+	{
+		const Cell *c = lib_->getCell(i);
+		isGood = writeName(fout, c->name_) && writeVal(fout, (uint32_t)c->getNPort());
+		for (size_t j = 0; j < c->getNPort() && isGood; ++j)
+		{
+			const Port *p = c->getPort(j);
+			isGood = writeName(fout, p->name_) && writeVal(fout, (int32_t)p->type_);
+		}
+
+		isGood = isGood && writeVal(fout, (uint32_t)c->getNNet());
+		for (size_t j = 0; j < c->getNNet() && isGood; ++j)
+		{
+			isGood = writeName(fout, c->getNet(j)->name_);
+		}
+
+		isGood = isGood && writeVal(fout, (uint32_t)c->getNCell());
+		for (size_t j = 0; j < c->getNCell() && isGood; ++j)
+		{
+			const Cell *sub = c->getCell(j);
+			const int32_t pmtType = sub->isPmt_ ? (int32_t)((const Pmt *)sub)->type_ : (int32_t)Pmt::NA;
+			isGood = writeVal(fout, (uint8_t)sub->isPmt_) && writeName(fout, sub->name_) &&
+							 writeName(fout, sub->typeName_) && writeVal(fout, pmtType) &&
+							 writeVal(fout, (int32_t)sub->lvl_) && writeVal(fout, (uint32_t)sub->getNPort());
+			for (size_t k = 0; k < sub->getNPort() && isGood; ++k)
+			{
+				const Port *p = sub->getPort(k);
+				isGood = writeName(fout, p->name_) && writeVal(fout, (int32_t)p->type_) &&
+								 writeVal(fout, (int32_t)(p->exNet_ ? p->exNet_->id_ : -1));
+			}
+		}
+
+		for (size_t j = 0; j < c->getNPort() && isGood; ++j)
+		{
+			const Net *n = c->getPort(j)->inNet_;
+			isGood = writeVal(fout, (int32_t)(n ? n->id_ : -1));
+		}
+
+		for (size_t j = 0; j < c->getNNet() && isGood; ++j)
+		{
+			const Net *n = c->getNet(j);
+			isGood = writeVal(fout, (uint32_t)n->getNPort());
+			for (size_t k = 0; k < n->getNPort() && isGood; ++k)
+			{
+				const Port *p = n->getPort(k);
+				// a port on a net is either one of the cell or one of a
+				// subcell, anything else cannot be restored
+				isGood = p->top_ == c || (p->top_ && p->top_->top_ == c);
+				isGood = isGood && writeVal(fout, (int32_t)(p->top_ == c ? -1 : p->top_->id_)) &&
+								 writeVal(fout, (uint32_t)p->id_);
+			}
+			isGood = isGood && writeVal(fout, (uint32_t)n->getNEqv());
+			for (size_t k = 0; k < n->getNEqv() && isGood; ++k)
+			{
+				isGood = writeVal(fout, (int32_t)n->getEqv(k)->id_);
+			}
+		}
+	}
+
+	isGood = isGood && fflush(fout) == 0 && fsync(fileno(fout)) == 0;
+	isGood = fclose(fout) == 0 && isGood;
+	if (!isGood || rename(tmpName.c_str(), fname) != 0)
+	{
+		fprintf(stderr, "**ERROR TechlibCache::write(): cannot write ");
+		fprintf(stderr, "`%s'\n", fname);
+		remove(tmpName.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,501 @@
+// **************************************************************************
+// File       [ vlog_fast_file.cpp ]
+// Author     [ PYH ]
+// Synopsis   [ ]
+// Date       [ 2026/10/19 created ]
+// **************************************************************************
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "global.h"
+#include "vlog_fast_file.h"
+
+using namespace IntfNs;
+
+namespace
+{
+	enum CharClass
+	{
+		C_SPACE = 1,
+		C_START = 2, // first character of a name
+		C_TRAIL = 4, // following characters of a name
+		C_DIGIT = 8,
+		C_PUNCT = 16
+	};
+
+	// one table lookup per character keeps the scanning loops branch light
+	struct CharTable
+	{
+		CharTable()
+		{
+			memset(cls_, 0, sizeof(cls_));
+			cls_[(unsigned char)' '] = C_SPACE;
+			cls_[(unsigned char)'\t'] = C_SPACE;
+			cls_[(unsigned char)'\v'] = C_SPACE;
+			cls_[(unsigned char)'\f'] = C_SPACE;
+			cls_[(unsigned char)'\r'] = C_SPACE;
+			cls_[(unsigned char)'\n'] = C_SPACE;
+			for (int c = 'a'; c <= 'z'; ++c)
+			{
+				cls_[c] = C_START | C_TRAIL;
+			}
+			for (int c = 'A'; c <= 'Z'; ++c)
+			{
+				cls_[c] = C_START | C_TRAIL;
+			}
+			cls_[(unsigned char)'_'] = C_START | C_TRAIL;
+			for (int c = '0'; c <= '9'; ++c)
+			{
+				cls_[c] = C_TRAIL | C_DIGIT;
+			}
+			cls_[(unsigned char)'.'] = C_TRAIL | C_PUNCT;
+			cls_[(unsigned char)'/'] = C_TRAIL;
+			cls_[(unsigned char)'('] = C_PUNCT;
+			cls_[(unsigned char)')'] = C_PUNCT;
+			cls_[(unsigned char)','] = C_PUNCT;
+			cls_[(unsigned char)';'] = C_PUNCT;
+			cls_[(unsigned char)'='] = C_PUNCT;
+		}
+		unsigned char cls_[256];
+	};
+
+	const CharTable charTable;
+
+	inline unsigned char charClass(const char &c)
+	{
+		return charTable.cls_[(unsigned char)c];
+	}
+
+	inline bool isKeyword(const char *const text, const size_t &len, const char *const kw)
+	{
+		return len == strlen(kw) && !memcmp(text, kw, len);
+	}
+}
+
+VlogFastFile::Status VlogFastFile::read(const char *const fname)
+{
+	unmap();
+	names_.clear();
+	stmts_.clear();
+
+	int fd = open(fname, O_RDONLY);
+	if (fd < 0)
+	{
+		return FAIL;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close(fd);
+		return UNSUPPORTED;
+	}
+	size_ = st.st_size;
+	void *buf = mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (buf == MAP_FAILED)
+	{
+		size_ = 0;
+		return UNSUPPORTED;
+	}
+	buf_ = (char *)buf;
+	madvise(buf_, size_, MADV_SEQUENTIAL);
+
+	cur_ = buf_;
+	pendingPunct_ = '\0';
+	unsupported_ = false;
+	lookHead_ = 0;
+	nLook_ = 0;
+	// roughly one name every sixteen bytes in generated netlists
+	names_.reserve(size_ / 16);
+	return parse();
+}
+
+bool VlogFastFile::lex(Tok &tok)
+{
+	if (pendingPunct_)
+	{
+		tok.type_ = T_PUNCT;
+		tok.c_ = pendingPunct_;
+		tok.text_ = NULL;
+		pendingPunct_ = '\0';
+		return true;
+	}
+
+	char *p = cur_;
+	char *const end = buf_ + size_;
+	while (p < end)
+	{
+		const unsigned char cls = charClass(*p);
+		if (cls & C_SPACE)
+		{
+			++p;
+			continue;
+		}
+		if (*p == '/' && p + 1 < end && p[1] == '/')
+		{
+			char *nl = (char *)memchr(p, '\n', end - p);
+			p = nl ? nl : end;
+			continue;
+		}
+		if (*p == '/' && p + 1 < end && p[1] == '*')
+		{
+			char *q = p + 2;
+			while (q + 1 < end && !(q[0] == '*' && q[1] == '/'))
+			{
+				q = (char *)memchr(q + 1, '*', end - q - 1);
+				if (!q)
+				{
+					break;
+				}
+			}
+			if (!q || q + 1 >= end)
+			{
+				unsupported_ = true;
+				return false;
+			}
+			p = q + 2;
+			continue;
+		}
+		// compiler directives are skipped up to the end of line
+		if (*p == '`')
+		{
+			char *nl = (char *)memchr(p, '\n', end - p);
+			p = nl ? nl : end;
+			continue;
+		}
+
+		if (cls & C_PUNCT)
+		{
+			tok.type_ = T_PUNCT;
+			tok.c_ = *p;
+			tok.text_ = NULL;
+			cur_ = p + 1;
+			return true;
+		}
+
+		char *q = p;
+		tok.type_ = T_NAME;
+		tok.c_ = '\0';
+		tok.text_ = p;
+		if (cls & C_START)
+		{
+			++q;
+			while (q < end && (charClass(*q) & C_TRAIL))
+			{
+				++q;
+			}
+			// bit select "[n]" or "[n:m]" directly attached to the name
+			if (q < end && *q == '[')
+			{
+				char *r = q + 1;
+				while (r < end && (charClass(*r) & C_DIGIT))
+				{
+					++r;
+				}
+				if (r < end && *r == ':' && r > q + 1)
+				{
+					char *s = ++r;
+					while (r < end && (charClass(*r) & C_DIGIT))
+					{
+						++r;
+					}
+					if (r == s)
+					{
+						r = q + 1;
+					}
+				}
+				if (r >= end || *r != ']' || r == q + 1)
+				{
+					unsupported_ = true;
+					return false;
+				}
+				q = r + 1;
+			}
+			const size_t len = q - p;
+			switch (len)
+			{
+				case 3:
+					if (isKeyword(p, 3, "reg"))
+					{
+						tok.type_ = T_REG;
+					}
+					break;
+				case 4:
+					if (isKeyword(p, 4, "wire"))
+					{
+						tok.type_ = T_WIRE;
+					}
+					break;
+				case 5:
+					if (isKeyword(p, 5, "input"))
+					{
+						tok.type_ = T_INPUT;
+					}
+					else if (isKeyword(p, 5, "inout"))
+					{
+						tok.type_ = T_INOUT;
+					}
+					else if (isKeyword(p, 5, "table") || isKeyword(p, 5, "weak0") || isKeyword(p, 5, "weak1"))
+					{
+						unsupported_ = true;
+						return false;
+					}
+					break;
+				case 6:
+					if (isKeyword(p, 6, "module"))
+					{
+						tok.type_ = T_MODULE;
+					}
+					else if (isKeyword(p, 6, "output"))
+					{
+						tok.type_ = T_OUTPUT;
+					}
+					else if (isKeyword(p, 6, "assign"))
+					{
+						tok.type_ = T_ASSIGN;
+					}
+					break;
+				case 7:
+					if (isKeyword(p, 7, "supply0") || isKeyword(p, 7, "supply1"))
+					{
+						tok.type_ = T_SUPPLY;
+					}
+					else if (isKeyword(p, 7, "specify") || isKeyword(p, 7, "strong0") || isKeyword(p, 7, "strong1"))
+					{
+						unsupported_ = true;
+						return false;
+					}
+					break;
+				case 9:
+					if (isKeyword(p, 9, "endmodule"))
+					{
+						tok.type_ = T_ENDMODULE;
+					}
+					else if (isKeyword(p, 9, "primitive"))
+					{
+						unsupported_ = true;
+						return false;
+					}
+					break;
+				case 12:
+					if (isKeyword(p, 12, "endprimitive"))
+					{
+						unsupported_ = true;
+						return false;
+					}
+					break;
+			}
+		}
+		else if (cls & C_DIGIT)
+		{
+			// only constants like 1'b0 are names, bare numbers appear in
+			// ranges and delays which are not handled here
+			while (q < end && (charClass(*q) & C_DIGIT))
+			{
+				++q;
+			}
+			if (q + 2 >= end || q[0] != '\'' || q[1] != 'b' || !q[2] || !strchr("01XxZz", q[2]))
+			{
+				unsupported_ = true;
+				return false;
+			}
+			q += 3;
+		}
+		else
+		{
+			unsupported_ = true;
+			return false;
+		}
+
+		if (tok.type_ != T_NAME)
+		{
+			cur_ = q;
+			return true;
+		}
+
+		// terminate the name in place. The character behind it must be a
+		// blank or a punctuation, the latter is handed out as the next token
+		if (q >= end || q - p >= NAME_LEN)
+		{
+			unsupported_ = true;
+			return false;
+		}
+		const unsigned char delimCls = charClass(*q);
+		if (delimCls & C_PUNCT)
+		{
+			pendingPunct_ = *q;
+		}
+		else if (!(delimCls & C_SPACE))
+		{
+			unsupported_ = true;
+			return false;
+		}
+		*q = '\0';
+		cur_ = q + 1;
+		return true;
+	}
+	cur_ = end;
+	return false;
+}
+
+VlogFastFile::Status VlogFastFile::parse()
+{
+	while (peek(0))
+	{
+		// module header
+		if (peek(0)->type_ != T_MODULE || !isName(1))
+		{
+			return UNSUPPORTED;
+		}
+		Stmt stmt;
+		stmt.type_ = Stmt::MODULE;
+		stmt.begin_ = names_.size();
+		names_.push_back(peek(1)->text_);
+		consume(2);
+		if (isPunct(0, '('))
+		{
+			consume(1);
+			if (!parseList(')') || !isPunct(1, ';'))
+			{
+				return UNSUPPORTED;
+			}
+			consume(2);
+		}
+		else if (isPunct(0, ';'))
+		{
+			consume(1);
+		}
+		else
+		{
+			return UNSUPPORTED;
+		}
+		stmt.end_ = names_.size();
+		stmts_.push_back(stmt);
+
+		// module body
+		while (peek(0) && peek(0)->type_ != T_ENDMODULE)
+		{
+			stmt.begin_ = names_.size();
+			switch (peek(0)->type_)
+			{
+				case T_INPUT:
+				case T_OUTPUT:
+				case T_INOUT:
+				case T_WIRE:
+					// token types are declared in the same order as statement types
+					stmt.type_ = (Stmt::Type)(Stmt::INPUT + (peek(0)->type_ - T_INPUT));
+					consume(1);
+					if (!parseList(';'))
+					{
+						return UNSUPPORTED;
+					}
+					consume(1);
+					break;
+				case T_REG:
+				case T_SUPPLY:
+					// accepted but not used by the netlist builder
+					consume(1);
+					if (!parseList(';'))
+					{
+						return UNSUPPORTED;
+					}
+					consume(1);
+					names_.resize(stmt.begin_);
+					continue;
+				case T_ASSIGN:
+					if (!isName(1) || !isPunct(2, '=') || !isName(3) || !isPunct(4, ';'))
+					{
+						return UNSUPPORTED;
+					}
+					stmt.type_ = Stmt::ASSIGN;
+					names_.push_back(peek(1)->text_);
+					names_.push_back(peek(3)->text_);
+					consume(5);
+					break;
+				case T_NAME:
+					// instance with named port mapping
+					if (!isName(1) || !isPunct(2, '('))
+					{
+						return UNSUPPORTED;
+					}
+					stmt.type_ = Stmt::CELL;
+					names_.push_back(peek(0)->text_);
+					names_.push_back(peek(1)->text_);
+					consume(3);
+					while (true)
+					{
+						if (!isPunct(0, '.') || !isName(1) || !isPunct(2, '(') || !isName(3) || !isPunct(4, ')'))
+						{
+							return UNSUPPORTED;
+						}
+						names_.push_back(peek(1)->text_);
+						names_.push_back(peek(3)->text_);
+						consume(5);
+						if (isPunct(0, ')'))
+						{
+							break;
+						}
+						if (!isPunct(0, ','))
+						{
+							return UNSUPPORTED;
+						}
+						consume(1);
+					}
+					if (!isPunct(1, ';'))
+					{
+						return UNSUPPORTED;
+					}
+					consume(2);
+					break;
+				default:
+					return UNSUPPORTED;
+			}
+			stmt.end_ = names_.size();
+			stmts_.push_back(stmt);
+		}
+		if (!peek(0))
+		{
+			return UNSUPPORTED;
+		}
+		consume(1); // endmodule
+	}
+	return unsupported_ || stmts_.empty() ? UNSUPPORTED : SUCCESS;
+}
+
+// parse "name {, name}" up to the closing character, which is left as the
+// next token
+bool VlogFastFile::parseList(const char &close)
+{
+	while (true)
+	{
+		if (!isName(0))
+		{
+			return false;
+		}
+		names_.push_back(peek(0)->text_);
+		consume(1);
+		if (isPunct(0, close))
+		{
+			return true;
+		}
+		if (!isPunct(0, ','))
+		{
+			return false;
+		}
+		consume(1);
+	}
+}
+
+void VlogFastFile::unmap()
+{
+	if (buf_)
+	{
+		munmap(buf_, size_);
+	}
+	buf_ = NULL;
+	size_ = 0;
+}
@@ -25,6 +25,11 @@ bool VlogFile::read(const char *const fname, const bool &verbose)
 		return false;
 	}
 
+	fseek(vlog_filein, 0, SEEK_END);
+	nBytes_ = ftell(vlog_filein);
+	rewind(vlog_filein);
+	fastPath_ = false;
+
 	success_ = true;
 	int res = vlog_fileparse(this);
 	if (res != 0)
@@ -9,6 +9,8 @@
 #ifndef _INTF_VLOG_FILE_H_
 #define _INTF_VLOG_FILE_H_
 
+#include <cstddef>
+
 #include "global.h"
 
 namespace IntfNs {
@@ -56,17 +58,33 @@ public:
                          VlogNames * const ports);
     virtual void addAssign(const char * const n1, const char * const n2);
 
+    // statistics of the last read
+    size_t       getNBytes() const;
+    bool         isFastPath() const;
+
 protected:
-    bool success_;
-    bool verbose_;
+    bool   success_;
+    bool   verbose_;
+    size_t nBytes_;
+    bool   fastPath_;
 };
 
 inline VlogFile::VlogFile() {
-    success_ = true;
-    verbose_ = false;
+    success_  = true;
+    verbose_  = false;
+    nBytes_   = 0;
+    fastPath_ = false;
 }
 inline VlogFile::~VlogFile() {}
 
+inline size_t VlogFile::getNBytes() const {
+    return nBytes_;
+}
+
+inline bool VlogFile::isFastPath() const {
+    return fastPath_;
+}
+
 };
 
 #endif